@@ -0,0 +1,163 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_CONTROLFLOW_CALLGRAPHSCCS_H
+#define PHASAR_CONTROLFLOW_CALLGRAPHSCCS_H
+
+#include "phasar/Utils/ByRef.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/// The strongly connected components (SCCs) of a call graph.
+///
+/// The SCCs are numbered in reverse topological order of the condensed call
+/// graph, i.e., if a function in SCC A calls a function in SCC B != A, then
+/// B < A. Hence, visiting the SCCs by increasing index visits all callees
+/// before their callers.
+template <typename F> class CallGraphSCCs {
+public:
+  using f_t = F;
+
+  /// Returns the index of the SCC that contains Fun. Functions that are not
+  /// part of the call graph get the index getNumSCCs(), i.e., they come last.
+  [[nodiscard]] uint32_t getSCCIndex(ByConstRef<f_t> Fun) const {
+    auto It = SCCOf.find(Fun);
+    return It != SCCOf.end() ? It->second : NumSCCs;
+  }
+
+  [[nodiscard]] uint32_t getNumSCCs() const noexcept { return NumSCCs; }
+  [[nodiscard]] size_t getNumFunctions() const noexcept {
+    return SCCOf.size();
+  }
+
+  [[nodiscard]] bool inSameSCC(ByConstRef<f_t> Fun1,
+                               ByConstRef<f_t> Fun2) const {
+    return getSCCIndex(Fun1) == getSCCIndex(Fun2);
+  }
+
+  /// Computes the SCCs of the call graph that consists of the functions in
+  /// Funs, where GetCallees(Fun) returns an iterable range of all functions
+  /// that Fun may call.
+  ///
+  /// Uses an iterative version of Tarjan's algorithm, so it does not overflow
+  /// the stack on deep call chains.
+  template <typename FunRange, typename CalleesFn>
+  [[nodiscard]] static CallGraphSCCs compute(const FunRange &Funs,
+                                             CalleesFn GetCallees) {
+    CallGraphSCCs Ret;
+
+    struct NodeInfo {
+      uint32_t Index{};
+      uint32_t LowLink{};
+      bool OnStack{};
+    };
+    struct Frame {
+      f_t Fun;
+      llvm::SmallVector<f_t, 4> Callees;
+      size_t NextCallee = 0;
+    };
+
+    llvm::DenseMap<f_t, NodeInfo> Info;
+    std::vector<f_t> SCCStack;
+    std::vector<Frame> CallStack;
+    uint32_t NextIndex = 0;
+
+    auto Visit = [&](f_t Fun) {
+      auto Idx = NextIndex++;
+      Info[Fun] = {Idx, Idx, true};
+      SCCStack.push_back(Fun);
+
+      auto &Fr = CallStack.emplace_back();
+      Fr.Fun = std::move(Fun);
+      for (const auto &Callee : GetCallees(Fr.Fun)) {
+        Fr.Callees.push_back(Callee);
+      }
+    };
+
+    for (const auto &Root : Funs) {
+      if (Info.count(Root)) {
+        continue;
+      }
+
+      Visit(Root);
+      while (!CallStack.empty()) {
+        auto &Top = CallStack.back();
+        if (Top.NextCallee != Top.Callees.size()) {
+          f_t Callee = Top.Callees[Top.NextCallee++];
+          auto It = Info.find(Callee);
+          if (It == Info.end()) {
+            // Invalidates Top
+            Visit(std::move(Callee));
+          } else if (It->second.OnStack) {
+            auto &TopInfo = Info[Top.Fun];
+            TopInfo.LowLink = std::min(TopInfo.LowLink, It->second.Index);
+          }
+          continue;
+        }
+
+        f_t Fun = std::move(Top.Fun);
+        CallStack.pop_back();
+
+        auto FunInfo = Info[Fun];
+        if (FunInfo.LowLink == FunInfo.Index) {
+          // Fun is the root of an SCC
+          f_t Member;
+          do {
+            Member = SCCStack.back();
+            SCCStack.pop_back();
+            Info[Member].OnStack = false;
+            Ret.SCCOf[Member] = Ret.NumSCCs;
+          } while (Member != Fun);
+          ++Ret.NumSCCs;
+        }
+
+        if (!CallStack.empty()) {
+          auto &CallerInfo = Info[CallStack.back().Fun];
+          CallerInfo.LowLink = std::min(CallerInfo.LowLink, FunInfo.LowLink);
+        }
+      }
+    }
+
+    return Ret;
+  }
+
+private:
+  llvm::DenseMap<f_t, uint32_t> SCCOf;
+  uint32_t NumSCCs = 0;
+};
+
+/// Computes the SCCs of the call graph that is induced by the given ICFG
+template <typename ICFGTy>
+[[nodiscard]] CallGraphSCCs<typename ICFGTy::f_t>
+computeCallGraphSCCs(const ICFGTy &ICF) {
+  using f_t = typename ICFGTy::f_t;
+  return CallGraphSCCs<f_t>::compute(
+      ICF.getAllFunctions(), [&ICF](ByConstRef<f_t> Fun) {
+        llvm::SmallVector<f_t, 4> Callees;
+        for (const auto &CS : ICF.getCallsFromWithin(Fun)) {
+          for (const auto &Callee : ICF.getCalleesOfCallAt(CS)) {
+            Callees.push_back(Callee);
+          }
+        }
+        return Callees;
+      });
+}
+
+} // namespace psr
+
+#endif // PHASAR_CONTROLFLOW_CALLGRAPHSCCS_H
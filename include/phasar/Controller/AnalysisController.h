@@ -47,6 +47,8 @@ public:
   needsToEmitPTA(AnalysisControllerEmitterOptions EmitterOptions) {
     return (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsDot) ||
            (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsJson) ||
+           (EmitterOptions &
+            AnalysisControllerEmitterOptions::EmitPTAAsBinary) ||
            (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsText);
   }
 
@@ -29,6 +29,7 @@ enum class AnalysisControllerEmitterOptions {
   EmitPTAAsJson = (1 << 13),
   EmitStatisticsAsText = (1 << 14),
   EmitStatisticsAsJson = (1 << 15),
+  EmitPTAAsBinary = (1 << 16),
 };
 } // namespace psr
 
@@ -33,6 +33,8 @@
 #include "phasar/DataFlow/Mono/IntraMonoProblem.h"
 #include "phasar/DataFlow/Mono/Solver/InterMonoSolver.h"
 #include "phasar/DataFlow/Mono/Solver/IntraMonoSolver.h"
+#include "phasar/DataFlow/Mono/Solver/ParallelIntraMonoSolver.h"
+#include "phasar/DataFlow/PathSensitivity/FlowPathEnumerator.h"
 #include "phasar/DataFlow/PathSensitivity/PathSensitivityConfig.h"
 #include "phasar/DataFlow/PathSensitivity/PathSensitivityManager.h"
 
@@ -10,6 +10,8 @@
 #ifndef PHASAR_DATAFLOW_IFDSIDE_EDGEFUNCTION_H
 #define PHASAR_DATAFLOW_IFDSIDE_EDGEFUNCTION_H
 
+#include "phasar/Config/phasar-config.h"
+#include "phasar/DataFlow/IfdsIde/EdgeFunctionAllocator.h"
 #include "phasar/DataFlow/IfdsIde/EdgeFunctionSingletonCache.h"
 #include "phasar/Utils/ByRef.h"
 #include "phasar/Utils/TypeTraits.h"
@@ -86,11 +88,36 @@ public:
 
 protected:
   struct RefCountedBase {
+#ifdef PHASAR_SINGLE_THREADED_EDGE_FUNCTIONS
+    mutable size_t Rc = 0;
+
+    void retain() const noexcept { ++Rc; }
+    [[nodiscard]] bool release() const noexcept { return --Rc == 0; }
+#else
     mutable std::atomic_size_t Rc = 0;
+
+    // Note: Memory-orders taken from llvm::ThreadSafeRefCountedBase
+    void retain() const noexcept { Rc.fetch_add(1, std::memory_order_relaxed); }
+    [[nodiscard]] bool release() const noexcept {
+      return Rc.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+#endif
+  };
+  template <typename T> struct RefCounted : RefCountedBase {
+    template <typename... ArgTys>
+    explicit RefCounted(std::in_place_t /*unused*/, ArgTys &&...Args)
+        : Value{std::forward<ArgTys>(Args)...} {}
+
+    T Value;
   };
-  template <typename T> struct RefCounted : RefCountedBase { T Value; };
 
   template <typename T> struct CachedRefCounted : RefCounted<T> {
+    template <typename... ArgTys>
+    explicit CachedRefCounted(EdgeFunctionSingletonCache<T> *Cache,
+                              ArgTys &&...Args)
+        : RefCounted<T>(std::in_place, std::forward<ArgTys>(Args)...),
+          Cache(Cache) {}
+
     EdgeFunctionSingletonCache<T> *Cache{};
   };
 
@@ -218,9 +245,7 @@ public:
     AllocationPolicy Policy = VTAndHeapAlloc.getInt();
     if (Policy != AllocationPolicy::SmallObjectOptimized) {
       assert(VTAndHeapAlloc.getPointer() != nullptr && "Heap-alloc'd nullptr?");
-      // Note: Memory-order taken from llvm::ThreadSafeRefCountedBase
-      if (static_cast<const RefCountedBase *>(EF)->Rc.fetch_sub(
-              1, std::memory_order_acq_rel) == 1) {
+      if (static_cast<const RefCountedBase *>(EF)->release()) {
         VTAndHeapAlloc.getPointer()->destroy(EF, Policy);
       }
     }
@@ -273,8 +298,8 @@ public:
                 new (&Ret) ConcreteEF(std::forward<ArgTys>(Args)...);
                 return Ret;
               } else {
-                return new RefCounted<ConcreteEF>{
-                    {}, {std::forward<ArgTys>(Args)...}};
+                return EdgeFunctionAllocator::create<RefCounted<ConcreteEF>>(
+                    std::in_place, std::forward<ArgTys>(Args)...);
               }
             }(std::forward<ArgTys>(Args)...),
             {&VTableFor<ConcreteEF>, DefaultAllocPolicy<ConcreteEF>}) {
@@ -310,8 +335,9 @@ public:
                   return static_cast<const RefCounted<ConcreteEF> *>(Mem);
                 }
 
-                auto Ret = new CachedRefCounted<ConcreteEF>{
-                    {{}, {std::move(EF.EF)}}, EF.Cache};
+                auto *Ret =
+                    EdgeFunctionAllocator::create<CachedRefCounted<ConcreteEF>>(
+                        EF.Cache, std::move(EF.EF));
                 EF.Cache->insert(&Ret->Value, Ret);
                 return static_cast<const RefCounted<ConcreteEF> *>(Ret);
               }
@@ -746,11 +772,12 @@ private:
         if constexpr (!IsSOOCandidate<ConcreteEF>) {
           if (Policy != AllocationPolicy::CustomHeapAllocated) {
             assert(Policy == AllocationPolicy::DefaultHeapAllocated);
-            delete static_cast<const RefCounted<ConcreteEF> *>(EF);
+            EdgeFunctionAllocator::destroy(
+                static_cast<const RefCounted<ConcreteEF> *>(EF));
           } else {
             auto CEF = static_cast<const CachedRefCounted<ConcreteEF> *>(EF);
             CEF->Cache->erase(CEF->Value);
-            delete CEF;
+            EdgeFunctionAllocator::destroy(CEF);
           }
         }
       },
@@ -780,9 +807,7 @@ private:
                           VTAndHeapAlloc) noexcept
       : EF(EF), VTAndHeapAlloc(VTAndHeapAlloc) {
     if (VTAndHeapAlloc.getInt() != AllocationPolicy::SmallObjectOptimized) {
-      // Note: Memory-order taken from llvm::ThreadSafeRefCountedBase
-      static_cast<const RefCountedBase *>(EF)->Rc.fetch_add(
-          1, std::memory_order_relaxed);
+      static_cast<const RefCountedBase *>(EF)->retain();
     }
   }
 
@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_DATAFLOW_IFDSIDE_EDGEFUNCTIONALLOCATOR_H
+#define PHASAR_DATAFLOW_IFDSIDE_EDGEFUNCTIONALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace psr {
+
+/// Size-class based slab allocator for the heap-allocated (i.e., not
+/// small-object-optimized) edge functions.
+///
+/// Objects of up to MaxPooledSize bytes are rounded up to a multiple of
+/// Granularity and served from per-thread free lists. The free lists are
+/// refilled in batches from a global pool that carves fresh chunks out of
+/// SlabSize-sized slabs. Larger or over-aligned objects are forwarded to
+/// ::operator new.
+///
+/// Memory that was once handed out by the pool is recycled, but never returned
+/// to the system, such that edge functions with static storage duration can
+/// still safely be destroyed after all threads have terminated.
+class EdgeFunctionAllocator {
+public:
+  static constexpr size_t Granularity = 16;
+  static constexpr size_t MaxPooledSize = 256;
+  static constexpr size_t NumSizeClasses = MaxPooledSize / Granularity;
+  static constexpr size_t SlabSize = size_t(64) * 1024;
+
+  /// True, iff objects of type T are served from the slab pool
+  template <typename T>
+  static constexpr bool IsPoolable =
+      sizeof(T) <= MaxPooledSize && alignof(T) <= Granularity;
+
+  struct Statistics {
+    /// Number of slabs allocated from the system
+    size_t NumSlabs{};
+    /// Total number of bytes reserved by the slabs
+    size_t NumBytesReserved{};
+  };
+
+  /// Allocates uninitialized memory for an object of type T
+  template <typename T> [[nodiscard]] static void *allocate() {
+    if constexpr (IsPoolable<T>) {
+      return allocateChunk(getSizeClass(sizeof(T)));
+    } else {
+      return ::operator new(sizeof(T), std::align_val_t{alignof(T)});
+    }
+  }
+
+  /// Releases memory that was obtained from allocate<T>(). Does not invoke the
+  /// destructor.
+  template <typename T> static void deallocate(const void *Ptr) noexcept {
+    auto *Mem = const_cast<void *>(Ptr); // NOLINT
+    if constexpr (IsPoolable<T>) {
+      deallocateChunk(Mem, getSizeClass(sizeof(T)));
+    } else {
+      ::operator delete(Mem, sizeof(T), std::align_val_t{alignof(T)});
+    }
+  }
+
+  /// Allocates memory for an object of type T and constructs it from the given
+  /// arguments
+  template <typename T, typename... ArgTys>
+  [[nodiscard]] static T *create(ArgTys &&...Args) {
+    void *Mem = allocate<T>();
+    if constexpr (std::is_nothrow_constructible_v<T, ArgTys...>) {
+      return new (Mem) T(std::forward<ArgTys>(Args)...);
+    } else {
+      try {
+        return new (Mem) T(std::forward<ArgTys>(Args)...);
+      } catch (...) {
+        deallocate<T>(Mem);
+        throw;
+      }
+    }
+  }
+
+  /// Destroys an object that was obtained from create<T>() and releases its
+  /// memory
+  template <typename T> static void destroy(const T *Obj) noexcept {
+    std::destroy_at(Obj);
+    deallocate<T>(Obj);
+  }
+
+  /// Moves all chunks that are cached by the calling thread back to the global
+  /// pool, such that they become available to other threads.
+  static void flushThreadCache() noexcept;
+
+  [[nodiscard]] static Statistics getStatistics() noexcept;
+
+private:
+  static constexpr size_t getSizeClass(size_t Size) noexcept {
+    return (Size + Granularity - 1) / Granularity - 1;
+  }
+
+  [[nodiscard]] static void *allocateChunk(size_t SizeClass);
+  static void deallocateChunk(void *Ptr, size_t SizeClass) noexcept;
+};
+
+} // namespace psr
+
+#endif // PHASAR_DATAFLOW_IFDSIDE_EDGEFUNCTIONALLOCATOR_H
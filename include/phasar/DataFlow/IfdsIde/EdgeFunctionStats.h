@@ -14,6 +14,7 @@
 #include "llvm/Support/raw_ostream.h"
 
 #include <array>
+#include <cassert>
 #include <cstddef>
 #include <numeric>
 
@@ -41,6 +42,15 @@ struct EdgeFunctionStatsData {
   double AvgUniqueJFDepth{};
   double AvgJFObjDepth{};
   std::array<size_t, NumAllocPolicies> PerAllocJFCount{};
+
+  std::array<size_t, NumEFKinds> FFCacheBytes{};
+  std::array<size_t, NumEFKinds> EFCacheBytes{};
+  std::array<size_t, NumEFKinds> NumEvictedCacheEntries{};
+  size_t CacheMemoryLimit{};
+
+  size_t NumNormalizedEFs{};
+  double AvgDepthBeforeNormalization{};
+  double AvgDepthAfterNormalization{};
 };
 } // namespace detail
 
@@ -68,6 +78,37 @@ public:
     return PerAllocCount[size_t(Policy)]; // NOLINT
   }
 
+  /// The number of bytes occupied by the entries of the flow- and edge
+  /// function caches, not counting the cached flow- and edge function objects
+  [[nodiscard]] size_t getCacheMemoryUsage() const noexcept {
+    return std::reduce(FFCacheBytes.begin(), FFCacheBytes.end()) +
+           std::reduce(EFCacheBytes.begin(), EFCacheBytes.end());
+  }
+  /// The number of bytes occupied by the flow-function cache for Kind
+  [[nodiscard]] size_t
+  getFlowFunctionCacheMemoryUsage(EdgeFunctionKind Kind) const noexcept {
+    assert(size_t(Kind) < NumEFKinds);
+    return FFCacheBytes[size_t(Kind)]; // NOLINT
+  }
+  /// The number of bytes occupied by the edge-function cache for Kind
+  [[nodiscard]] size_t
+  getEdgeFunctionCacheMemoryUsage(EdgeFunctionKind Kind) const noexcept {
+    assert(size_t(Kind) < NumEFKinds);
+    return EFCacheBytes[size_t(Kind)]; // NOLINT
+  }
+  /// The number of cache entries for Kind that were evicted, because the
+  /// cache exceeded its memory limit
+  [[nodiscard]] size_t
+  getNumEvictedCacheEntries(EdgeFunctionKind Kind) const noexcept {
+    assert(size_t(Kind) < NumEFKinds);
+    return NumEvictedCacheEntries[size_t(Kind)]; // NOLINT
+  }
+  /// The memory limit of the flow- and edge function cache in bytes. 0 means
+  /// unbounded.
+  [[nodiscard]] size_t getCacheMemoryLimit() const noexcept {
+    return CacheMemoryLimit;
+  }
+
   friend llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
                                        const EdgeFunctionStats &S);
 
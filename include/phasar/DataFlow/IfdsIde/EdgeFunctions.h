@@ -264,6 +264,23 @@ public:
                                                    d_t /*SuccNode*/) {
     return nullptr;
   }
+
+  //
+  // Brings a composed edge function into a closed normal form.
+  //
+  // Repeated composition builds up chains of composed edge functions, which
+  // make computeTarget() and operator== linear in the length of the chain. The
+  // IDESolver calls this function on every composition result whose depth()
+  // exceeds IFDSIDESolverConfig::edgeFunctionNormalizationThreshold(). An
+  // implementation may return any edge function that computes the same values
+  // as EF for all inputs, ideally one of constant depth, e.g., a constant or
+  // an affine function in a constant-propagation analysis.
+  //
+  // The default implementation returns EF unchanged.
+  //
+  virtual EdgeFunction<l_t> normalizeEdgeFunction(EdgeFunction<l_t> EF) {
+    return EF;
+  }
 };
 
 } // namespace psr
@@ -19,7 +19,9 @@
 
 #include "phasar/Utils/EnumFlags.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <string>
 
 namespace llvm {
 class raw_ostream;
@@ -35,6 +37,7 @@ enum class SolverConfigOptions : uint32_t {
   RecordEdges = 8,
   EmitESG = 16,
   ComputePersistedSummaries = 32,
+  BottomUpScheduling = 64,
 
   All = ~0U
 };
@@ -49,6 +52,24 @@ struct IFDSIDESolverConfig {
   [[nodiscard]] bool recordEdges() const;
   [[nodiscard]] bool emitESG() const;
   [[nodiscard]] bool computePersistedSummaries() const;
+  /// Whether the IDE solver schedules its worklist along the SCCs of the call
+  /// graph, such that callee summaries are completed before the pending path
+  /// edges of their callers are processed.
+  [[nodiscard]] bool bottomUpScheduling() const;
+  /// The maximum number of bytes the solver's flow- and edge function cache may
+  /// occupy before it starts evicting entries. 0 means unbounded.
+  ///
+  /// Only the cache's own entries are counted, not the flow- and edge function
+  /// objects they share with the solver; see FlowEdgeFunctionCache.
+  [[nodiscard]] size_t flowEdgeFunctionCacheLimit() const;
+  /// The composition depth above which the solver asks the analysis problem
+  /// to normalize a composed edge function (see
+  /// EdgeFunctions::normalizeEdgeFunction()). 0 means never.
+  [[nodiscard]] size_t edgeFunctionNormalizationThreshold() const;
+  /// If non-empty and recordEdges() is set, the solver streams the recorded
+  /// exploded supergraph edges to this file instead of keeping them in memory
+  /// (see ESGEdgeLog).
+  [[nodiscard]] const std::string &edgeLogFile() const;
 
   void setFollowReturnsPastSeeds(bool Set = true);
   void setAutoAddZero(bool Set = true);
@@ -56,6 +77,10 @@ struct IFDSIDESolverConfig {
   void setRecordEdges(bool Set = true);
   void setEmitESG(bool Set = true);
   void setComputePersistedSummaries(bool Set = true);
+  void setBottomUpScheduling(bool Set = true);
+  void setFlowEdgeFunctionCacheLimit(size_t LimitInBytes);
+  void setEdgeFunctionNormalizationThreshold(size_t Depth);
+  void setEdgeLogFile(std::string Path);
 
   void setConfig(SolverConfigOptions Opt);
 
@@ -65,6 +90,9 @@ struct IFDSIDESolverConfig {
 private:
   SolverConfigOptions Options =
       SolverConfigOptions::AutoAddZero | SolverConfigOptions::ComputeValues;
+  size_t FlowEdgeFunctionCacheLimit = 0;
+  size_t EdgeFunctionNormalizationThreshold = 0;
+  std::string EdgeLogFile;
 };
 
 } // namespace psr
@@ -0,0 +1,367 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_DATAFLOW_IFDSIDE_SOLVER_ESGEDGELOG_H
+#define PHASAR_DATAFLOW_IFDSIDE_SOLVER_ESGEDGELOG_H
+
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/DataFlow/IfdsIde/Solver/ESGEdgeKind.h"
+#include "phasar/Utils/ByRef.h"
+#include "phasar/Utils/Table.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/Compiler.h"
+#include "llvm/Support/ErrorHandling.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+class raw_fd_ostream;
+} // namespace llvm
+
+namespace psr {
+
+/// One edge (From, FromFact) --> (To, ToFact) of the exploded supergraph,
+/// where statements and facts are encoded by dense IDs. The edge kind is
+/// stored in the uppermost bits of the target fact's ID, such that a record
+/// only occupies 16 bytes.
+///
+/// A record whose target fact is KillFactId marks that all facts of the edge
+/// (From, FromFact) --> To have been killed.
+struct ESGEdgeRecord {
+  static constexpr unsigned KindBits = 3;
+  static constexpr uint32_t MaxFactId = (uint32_t(1) << (32 - KindBits)) - 1;
+  /// Reserved target fact of kill-records; never assigned to a real fact
+  static constexpr uint32_t KillFactId = MaxFactId;
+
+  static_assert(uint32_t(ESGEdgeKind::Summary) < (uint32_t(1) << KindBits),
+                "The ESGEdgeKind does not fit into KindBits anymore");
+
+  uint32_t From;
+  uint32_t FromFact;
+  uint32_t To;
+  uint32_t ToFactAndKind;
+
+  ESGEdgeRecord() noexcept = default;
+  constexpr ESGEdgeRecord(uint32_t From, uint32_t FromFact, uint32_t To,
+                          uint32_t ToFact, ESGEdgeKind Kind) noexcept
+      : From(From), FromFact(FromFact), To(To),
+        ToFactAndKind(ToFact | (uint32_t(Kind) << (32 - KindBits))) {
+    assert(ToFact <= MaxFactId);
+  }
+
+  [[nodiscard]] constexpr uint32_t toFact() const noexcept {
+    return ToFactAndKind & MaxFactId;
+  }
+  [[nodiscard]] constexpr ESGEdgeKind kind() const noexcept {
+    return ESGEdgeKind(ToFactAndKind >> (32 - KindBits));
+  }
+  [[nodiscard]] constexpr bool isKill() const noexcept {
+    return toFact() == KillFactId;
+  }
+
+  [[nodiscard]] friend constexpr bool
+  operator==(const ESGEdgeRecord &LHS, const ESGEdgeRecord &RHS) noexcept {
+    return LHS.From == RHS.From && LHS.FromFact == RHS.FromFact &&
+           LHS.To == RHS.To && LHS.ToFactAndKind == RHS.ToFactAndKind;
+  }
+  [[nodiscard]] friend constexpr bool
+  operator!=(const ESGEdgeRecord &LHS, const ESGEdgeRecord &RHS) noexcept {
+    return !(LHS == RHS);
+  }
+  [[nodiscard]] friend bool operator<(const ESGEdgeRecord &LHS,
+                                      const ESGEdgeRecord &RHS) noexcept {
+    return std::tie(LHS.From, LHS.To, LHS.FromFact, LHS.ToFactAndKind) <
+           std::tie(RHS.From, RHS.To, RHS.FromFact, RHS.ToFactAndKind);
+  }
+};
+
+static_assert(sizeof(ESGEdgeRecord) == 16);
+static_assert(std::is_trivially_copyable_v<ESGEdgeRecord>);
+
+/// Append-only storage for ESGEdgeRecords that allocates memory in chunks of
+/// ChunkSize records, so appending never copies already recorded edges.
+///
+/// Optionally, full chunks are streamed to a file instead of being kept in
+/// memory. The file contains the raw records in the order they were appended.
+class ESGEdgeRecordBuffer {
+public:
+  /// Number of records per chunk (64KiB)
+  static constexpr size_t ChunkSize = 4096;
+
+  ESGEdgeRecordBuffer() noexcept;
+  ~ESGEdgeRecordBuffer();
+
+  ESGEdgeRecordBuffer(const ESGEdgeRecordBuffer &) = delete;
+  ESGEdgeRecordBuffer &operator=(const ESGEdgeRecordBuffer &) = delete;
+  ESGEdgeRecordBuffer(ESGEdgeRecordBuffer &&) noexcept;
+  ESGEdgeRecordBuffer &operator=(ESGEdgeRecordBuffer &&) noexcept;
+
+  /// From now on, write full chunks to the file at Path instead of keeping
+  /// them in memory. Records that were appended before are written as well.
+  /// Must be called at most once.
+  ///
+  /// Throws std::system_error, if the file cannot be opened.
+  void streamTo(const llvm::Twine &Path);
+
+  void push_back(const ESGEdgeRecord &Rec) {
+    if (LLVM_UNLIKELY(Pos == End)) {
+      grow();
+    }
+    *Pos++ = Rec;
+    ++NumRecords;
+  }
+
+  /// Invokes Handler on consecutive ranges of records, such that all records
+  /// are visited exactly once in the order they were appended. The ranges are
+  /// only valid during the respective invocation of Handler.
+  ///
+  /// Streamed records are read back one chunk at a time, so this needs at most
+  /// one additional chunk of memory.
+  ///
+  /// Throws std::system_error, if the streamed records cannot be read back.
+  void foreachChunk(
+      llvm::function_ref<void(llvm::ArrayRef<ESGEdgeRecord>)> Handler) const;
+
+  [[nodiscard]] size_t size() const noexcept { return NumRecords; }
+  [[nodiscard]] bool empty() const noexcept { return NumRecords == 0; }
+
+  [[nodiscard]] bool isStreaming() const noexcept { return Stream != nullptr; }
+
+  /// The number of bytes currently held in memory
+  [[nodiscard]] size_t getMemoryUsage() const noexcept {
+    return Chunks.size() * ChunkSize * sizeof(ESGEdgeRecord);
+  }
+
+  /// Removes all records and stops streaming. An already written file is
+  /// left untouched.
+  void clear() noexcept;
+
+private:
+  void grow();
+
+  std::vector<std::unique_ptr<ESGEdgeRecord[]>> Chunks;
+  ESGEdgeRecord *Pos = nullptr;
+  ESGEdgeRecord *End = nullptr;
+  size_t NumRecords = 0;
+  size_t NumStreamed = 0;
+
+  std::unique_ptr<llvm::raw_fd_ostream> Stream;
+  std::string StreamPath;
+};
+
+/// Compact, append-only log of the exploded supergraph edges that the
+/// IDESolver computes with IFDSIDESolverConfig::recordEdges() enabled.
+///
+/// Statements and data-flow facts are interned once and each edge is stored
+/// as a 16-byte ESGEdgeRecord. The log does not deduplicate edges while
+/// recording; the getPathEdges() view does.
+///
+/// With IFDSIDESolverConfig::emitESG() enabled, the IDESolver additionally
+/// logs the edge functions that belong to the recorded edges.
+template <typename N, typename D, typename L> class ESGEdgeLog {
+public:
+  using n_t = N;
+  using d_t = D;
+  using l_t = L;
+
+  /// See ESGEdgeRecordBuffer::streamTo()
+  void streamTo(const llvm::Twine &Path) { Records.streamTo(Path); }
+
+  /// Records the edges (From, FromFact) --> (To, ToFact) for all ToFact in
+  /// ToFacts. If ToFacts is empty, records a kill-record instead, such that
+  /// getPathEdges() still reports FromFact with an empty set of targets.
+  template <typename ContainerTy>
+  void saveEdges(ByConstRef<n_t> From, ByConstRef<d_t> FromFact,
+                 ByConstRef<n_t> To, const ContainerTy &ToFacts,
+                 ESGEdgeKind Kind) {
+    auto FromId = getOrCreateNodeId(From);
+    auto FromFactId = getOrCreateFactId(FromFact);
+    auto ToId = getOrCreateNodeId(To);
+    if (llvm::empty(ToFacts)) {
+      Records.push_back(
+          {FromId, FromFactId, ToId, ESGEdgeRecord::KillFactId, Kind});
+      return;
+    }
+    for (const auto &ToFact : ToFacts) {
+      Records.push_back(
+          {FromId, FromFactId, ToId, getOrCreateFactId(ToFact), Kind});
+    }
+  }
+
+  /// Records that EF is (one of) the edge function(s) that belongs to the edge
+  /// (From, FromFact) --> (To, ToFact)
+  void saveEdgeFunction(ByConstRef<n_t> From, ByConstRef<d_t> FromFact,
+                        ByConstRef<n_t> To, ByConstRef<d_t> ToFact,
+                        EdgeFunction<l_t> EF) {
+    EdgeFunctions.emplace_back(
+        ESGEdgeRecord{getOrCreateNodeId(From), getOrCreateFactId(FromFact),
+                      getOrCreateNodeId(To), getOrCreateFactId(ToFact),
+                      ESGEdgeKind::Normal},
+        std::move(EF));
+    EdgeFunctionsSorted = false;
+  }
+
+  /// Returns all edge functions that were logged for the edge
+  /// (From, FromFact) --> (To, ToFact) in the order they were logged
+  [[nodiscard]] llvm::SmallVector<EdgeFunction<l_t>, 2>
+  getEdgeFunctions(ByConstRef<n_t> From, ByConstRef<d_t> FromFact,
+                   ByConstRef<n_t> To, ByConstRef<d_t> ToFact) {
+    llvm::SmallVector<EdgeFunction<l_t>, 2> Ret;
+    auto FromId = NodeIds.find(From);
+    auto FromFactId = FactIds.find(FromFact);
+    auto ToId = NodeIds.find(To);
+    auto ToFactId = FactIds.find(ToFact);
+    if (FromId == NodeIds.end() || FromFactId == FactIds.end() ||
+        ToId == NodeIds.end() || ToFactId == FactIds.end()) {
+      return Ret;
+    }
+
+    if (!EdgeFunctionsSorted) {
+      std::stable_sort(EdgeFunctions.begin(), EdgeFunctions.end(),
+                       [](const auto &LHS, const auto &RHS) {
+                         return LHS.first < RHS.first;
+                       });
+      EdgeFunctionsSorted = true;
+    }
+
+    ESGEdgeRecord Key{FromId->second, FromFactId->second, ToId->second,
+                      ToFactId->second, ESGEdgeKind::Normal};
+    auto It = std::lower_bound(
+        EdgeFunctions.begin(), EdgeFunctions.end(), Key,
+        [](const auto &Entry, const auto &Key) { return Entry.first < Key; });
+    for (auto End = EdgeFunctions.end(); It != End && It->first == Key; ++It) {
+      Ret.push_back(It->second);
+    }
+    return Ret;
+  }
+
+  /// Invokes Handler on every recorded edge in the order they were recorded.
+  /// Edges that were recorded multiple times are visited multiple times.
+  /// Kill-records are skipped, as they do not lead to a fact.
+  template <typename HandlerFn> void foreachEdge(HandlerFn Handler) const {
+    Records.foreachChunk([this, &Handler](llvm::ArrayRef<ESGEdgeRecord> Recs) {
+      for (const auto &Rec : Recs) {
+        if (Rec.isKill()) {
+          continue;
+        }
+        std::invoke(Handler, Nodes[Rec.From], Facts[Rec.FromFact],
+                    Nodes[Rec.To], Facts[Rec.toFact()], Rec.kind());
+      }
+    });
+  }
+
+  /// Materializes the deduplicated intra- (InterProc = false) or
+  /// inter-procedural (InterProc = true) edges as table from (From, To) to the
+  /// fact-edges between them. A FromFact whose facts have all been killed is
+  /// mapped to an empty set of targets.
+  ///
+  /// Intended for debugging and statistics output only, as the resulting table
+  /// is much larger than the log itself.
+  template <typename ContainerTy = std::set<d_t>>
+  [[nodiscard]] Table<n_t, n_t, std::map<d_t, ContainerTy>>
+  getPathEdges(bool InterProc) const {
+    Table<n_t, n_t, std::map<d_t, ContainerTy>> Ret;
+    Records.foreachChunk(
+        [this, &Ret, InterProc](llvm::ArrayRef<ESGEdgeRecord> Recs) {
+          for (const auto &Rec : Recs) {
+            if (isInterProc(Rec.kind()) != InterProc) {
+              continue;
+            }
+            auto &Targets =
+                Ret.get(Nodes[Rec.From], Nodes[Rec.To])[Facts[Rec.FromFact]];
+            if (!Rec.isKill()) {
+              Targets.insert(Facts[Rec.toFact()]);
+            }
+          }
+        });
+    return Ret;
+  }
+
+  /// The number of recorded edges, including duplicates and kill-records
+  [[nodiscard]] size_t size() const noexcept { return Records.size(); }
+  [[nodiscard]] bool empty() const noexcept { return Records.empty(); }
+
+  [[nodiscard]] size_t getNumNodes() const noexcept { return Nodes.size(); }
+  [[nodiscard]] size_t getNumFacts() const noexcept { return Facts.size(); }
+
+  [[nodiscard]] const ESGEdgeRecordBuffer &getRecords() const noexcept {
+    return Records;
+  }
+
+  [[nodiscard]] ByConstRef<n_t> getNode(uint32_t Id) const noexcept {
+    assert(Id < Nodes.size());
+    return Nodes[Id];
+  }
+  [[nodiscard]] ByConstRef<d_t> getFact(uint32_t Id) const noexcept {
+    assert(Id < Facts.size());
+    return Facts[Id];
+  }
+
+  void clear() noexcept {
+    Records.clear();
+    EdgeFunctions.clear();
+    NodeIds.clear();
+    FactIds.clear();
+    Nodes.clear();
+    Facts.clear();
+  }
+
+private:
+  [[nodiscard]] uint32_t getOrCreateNodeId(ByConstRef<n_t> Node) {
+    auto [It, Inserted] = NodeIds.try_emplace(Node, uint32_t(Nodes.size()));
+    if (Inserted) {
+      Nodes.push_back(Node);
+    }
+    return It->second;
+  }
+
+  [[nodiscard]] uint32_t getOrCreateFactId(ByConstRef<d_t> Fact) {
+    auto [It, Inserted] = FactIds.try_emplace(Fact, uint32_t(Facts.size()));
+    if (Inserted) {
+      if (LLVM_UNLIKELY(Facts.size() >= ESGEdgeRecord::KillFactId)) {
+        llvm::report_fatal_error(
+            "Too many data-flow facts for the ESGEdgeLog: At most " +
+            llvm::Twine(ESGEdgeRecord::KillFactId) +
+            " distinct facts can be recorded");
+      }
+      Facts.push_back(Fact);
+    }
+    return It->second;
+  }
+
+  ESGEdgeRecordBuffer Records;
+  std::vector<std::pair<ESGEdgeRecord, EdgeFunction<l_t>>> EdgeFunctions;
+  bool EdgeFunctionsSorted = true;
+
+  std::unordered_map<n_t, uint32_t> NodeIds;
+  std::unordered_map<d_t, uint32_t> FactIds;
+  std::vector<n_t> Nodes;
+  std::vector<d_t> Facts;
+};
+
+} // namespace psr
+
+#endif // PHASAR_DATAFLOW_IFDSIDE_SOLVER_ESGEDGELOG_H
@@ -12,6 +12,7 @@
 
 #include "phasar/DataFlow/IfdsIde/EdgeFunctions.h"
 #include "phasar/DataFlow/IfdsIde/IDETabulationProblem.h"
+#include "phasar/Utils/CountingAllocator.h"
 #include "phasar/Utils/EquivalenceClassMap.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/PAMMMacros.h"
@@ -20,12 +21,16 @@
 #include "llvm/ADT/DenseMap.h"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <set>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace llvm {
 class Value;
@@ -71,6 +76,20 @@ private:
  * When a flow or edge function must be applied to multiple times, a cached
  * version is used if existend, otherwise a new one is created and inserted
  * into the cache.
+ *
+ * The memory held by the cache-maps is accounted for exactly, separately for
+ * each EdgeFunctionKind and for flow- and edge functions. If a memory limit is
+ * set (see IFDSIDESolverConfig::setFlowEdgeFunctionCacheLimit()), the least
+ * recently used entries are evicted once the limit is exceeded. As the flow-
+ * and edge function factories of the IDETabulationProblem are required to be
+ * pure, evicted entries are transparently recomputed on their next query.
+ *
+ * Note: The accounted memory covers the nodes of the cache-maps, i.e., the
+ * keys, the bookkeeping and the handles to the cached flow- and edge functions
+ * (small edge functions are stored inline in their handle). It does not cover
+ * the heap-allocated flow- and edge function objects the handles refer to.
+ * These are reference-counted and typically shared with the solver's jump
+ * functions, so they are not freed by evicting their cache entry anyway.
  */
 template <typename AnalysisDomainTy,
           typename Container = std::set<typename AnalysisDomainTy::d_t>>
@@ -104,40 +123,74 @@ private:
       std::is_base_of_v<llvm::Value, std::remove_pointer_t<d_t>>, uint64_t,
       std::pair<d_t, d_t>>;
   using InnerEdgeFunctionMapType =
-      EquivalenceClassMap<EdgeFuncNodeKey, EdgeFunction<l_t>>;
+      EquivalenceClassMap<EdgeFuncNodeKey, EdgeFunction<l_t>,
+                          CountingAllocator<EdgeFuncNodeKey>>;
+
+  /// Wraps a cached value together with the logical timestamp of its last
+  /// use. The timestamps drive the LRU eviction.
+  template <typename T> struct CacheEntry {
+    template <typename... ArgTys>
+    CacheEntry(uint64_t LastUse, ArgTys &&...Args)
+        : Value(std::forward<ArgTys>(Args)...), LastUse(LastUse) {}
+
+    T Value;
+    uint64_t LastUse{};
+  };
+
+  template <typename KeyT, typename ValueT>
+  using CacheMapType =
+      std::map<KeyT, CacheEntry<ValueT>, std::less<KeyT>,
+               CountingAllocator<std::pair<const KeyT, CacheEntry<ValueT>>>>;
+
+  /// Number of bytes currently held by the nodes of the cache-maps of each
+  /// EdgeFunctionKind. Lives on the heap, such that the allocators of the
+  /// cache-maps keep valid pointers when the FlowEdgeFunctionCache is moved.
+  struct MemoryCounters {
+    std::array<size_t, EdgeFunctionKindCount> FlowFunctionBytes{};
+    std::array<size_t, EdgeFunctionKindCount> EdgeFunctionBytes{};
+    std::array<size_t, EdgeFunctionKindCount> NumEvictions{};
+  };
 
   IDETabulationProblem<AnalysisDomainTy, Container> &Problem;
   // Auto add zero
   bool AutoAddZero;
   d_t ZV;
 
+  // Memory accounting and eviction. Must be declared before the caches, such
+  // that it outlives them.
+  std::unique_ptr<MemoryCounters> Counters;
+  size_t MemoryLimit = 0;
+  uint64_t Clock = 0;
+
   struct NormalEdgeFlowData {
-    NormalEdgeFlowData(FlowFunctionPtrType Val)
-        : FlowFuncPtr(std::move(Val)), EdgeFunctionMap{} {}
-    NormalEdgeFlowData(InnerEdgeFunctionMapType Map)
-        : FlowFuncPtr(nullptr), EdgeFunctionMap{std::move(Map)} {}
+    NormalEdgeFlowData(FlowFunctionPtrType Val,
+                       const CountingAllocator<EdgeFuncNodeKey> &Alloc)
+        : FlowFuncPtr(std::move(Val)), EdgeFunctionMap(0, Alloc) {}
+    NormalEdgeFlowData(const CountingAllocator<EdgeFuncNodeKey> &Alloc)
+        : FlowFuncPtr(nullptr), EdgeFunctionMap(0, Alloc) {}
 
     FlowFunctionPtrType FlowFuncPtr;
     InnerEdgeFunctionMapType EdgeFunctionMap;
   };
 
   // Caches for the flow/edge functions
-  std::map<EdgeFuncInstKey, NormalEdgeFlowData> NormalFunctionCache;
+  CacheMapType<EdgeFuncInstKey, NormalEdgeFlowData> NormalFunctionCache;
 
   // Caches for the flow functions
-  std::map<std::tuple<n_t, f_t>, FlowFunctionPtrType> CallFlowFunctionCache;
-  std::map<std::tuple<n_t, f_t, n_t, n_t>, FlowFunctionPtrType>
+  CacheMapType<std::tuple<n_t, f_t>, FlowFunctionPtrType>
+      CallFlowFunctionCache;
+  CacheMapType<std::tuple<n_t, f_t, n_t, n_t>, FlowFunctionPtrType>
       ReturnFlowFunctionCache;
-  std::map<std::tuple<n_t, n_t>, FlowFunctionPtrType>
+  CacheMapType<std::tuple<n_t, n_t>, FlowFunctionPtrType>
       CallToRetFlowFunctionCache;
   // Caches for the edge functions
-  std::map<std::tuple<n_t, d_t, f_t, d_t>, EdgeFunction<l_t>>
+  CacheMapType<std::tuple<n_t, d_t, f_t, d_t>, EdgeFunction<l_t>>
       CallEdgeFunctionCache;
-  std::map<std::tuple<n_t, f_t, n_t, d_t, n_t, d_t>, EdgeFunction<l_t>>
+  CacheMapType<std::tuple<n_t, f_t, n_t, d_t, n_t, d_t>, EdgeFunction<l_t>>
       ReturnEdgeFunctionCache;
-  std::map<EdgeFuncInstKey, InnerEdgeFunctionMapType>
+  CacheMapType<EdgeFuncInstKey, InnerEdgeFunctionMapType>
       CallToRetEdgeFunctionCache;
-  std::map<std::tuple<n_t, d_t, n_t, d_t>, EdgeFunction<l_t>>
+  CacheMapType<std::tuple<n_t, d_t, n_t, d_t>, EdgeFunction<l_t>>
       SummaryEdgeFunctionCache;
 
 public:
@@ -147,7 +200,20 @@ public:
       IDETabulationProblem<AnalysisDomainTy, Container> &Problem)
       : Problem(Problem),
         AutoAddZero(Problem.getIFDSIDESolverConfig().autoAddZero()),
-        ZV(Problem.getZeroValue()) {
+        ZV(Problem.getZeroValue()),
+        Counters(std::make_unique<MemoryCounters>()),
+        MemoryLimit(
+            Problem.getIFDSIDESolverConfig().flowEdgeFunctionCacheLimit()),
+        NormalFunctionCache(ffAllocator(EdgeFunctionKind::Normal)),
+        CallFlowFunctionCache(ffAllocator(EdgeFunctionKind::Call)),
+        ReturnFlowFunctionCache(ffAllocator(EdgeFunctionKind::Return)),
+        CallToRetFlowFunctionCache(
+            ffAllocator(EdgeFunctionKind::CallToReturn)),
+        CallEdgeFunctionCache(efAllocator(EdgeFunctionKind::Call)),
+        ReturnEdgeFunctionCache(efAllocator(EdgeFunctionKind::Return)),
+        CallToRetEdgeFunctionCache(
+            efAllocator(EdgeFunctionKind::CallToReturn)),
+        SummaryEdgeFunctionCache(efAllocator(EdgeFunctionKind::Summary)) {
     PAMM_GET_INSTANCE;
     REG_COUNTER("Normal-FF Construction", 0, Full);
     REG_COUNTER("Normal-FF Cache Hit", 0, Full);
@@ -178,16 +244,54 @@ public:
     // Counters for the summary edge functions
     REG_COUNTER("Summary-EF Construction", 0, Full);
     REG_COUNTER("Summary-EF Cache Hit", 0, Full);
+    // Counter for the entries evicted due to the memory limit
+    REG_COUNTER("FEF-Cache Evictions", 0, Full);
   }
 
   ~FlowEdgeFunctionCache() = default;
 
-  FlowEdgeFunctionCache(const FlowEdgeFunctionCache &FEFC) = default;
-  FlowEdgeFunctionCache &operator=(const FlowEdgeFunctionCache &FEFC) = default;
+  // The cache-maps refer to the memory counters of their owning cache, so we
+  // cannot copy or assign them
+  FlowEdgeFunctionCache(const FlowEdgeFunctionCache &FEFC) = delete;
+  FlowEdgeFunctionCache &operator=(const FlowEdgeFunctionCache &FEFC) = delete;
 
   FlowEdgeFunctionCache(FlowEdgeFunctionCache &&FEFC) noexcept = default;
-  FlowEdgeFunctionCache &
-  operator=(FlowEdgeFunctionCache &&FEFC) noexcept = default;
+  FlowEdgeFunctionCache &operator=(FlowEdgeFunctionCache &&FEFC) = delete;
+
+  /// Sets the maximum number of bytes the nodes of the cache-maps may occupy.
+  /// A limit of 0 means unbounded.
+  void setMemoryLimit(size_t LimitInBytes) {
+    MemoryLimit = LimitInBytes;
+    evictIfNeeded();
+  }
+  [[nodiscard]] size_t getMemoryLimit() const noexcept { return MemoryLimit; }
+
+  /// The number of bytes currently occupied by the flow-function cache for
+  /// the given Kind
+  [[nodiscard]] size_t
+  getFlowFunctionCacheMemoryUsage(EdgeFunctionKind Kind) const noexcept {
+    return Counters->FlowFunctionBytes[size_t(Kind)];
+  }
+  /// The number of bytes currently occupied by the edge-function cache for
+  /// the given Kind
+  [[nodiscard]] size_t
+  getEdgeFunctionCacheMemoryUsage(EdgeFunctionKind Kind) const noexcept {
+    return Counters->EdgeFunctionBytes[size_t(Kind)];
+  }
+  /// The total number of bytes currently occupied by the nodes of all
+  /// cache-maps. This is the quantity that is bounded by the memory limit.
+  [[nodiscard]] size_t getMemoryUsage() const noexcept {
+    return std::reduce(Counters->FlowFunctionBytes.begin(),
+                       Counters->FlowFunctionBytes.end()) +
+           std::reduce(Counters->EdgeFunctionBytes.begin(),
+                       Counters->EdgeFunctionBytes.end());
+  }
+  /// The number of cache entries of the given Kind that have been evicted so
+  /// far, because the memory limit was exceeded
+  [[nodiscard]] size_t
+  getNumEvictedEntries(EdgeFunctionKind Kind) const noexcept {
+    return Counters->NumEvictions[size_t(Kind)];
+  }
 
   FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t Succ) {
     assertNotNull(Curr);
@@ -202,14 +306,16 @@ public:
     if (SearchNormalFlowFunction != NormalFunctionCache.end()) {
       PHASAR_LOG_LEVEL(DEBUG, "Flow function fetched from cache");
       INC_COUNTER("Normal-FF Cache Hit", 1, Full);
-      if (SearchNormalFlowFunction->second.FlowFuncPtr != nullptr) {
-        return SearchNormalFlowFunction->second.FlowFuncPtr;
+      SearchNormalFlowFunction->second.LastUse = ++Clock;
+      auto &Data = SearchNormalFlowFunction->second.Value;
+      if (Data.FlowFuncPtr != nullptr) {
+        return Data.FlowFuncPtr;
       }
       auto FF = (AutoAddZero)
                     ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
                           Problem.getNormalFlowFunction(Curr, Succ), ZV)
                     : Problem.getNormalFlowFunction(Curr, Succ);
-      SearchNormalFlowFunction->second.FlowFuncPtr = FF;
+      Data.FlowFuncPtr = FF;
       return FF;
     }
     INC_COUNTER("Normal-FF Construction", 1, Full);
@@ -217,8 +323,10 @@ public:
                   ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
                         Problem.getNormalFlowFunction(Curr, Succ), ZV)
                   : Problem.getNormalFlowFunction(Curr, Succ);
-    NormalFunctionCache.insert(std::make_pair(Key, NormalEdgeFlowData(FF)));
+    NormalFunctionCache.try_emplace(Key, ++Clock, FF,
+                                    efAllocator(EdgeFunctionKind::Normal));
     PHASAR_LOG_LEVEL(DEBUG, "Flow function constructed");
+    evictIfNeeded();
 
     return FF;
   }
@@ -236,15 +344,17 @@ public:
     if (SearchCallFlowFunction != CallFlowFunctionCache.end()) {
       PHASAR_LOG_LEVEL(DEBUG, "Flow function fetched from cache");
       INC_COUNTER("Call-FF Cache Hit", 1, Full);
-      return SearchCallFlowFunction->second;
+      SearchCallFlowFunction->second.LastUse = ++Clock;
+      return SearchCallFlowFunction->second.Value;
     }
     INC_COUNTER("Call-FF Construction", 1, Full);
     auto FF = (AutoAddZero)
                   ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
                         Problem.getCallFlowFunction(CallSite, DestFun), ZV)
                   : Problem.getCallFlowFunction(CallSite, DestFun);
-    CallFlowFunctionCache.insert(std::make_pair(Key, FF));
+    CallFlowFunctionCache.try_emplace(Key, ++Clock, FF);
     PHASAR_LOG_LEVEL(DEBUG, "Flow function constructed");
+    evictIfNeeded();
     return FF;
   }
 
@@ -266,7 +376,8 @@ public:
     if (SearchReturnFlowFunction != ReturnFlowFunctionCache.end()) {
       PHASAR_LOG_LEVEL(DEBUG, "Flow function fetched from cache");
       INC_COUNTER("Return-FF Cache Hit", 1, Full);
-      return SearchReturnFlowFunction->second;
+      SearchReturnFlowFunction->second.LastUse = ++Clock;
+      return SearchReturnFlowFunction->second.Value;
     }
     INC_COUNTER("Return-FF Construction", 1, Full);
     auto FF = (AutoAddZero)
@@ -276,8 +387,9 @@ public:
                         ZV)
                   : Problem.getRetFlowFunction(CallSite, CalleeFun, ExitInst,
                                                RetSite);
-    ReturnFlowFunctionCache.insert(std::make_pair(Key, FF));
+    ReturnFlowFunctionCache.try_emplace(Key, ++Clock, FF);
     PHASAR_LOG_LEVEL(DEBUG, "Flow function constructed");
+    evictIfNeeded();
     return FF;
   }
 
@@ -301,7 +413,8 @@ public:
     if (SearchCallToRetFlowFunction != CallToRetFlowFunctionCache.end()) {
       PHASAR_LOG_LEVEL(DEBUG, "Flow function fetched from cache");
       INC_COUNTER("CallToRet-FF Cache Hit", 1, Full);
-      return SearchCallToRetFlowFunction->second;
+      SearchCallToRetFlowFunction->second.LastUse = ++Clock;
+      return SearchCallToRetFlowFunction->second.Value;
     }
     INC_COUNTER("CallToRet-FF Construction", 1, Full);
     auto FF =
@@ -310,8 +423,9 @@ public:
                   Problem.getCallToRetFlowFunction(CallSite, RetSite, Callees),
                   ZV)
             : Problem.getCallToRetFlowFunction(CallSite, RetSite, Callees);
-    CallToRetFlowFunctionCache.insert(std::make_pair(Key, FF));
+    CallToRetFlowFunctionCache.try_emplace(Key, ++Clock, FF);
     PHASAR_LOG_LEVEL(DEBUG, "Flow function constructed");
+    evictIfNeeded();
     return FF;
   }
 
@@ -345,9 +459,11 @@ public:
     EdgeFuncInstKey OuterMapKey = createEdgeFunctionInstKey(Curr, Succ);
     auto SearchInnerMap = NormalFunctionCache.find(OuterMapKey);
     if (SearchInnerMap != NormalFunctionCache.end()) {
-      auto SearchEdgeFunc = SearchInnerMap->second.EdgeFunctionMap.find(
-          createEdgeFunctionNodeKey(CurrNode, SuccNode));
-      if (SearchEdgeFunc != SearchInnerMap->second.EdgeFunctionMap.end()) {
+      SearchInnerMap->second.LastUse = ++Clock;
+      auto &InnerMap = SearchInnerMap->second.Value.EdgeFunctionMap;
+      auto SearchEdgeFunc =
+          InnerMap.find(createEdgeFunctionNodeKey(CurrNode, SuccNode));
+      if (SearchEdgeFunc != InnerMap.end()) {
         INC_COUNTER("Normal-EF Cache Hit", 1, Full);
         PHASAR_LOG_LEVEL(DEBUG, "Edge function fetched from cache");
         PHASAR_LOG_LEVEL(DEBUG,
@@ -357,22 +473,25 @@ public:
       INC_COUNTER("Normal-EF Construction", 1, Full);
       auto EF = Problem.getNormalEdgeFunction(Curr, CurrNode, Succ, SuccNode);
 
-      SearchInnerMap->second.EdgeFunctionMap.insert(
-          createEdgeFunctionNodeKey(CurrNode, SuccNode), EF);
+      InnerMap.insert(createEdgeFunctionNodeKey(CurrNode, SuccNode), EF);
 
       PHASAR_LOG_LEVEL(DEBUG, "Edge function constructed");
       PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: " << EF);
+      evictIfNeeded();
       return EF;
     }
     INC_COUNTER("Normal-EF Construction", 1, Full);
     auto EF = Problem.getNormalEdgeFunction(Curr, CurrNode, Succ, SuccNode);
 
-    NormalFunctionCache.try_emplace(
-        OuterMapKey, NormalEdgeFlowData(InnerEdgeFunctionMapType{std::make_pair(
-                         createEdgeFunctionNodeKey(CurrNode, SuccNode), EF)}));
+    NormalFunctionCache
+        .try_emplace(OuterMapKey, ++Clock,
+                     efAllocator(EdgeFunctionKind::Normal))
+        .first->second.Value.EdgeFunctionMap.insert(
+            createEdgeFunctionNodeKey(CurrNode, SuccNode), EF);
 
     PHASAR_LOG_LEVEL(DEBUG, "Edge function constructed");
     PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: " << EF);
+    evictIfNeeded();
     return EF;
   }
 
@@ -395,17 +514,19 @@ public:
     auto SearchCallEdgeFunction = CallEdgeFunctionCache.find(Key);
     if (SearchCallEdgeFunction != CallEdgeFunctionCache.end()) {
       INC_COUNTER("Call-EF Cache Hit", 1, Full);
+      SearchCallEdgeFunction->second.LastUse = ++Clock;
       PHASAR_LOG_LEVEL(DEBUG, "Edge function fetched from cache");
-      PHASAR_LOG_LEVEL(
-          DEBUG, "Provide Edge Function: " << SearchCallEdgeFunction->second);
-      return SearchCallEdgeFunction->second;
+      PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: "
+                                  << SearchCallEdgeFunction->second.Value);
+      return SearchCallEdgeFunction->second.Value;
     }
     INC_COUNTER("Call-EF Construction", 1, Full);
     auto EF = Problem.getCallEdgeFunction(CallSite, SrcNode,
                                           DestinationFunction, DestNode);
-    CallEdgeFunctionCache.insert(std::make_pair(Key, EF));
+    CallEdgeFunctionCache.try_emplace(Key, ++Clock, EF);
     PHASAR_LOG_LEVEL(DEBUG, "Edge function constructed");
     PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: " << EF);
+    evictIfNeeded();
     return EF;
   }
 
@@ -432,17 +553,19 @@ public:
     auto SearchReturnEdgeFunction = ReturnEdgeFunctionCache.find(Key);
     if (SearchReturnEdgeFunction != ReturnEdgeFunctionCache.end()) {
       INC_COUNTER("Return-EF Cache Hit", 1, Full);
+      SearchReturnEdgeFunction->second.LastUse = ++Clock;
       PHASAR_LOG_LEVEL(DEBUG, "Edge function fetched from cache");
-      PHASAR_LOG_LEVEL(
-          DEBUG, "Provide Edge Function: " << SearchReturnEdgeFunction->second);
-      return SearchReturnEdgeFunction->second;
+      PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: "
+                                  << SearchReturnEdgeFunction->second.Value);
+      return SearchReturnEdgeFunction->second.Value;
     }
     INC_COUNTER("Return-EF Construction", 1, Full);
     auto EF = Problem.getReturnEdgeFunction(CallSite, CalleeFunction, ExitInst,
                                             ExitNode, RetSite, RetNode);
-    ReturnEdgeFunctionCache.insert(std::make_pair(Key, EF));
+    ReturnEdgeFunctionCache.try_emplace(Key, ++Clock, EF);
     PHASAR_LOG_LEVEL(DEBUG, "Edge function constructed");
     PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: " << EF);
+    evictIfNeeded();
     return EF;
   }
 
@@ -470,9 +593,11 @@ public:
     EdgeFuncInstKey OuterMapKey = createEdgeFunctionInstKey(CallSite, RetSite);
     auto SearchInnerMap = CallToRetEdgeFunctionCache.find(OuterMapKey);
     if (SearchInnerMap != CallToRetEdgeFunctionCache.end()) {
-      auto SearchEdgeFunc = SearchInnerMap->second.find(
-          createEdgeFunctionNodeKey(CallNode, RetSiteNode));
-      if (SearchEdgeFunc != SearchInnerMap->second.end()) {
+      SearchInnerMap->second.LastUse = ++Clock;
+      auto &InnerMap = SearchInnerMap->second.Value;
+      auto SearchEdgeFunc =
+          InnerMap.find(createEdgeFunctionNodeKey(CallNode, RetSiteNode));
+      if (SearchEdgeFunc != InnerMap.end()) {
         INC_COUNTER("CallToRet-EF Cache Hit", 1, Full);
         PHASAR_LOG_LEVEL(DEBUG, "Edge function fetched from cache");
         PHASAR_LOG_LEVEL(DEBUG,
@@ -483,11 +608,11 @@ public:
       auto EF = Problem.getCallToRetEdgeFunction(CallSite, CallNode, RetSite,
                                                  RetSiteNode, Callees);
 
-      SearchInnerMap->second.insert(
-          createEdgeFunctionNodeKey(CallNode, RetSiteNode), EF);
+      InnerMap.insert(createEdgeFunctionNodeKey(CallNode, RetSiteNode), EF);
 
       PHASAR_LOG_LEVEL(DEBUG, "Edge function constructed");
       PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: " << EF);
+      evictIfNeeded();
       return EF;
     }
 
@@ -495,12 +620,14 @@ public:
     auto EF = Problem.getCallToRetEdgeFunction(CallSite, CallNode, RetSite,
                                                RetSiteNode, Callees);
 
-    CallToRetEdgeFunctionCache.emplace(
-        OuterMapKey,
-        InnerEdgeFunctionMapType{std::make_pair(
-            createEdgeFunctionNodeKey(CallNode, RetSiteNode), EF)});
+    CallToRetEdgeFunctionCache
+        .try_emplace(OuterMapKey, ++Clock, 0,
+                     efAllocator(EdgeFunctionKind::CallToReturn))
+        .first->second.Value.insert(
+            createEdgeFunctionNodeKey(CallNode, RetSiteNode), EF);
     PHASAR_LOG_LEVEL(DEBUG, "Edge function constructed");
     PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: " << EF);
+    evictIfNeeded();
     return EF;
   }
 
@@ -521,17 +648,19 @@ public:
     auto SearchSummaryEdgeFunction = SummaryEdgeFunctionCache.find(Key);
     if (SearchSummaryEdgeFunction != SummaryEdgeFunctionCache.end()) {
       INC_COUNTER("Summary-EF Cache Hit", 1, Full);
+      SearchSummaryEdgeFunction->second.LastUse = ++Clock;
       PHASAR_LOG_LEVEL(DEBUG, "Edge function fetched from cache");
       PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: "
-                                  << SearchSummaryEdgeFunction->second);
-      return SearchSummaryEdgeFunction->second;
+                                  << SearchSummaryEdgeFunction->second.Value);
+      return SearchSummaryEdgeFunction->second.Value;
     }
     INC_COUNTER("Summary-EF Construction", 1, Full);
     auto EF = Problem.getSummaryEdgeFunction(CallSite, CallNode, RetSite,
                                              RetSiteNode);
-    SummaryEdgeFunctionCache.insert(std::make_pair(Key, EF));
+    SummaryEdgeFunctionCache.try_emplace(Key, ++Clock, EF);
     PHASAR_LOG_LEVEL(DEBUG, "Edge function constructed");
     PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: " << EF);
+    evictIfNeeded();
     return EF;
   }
 
@@ -600,6 +729,12 @@ public:
                     {"Normal-EF Construction", "Call-EF Construction",
                      "Return-EF Construction", "CallToRet-EF Construction",
                      "Summary-EF Construction"}));
+      PHASAR_LOG_LEVEL(INFO, ' ');
+      PHASAR_LOG_LEVEL(INFO,
+                       "Cache memory usage (bytes): " << getMemoryUsage());
+      PHASAR_LOG_LEVEL(INFO, "Cache memory limit (bytes): " << MemoryLimit);
+      PHASAR_LOG_LEVEL(INFO, "Evicted cache entries: "
+                                 << GET_COUNTER("FEF-Cache Evictions"));
       PHASAR_LOG_LEVEL(INFO, "----------------------------------------------");
     } else {
       PHASAR_LOG_LEVEL(
@@ -609,31 +744,122 @@ public:
 
   template <typename Handler> void foreachCachedEdgeFunction(Handler Fn) const {
     for (const auto &[Key, NormalFns] : NormalFunctionCache) {
-      for (const auto &[Set, EF] : NormalFns.EdgeFunctionMap) {
+      for (const auto &[Set, EF] : NormalFns.Value.EdgeFunctionMap) {
         std::invoke(Fn, EF, EdgeFunctionKind::Normal);
       }
     }
 
     for (const auto &[Key, EF] : CallEdgeFunctionCache) {
-      std::invoke(Fn, EF, EdgeFunctionKind::Call);
+      std::invoke(Fn, EF.Value, EdgeFunctionKind::Call);
     }
 
     for (const auto &[Key, EF] : ReturnEdgeFunctionCache) {
-      std::invoke(Fn, EF, EdgeFunctionKind::Return);
+      std::invoke(Fn, EF.Value, EdgeFunctionKind::Return);
     }
 
     for (const auto &[Key, CTRFns] : CallToRetEdgeFunctionCache) {
-      for (const auto &[Set, EF] : CTRFns) {
+      for (const auto &[Set, EF] : CTRFns.Value) {
         std::invoke(Fn, EF, EdgeFunctionKind::CallToReturn);
       }
     }
 
     for (const auto &[Key, EF] : SummaryEdgeFunctionCache) {
-      std::invoke(Fn, EF, EdgeFunctionKind::Summary);
+      std::invoke(Fn, EF.Value, EdgeFunctionKind::Summary);
     }
   }
 
 private:
+  [[nodiscard]] CountingAllocator<EdgeFuncNodeKey>
+  ffAllocator(EdgeFunctionKind Kind) const noexcept {
+    return CountingAllocator<EdgeFuncNodeKey>(
+        &Counters->FlowFunctionBytes[size_t(Kind)]);
+  }
+  [[nodiscard]] CountingAllocator<EdgeFuncNodeKey>
+  efAllocator(EdgeFunctionKind Kind) const noexcept {
+    return CountingAllocator<EdgeFuncNodeKey>(
+        &Counters->EdgeFunctionBytes[size_t(Kind)]);
+  }
+
+  void evictIfNeeded() {
+    if (MemoryLimit == 0 || getMemoryUsage() <= MemoryLimit) {
+      return;
+    }
+    evict();
+  }
+
+  /// Evicts the least recently used cache entries until the memory usage
+  /// drops below 3/4 of the memory limit. Evicting more than strictly
+  /// necessary amortizes the cost of the eviction over the next insertions.
+  void evict() {
+    PAMM_GET_INSTANCE;
+    const size_t LowWaterMark = MemoryLimit - MemoryLimit / 4;
+
+    std::vector<uint64_t> Timestamps;
+    auto CollectTimestamps = [&Timestamps](const auto &Cache) {
+      for (const auto &Entry : Cache) {
+        Timestamps.push_back(Entry.second.LastUse);
+      }
+    };
+
+    auto EvictOlderThan = [this](auto &Cache, uint64_t Threshold,
+                                 EdgeFunctionKind Kind) {
+      size_t NumEvicted = 0;
+      for (auto It = Cache.begin(), End = Cache.end(); It != End;) {
+        if (It->second.LastUse <= Threshold) {
+          It = Cache.erase(It);
+          ++NumEvicted;
+        } else {
+          ++It;
+        }
+      }
+      Counters->NumEvictions[size_t(Kind)] += NumEvicted;
+      return NumEvicted;
+    };
+
+    while (getMemoryUsage() > LowWaterMark) {
+      Timestamps.clear();
+      CollectTimestamps(NormalFunctionCache);
+      CollectTimestamps(CallFlowFunctionCache);
+      CollectTimestamps(ReturnFlowFunctionCache);
+      CollectTimestamps(CallToRetFlowFunctionCache);
+      CollectTimestamps(CallEdgeFunctionCache);
+      CollectTimestamps(ReturnEdgeFunctionCache);
+      CollectTimestamps(CallToRetEdgeFunctionCache);
+      CollectTimestamps(SummaryEdgeFunctionCache);
+
+      if (Timestamps.empty()) {
+        break;
+      }
+
+      // The timestamps are unique, so evicting all entries not younger than
+      // the median removes the least recently used half of the entries
+      auto Median = Timestamps.begin() + (Timestamps.size() - 1) / 2;
+      std::nth_element(Timestamps.begin(), Median, Timestamps.end());
+      auto Threshold = *Median;
+
+      size_t NumEvicted = 0;
+      NumEvicted += EvictOlderThan(NormalFunctionCache, Threshold,
+                                   EdgeFunctionKind::Normal);
+      NumEvicted += EvictOlderThan(CallFlowFunctionCache, Threshold,
+                                   EdgeFunctionKind::Call);
+      NumEvicted += EvictOlderThan(ReturnFlowFunctionCache, Threshold,
+                                   EdgeFunctionKind::Return);
+      NumEvicted += EvictOlderThan(CallToRetFlowFunctionCache, Threshold,
+                                   EdgeFunctionKind::CallToReturn);
+      NumEvicted += EvictOlderThan(CallEdgeFunctionCache, Threshold,
+                                   EdgeFunctionKind::Call);
+      NumEvicted += EvictOlderThan(ReturnEdgeFunctionCache, Threshold,
+                                   EdgeFunctionKind::Return);
+      NumEvicted += EvictOlderThan(CallToRetEdgeFunctionCache, Threshold,
+                                   EdgeFunctionKind::CallToReturn);
+      NumEvicted += EvictOlderThan(SummaryEdgeFunctionCache, Threshold,
+                                   EdgeFunctionKind::Summary);
+      INC_COUNTER("FEF-Cache Evictions", NumEvicted, Full);
+      PHASAR_LOG_LEVEL(DEBUG, "Evicted " << NumEvicted
+                                         << " cached flow/edge functions");
+    }
+  }
+
   inline EdgeFuncInstKey createEdgeFunctionInstKey(n_t Lhs, n_t Rhs) {
     uint64_t Val = 0;
     Val |= KeyCompressor.getCompressedID(Lhs);
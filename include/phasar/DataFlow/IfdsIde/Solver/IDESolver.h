@@ -18,6 +18,7 @@
 #define PHASAR_DATAFLOW_IFDSIDE_SOLVER_IDESOLVER_H
 
 #include "phasar/Config/Configuration.h"
+#include "phasar/ControlFlow/CallGraphSCCs.h"
 #include "phasar/DB/ProjectIRDBBase.h"
 #include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
 #include "phasar/DataFlow/IfdsIde/EdgeFunctionStats.h"
@@ -28,6 +29,7 @@
 #include "phasar/DataFlow/IfdsIde/IFDSTabulationProblem.h"
 #include "phasar/DataFlow/IfdsIde/InitialSeeds.h"
 #include "phasar/DataFlow/IfdsIde/Solver/ESGEdgeKind.h"
+#include "phasar/DataFlow/IfdsIde/Solver/ESGEdgeLog.h"
 #include "phasar/DataFlow/IfdsIde/Solver/FlowEdgeFunctionCache.h"
 #include "phasar/DataFlow/IfdsIde/Solver/IDESolverAPIMixin.h"
 #include "phasar/DataFlow/IfdsIde/Solver/JumpFunctions.h"
@@ -35,6 +37,7 @@
 #include "phasar/DataFlow/IfdsIde/SolverResults.h"
 #include "phasar/Domain/AnalysisDomain.h"
 #include "phasar/Utils/Average.h"
+#include "phasar/Utils/BucketedWorkList.h"
 #include "phasar/Utils/DOTGraph.h"
 #include "phasar/Utils/JoinLattice.h"
 #include "phasar/Utils/Logger.h"
@@ -50,6 +53,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <tuple>
@@ -201,19 +205,20 @@ public:
 
   void dumpAllInterPathEdges() {
     llvm::outs() << "COMPUTED INTER PATH EDGES" << '\n';
-    auto Interpe = this->computedInterPathEdges.cellSet();
+    auto Interpe =
+        EdgeLog.template getPathEdges<Container>(/*InterProc*/ true).cellSet();
     for (const auto &Cell : Interpe) {
       llvm::outs() << "FROM" << '\n';
-      IDEProblem.printNode(llvm::outs(), Cell.getRowKey());
+      llvm::outs() << NToString(Cell.getRowKey()) << '\n';
       llvm::outs() << "TO" << '\n';
-      IDEProblem.printNode(llvm::outs(), Cell.getColumnKey());
+      llvm::outs() << NToString(Cell.getColumnKey()) << '\n';
       llvm::outs() << "FACTS" << '\n';
       for (const auto &Fact : Cell.getValue()) {
         llvm::outs() << "fact" << '\n';
-        IDEProblem.printDataFlowFact(llvm::outs(), Fact.first);
+        llvm::outs() << DToString(Fact.first) << '\n';
         llvm::outs() << "produces" << '\n';
         for (const auto &Out : Fact.second) {
-          IDEProblem.printDataFlowFact(llvm::outs(), Out);
+          llvm::outs() << DToString(Out) << '\n';
         }
       }
     }
@@ -221,19 +226,20 @@ public:
 
   void dumpAllIntraPathEdges() {
     llvm::outs() << "COMPUTED INTRA PATH EDGES" << '\n';
-    auto Intrape = this->computedIntraPathEdges.cellSet();
-    for (auto &Cell : Intrape) {
+    auto Intrape =
+        EdgeLog.template getPathEdges<Container>(/*InterProc*/ false).cellSet();
+    for (const auto &Cell : Intrape) {
       llvm::outs() << "FROM" << '\n';
-      IDEProblem.printNode(llvm::outs(), Cell.getRowKey());
+      llvm::outs() << NToString(Cell.getRowKey()) << '\n';
       llvm::outs() << "TO" << '\n';
-      IDEProblem.printNode(llvm::outs(), Cell.getColumnKey());
+      llvm::outs() << NToString(Cell.getColumnKey()) << '\n';
       llvm::outs() << "FACTS" << '\n';
-      for (auto &Fact : Cell.getValue()) {
+      for (const auto &Fact : Cell.getValue()) {
         llvm::outs() << "fact" << '\n';
-        IDEProblem.printDataFlowFact(llvm::outs(), Fact.first);
+        llvm::outs() << DToString(Fact.first) << '\n';
         llvm::outs() << "produces" << '\n';
-        for (auto &Out : Fact.second) {
-          IDEProblem.printDataFlowFact(llvm::outs(), Out);
+        for (const auto &Out : Fact.second) {
+          llvm::outs() << DToString(Out) << '\n';
         }
       }
     }
@@ -259,6 +265,23 @@ public:
                                               std::move(ZeroValue));
   }
 
+  /// The number of path edges the solver has taken from its worklist
+  [[nodiscard]] size_t getNumPropagations() const noexcept {
+    return PropagationCount;
+  }
+
+  /// The number of propagated path edges that led to a new jump function and
+  /// thus have been processed further
+  [[nodiscard]] size_t getNumProcessedPathEdges() const noexcept {
+    return PathEdgeCount;
+  }
+
+  /// The exploded supergraph edges that were recorded while solving. Empty,
+  /// unless IFDSIDESolverConfig::recordEdges() is set.
+  [[nodiscard]] const ESGEdgeLog<n_t, d_t, l_t> &getEdgeLog() const noexcept {
+    return EdgeLog;
+  }
+
   [[nodiscard]] EdgeFunctionStats getEdgeFunctionStatistics() const {
     detail::EdgeFunctionStatsData Stats{};
 
@@ -292,6 +315,17 @@ public:
 
       Stats.AvgDepth = DepthSampler.getAverage();
       Stats.AvgUniqueDepth = UniqueDepthSampler.getAverage();
+
+      for (size_t I = 0; I != EdgeFunctionKindCount; ++I) {
+        auto Kind = EdgeFunctionKind(I);
+        Stats.FFCacheBytes[I] = // NOLINT
+            CachedFlowEdgeFunctions.getFlowFunctionCacheMemoryUsage(Kind);
+        Stats.EFCacheBytes[I] = // NOLINT
+            CachedFlowEdgeFunctions.getEdgeFunctionCacheMemoryUsage(Kind);
+        Stats.NumEvictedCacheEntries[I] = // NOLINT
+            CachedFlowEdgeFunctions.getNumEvictedEntries(Kind);
+      }
+      Stats.CacheMemoryLimit = CachedFlowEdgeFunctions.getMemoryLimit();
     }
 
     // Jump Functions
@@ -327,6 +361,11 @@ public:
       Stats.AvgUniqueJFDepth = UniqueDepthSampler.getAverage();
       Stats.AvgJFObjDepth = AllocDepthSampler.getAverage();
     }
+
+    // Normalization
+    Stats.NumNormalizedEFs = DepthBeforeNormalization.getNumSamples();
+    Stats.AvgDepthBeforeNormalization = DepthBeforeNormalization.getAverage();
+    Stats.AvgDepthAfterNormalization = DepthAfterNormalization.getAverage();
     return Stats;
   }
 
@@ -405,8 +444,8 @@ protected:
                              "Queried Summary Edge Function: " << SumEdgFnE);
             PHASAR_LOG_LEVEL(DEBUG,
                              "Compose: " << SumEdgFnE << " * " << f << '\n');
-            WorkList.emplace_back(PathEdge(d1, ReturnSiteN, std::move(d3)),
-                                  f.composeWith(SumEdgFnE));
+            scheduleEdge(PathEdge(d1, ReturnSiteN, std::move(d3)),
+                         composeEdgeFunctions(f, SumEdgFnE));
           }
         }
       } else {
@@ -433,8 +472,8 @@ protected:
             // create initial self-loop
             PHASAR_LOG_LEVEL(
                 DEBUG, "Create initial self-loop with D: " << DToString(d3));
-            WorkList.emplace_back(PathEdge(d3, SP, d3),
-                                  EdgeIdentity<l_t>{}); // line 15
+            scheduleEdge(PathEdge(d3, SP, d3),
+                         EdgeIdentity<l_t>{}); // line 15
             //  register the fact that <sp,d3> has an incoming edge from <n,d2>
             //  line 15.1 of Naeem/Lhotak/Rodriguez
             addIncoming(SP, d3, n, d2);
@@ -484,12 +523,9 @@ protected:
                                    "Queried Return Edge Function: " << f5);
                   if (SolverConfig.emitESG()) {
                     for (auto SP : ICF->getStartPointsOf(SCalledProcN)) {
-                      IntermediateEdgeFunctions[std::make_tuple(n, d2, SP, d3)]
-                          .push_back(f4);
+                      EdgeLog.saveEdgeFunction(n, d2, SP, d3, f4);
                     }
-                    IntermediateEdgeFunctions[std::make_tuple(eP, d4, RetSiteN,
-                                                              d5)]
-                        .push_back(f5);
+                    EdgeLog.saveEdgeFunction(eP, d4, RetSiteN, d5, f5);
                   }
                   INC_COUNTER("EF Queries", 2, Full);
                   // compose call * calleeSummary * return edge functions
@@ -498,15 +534,15 @@ protected:
                                                       << f4);
                   PHASAR_LOG_LEVEL(DEBUG,
                                    "         (return * calleeSummary * call)");
-                  EdgeFunction<l_t> fPrime =
-                      f4.composeWith(fCalleeSummary).composeWith(f5);
+                  EdgeFunction<l_t> fPrime = composeEdgeFunctions(
+                      composeEdgeFunctions(f4, fCalleeSummary), f5);
                   PHASAR_LOG_LEVEL(DEBUG, "       = " << fPrime);
                   d_t d5_restoredCtx = restoreContextOnReturnedFact(n, d2, d5);
                   // propagte the effects of the entire call
                   PHASAR_LOG_LEVEL(DEBUG, "Compose: " << fPrime << " * " << f);
-                  WorkList.emplace_back(
+                  scheduleEdge(
                       PathEdge(d1, RetSiteN, std::move(d5_restoredCtx)),
-                      f.composeWith(fPrime));
+                      composeEdgeFunctions(f, fPrime));
                 }
               }
             }
@@ -534,15 +570,14 @@ protected:
         PHASAR_LOG_LEVEL(DEBUG,
                          "Queried Call-to-Return Edge Function: " << EdgeFnE);
         if (SolverConfig.emitESG()) {
-          IntermediateEdgeFunctions[std::make_tuple(n, d2, ReturnSiteN, d3)]
-              .push_back(EdgeFnE);
+          EdgeLog.saveEdgeFunction(n, d2, ReturnSiteN, d3, EdgeFnE);
         }
         INC_COUNTER("EF Queries", 1, Full);
-        auto fPrime = f.composeWith(EdgeFnE);
+        auto fPrime = composeEdgeFunctions(f, EdgeFnE);
         PHASAR_LOG_LEVEL(DEBUG, "Compose: " << EdgeFnE << " * " << f << " = "
                                             << fPrime);
-        WorkList.emplace_back(PathEdge(d1, ReturnSiteN, std::move(d3)),
-                              std::move(fPrime));
+        scheduleEdge(PathEdge(d1, ReturnSiteN, std::move(d3)),
+                     std::move(fPrime));
       }
     }
   }
@@ -570,16 +605,14 @@ protected:
         EdgeFunction<l_t> g =
             CachedFlowEdgeFunctions.getNormalEdgeFunction(n, d2, nPrime, d3);
         PHASAR_LOG_LEVEL(DEBUG, "Queried Normal Edge Function: " << g);
-        EdgeFunction<l_t> fPrime = f.composeWith(g);
+        EdgeFunction<l_t> fPrime = composeEdgeFunctions(f, g);
         if (SolverConfig.emitESG()) {
-          IntermediateEdgeFunctions[std::make_tuple(n, d2, nPrime, d3)]
-              .push_back(g);
+          EdgeLog.saveEdgeFunction(n, d2, nPrime, d3, g);
         }
         PHASAR_LOG_LEVEL(DEBUG,
                          "Compose: " << g << " * " << f << " = " << fPrime);
         INC_COUNTER("EF Queries", 1, Full);
-        WorkList.emplace_back(PathEdge(d1, nPrime, std::move(d3)),
-                              std::move(fPrime));
+        scheduleEdge(PathEdge(d1, nPrime, std::move(d3)), std::move(fPrime));
       }
     }
   }
@@ -618,8 +651,7 @@ protected:
         PHASAR_LOG_LEVEL(DEBUG, "Queried Call Edge Function: " << EdgeFn);
         if (SolverConfig.emitESG()) {
           for (const auto SP : ICF->getStartPointsOf(Callee)) {
-            IntermediateEdgeFunctions[std::make_tuple(Stmt, Fact, SP, dPrime)]
-                .push_back(EdgeFn);
+            EdgeLog.saveEdgeFunction(Stmt, Fact, SP, dPrime, EdgeFn);
           }
         }
         INC_COUNTER("EF Queries", 1, Full);
@@ -781,10 +813,7 @@ protected:
     if (!SolverConfig.recordEdges()) {
       return;
     }
-    Table<n_t, n_t, std::map<d_t, container_type>> &TgtMap =
-        (isInterProc(Kind)) ? ComputedInterPathEdges : ComputedIntraPathEdges;
-    TgtMap.get(SourceNode, SinkStmt)[SourceVal].insert(DestVals.begin(),
-                                                       DestVals.end());
+    EdgeLog.saveEdges(SourceNode, SourceVal, SinkStmt, DestVals, Kind);
   }
 
   void submitInitialValues() {
@@ -869,8 +898,7 @@ protected:
         if (!IDEProblem.isZeroValue(Fact)) {
           INC_COUNTER("Gen facts", 1, Core);
         }
-        WorkList.emplace_back(PathEdge(Fact, StartPoint, Fact),
-                              EdgeIdentity<l_t>{});
+        scheduleEdge(PathEdge(Fact, StartPoint, Fact), EdgeIdentity<l_t>{});
       }
     }
   }
@@ -939,18 +967,17 @@ protected:
             PHASAR_LOG_LEVEL(DEBUG, "Queried Return Edge Function: " << f5);
             if (SolverConfig.emitESG()) {
               for (auto SP : ICF->getStartPointsOf(ICF->getFunctionOf(n))) {
-                IntermediateEdgeFunctions[std::make_tuple(c, d4, SP, d1)]
-                    .push_back(f4);
+                EdgeLog.saveEdgeFunction(c, d4, SP, d1, f4);
               }
-              IntermediateEdgeFunctions[std::make_tuple(n, d2, RetSiteC, d5)]
-                  .push_back(f5);
+              EdgeLog.saveEdgeFunction(n, d2, RetSiteC, d5, f5);
             }
             INC_COUNTER("EF Queries", 2, Full);
             // compose call function * function * return function
             PHASAR_LOG_LEVEL(DEBUG,
                              "Compose: " << f5 << " * " << f << " * " << f4);
             PHASAR_LOG_LEVEL(DEBUG, "         (return * function * call)");
-            EdgeFunction<l_t> fPrime = f4.composeWith(f).composeWith(f5);
+            EdgeFunction<l_t> fPrime =
+                composeEdgeFunctions(composeEdgeFunctions(f4, f), f5);
             PHASAR_LOG_LEVEL(DEBUG, "       = " << fPrime);
             // for each jump function coming into the call, propagate to
             // return site using the composed function
@@ -963,9 +990,9 @@ protected:
                   d_t d3 = ValAndFunc.first;
                   d_t d5_restoredCtx = restoreContextOnReturnedFact(c, d4, d5);
                   PHASAR_LOG_LEVEL(DEBUG, "Compose: " << fPrime << " * " << f3);
-                  WorkList.emplace_back(PathEdge(std::move(d3), RetSiteC,
-                                                 std::move(d5_restoredCtx)),
-                                        f3.composeWith(fPrime));
+                  scheduleEdge(PathEdge(std::move(d3), RetSiteC,
+                                        std::move(d5_restoredCtx)),
+                               composeEdgeFunctions(f3, fPrime));
                 }
               }
             }
@@ -999,13 +1026,12 @@ protected:
                     Caller, ICF->getFunctionOf(n), n, d2, RetSiteC, d5);
             PHASAR_LOG_LEVEL(DEBUG, "Queried Return Edge Function: " << f5);
             if (SolverConfig.emitESG()) {
-              IntermediateEdgeFunctions[std::make_tuple(n, d2, RetSiteC, d5)]
-                  .push_back(f5);
+              EdgeLog.saveEdgeFunction(n, d2, RetSiteC, d5, f5);
             }
             INC_COUNTER("EF Queries", 1, Full);
             PHASAR_LOG_LEVEL(DEBUG, "Compose: " << f5 << " * " << f);
-            propagteUnbalancedReturnFlow(RetSiteC, d5, f.composeWith(f5),
-                                         Caller);
+            propagteUnbalancedReturnFlow(
+                RetSiteC, d5, composeEdgeFunctions(f, f5), Caller);
             // register for value processing (2nd IDE phase)
             UnbalancedRetSites.insert(RetSiteC);
           }
@@ -1022,10 +1048,21 @@ protected:
     }
   }
 
+  /// Adds a path edge to the worklist. With bottom-up scheduling, path edges
+  /// are prioritized by the call-graph SCC of their target, such that callees
+  /// are completed before their callers.
+  void scheduleEdge(PathEdge<n_t, d_t> Edge, EdgeFunction<l_t> EF) {
+    size_t Bucket = 0;
+    if (SCCs) {
+      Bucket = SCCs->getSCCIndex(ICF->getFunctionOf(Edge.getTarget()));
+    }
+    WorkList.emplace(Bucket, std::move(Edge), std::move(EF));
+  }
+
   void propagteUnbalancedReturnFlow(n_t RetSiteC, d_t TargetVal,
                                     EdgeFunction<l_t> EdgeFunc,
                                     n_t /*RelatedCallSite*/) {
-    WorkList.emplace_back(
+    scheduleEdge(
         PathEdge(ZeroValue, std::move(RetSiteC), std::move(TargetVal)),
         std::move(EdgeFunc));
   }
@@ -1187,6 +1224,38 @@ protected:
     }
   }
 
+  /// Computes First.composeWith(Second). If the composition depth of the
+  /// result exceeds the configured normalization threshold, lets the analysis
+  /// problem bring it into normal form (see
+  /// EdgeFunctions::normalizeEdgeFunction()).
+  EdgeFunction<l_t> composeEdgeFunctions(const EdgeFunction<l_t> &First,
+                                         const EdgeFunction<l_t> &Second) {
+    auto Ret = First.composeWith(Second);
+    auto Threshold = SolverConfig.edgeFunctionNormalizationThreshold();
+    if (!Threshold || !Ret) {
+      return Ret;
+    }
+
+    auto Depth = Ret.depth();
+    if (Depth <= Threshold) {
+      return Ret;
+    }
+
+    PAMM_GET_INSTANCE;
+    ADD_TO_HISTOGRAM("EF Depth Before Normalization", Depth, 1, Full);
+    DepthBeforeNormalization.addSample(Depth);
+
+    auto Normalized = IDEProblem.normalizeEdgeFunction(std::move(Ret));
+    assert(Normalized && "normalizeEdgeFunction() must not return nullptr!");
+    auto NormalizedDepth = Normalized.depth();
+
+    ADD_TO_HISTOGRAM("EF Depth After Normalization", NormalizedDepth, 1, Full);
+    DepthAfterNormalization.addSample(NormalizedDepth);
+    PHASAR_LOG_LEVEL(DEBUG, "Normalize EF of depth " << Depth << " to "
+                                                     << Normalized);
+    return Normalized;
+  }
+
   l_t joinValueAt(n_t /*Unit*/, d_t /*Fact*/, l_t Curr, l_t NewVal) {
     return IDEProblem.join(std::move(Curr), std::move(NewVal));
   }
@@ -1262,7 +1331,8 @@ protected:
         << "\n**********************************************************\n";
 
     // Sort intra-procedural path edges
-    auto Cells = ComputedIntraPathEdges.cellVec();
+    auto Cells =
+        EdgeLog.template getPathEdges<Container>(/*InterProc*/ false).cellVec();
     StmtLess Stmtless(ICF);
     sort(Cells.begin(), Cells.end(), [&Stmtless](auto Lhs, auto Rhs) {
       return Stmtless(Lhs.getRowKey(), Rhs.getRowKey());
@@ -1291,7 +1361,8 @@ protected:
         << "\n**********************************************************\n";
 
     // Sort intra-procedural path edges
-    Cells = ComputedInterPathEdges.cellVec();
+    Cells =
+        EdgeLog.template getPathEdges<Container>(/*InterProc*/ true).cellVec();
     sort(Cells.begin(), Cells.end(), [&Stmtless](auto Lhs, auto Rhs) {
       return Stmtless(Lhs.getRowKey(), Rhs.getRowKey());
     });
@@ -1338,7 +1409,9 @@ protected:
     // d1 --> d2-Set
     // Case 1: d1 in d2-Set
     // Case 2: d1 not in d2-Set, i.e., d1 was killed. d2-Set could be empty.
-    for (const auto &Cell : ComputedIntraPathEdges.cellSet()) {
+    auto IntraPathEdges =
+        EdgeLog.template getPathEdges<Container>(/*InterProc*/ false);
+    for (const auto &Cell : IntraPathEdges.cellSet()) {
       auto Edge = std::make_pair(Cell.getRowKey(), Cell.getColumnKey());
       PHASAR_LOG_LEVEL(DEBUG, "N1: " << NToString(Edge.first));
       PHASAR_LOG_LEVEL(DEBUG, "N2: " << NToString(Edge.second));
@@ -1370,7 +1443,9 @@ protected:
     std::set<std::pair<n_t, d_t>> ProcessSummaryFacts;
     PHASAR_LOG_LEVEL(DEBUG, "==============================================");
     PHASAR_LOG_LEVEL(DEBUG, "INTER PATH EDGES");
-    for (const auto &Cell : ComputedInterPathEdges.cellSet()) {
+    auto InterPathEdges =
+        EdgeLog.template getPathEdges<Container>(/*InterProc*/ true);
+    for (const auto &Cell : InterPathEdges.cellSet()) {
       auto Edge = std::make_pair(Cell.getRowKey(), Cell.getColumnKey());
       PHASAR_LOG_LEVEL(DEBUG, "N1: " << NToString(Edge.first));
       PHASAR_LOG_LEVEL(DEBUG, "N2: " << NToString(Edge.second));
@@ -1468,6 +1543,8 @@ protected:
                      "#Intra Path Edges: " << GET_COUNTER("Intra Path Edges"));
     PHASAR_LOG_LEVEL(INFO,
                      "#Inter Path Edges: " << GET_COUNTER("Inter Path Edges"));
+    PHASAR_LOG_LEVEL(INFO, "#Propagations    : " << PropagationCount);
+    PHASAR_LOG_LEVEL(INFO, "#New Jump Fns    : " << PathEdgeCount);
     if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Full) {
       PHASAR_LOG_LEVEL(
           INFO, "Flow function query count: " << GET_COUNTER("FF Queries"));
@@ -1505,7 +1582,8 @@ public:
     DOTFunctionSubGraph *FG = nullptr;
 
     // Sort intra-procedural path edges
-    auto Cells = ComputedIntraPathEdges.cellVec();
+    auto Cells =
+        EdgeLog.template getPathEdges<Container>(/*InterProc*/ false).cellVec();
     StmtLess Stmtless(ICF);
     sort(Cells.begin(), Cells.end(), [&Stmtless](auto Lhs, auto Rhs) {
       return Stmtless(Lhs.getRowKey(), Rhs.getRowKey());
@@ -1572,8 +1650,8 @@ public:
             std::string D2Label = DToString(D2Fact);
             DOTNode D2 = {FuncName, D2Label, N2StmtId, D2FactId, false, true};
             std::string EFLabel;
-            auto EFVec = IntermediateEdgeFunctions[std::make_tuple(
-                Edge.first, D1Fact, Edge.second, D2Fact)];
+            auto EFVec = EdgeLog.getEdgeFunctions(Edge.first, D1Fact,
+                                                  Edge.second, D2Fact);
             for (const auto &EF : EFVec) {
               EFLabel += to_string(EF) + ", ";
             }
@@ -1599,7 +1677,8 @@ public:
     PHASAR_LOG_LEVEL(DEBUG, "=============================================");
     PHASAR_LOG_LEVEL(DEBUG, "Process inter-procedural path edges");
     PHASAR_LOG_LEVEL(DEBUG, "=============================================");
-    Cells = ComputedInterPathEdges.cellVec();
+    Cells =
+        EdgeLog.template getPathEdges<Container>(/*InterProc*/ true).cellVec();
     sort(Cells.begin(), Cells.end(), [&Stmtless](auto Lhs, auto Rhs) {
       return Stmtless(Lhs.getRowKey(), Rhs.getRowKey());
     });
@@ -1692,8 +1771,8 @@ public:
           } else {
             // std::string EFLabel = EF ? EF->str() : " ";
             std::string EFLabel;
-            auto EFVec = IntermediateEdgeFunctions[std::make_tuple(
-                Edge.first, D1Fact, Edge.second, D2Fact)];
+            auto EFVec = EdgeLog.getEdgeFunctions(Edge.first, D1Fact,
+                                                  Edge.second, D2Fact);
             for (const auto &EF : EFVec) {
               PHASAR_LOG_LEVEL(DEBUG, "Partial EF Label: " << EF);
               EFLabel.append(to_string(EF) + ", ");
@@ -1742,6 +1821,14 @@ private:
     REG_COUNTER("[Calls] getAliasSet", 0, Full);
     REG_HISTOGRAM("Data-flow facts", Full);
     REG_HISTOGRAM("Points-to", Full);
+    REG_HISTOGRAM("EF Depth Before Normalization", Full);
+    REG_HISTOGRAM("EF Depth After Normalization", Full);
+
+    if (SolverConfig.recordEdges() && !SolverConfig.edgeLogFile().empty()) {
+      PHASAR_LOG_LEVEL(INFO, "Stream the recorded ESG edges to "
+                                 << SolverConfig.edgeLogFile());
+      EdgeLog.streamTo(SolverConfig.edgeLogFile());
+    }
 
     PHASAR_LOG_LEVEL(INFO, "IDE solver is solving the specified problem");
     PHASAR_LOG_LEVEL(INFO,
@@ -1749,6 +1836,13 @@ private:
     // computations starting here
     START_TIMER("DFA Phase I", Full);
 
+    if (SolverConfig.bottomUpScheduling()) {
+      SCCs = computeCallGraphSCCs(*ICF);
+      WorkList.setNumBuckets(SCCs->getNumSCCs() + 1);
+      PHASAR_LOG_LEVEL(INFO, "Schedule bottom-up along "
+                                 << SCCs->getNumSCCs() << " call-graph SCCs");
+    }
+
     // We start our analysis and construct exploded supergraph
     submitInitialSeeds();
     return !WorkList.empty();
@@ -1756,10 +1850,10 @@ private:
 
   bool doNext() {
     assert(!WorkList.empty());
-    auto [Edge, EF] = std::move(WorkList.back());
-    WorkList.pop_back();
+    auto [Edge, EF] = WorkList.pop();
 
     auto [SourceVal, Target, TargetVal] = Edge.consume();
+    ++PropagationCount;
     propagate(std::move(SourceVal), std::move(Target), std::move(TargetVal),
               std::move(EF));
 
@@ -1806,24 +1900,22 @@ private:
   const i_t *ICF;
   IFDSIDESolverConfig &SolverConfig;
 
-  std::vector<std::pair<PathEdge<n_t, d_t>, EdgeFunction<l_t>>> WorkList;
+  BucketedWorkList<std::pair<PathEdge<n_t, d_t>, EdgeFunction<l_t>>> WorkList;
+  /// Only present with IFDSIDESolverConfig::bottomUpScheduling()
+  std::optional<CallGraphSCCs<f_t>> SCCs;
   std::vector<std::pair<n_t, d_t>> ValuePropWL;
 
   size_t PathEdgeCount = 0;
+  size_t PropagationCount = 0;
 
   FlowEdgeFunctionCache<AnalysisDomainTy, Container> CachedFlowEdgeFunctions;
 
-  Table<n_t, n_t, std::map<d_t, Container>> ComputedIntraPathEdges;
-
-  Table<n_t, n_t, std::map<d_t, Container>> ComputedInterPathEdges;
+  ESGEdgeLog<n_t, d_t, l_t> EdgeLog;
 
   EdgeFunction<l_t> AllTop;
 
   std::shared_ptr<JumpFunctions<AnalysisDomainTy, Container>> JumpFn;
 
-  std::map<std::tuple<n_t, d_t, n_t, d_t>, std::vector<EdgeFunction<l_t>>>
-      IntermediateEdgeFunctions;
-
   // stores summaries that were queried before they were computed
   // see CC 2010 paper by Naeem, Lhotak and Rodriguez
   Table<n_t, d_t, Table<n_t, d_t, EdgeFunction<l_t>>> EndsummaryTab;
@@ -1841,6 +1933,10 @@ private:
   Table<n_t, d_t, l_t> ValTab;
 
   std::map<std::pair<n_t, d_t>, size_t> FSummaryReuse;
+
+  // Composition depths of the normalized edge functions
+  Sampler DepthBeforeNormalization{};
+  Sampler DepthAfterNormalization{};
 };
 
 template <typename AnalysisDomainTy, typename Container>
@@ -46,7 +46,15 @@ public:
     return ESG;
   }
 
-  [[nodiscard]] ExplodedSuperGraph<domain_t> &&getExplicitESG() &&noexcept {
+  /// Finalizes the ESG before handing it out. Prefer this overload after the
+  /// solver has finished, as the finalized ESG is more compact.
+  [[nodiscard]] const ExplodedSuperGraph<domain_t> &getExplicitESG() & {
+    ESG.finalize();
+    return ESG;
+  }
+
+  [[nodiscard]] ExplodedSuperGraph<domain_t> &&getExplicitESG() && {
+    ESG.finalize();
     return std::move(ESG);
   }
 
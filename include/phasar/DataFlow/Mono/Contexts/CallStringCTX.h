@@ -3,50 +3,73 @@
 
 #include "phasar/Utils/Printer.h"
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMapInfo.h"
 #include "llvm/Support/raw_ostream.h"
 
-#include "boost/functional/hash.hpp"
-
-#include <deque>
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
+#include <stdexcept>
 
 namespace psr {
 
+/// A call string of at most K call sites.
+///
+/// The call sites are stored inline, so creating, copying and comparing
+/// contexts never allocates. The hash is cached and updated on every
+/// modification, which makes CallStringCTX cheap to use as key in hash maps.
 template <typename N, unsigned K> class CallStringCTX {
 protected:
-  std::deque<N> CallString;
   static constexpr unsigned KLimit = K;
   friend struct std::hash<psr::CallStringCTX<N, K>>;
+  friend struct llvm::DenseMapInfo<psr::CallStringCTX<N, K>>;
+
+  std::array<N, K> CallString{};
+  uint32_t Size = 0;
+  size_t Hash = computeHash();
 
 public:
   CallStringCTX() = default;
 
-  CallStringCTX(std::initializer_list<N> IList) : CallString(IList) {
+  CallStringCTX(std::initializer_list<N> IList) {
     if (IList.size() > KLimit) {
       throw std::runtime_error(
           "initial call std::string length exceeds maximal length K");
     }
+    std::copy(IList.begin(), IList.end(), CallString.begin());
+    Size = uint32_t(IList.size());
+    Hash = computeHash();
   }
 
   void push_back(N Stmt) { // NOLINT
-    if (CallString.size() > KLimit - 1) {
-      CallString.pop_front();
+    if constexpr (KLimit == 0) {
+      return;
+    } else {
+      if (Size == KLimit) {
+        std::move(std::next(CallString.begin()), CallString.end(),
+                  CallString.begin());
+        --Size;
+      }
+      CallString[Size++] = std::move(Stmt);
+      Hash = computeHash();
     }
-    CallString.push_back(Stmt);
   }
 
   N pop_back() { // NOLINT
-    if (!CallString.empty()) {
-      N Stmt = CallString.back();
-      CallString.pop_back();
+    if (Size != 0) {
+      N Stmt = std::move(CallString[--Size]);
+      CallString[Size] = N{};
+      Hash = computeHash();
       return Stmt;
     }
     return N{};
   }
 
   [[nodiscard]] bool isEqual(const CallStringCTX &Rhs) const {
-    return CallString == Rhs.CallString;
+    return Hash == Rhs.Hash && getCallString() == Rhs.getCallString();
   }
 
   [[nodiscard]] bool isDifferent(const CallStringCTX &Rhs) const {
@@ -65,23 +88,42 @@ public:
 
   friend bool operator<(const CallStringCTX<N, K> &Lhs,
                         const CallStringCTX<N, K> &Rhs) {
-    return Lhs.cs < Rhs.cs;
+    auto LhsCS = Lhs.getCallString();
+    auto RhsCS = Rhs.getCallString();
+    return std::lexicographical_compare(LhsCS.begin(), LhsCS.end(),
+                                        RhsCS.begin(), RhsCS.end());
   }
 
   llvm::raw_ostream &print(llvm::raw_ostream &OS) const {
     OS << "Call string: [ ";
-    for (auto C : CallString) {
-      OS << NToString(C);
-      if (C != CallString.back()) {
+    for (uint32_t I = 0; I != Size; ++I) {
+      if (I != 0) {
         OS << " * ";
       }
+      OS << NToString(CallString[I]);
     }
     return OS << " ]";
   }
 
-  [[nodiscard]] bool empty() const { return CallString.empty(); }
+  /// The call sites of this context, the most recent one last
+  [[nodiscard]] llvm::ArrayRef<N> getCallString() const noexcept {
+    return llvm::makeArrayRef(CallString.data(), Size);
+  }
+
+  [[nodiscard]] bool empty() const { return Size == 0; }
 
-  [[nodiscard]] std::size_t size() const { return CallString.size(); }
+  [[nodiscard]] std::size_t size() const { return Size; }
+
+  [[nodiscard]] size_t getHash() const noexcept { return Hash; }
+
+private:
+  [[nodiscard]] size_t computeHash() const noexcept {
+    size_t H = std::hash<unsigned>{}(K);
+    for (const auto &C : getCallString()) {
+      H ^= std::hash<N>{}(C) + 0x9e3779b9 + (H << 6) + (H >> 2);
+    }
+    return H;
+  }
 };
 
 } // namespace psr
@@ -90,14 +132,41 @@ namespace std {
 
 template <typename N, unsigned K> struct hash<psr::CallStringCTX<N, K>> {
   size_t operator()(const psr::CallStringCTX<N, K> &CS) const noexcept {
-    boost::hash<std::deque<N>> HashDeque;
-    std::hash<unsigned> HashUnsigned;
-    size_t U = HashUnsigned(K);
-    size_t H = HashDeque(CS.CallString);
-    return U ^ (H << 1);
+    return CS.getHash();
   }
 };
 
 } // namespace std
 
+namespace llvm {
+
+template <typename N, unsigned K>
+struct DenseMapInfo<psr::CallStringCTX<N, K>> {
+  using CTX = psr::CallStringCTX<N, K>;
+
+  // Sizes that no valid call string can have
+  static CTX getEmptyKey() {
+    CTX Ret;
+    Ret.Size = K + 1;
+    return Ret;
+  }
+  static CTX getTombstoneKey() {
+    CTX Ret;
+    Ret.Size = K + 2;
+    return Ret;
+  }
+
+  static unsigned getHashValue(const CTX &CS) noexcept {
+    return unsigned(CS.getHash());
+  }
+  static bool isEqual(const CTX &LHS, const CTX &RHS) noexcept {
+    if (LHS.Size > K || RHS.Size > K) {
+      return LHS.Size == RHS.Size;
+    }
+    return LHS == RHS;
+  }
+};
+
+} // namespace llvm
+
 #endif
@@ -19,8 +19,11 @@
 
 #include "phasar/DataFlow/Mono/Contexts/CallStringCTX.h"
 #include "phasar/DataFlow/Mono/InterMonoProblem.h"
+#include "phasar/Utils/PriorityEdgeWorkList.h"
 
-#include <deque>
+#include "llvm/ADT/DenseMap.h"
+
+#include <cstdint>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -37,35 +40,45 @@ public:
   using v_t = typename AnalysisDomainTy::v_t;
   using i_t = typename AnalysisDomainTy::i_t;
   using mono_container_t = typename AnalysisDomainTy::mono_container_t;
+  using context_t = CallStringCTX<n_t, K>;
+  using ContextMapTy = llvm::DenseMap<context_t, mono_container_t>;
 
 protected:
   ProblemTy &IMProblem;
-  std::deque<std::pair<n_t, n_t>> Worklist;
-  std::unordered_map<
-      n_t, std::unordered_map<CallStringCTX<n_t, K>, mono_container_t>>
-      Analysis;
+  PriorityEdgeWorkList<n_t> Worklist;
+  std::unordered_map<n_t, ContextMapTy> Analysis;
   std::unordered_set<f_t> AddedFunctions;
   const i_t *ICF;
+  uint32_t NumOrderedFunctions = 0;
+
+  /// Orders the instructions of Fun in reverse postorder. Functions that are
+  /// discovered later are processed first, such that the callees are drained
+  /// before their callers resume.
+  void addReversePostOrder(f_t Fun) {
+    Worklist.addReversePostOrder(
+        ICF->getStartPointsOf(Fun),
+        [this](n_t Inst) { return ICF->getSuccsOf(Inst); },
+        UINT32_MAX - NumOrderedFunctions++);
+  }
 
   void initialize() {
     for (auto &[Node, FlowFacts] : IMProblem.initialSeeds()) {
-      auto ControlFlowEdges =
-          ICF->getAllControlFlowEdges(ICF->getFunctionOf(Node));
-      Worklist.insert(Worklist.begin(), ControlFlowEdges.begin(),
-                      ControlFlowEdges.end());
+      auto Fun = ICF->getFunctionOf(Node);
+      addReversePostOrder(Fun);
+      auto ControlFlowEdges = ICF->getAllControlFlowEdges(Fun);
+      Worklist.pushAll(ControlFlowEdges);
       // Initialize with empty context and empty data-flow set such that the
       // flow functions are at least called once per instruction
       for (auto &[Src, Dst] : ControlFlowEdges) {
-        Analysis[Src][CallStringCTX<n_t, K>()] = IMProblem.allTop();
+        Analysis[Src][context_t()] = IMProblem.allTop();
       }
       // Initialize last
       if (!ControlFlowEdges.empty()) {
-        Analysis[ControlFlowEdges.back().second][CallStringCTX<n_t, K>()] =
+        Analysis[ControlFlowEdges.back().second][context_t()] =
             IMProblem.allTop();
       }
       // Additionally, insert the initial seeds
-      Analysis[Node][CallStringCTX<n_t, K>()].insert(FlowFacts.begin(),
-                                                     FlowFacts.end());
+      Analysis[Node][context_t()].insert(FlowFacts.begin(), FlowFacts.end());
     }
   }
 
@@ -83,9 +96,9 @@ protected:
 
   void printWorkList() {
     llvm::outs() << "CURRENT WORKLIST:\n";
-    for (auto &[Src, Dst] : Worklist) {
+    Worklist.foreachPending([](n_t Src, n_t Dst) {
       llvm::outs() << NToString(Src) << " --> " << NToString(Dst) << '\n';
-    }
+    });
     llvm::outs() << "-----------------\n";
   }
 
@@ -98,27 +111,27 @@ protected:
         break;
       }
       AddedFunctions.insert(Callee);
+      addReversePostOrder(Callee);
       // Add call Edge(s)
       for (auto StartPoint : ICF->getStartPointsOf(Callee)) {
-        Worklist.push_back({Src, StartPoint});
+        Worklist.push(Src, StartPoint);
       }
       // Add intra edges of callee
       auto Edges = ICF->getAllControlFlowEdges(Callee);
-      Worklist.insert(Worklist.begin(), Edges.begin(), Edges.end());
+      Worklist.pushAll(Edges);
       // Initialize with empty context and empty data-flow set such that the
       // flow functions are at least called once per instruction
       for (auto &[Src, Dst] : Edges) {
-        Analysis[Src][CallStringCTX<n_t, K>()] = IMProblem.allTop();
+        Analysis[Src][context_t()] = IMProblem.allTop();
       }
       // Initialize last
       if (!Edges.empty()) {
-        Analysis[Edges.back().second][CallStringCTX<n_t, K>()] =
-            IMProblem.allTop();
+        Analysis[Edges.back().second][context_t()] = IMProblem.allTop();
       }
       // Add return Edge(s)
       for (auto Ret : ICF->getExitPointsOf(Callee)) {
         for (auto RetSite : ICF->getReturnSitesOfCallAt(Src)) {
-          Worklist.push_back({Ret, RetSite});
+          Worklist.push(Ret, RetSite);
         }
       }
     }
@@ -129,16 +142,16 @@ protected:
   void addToWorklist(std::pair<n_t, n_t> Edge) {
     auto Src = Edge.first;
     auto Dst = Edge.second;
-    Worklist.push_back({Src, Dst});
+    Worklist.push(Src, Dst);
     // add intra-procedural edges again
     for (auto Nprimeprime : ICF->getSuccsOf(Dst)) {
-      Worklist.push_back({Dst, Nprimeprime});
+      Worklist.push(Dst, Nprimeprime);
     }
     // add inter-procedural call edges again
     if (ICF->isCallSite(Dst)) {
       for (auto Callee : ICF->getCalleesOfCallAt(Dst)) {
         for (auto StartPoint : ICF->getStartPointsOf(Callee)) {
-          Worklist.push_back({Dst, StartPoint});
+          Worklist.push(Dst, StartPoint);
         }
       }
     }
@@ -146,7 +159,7 @@ protected:
     if (ICF->isExitInst(Dst)) {
       for (const auto *Caller : ICF->getCallersOf(ICF->getFunctionOf(Dst))) {
         for (const auto *Nprimeprime : ICF->getSuccsOf(Caller)) {
-          Worklist.push_back({Dst, Nprimeprime});
+          Worklist.push(Dst, Nprimeprime);
         }
       }
     }
@@ -166,11 +179,7 @@ public:
 
   virtual ~InterMonoSolver() = default;
 
-  std::unordered_map<
-      n_t, std::unordered_map<CallStringCTX<n_t, K>, mono_container_t>>
-  getAnalysis() {
-    return Analysis;
-  }
+  std::unordered_map<n_t, ContextMapTy> getAnalysis() { return Analysis; }
 
   void processNormal(std::pair<n_t, n_t> Edge) {
     llvm::outs() << "Handle normal flow\n";
@@ -178,7 +187,7 @@ public:
     auto Dst = Edge.second;
     llvm::outs() << "Src: " << NToString(Src) << '\n';
     llvm::outs() << "Dst: " << NToString(Dst) << '\n';
-    std::unordered_map<CallStringCTX<n_t, K>, mono_container_t> Out;
+    ContextMapTy Out;
     for (auto &[Ctx, Facts] : Analysis[Src]) {
       Out[Ctx] = IMProblem.normalFlow(Src, Analysis[Src][Ctx]);
       // need to merge if Dst is a branch target
@@ -219,7 +228,7 @@ public:
   void processCall(std::pair<n_t, n_t> Edge) {
     auto Src = Edge.first;
     auto Dst = Edge.second;
-    std::unordered_map<CallStringCTX<n_t, K>, mono_container_t> Out;
+    ContextMapTy Out;
     if (!isIntraEdge(Edge)) {
       llvm::outs() << "Handle call flow\n";
       llvm::outs() << "Src: " << NToString(Src) << '\n';
@@ -283,7 +292,7 @@ public:
   void processExit(std::pair<n_t, n_t> Edge) {
     auto Src = Edge.first;
     auto Dst = Edge.second;
-    std::unordered_map<CallStringCTX<n_t, K>, mono_container_t> Out;
+    ContextMapTy Out;
     llvm::outs() << "\nHandle ret flow in: "
                  << ICF->getFunctionName(ICF->getFunctionOf(Src)) << '\n';
     llvm::outs() << "Src: " << NToString(Src) << '\n';
@@ -358,8 +367,7 @@ public:
   virtual void solve() {
     initialize();
     while (!Worklist.empty()) {
-      std::pair<n_t, n_t> Edge = Worklist.front();
-      Worklist.pop_front();
+      std::pair<n_t, n_t> Edge = Worklist.pop();
       auto Src = Edge.first;
       // auto Dst = Edge.second;
       if (ICF->isCallSite(Src)) {
@@ -379,6 +387,12 @@ public:
     }
   }
 
+  /// The number of edges that have been processed until the fixpoint was
+  /// reached
+  [[nodiscard]] size_t getNumIterations() const noexcept {
+    return Worklist.getNumPops();
+  }
+
   mono_container_t getResultsAt(n_t Stmt) {
     mono_container_t Result;
     for (auto &[Ctx, Facts] : Analysis[Stmt]) {
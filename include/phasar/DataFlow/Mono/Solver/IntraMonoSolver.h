@@ -19,8 +19,8 @@
 
 #include "phasar/DataFlow/Mono/IntraMonoProblem.h"
 #include "phasar/Utils/BitVectorSet.h"
+#include "phasar/Utils/PriorityEdgeWorkList.h"
 
-#include <deque>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -41,7 +41,7 @@ public:
 
 protected:
   ProblemTy &IMProblem;
-  std::deque<std::pair<n_t, n_t>> Worklist;
+  PriorityEdgeWorkList<n_t> Worklist;
   std::unordered_map<n_t, mono_container_t> Analysis;
   const CFGBase<c_t> *CFG;
 
@@ -50,10 +50,15 @@ protected:
     for (const auto &EntryPoint : EntryPoints) {
       auto Function =
           IMProblem.getProjectIRDB()->getFunctionDefinition(EntryPoint);
-      auto ControlFlowEdges = CFG->getAllControlFlowEdges(Function);
+      if (!Function) {
+        continue;
+      }
+      // process the edges in reverse postorder of their source instructions
+      Worklist.addReversePostOrder(
+          CFG->getStartPointsOf(Function),
+          [this](n_t Inst) { return CFG->getSuccsOf(Inst); });
       // add all intra-procedural edges to the worklist
-      Worklist.insert(Worklist.begin(), ControlFlowEdges.begin(),
-                      ControlFlowEdges.end());
+      Worklist.pushAll(CFG->getAllControlFlowEdges(Function));
       // set all analysis information to the empty set
       for (auto Insts : CFG->getAllInstructionsOf(Function)) {
         Analysis.insert(std::make_pair(Insts, IMProblem.allTop()));
@@ -75,11 +80,7 @@ public:
     initialize();
     // step 2: Iteration (updating Worklist and Analysis)
     while (!Worklist.empty()) {
-      // llvm::outs() << "worklist size: " << Worklist.size() << "\n";
-      std::pair<n_t, n_t> Edge = Worklist.front();
-      Worklist.pop_front();
-      n_t Src = Edge.first;
-      n_t Dst = Edge.second;
+      auto [Src, Dst] = Worklist.pop();
       auto Out = IMProblem.normalFlow(Src, Analysis[Src]);
       // need to merge if Dst is a branch target
       if (CFG->isBranchTarget(Src, Dst)) {
@@ -97,7 +98,7 @@ public:
       if (!IMProblem.equal_to(Out, Analysis[Dst])) {
         Analysis[Dst] = Out;
         for (auto Nprimeprime : CFG->getSuccsOf(Dst)) {
-          Worklist.push_back({Dst, Nprimeprime});
+          Worklist.push(Dst, Nprimeprime);
         }
       }
     }
@@ -111,6 +112,24 @@ public:
 
   mono_container_t getResultsAt(n_t Stmt) { return Analysis[Stmt]; }
 
+  [[nodiscard]] const std::unordered_map<n_t, mono_container_t> &
+  getAllResults() const noexcept {
+    return Analysis;
+  }
+
+  /// Moves the computed results out of this solver. The solver must not be
+  /// queried afterwards.
+  [[nodiscard]] std::unordered_map<n_t, mono_container_t>
+  consumeSolverResults() noexcept {
+    return std::move(Analysis);
+  }
+
+  /// The number of edges that have been processed until the fixpoint was
+  /// reached
+  [[nodiscard]] size_t getNumIterations() const noexcept {
+    return Worklist.getNumPops();
+  }
+
   virtual void dumpResults(llvm::raw_ostream &OS = llvm::outs()) {
     OS << "Intra-Monotone solver results:\n"
           "------------------------------\n";
@@ -0,0 +1,163 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_DATAFLOW_MONO_SOLVER_PARALLELINTRAMONOSOLVER_H
+#define PHASAR_DATAFLOW_MONO_SOLVER_PARALLELINTRAMONOSOLVER_H
+
+#include "phasar/DataFlow/Mono/IntraMonoProblem.h"
+#include "phasar/DataFlow/Mono/Solver/IntraMonoSolver.h"
+#include "phasar/Utils/ByRef.h"
+#include "phasar/Utils/Printer.h"
+
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/// Solves an intra-procedural monotone problem for many functions at once.
+///
+/// As intra-procedural problems do not propagate information across function
+/// boundaries, every function is solved by its own IntraMonoSolver. These
+/// solvers run concurrently on a thread pool. Afterwards, their results are
+/// merged into a single store that can be queried like an IntraMonoSolver.
+template <typename AnalysisDomainTy> class ParallelIntraMonoSolver {
+public:
+  using ProblemTy = IntraMonoProblem<AnalysisDomainTy>;
+  using n_t = typename AnalysisDomainTy::n_t;
+  using f_t = typename AnalysisDomainTy::f_t;
+  using mono_container_t = typename AnalysisDomainTy::mono_container_t;
+
+  /// IMProblem is only used to print the results; it is not solved itself.
+  /// The problems that are actually solved are created per function in
+  /// solve().
+  ///
+  /// With NumThreads == 0, uses one thread per available hardware thread.
+  explicit ParallelIntraMonoSolver(const ProblemTy &IMProblem,
+                                   unsigned NumThreads = 0) noexcept
+      : IMProblem(IMProblem), NumThreads(NumThreads) {}
+
+  /// Solves the problem MakeProblem(Fun) for each function Fun in Functions
+  /// with a separate IntraMonoSolver. MakeProblem must return an
+  /// IntraMonoProblem (by value) whose only entry point is Fun.
+  ///
+  /// MakeProblem and the flow functions of the created problems are called
+  /// concurrently. Hence, they must not modify shared state, e.g., lazily
+  /// computed helper analyses should be constructed before calling solve().
+  template <typename FunRange, typename ProblemFactory>
+  void solve(const FunRange &Functions, ProblemFactory MakeProblem) {
+    std::vector<f_t> Funs;
+    for (const auto &Fun : Functions) {
+      Funs.push_back(Fun);
+    }
+
+    std::vector<std::unordered_map<n_t, mono_container_t>> PerFunction(
+        Funs.size());
+    std::atomic_size_t NumIters = 0;
+    {
+      llvm::ThreadPool Pool(llvm::hardware_concurrency(NumThreads));
+      std::vector<std::shared_future<void>> Tasks;
+      Tasks.reserve(Funs.size());
+      for (size_t I = 0, End = Funs.size(); I != End; ++I) {
+        Tasks.push_back(Pool.async([&, I] {
+          auto Problem = std::invoke(MakeProblem, Funs[I]);
+          IntraMonoSolver<AnalysisDomainTy> Solver(Problem);
+          Solver.solve();
+          NumIters.fetch_add(Solver.getNumIterations(),
+                             std::memory_order_relaxed);
+          PerFunction[I] = Solver.consumeSolverResults();
+        }));
+      }
+      // Propagates the first exception that was thrown by a worker
+      for (auto &Task : Tasks) {
+        Task.get();
+      }
+    }
+
+    size_t NumResults = Analysis.size();
+    for (const auto &Results : PerFunction) {
+      NumResults += Results.size();
+    }
+    Analysis.reserve(NumResults);
+    for (auto &Results : PerFunction) {
+      Analysis.merge(Results);
+    }
+
+    NumIterations += NumIters;
+    NumSolvedFunctions += Funs.size();
+  }
+
+  [[nodiscard]] mono_container_t getResultsAt(ByConstRef<n_t> Stmt) const {
+    auto It = Analysis.find(Stmt);
+    if (It == Analysis.end()) {
+      return {};
+    }
+    return It->second;
+  }
+
+  [[nodiscard]] const std::unordered_map<n_t, mono_container_t> &
+  getAllResults() const noexcept {
+    return Analysis;
+  }
+
+  /// The total number of edges that have been processed by all solvers
+  [[nodiscard]] size_t getNumIterations() const noexcept {
+    return NumIterations;
+  }
+
+  [[nodiscard]] size_t getNumSolvedFunctions() const noexcept {
+    return NumSolvedFunctions;
+  }
+
+  void dumpResults(llvm::raw_ostream &OS = llvm::outs()) const {
+    OS << "Intra-Monotone solver results:\n"
+          "------------------------------\n";
+    for (const auto &[Node, FlowFacts] : Analysis) {
+      OS << "Instruction:\n" << NToString(Node);
+      OS << "\nFacts:\n";
+      if (FlowFacts.empty()) {
+        OS << "\tEMPTY\n";
+      } else {
+        IMProblem.printContainer(OS, FlowFacts);
+      }
+      OS << "\n\n";
+    }
+  }
+
+  void emitTextReport(llvm::raw_ostream & /*OS*/ = llvm::outs()) const {}
+
+  void emitGraphicalReport(llvm::raw_ostream & /*OS*/ = llvm::outs()) const {}
+
+private:
+  const ProblemTy &IMProblem;
+  unsigned NumThreads{};
+  std::unordered_map<n_t, mono_container_t> Analysis;
+  size_t NumIterations = 0;
+  size_t NumSolvedFunctions = 0;
+};
+
+template <typename Problem>
+ParallelIntraMonoSolver(const Problem &, unsigned = 0)
+    -> ParallelIntraMonoSolver<typename Problem::ProblemAnalysisDomain>;
+
+template <typename Problem>
+using ParallelIntraMonoSolver_P =
+    ParallelIntraMonoSolver<typename Problem::ProblemAnalysisDomain>;
+
+} // namespace psr
+
+#endif // PHASAR_DATAFLOW_MONO_SOLVER_PARALLELINTRAMONOSOLVER_H
@@ -13,14 +13,18 @@
 #include "phasar/DataFlow/IfdsIde/Solver/ESGEdgeKind.h"
 #include "phasar/Utils/ByRef.h"
 #include "phasar/Utils/Logger.h"
+#include "phasar/Utils/NlohmannLogging.h"
 #include "phasar/Utils/Printer.h"
 #include "phasar/Utils/StableVector.h"
 #include "phasar/Utils/Utilities.h"
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseMapInfo.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/Sequence.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/IR/Instructions.h"
@@ -30,8 +34,12 @@
 #include "llvm/Support/raw_os_ostream.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include "nlohmann/json.hpp"
+
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <functional>
 #include <numeric>
 #include <optional>
 #include <set>
@@ -40,6 +48,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace psr {
 
@@ -49,23 +58,25 @@ namespace psr {
 /// Not all covered instructions of a BasicBlock might be present; however, it
 /// is guaranteed that for each BasicBlock covered by the analysis there is at
 /// least one node in the ExplicitESG containing an instruction from that BB.
+///
+/// To keep the memory footprint low, the ESG interns all instructions and
+/// flow facts and only refers to them by dense 32-bit ids. The neighbors of
+/// the nodes are collected in a sparse map while the ESG is being built and
+/// are compacted into a CSR (compressed sparse row) representation by
+/// finalize().
 template <typename AnalysisDomainTy> class ExplodedSuperGraph {
 public:
   using n_t = typename AnalysisDomainTy::n_t;
   using d_t = typename AnalysisDomainTy::d_t;
+  using id_t = uint32_t;
 
   struct Node {
-    static constexpr size_t NoPredId = ~size_t(0);
+    static constexpr id_t NoPredId = ~id_t(0);
   };
 
   struct NodeData {
-    d_t Value{};
-    n_t Source{};
-  };
-
-  struct NodeAdj {
-    size_t PredecessorIdx = Node::NoPredId;
-    llvm::SmallVector<size_t, 0> Neighbors{};
+    id_t FactId{};
+    id_t InstId{};
   };
 
   class BuildNodeRef;
@@ -79,35 +90,35 @@ public:
 
     [[nodiscard]] ByConstRef<d_t> value() const noexcept {
       assert(*this);
-      return Owner->NodeDataOwner[NodeId].Value;
+      return Owner->Facts[Owner->NodeDataOwner[NodeId].FactId];
     }
 
     [[nodiscard]] ByConstRef<n_t> source() const noexcept {
       assert(*this);
-      return Owner->NodeDataOwner[NodeId].Source;
+      return Owner->Insts[Owner->NodeDataOwner[NodeId].InstId];
     }
 
     [[nodiscard]] NodeRef predecessor() const noexcept {
       assert(*this);
-      auto PredId = Owner->NodeAdjOwner[NodeId].PredecessorIdx;
+      auto PredId = Owner->PredecessorOwner[NodeId];
       return PredId == Node::NoPredId ? NodeRef() : NodeRef(PredId, Owner);
     }
 
     [[nodiscard]] bool hasNeighbors() const noexcept {
       assert(*this);
-      return !Owner->NodeAdjOwner[NodeId].Neighbors.empty();
+      return !Owner->getNeighborIds(NodeId).empty();
     }
 
-    [[nodiscard]] bool getNumNeighbors() const noexcept {
+    [[nodiscard]] size_t getNumNeighbors() const noexcept {
       assert(*this);
-      return Owner->NodeAdjOwner[NodeId].Neighbors.size();
+      return Owner->getNeighborIds(NodeId).size();
     }
 
     [[nodiscard]] auto neighbors() const noexcept {
       assert(*this);
 
-      return llvm::map_range(Owner->NodeAdjOwner[NodeId].Neighbors,
-                             [Owner{Owner}](size_t NBIdx) {
+      return llvm::map_range(Owner->getNeighborIds(NodeId),
+                             [Owner{Owner}](id_t NBIdx) {
                                assert(NBIdx != Node::NoPredId);
                                return NodeRef(NBIdx, Owner);
                              });
@@ -138,17 +149,19 @@ public:
     }
 
   private:
-    explicit NodeRef(size_t NodeId, const ExplodedSuperGraph *Owner) noexcept
+    explicit NodeRef(id_t NodeId, const ExplodedSuperGraph *Owner) noexcept
         : NodeId(NodeId), Owner(Owner) {}
 
-    size_t NodeId = Node::NoPredId;
+    id_t NodeId = Node::NoPredId;
     const ExplodedSuperGraph *Owner{};
   };
 
   class BuildNodeRef {
+    friend ExplodedSuperGraph;
+
   public:
     [[nodiscard]] NodeRef operator()(size_t NodeId) const noexcept {
-      return NodeRef(NodeId, Owner);
+      return NodeRef(id_t(NodeId), Owner);
     }
 
   private:
@@ -171,19 +184,17 @@ public:
   ~ExplodedSuperGraph() = default;
 
   [[nodiscard]] NodeRef getNodeOrNull(n_t Inst, d_t Fact) const {
-    auto It = FlowFactVertexMap.find(
-        std::make_pair(std::move(Inst), std::move(Fact)));
-    if (It != FlowFactVertexMap.end()) {
-      return NodeRef(It->second, this);
+    if (auto NodeId = getNodeIdOrNull(std::move(Inst), std::move(Fact))) {
+      return NodeRef(*NodeId, this);
     }
     return nullptr;
   }
 
   [[nodiscard]] NodeRef fromNodeId(size_t NodeId) const noexcept {
-    assert(NodeDataOwner.size() == NodeAdjOwner.size());
+    assert(NodeDataOwner.size() == PredecessorOwner.size());
     assert(NodeId < NodeDataOwner.size());
 
-    return NodeRef(NodeId, this);
+    return NodeRef(id_t(NodeId), this);
   }
 
   [[nodiscard]] ByConstRef<d_t> getZeroValue() const noexcept {
@@ -193,52 +204,93 @@ public:
   template <typename Container>
   void saveEdges(n_t Curr, d_t CurrNode, n_t Succ, const Container &SuccNodes,
                  ESGEdgeKind Kind) {
-    auto PredId = getNodeIdOrNull(Curr, std::move(CurrNode));
+    if (LLVM_UNLIKELY(IsFinalized)) {
+      unfinalize();
+    }
+
+    auto PredId = getNodeIdOrNull(Curr, CurrNode);
 
     /// The Identity CTR-flow on the zero-value has no meaning at all regarding
     /// path sensitivity, so skip it
     bool MaySkipEdge = Kind == ESGEdgeKind::CallToRet && CurrNode == ZeroValue;
+    auto CurrId = getOrCreateInstId(Curr);
+    auto CurrNodeId = getOrCreateFactId(CurrNode);
+    auto SuccId = getOrCreateInstId(Succ);
     for (const d_t &SuccNode : SuccNodes) {
-      saveEdge(PredId, Curr, CurrNode, Succ, SuccNode, MaySkipEdge);
+      saveEdge(PredId, CurrId, CurrNodeId, SuccId, getOrCreateFactId(SuccNode),
+               MaySkipEdge);
+    }
+  }
+
+  /// Compacts the neighbor lists into a CSR representation and releases the
+  /// excess capacity of the ESG. Call this after the analysis has been solved.
+  /// Adding more edges afterwards is still possible, but reverts the
+  /// compaction.
+  void finalize() {
+    if (IsFinalized) {
+      return;
+    }
+
+    NeighborOffsets.assign(NodeDataOwner.size() + 1, 0);
+    for (const auto &[NodeId, NBs] : PendingNeighbors) {
+      NeighborOffsets[NodeId + 1] = id_t(NBs.size());
     }
+    std::partial_sum(NeighborOffsets.begin(), NeighborOffsets.end(),
+                     NeighborOffsets.begin());
+
+    NeighborOwner.resize(NeighborOffsets.back());
+    for (const auto &[NodeId, NBs] : PendingNeighbors) {
+      llvm::copy(NBs, std::next(NeighborOwner.begin(),
+                                ptrdiff_t(NeighborOffsets[NodeId])));
+    }
+
+    PendingNeighbors = decltype(PendingNeighbors)();
+    NodeDataOwner.shrink_to_fit();
+    PredecessorOwner.shrink_to_fit();
+    Insts.shrink_to_fit();
+    Facts.shrink_to_fit();
+    IsFinalized = true;
   }
 
+  [[nodiscard]] bool isFinalized() const noexcept { return IsFinalized; }
+
   // NOLINTNEXTLINE(readability-identifier-naming)
   [[nodiscard]] auto node_begin() const noexcept {
-    assert(NodeAdjOwner.size() == NodeDataOwner.size());
+    assert(PredecessorOwner.size() == NodeDataOwner.size());
     return llvm::map_iterator(
         llvm::seq(size_t(0), NodeDataOwner.size()).begin(), BuildNodeRef(this));
   }
   // NOLINTNEXTLINE(readability-identifier-naming)
   [[nodiscard]] auto node_end() const noexcept {
-    assert(NodeAdjOwner.size() == NodeDataOwner.size());
+    assert(PredecessorOwner.size() == NodeDataOwner.size());
     return llvm::map_iterator(llvm::seq(size_t(0), NodeDataOwner.size()).end(),
                               BuildNodeRef(this));
   }
   [[nodiscard]] auto nodes() const noexcept {
-    assert(NodeAdjOwner.size() == NodeDataOwner.size());
+    assert(PredecessorOwner.size() == NodeDataOwner.size());
     return llvm::map_range(llvm::seq(size_t(0), NodeDataOwner.size()),
                            BuildNodeRef(this));
   }
 
   [[nodiscard]] size_t size() const noexcept {
-    assert(NodeAdjOwner.size() == NodeDataOwner.size());
+    assert(PredecessorOwner.size() == NodeDataOwner.size());
     return NodeDataOwner.size();
   }
 
   /// Printing:
 
   void printAsDot(llvm::raw_ostream &OS) const {
-    assert(NodeAdjOwner.size() == NodeDataOwner.size());
+    assert(PredecessorOwner.size() == NodeDataOwner.size());
     OS << "digraph ESG{\n";
     psr::scope_exit ClosingBrace = [&OS] { OS << '}'; };
 
     for (size_t I = 0, End = NodeDataOwner.size(); I != End; ++I) {
-      auto Nod = NodeRef(I, this);
+      auto Nod = fromNodeId(I);
       OS << I << "[label=\"";
       OS.write_escaped(DToString(Nod.value())) << "\"];\n";
 
-      OS << I << "->" << intptr_t(Nod.predecessor().id())
+      auto Pred = Nod.predecessor();
+      OS << I << "->" << (Pred ? intptr_t(Pred.id()) : intptr_t(-1))
          << R"([style="bold" label=")";
       OS.write_escaped(NToString(Nod.source())) << "\"];\n";
       for (auto NB : Nod.neighbors()) {
@@ -253,63 +305,265 @@ public:
   }
 
   void printESGNodes(llvm::raw_ostream &OS) const {
-    for (const auto &[Node, _] : FlowFactVertexMap) {
-      OS << "( " << NToString(Node.first) << "; " << DToString(Node.second)
-         << " )\n";
+    for (const auto &[Key, _] : FlowFactVertexMap) {
+      OS << "( " << NToString(Insts[Key >> 32]) << "; "
+         << DToString(Facts[id_t(Key)]) << " )\n";
     }
   }
 
+  /// Serialization:
+  ///
+  /// The ESG can be written to disk and loaded again in a different process,
+  /// e.g., to answer path queries separately from the analysis. As only the
+  /// interned instructions and flow facts refer to the analyzed program,
+  /// NToJson and DToJson (and JsonToN and JsonToD for loading) translate
+  /// between them and a stable representation, such as the metadata-ids of
+  /// LLVM values (see getMetaDataID()).
+
+  template <typename NToJsonFn, typename DToJsonFn>
+  [[nodiscard]] nlohmann::json getAsJson(NToJsonFn &&NToJson,
+                                         DToJsonFn &&DToJson) const {
+    nlohmann::json JInsts = nlohmann::json::array();
+    for (const auto &Inst : Insts) {
+      JInsts.push_back(std::invoke(NToJson, Inst));
+    }
+    nlohmann::json JFacts = nlohmann::json::array();
+    for (const auto &Fact : Facts) {
+      JFacts.push_back(std::invoke(DToJson, Fact));
+    }
+
+    std::vector<id_t> NodeFacts;
+    std::vector<id_t> NodeInsts;
+    NodeFacts.reserve(NodeDataOwner.size());
+    NodeInsts.reserve(NodeDataOwner.size());
+    for (const auto &Nod : NodeDataOwner) {
+      NodeFacts.push_back(Nod.FactId);
+      NodeInsts.push_back(Nod.InstId);
+    }
+
+    std::vector<id_t> NBOffsets;
+    std::vector<id_t> NBs;
+    NBOffsets.reserve(NodeDataOwner.size() + 1);
+    NBOffsets.push_back(0);
+    for (size_t I = 0, End = NodeDataOwner.size(); I != End; ++I) {
+      auto NBIds = getNeighborIds(id_t(I));
+      NBs.insert(NBs.end(), NBIds.begin(), NBIds.end());
+      NBOffsets.push_back(id_t(NBs.size()));
+    }
+
+    std::vector<uint64_t> VertexKeys;
+    std::vector<id_t> VertexIds;
+    VertexKeys.reserve(FlowFactVertexMap.size());
+    VertexIds.reserve(FlowFactVertexMap.size());
+    for (const auto &[Key, NodeId] : FlowFactVertexMap) {
+      VertexKeys.push_back(Key);
+      VertexIds.push_back(NodeId);
+    }
+
+    return {
+        {"ZeroValue", std::invoke(DToJson, ZeroValue)},
+        {"Insts", std::move(JInsts)},
+        {"Facts", std::move(JFacts)},
+        {"NodeFacts", std::move(NodeFacts)},
+        {"NodeInsts", std::move(NodeInsts)},
+        {"Predecessors", PredecessorOwner},
+        {"NeighborOffsets", std::move(NBOffsets)},
+        {"Neighbors", std::move(NBs)},
+        {"VertexKeys", std::move(VertexKeys)},
+        {"VertexIds", std::move(VertexIds)},
+    };
+  }
+
+  template <typename NToJsonFn, typename DToJsonFn>
+  void printAsJson(llvm::raw_ostream &OS, NToJsonFn &&NToJson,
+                   DToJsonFn &&DToJson) const {
+    OS << getAsJson(std::forward<NToJsonFn>(NToJson),
+                    std::forward<DToJsonFn>(DToJson));
+  }
+
+  /// Loads an ESG that has previously been serialized with getAsJson(). The
+  /// returned ESG is finalized.
+  template <typename JsonToNFn, typename JsonToDFn>
+  [[nodiscard]] static ExplodedSuperGraph
+  fromJson(const nlohmann::json &J, JsonToNFn &&JsonToN, JsonToDFn &&JsonToD) {
+    ExplodedSuperGraph Ret(std::invoke(JsonToD, J.at("ZeroValue")));
+
+    for (const auto &JInst : J.at("Insts")) {
+      Ret.getOrCreateInstId(std::invoke(JsonToN, JInst));
+    }
+    for (const auto &JFact : J.at("Facts")) {
+      Ret.getOrCreateFactId(std::invoke(JsonToD, JFact));
+    }
+    if (Ret.Insts.size() != J.at("Insts").size() ||
+        Ret.Facts.size() != J.at("Facts").size()) {
+      llvm::report_fatal_error(
+          "Invalid serialized ESG: The instructions or flow facts do not map "
+          "to distinct objects");
+    }
+
+    auto NodeFacts = J.at("NodeFacts").get<std::vector<id_t>>();
+    auto NodeInsts = J.at("NodeInsts").get<std::vector<id_t>>();
+    Ret.PredecessorOwner = J.at("Predecessors").get<std::vector<id_t>>();
+    Ret.NeighborOffsets = J.at("NeighborOffsets").get<std::vector<id_t>>();
+    Ret.NeighborOwner = J.at("Neighbors").get<std::vector<id_t>>();
+    auto VertexKeys = J.at("VertexKeys").get<std::vector<uint64_t>>();
+    auto VertexIds = J.at("VertexIds").get<std::vector<id_t>>();
+
+    auto NumNodes = NodeFacts.size();
+    if (NodeInsts.size() != NumNodes ||
+        Ret.PredecessorOwner.size() != NumNodes ||
+        Ret.NeighborOffsets.size() != NumNodes + 1 ||
+        Ret.NeighborOffsets.back() != Ret.NeighborOwner.size() ||
+        VertexKeys.size() != VertexIds.size()) {
+      llvm::report_fatal_error("Invalid serialized ESG: Inconsistent sizes");
+    }
+
+    auto NumInsts = Ret.Insts.size();
+    auto NumFacts = Ret.Facts.size();
+    auto IsInstId = [NumInsts](id_t Id) { return Id < NumInsts; };
+    auto IsFactId = [NumFacts](id_t Id) { return Id < NumFacts; };
+    auto IsNodeId = [NumNodes](id_t Id) { return Id < NumNodes; };
+    auto IsPredId = [NumNodes](id_t Id) {
+      return Id < NumNodes || Id == Node::NoPredId;
+    };
+
+    if (!llvm::all_of(NodeInsts, IsInstId) ||
+        !llvm::all_of(NodeFacts, IsFactId)) {
+      llvm::report_fatal_error(
+          "Invalid serialized ESG: Node refers to an unknown instruction or "
+          "flow fact");
+    }
+    if (!llvm::all_of(Ret.PredecessorOwner, IsPredId) ||
+        !llvm::all_of(Ret.NeighborOwner, IsNodeId) ||
+        !llvm::all_of(VertexIds, IsNodeId)) {
+      llvm::report_fatal_error(
+          "Invalid serialized ESG: Reference to a non-existing node");
+    }
+    if (Ret.NeighborOffsets.front() != 0 ||
+        !llvm::is_sorted(Ret.NeighborOffsets)) {
+      llvm::report_fatal_error(
+          "Invalid serialized ESG: Neighbor offsets are not ascending");
+    }
+    for (auto Key : VertexKeys) {
+      if (!IsInstId(id_t(Key >> 32)) || !IsFactId(id_t(Key))) {
+        llvm::report_fatal_error(
+            "Invalid serialized ESG: Vertex refers to an unknown instruction "
+            "or flow fact");
+      }
+    }
+
+    Ret.NodeDataOwner.reserve(NumNodes);
+    for (size_t I = 0; I != NumNodes; ++I) {
+      Ret.NodeDataOwner.push_back({NodeFacts[I], NodeInsts[I]});
+    }
+
+    Ret.FlowFactVertexMap.reserve(VertexKeys.size());
+    for (size_t I = 0, End = VertexKeys.size(); I != End; ++I) {
+      Ret.FlowFactVertexMap.try_emplace(VertexKeys[I], VertexIds[I]);
+    }
+
+    Ret.IsFinalized = true;
+    return Ret;
+  }
+
 private:
-  struct PathInfoHash {
-    size_t operator()(const std::pair<n_t, d_t> &ND) const {
-      return std::hash<n_t>()(ND.first) * 31 + std::hash<d_t>()(ND.second);
+  [[nodiscard]] static uint64_t getVertexKey(id_t InstId,
+                                             id_t FactId) noexcept {
+    return (uint64_t(InstId) << 32) | FactId;
+  }
+
+  id_t getOrCreateInstId(ByConstRef<n_t> Inst) {
+    auto [It, Inserted] = InstIds.try_emplace(Inst, id_t(Insts.size()));
+    if (Inserted) {
+      assert(Insts.size() < Node::NoPredId);
+      Insts.push_back(Inst);
     }
-  };
+    return It->second;
+  }
 
-  struct PathInfoEq {
-    bool operator()(const std::pair<n_t, d_t> &Lhs,
-                    const std::pair<n_t, d_t> &Rhs) const {
-      return Lhs.first == Rhs.first && Lhs.second == Rhs.second;
+  id_t getOrCreateFactId(ByConstRef<d_t> Fact) {
+    auto [It, Inserted] = FactIds.try_emplace(Fact, id_t(Facts.size()));
+    if (Inserted) {
+      assert(Facts.size() < Node::NoPredId);
+      Facts.push_back(Fact);
     }
-  };
+    return It->second;
+  }
 
-  [[nodiscard]] std::optional<size_t> getNodeIdOrNull(n_t Inst,
-                                                      d_t Fact) const {
-    auto It = FlowFactVertexMap.find(
-        std::make_pair(std::move(Inst), std::move(Fact)));
+  [[nodiscard]] std::optional<id_t> getNodeIdOrNull(n_t Inst, d_t Fact) const {
+    auto InstIt = InstIds.find(Inst);
+    if (InstIt == InstIds.end()) {
+      return std::nullopt;
+    }
+    auto FactIt = FactIds.find(Fact);
+    if (FactIt == FactIds.end()) {
+      return std::nullopt;
+    }
+    auto It =
+        FlowFactVertexMap.find(getVertexKey(InstIt->second, FactIt->second));
     if (It != FlowFactVertexMap.end()) {
       return It->second;
     }
     return std::nullopt;
   }
 
-  void saveEdge(std::optional<size_t> PredId, n_t Curr, d_t CurrNode, n_t Succ,
-                d_t SuccNode, bool MaySkipEdge) {
-    auto [SuccVtxIt, Inserted] = FlowFactVertexMap.try_emplace(
-        std::make_pair(Succ, SuccNode), Node::NoPredId);
+  [[nodiscard]] llvm::ArrayRef<id_t> getNeighborIds(id_t NodeId) const {
+    if (IsFinalized) {
+      assert(size_t(NodeId) + 1 < NeighborOffsets.size());
+      return llvm::ArrayRef<id_t>(NeighborOwner)
+          .slice(NeighborOffsets[NodeId],
+                 NeighborOffsets[NodeId + 1] - NeighborOffsets[NodeId]);
+    }
+    auto It = PendingNeighbors.find(NodeId);
+    if (It == PendingNeighbors.end()) {
+      return {};
+    }
+    return It->second;
+  }
 
-    // Save a reference into the FlowFactVertexMap before the SuccVtxIt gets
-    // invalidated
-    auto &SuccVtxNode = SuccVtxIt->second;
+  /// Reverts finalize(), such that new edges can be added
+  void unfinalize() {
+    assert(IsFinalized);
+    for (size_t I = 0, End = NodeDataOwner.size(); I != End; ++I) {
+      auto NBs = getNeighborIds(id_t(I));
+      if (!NBs.empty()) {
+        PendingNeighbors[id_t(I)].append(NBs.begin(), NBs.end());
+      }
+    }
+    NeighborOffsets = {};
+    NeighborOwner = {};
+    IsFinalized = false;
+  }
+
+  void saveEdge(std::optional<id_t> PredId, id_t Curr, id_t CurrNode,
+                id_t Succ, id_t SuccNode, bool MaySkipEdge) {
+    auto SuccKey = getVertexKey(Succ, SuccNode);
+    auto [SuccVtxIt, Inserted] =
+        FlowFactVertexMap.try_emplace(SuccKey, Node::NoPredId);
 
+    // Copy the node-id out of the FlowFactVertexMap, as makeNode() may
+    // invalidate SuccVtxIt
+    auto SuccVtxNode = SuccVtxIt->second;
     // NOLINTNEXTLINE(readability-identifier-naming)
-    auto makeNode = [this, PredId, Curr, &CurrNode, &SuccNode]() mutable {
-      assert(NodeAdjOwner.size() == NodeDataOwner.size());
-      auto Ret = NodeDataOwner.size();
+    auto setSuccVtxNode = [this, SuccKey](id_t NodeId) {
+      FlowFactVertexMap[SuccKey] = NodeId;
+    };
+
+    // NOLINTNEXTLINE(readability-identifier-naming)
+    auto makeNode = [this, PredId, Curr, CurrNode, SuccNode]() {
+      assert(PredecessorOwner.size() == NodeDataOwner.size());
+      assert(NodeDataOwner.size() < Node::NoPredId);
+      auto Ret = id_t(NodeDataOwner.size());
 
-      auto &NodData = NodeDataOwner.emplace_back();
-      auto &NodAdj = NodeAdjOwner.emplace_back();
-      NodData.Value = SuccNode;
+      NodeDataOwner.push_back({SuccNode, Curr});
+      PredecessorOwner.push_back(PredId.value_or(Node::NoPredId));
 
       if (!PredId) {
         // For the seeds: Just that the FlowFactVertexMap is filled at that
         // position...
-        FlowFactVertexMap[std::make_pair(Curr, CurrNode)] = Ret;
+        FlowFactVertexMap[getVertexKey(Curr, CurrNode)] = Ret;
       }
 
-      NodAdj.PredecessorIdx = PredId.value_or(Node::NoPredId);
-      NodData.Source = Curr;
-
       return Ret;
     };
 
@@ -318,19 +572,20 @@ private:
       // We still want to create the destination node for the ret-FF later
       assert(PredId);
       if (Inserted) {
-        SuccVtxNode = makeNode();
-        NodeAdjOwner.back().PredecessorIdx = Node::NoPredId;
+        setSuccVtxNode(makeNode());
+        PredecessorOwner.back() = Node::NoPredId;
       }
       return;
     }
 
-    if (PredId && NodeDataOwner[*PredId].Value == SuccNode &&
-        NodeDataOwner[*PredId].Source->getParent() == Succ->getParent() &&
-        SuccNode != ZeroValue) {
+    if (PredId && NodeDataOwner[*PredId].FactId == SuccNode &&
+        Insts[NodeDataOwner[*PredId].InstId]->getParent() ==
+            Insts[Succ]->getParent() &&
+        Facts[SuccNode] != ZeroValue) {
 
       // Identity edge, we don't need a new node; just assign the Pred here
       if (Inserted) {
-        SuccVtxNode = *PredId;
+        setSuccVtxNode(*PredId);
         return;
       }
 
@@ -341,7 +596,7 @@ private:
     }
 
     if (Inserted) {
-      SuccVtxNode = makeNode();
+      setSuccVtxNode(makeNode());
       return;
     }
 
@@ -349,9 +604,8 @@ private:
     // connecting with the pred. Now, we have a non-skippable edge to connect to
     NodeRef SuccVtx(SuccVtxNode, this);
     if (!SuccVtx.predecessor()) {
-      NodeAdjOwner[SuccVtxNode].PredecessorIdx =
-          PredId.value_or(Node::NoPredId);
-      NodeDataOwner[SuccVtxNode].Source = Curr;
+      PredecessorOwner[SuccVtxNode] = PredId.value_or(Node::NoPredId);
+      NodeDataOwner[SuccVtxNode].InstId = Curr;
       return;
     }
 
@@ -363,15 +617,29 @@ private:
                       })) {
 
       auto NewNode = makeNode();
-      NodeAdjOwner[SuccVtxNode].Neighbors.push_back(NewNode);
+      PendingNeighbors[SuccVtxNode].push_back(NewNode);
       return;
     }
   }
 
   std::vector<NodeData> NodeDataOwner;
-  std::vector<NodeAdj> NodeAdjOwner;
-  std::unordered_map<std::pair<n_t, d_t>, size_t, PathInfoHash, PathInfoEq>
-      FlowFactVertexMap{};
+  std::vector<id_t> PredecessorOwner;
+
+  /// The neighbors while building the ESG
+  llvm::DenseMap<id_t, llvm::SmallVector<id_t, 2>> PendingNeighbors;
+  /// The neighbors in CSR representation after finalize(): The neighbors of
+  /// node I are NeighborOwner[NeighborOffsets[I] .. NeighborOffsets[I + 1]]
+  std::vector<id_t> NeighborOffsets;
+  std::vector<id_t> NeighborOwner;
+  bool IsFinalized = false;
+
+  std::vector<n_t> Insts;
+  std::unordered_map<n_t, id_t> InstIds;
+  std::vector<d_t> Facts;
+  std::unordered_map<d_t, id_t> FactIds;
+
+  /// Maps (InstId, FactId) to the respective node-id
+  llvm::DenseMap<uint64_t, id_t> FlowFactVertexMap;
 
   // ZeroValue
   d_t ZeroValue;
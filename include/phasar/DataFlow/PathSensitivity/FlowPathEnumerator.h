@@ -0,0 +1,307 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_DATAFLOW_PATHSENSITIVITY_FLOWPATHENUMERATOR_H
+#define PHASAR_DATAFLOW_PATHSENSITIVITY_FLOWPATHENUMERATOR_H
+
+#include "phasar/Utils/GraphTraits.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/ErrorHandling.h"
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+enum class PathEnumerationOrder {
+  /// Enumerates the paths in the order of a depth-first traversal of the DAG.
+  /// Only needs memory proportional to the depth of the DAG.
+  DepthFirst,
+  /// Enumerates the paths with the least number of nodes first. Needs memory
+  /// proportional to the number of explored partial paths.
+  ShortestFirst,
+};
+
+/// A path filter that accepts all paths.
+///
+/// A path filter checks the feasibility of (partial) paths incrementally. The
+/// FlowPathEnumerator calls saveEdge() for each pair of adjacent nodes on the
+/// path, isValid() to check a partial path, and saveFinalEdge() once a
+/// complete path has been reached. saveState() and restoreState() bracket the
+/// nodes added for one vertex of the DAG, such that the filter can roll back
+/// to the state of a shorter prefix.
+struct AcceptAllPathFilter {
+  constexpr void saveState() const noexcept {}
+  constexpr void restoreState() const noexcept {}
+  template <typename N>
+  constexpr void saveEdge(const N & /*Prev*/,
+                          const N & /*Curr*/) const noexcept {}
+  [[nodiscard]] constexpr bool isValid() const noexcept { return true; }
+  template <typename N>
+  constexpr bool saveFinalEdge(const N & /*Prev*/,
+                               const N & /*FinalInst*/) const noexcept {
+    return true;
+  }
+};
+
+/// Lazily enumerates the paths through a reversed paths-DAG, as created by the
+/// PathSensitivityManagerMixin, one at a time.
+///
+/// Each path starts at a root of the DAG and ends at a vertex without
+/// successors. It is the concatenation of the (reversed) node-tags of the
+/// vertices along the way. Partial paths that the Filter rejects are not
+/// extended any further.
+///
+/// In contrast to materializing all paths in a FlowPathSequence, consumers can
+/// stop after any number of paths, e.g., after the first witness.
+template <typename GraphType, typename FilterT = AcceptAllPathFilter>
+class FlowPathEnumerator {
+public:
+  using graph_type = GraphType;
+  using graph_traits_t = GraphTraits<graph_type>;
+  using vertex_t = typename graph_traits_t::vertex_t;
+  using n_t = typename graph_traits_t::value_type::value_type;
+
+  /// RevDAG must outlive the enumerator and must not be modified while
+  /// enumerating. FinalInst is passed to Filter.saveFinalEdge() for each
+  /// complete path.
+  explicit FlowPathEnumerator(
+      const graph_type &RevDAG, n_t FinalInst = n_t{}, FilterT Filter = {},
+      PathEnumerationOrder Order = PathEnumerationOrder::DepthFirst)
+      : RevDAG(RevDAG), Filter(std::move(Filter)), FinalInst(FinalInst),
+        Order(Order) {
+    if (Order == PathEnumerationOrder::ShortestFirst) {
+      for (auto Rt : graph_traits_t::roots(RevDAG)) {
+        pushPrefix(Rt, 0, NoParent);
+      }
+    }
+  }
+
+  /// Computes the next path that the filter accepts and passes it to Handler,
+  /// together with the filter. The filter still reflects the state of the
+  /// path, so Handler can extract information from it, e.g., a model.
+  /// The path is only valid during the call to Handler.
+  ///
+  /// \returns false, iff there are no more paths
+  template <typename HandlerFn> bool next(HandlerFn &&Handler) {
+    bool Found = Order == PathEnumerationOrder::DepthFirst
+                     ? nextDepthFirst(Handler)
+                     : nextShortestFirst(Handler);
+    NumPathsEmitted += Found;
+    return Found;
+  }
+
+  /// Calls Handler for each of the remaining paths, until Handler returns
+  /// false (if it returns bool at all)
+  template <typename HandlerFn> void forEach(HandlerFn &&Handler) {
+    bool Continue = true;
+    auto Wrapper = [&Handler, &Continue](llvm::ArrayRef<n_t> Path, FilterT &F) {
+      if constexpr (std::is_invocable_r_v<bool, HandlerFn, llvm::ArrayRef<n_t>,
+                                          FilterT &>) {
+        Continue = std::invoke(Handler, Path, F);
+      } else {
+        std::invoke(Handler, Path, F);
+      }
+    };
+    while (Continue && next(Wrapper)) {
+    }
+  }
+
+  /// Restricts the complete paths to the ones that end at Leaf. Reaching any
+  /// other vertex without successors is a fatal error, as it indicates a
+  /// malformed DAG. Must be called before the first call to next().
+  void setLeaf(vertex_t Leaf) noexcept { this->Leaf = Leaf; }
+
+  [[nodiscard]] FilterT &getFilter() noexcept { return Filter; }
+  [[nodiscard]] const FilterT &getFilter() const noexcept { return Filter; }
+
+  [[nodiscard]] size_t getNumPathsEmitted() const noexcept {
+    return NumPathsEmitted;
+  }
+
+private:
+  static constexpr uint32_t NoParent = UINT32_MAX;
+
+  struct Frame {
+    vertex_t Vtx;
+    size_t NextEdge;
+    size_t PathSize;
+    n_t PrevSave;
+    bool Exhausted;
+  };
+
+  struct Prefix {
+    vertex_t Vtx;
+    uint32_t Parent;
+  };
+
+  [[nodiscard]] bool isLeaf(vertex_t Vtx) const {
+    if (graph_traits_t::outDegree(RevDAG, Vtx) != 0) {
+      return false;
+    }
+    if (Leaf && Vtx != *Leaf) {
+      llvm::report_fatal_error("Non-leaf node has no successors!");
+    }
+    return true;
+  }
+
+  void appendNode(vertex_t Vtx) {
+    for (const auto &Inst : llvm::reverse(graph_traits_t::node(RevDAG, Vtx))) {
+      CurrPath.push_back(Inst);
+      if (HasPrev) {
+        Filter.saveEdge(Prev, Inst);
+      }
+      Prev = Inst;
+      HasPrev = true;
+    }
+  }
+
+  /// \returns true, iff Vtx is a leaf that completes a valid path
+  bool enter(vertex_t Vtx) {
+    Stack.push_back({Vtx, 0, CurrPath.size(), Prev, false});
+    Filter.saveState();
+    appendNode(Vtx);
+
+    auto &Top = Stack.back();
+    if (isLeaf(Vtx)) {
+      Top.Exhausted = true;
+      return Filter.saveFinalEdge(Prev, FinalInst);
+    }
+    Top.Exhausted = !Filter.isValid();
+    return false;
+  }
+
+  void leave() {
+    auto &Top = Stack.back();
+    Filter.restoreState();
+    CurrPath.resize(Top.PathSize);
+    Prev = Top.PrevSave;
+    HasPrev = !CurrPath.empty();
+    Stack.pop_back();
+  }
+
+  template <typename HandlerFn> bool nextDepthFirst(HandlerFn &Handler) {
+    auto Roots = graph_traits_t::roots(RevDAG);
+    while (true) {
+      vertex_t Succ{};
+      if (Stack.empty()) {
+        if (NextRoot == size_t(llvm::size(Roots))) {
+          return false;
+        }
+        Succ = *std::next(llvm::adl_begin(Roots), NextRoot++);
+      } else {
+        auto &Top = Stack.back();
+        if (Top.Exhausted ||
+            Top.NextEdge == graph_traits_t::outDegree(RevDAG, Top.Vtx)) {
+          leave();
+          continue;
+        }
+        auto Edges = graph_traits_t::outEdges(RevDAG, Top.Vtx);
+        Succ = graph_traits_t::target(
+            *std::next(llvm::adl_begin(Edges), Top.NextEdge++));
+      }
+
+      if (enter(Succ)) {
+        std::invoke(Handler, llvm::ArrayRef<n_t>(CurrPath), Filter);
+        leave();
+        return true;
+      }
+    }
+  }
+
+  void pushPrefix(vertex_t Vtx, size_t ParentLength, uint32_t Parent) {
+    auto Length = ParentLength + llvm::size(graph_traits_t::node(RevDAG, Vtx));
+    auto Idx = uint32_t(Prefixes.size());
+    Prefixes.push_back({Vtx, Parent});
+    Queue.emplace(Length, Idx);
+  }
+
+  /// Re-builds the path and the filter-state for the prefix with index Idx
+  /// from scratch.
+  /// \returns Whether the filter accepts the prefix
+  bool replay(uint32_t Idx) {
+    llvm::SmallVector<vertex_t> Vertices;
+    for (; Idx != NoParent; Idx = Prefixes[Idx].Parent) {
+      Vertices.push_back(Prefixes[Idx].Vtx);
+    }
+
+    CurrPath.clear();
+    HasPrev = false;
+    Filter.saveState();
+    for (auto Vtx : llvm::reverse(Vertices)) {
+      appendNode(Vtx);
+    }
+    if (isLeaf(Vertices.front())) {
+      return Filter.saveFinalEdge(Prev, FinalInst);
+    }
+    return Filter.isValid();
+  }
+
+  template <typename HandlerFn> bool nextShortestFirst(HandlerFn &Handler) {
+    while (!Queue.empty()) {
+      auto [Length, Idx] = Queue.top();
+      Queue.pop();
+
+      bool Valid = replay(Idx);
+      auto Vtx = Prefixes[Idx].Vtx;
+      if (Valid && isLeaf(Vtx)) {
+        std::invoke(Handler, llvm::ArrayRef<n_t>(CurrPath), Filter);
+        Filter.restoreState();
+        return true;
+      }
+      Filter.restoreState();
+
+      if (Valid) {
+        for (auto Edge : graph_traits_t::outEdges(RevDAG, Vtx)) {
+          pushPrefix(graph_traits_t::target(Edge), Length, Idx);
+        }
+      }
+    }
+
+    // All paths have been enumerated, so the prefixes are no longer needed
+    Prefixes.clear();
+    Prefixes.shrink_to_fit();
+    return false;
+  }
+
+  const graph_type &RevDAG;
+  FilterT Filter;
+  n_t FinalInst{};
+  PathEnumerationOrder Order{};
+  std::optional<vertex_t> Leaf{};
+
+  llvm::SmallVector<n_t, 0> CurrPath;
+  n_t Prev{};
+  bool HasPrev = false;
+  size_t NumPathsEmitted = 0;
+
+  // DepthFirst
+  llvm::SmallVector<Frame, 0> Stack;
+  size_t NextRoot = 0;
+
+  // ShortestFirst
+  std::vector<Prefix> Prefixes;
+  std::priority_queue<std::pair<size_t, uint32_t>,
+                      std::vector<std::pair<size_t, uint32_t>>,
+                      std::greater<>>
+      Queue;
+};
+
+} // namespace psr
+
+#endif // PHASAR_DATAFLOW_PATHSENSITIVITY_FLOWPATHENUMERATOR_H
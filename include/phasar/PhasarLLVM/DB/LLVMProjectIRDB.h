@@ -26,6 +26,7 @@
 #include "llvm/Support/raw_ostream.h"
 
 #include <memory>
+#include <optional>
 
 namespace psr {
 class LLVMProjectIRDB;
@@ -96,6 +97,16 @@ public:
     return Id < IdToInst.size() ? IdToInst[Id] : nullptr;
   }
 
+  /// The inverse of getValueFromId(): Returns the id of the instruction or
+  /// global variable V
+  [[nodiscard]] std::optional<size_t>
+  getValueId(const llvm::Value *V) const noexcept {
+    if (auto It = InstToId.find(V); It != InstToId.end()) {
+      return It->second;
+    }
+    return std::nullopt;
+  }
+
   void emitPreprocessedIR(llvm::raw_ostream &OS) const;
 
   /// Insert a new function F into the IRDB. F should be present in the same
@@ -254,7 +254,7 @@ public:
                       llvm::raw_ostream &OS = llvm::outs()) override;
 
 private:
-  LLVMAliasInfoRef PT{};
+  LLVMCachedAliasInfo PT{};
   const LLVMBasedICFG *ICF{};
 
   /// Save all leaks here that were found using the IFDS part if the analysis.
@@ -332,7 +332,7 @@ public:
         //
         return this->generateFlowIf(
             Load, [PointerOp = Load->getPointerOperand(),
-                   PTS = PT.getReachableAllocationSites(
+                   PTS = PT.getSharedReachableAllocationSites(
                        Load->getPointerOperand(), OnlyConsiderLocalAliases)](
                       d_t Src) { return Src == PointerOp || PTS->count(Src); });
       }
@@ -357,7 +357,7 @@ public:
         //             0  x  Y
         //
         return this->lambdaFlow(
-            [Store, PointerPTS = PT.getReachableAllocationSites(
+            [Store, PointerPTS = PT.getSharedReachableAllocationSites(
                         Store->getPointerOperand(), OnlyConsiderLocalAliases,
                         Store)](d_t Src) -> container_type {
               if (Store->getPointerOperand() == Src || PointerPTS->count(Src)) {
@@ -1270,7 +1270,7 @@ private:
       IIAAKillOrReplaceEFCache;
 
   const LLVMBasedICFG *ICF{};
-  LLVMAliasInfoRef PT{};
+  LLVMCachedAliasInfo PT{};
   std::function<EdgeFactGeneratorTy> EdgeFactGen;
   static inline const bool OnlyConsiderLocalAliases = true;
 
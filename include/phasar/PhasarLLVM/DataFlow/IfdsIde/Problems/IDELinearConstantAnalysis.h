@@ -117,6 +117,10 @@ public:
   EdgeFunction<l_t> getSummaryEdgeFunction(n_t Curr, d_t CurrNode, n_t Succ,
                                            d_t SuccNode) override;
 
+  /// Folds chains of additions, subtractions and multiplications with
+  /// constants into a single affine edge function or a constant
+  EdgeFunction<l_t> normalizeEdgeFunction(EdgeFunction<l_t> EF) override;
+
   // Helper functions
 
   [[nodiscard]] lca_results_t getLCAResults(SolverResults<n_t, d_t, l_t> SR);
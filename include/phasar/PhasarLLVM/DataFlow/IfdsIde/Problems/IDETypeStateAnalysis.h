@@ -102,11 +102,9 @@ protected:
   /**
    * @brief Returns whole-module aliases of V.
    *
-   * This function retrieves whole-module points-to information. We store
-   * already computed points-to information in a cache to prevent expensive
-   * recomputation since the whole module points-to graph can be huge. This
-   * might become unnecessary once PhASAR's AliasGraph starts using a cache
-   * itself.
+   * This function retrieves whole-module points-to information. Already
+   * computed alias sets are cached by PT to prevent expensive recomputation
+   * since the whole module points-to graph can be huge.
    */
   container_type getWMAliasSet(d_t V);
 
@@ -132,8 +130,7 @@ private:
 
   bool hasMatchingTypeName(const llvm::Type *Ty);
 
-  std::map<const llvm::Value *, LLVMAliasInfo::AliasSetTy> AliasCache;
-  LLVMAliasInfoRef PT{};
+  LLVMCachedAliasInfo PT{};
   std::map<const llvm::Value *, std::set<const llvm::Value *>>
       RelevantAllocaCache;
 };
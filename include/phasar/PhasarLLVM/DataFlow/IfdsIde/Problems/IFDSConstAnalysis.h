@@ -204,7 +204,7 @@ public:
                                                   f_t Context);
 
 private:
-  LLVMAliasInfoRef PT{};
+  LLVMCachedAliasInfo PT{};
   // Holds all allocated memory locations, including global variables
   std::set<d_t> AllMemLocs; // FIXME: initialize within the constructor body!
   // Holds all initialized variables and objects.
@@ -85,7 +85,7 @@ public:
 
 private:
   const LLVMTaintConfig *Config{};
-  LLVMAliasInfoRef PT{};
+  LLVMCachedAliasInfo PT{};
   bool TaintMainArgs{};
 
   bool isSourceCall(const llvm::CallBase *CB,
@@ -95,7 +95,7 @@ private:
                        const llvm::Function *Callee) const;
 
   void populateWithMayAliases(container_type &Facts,
-                              const llvm::Instruction *Context) const;
+                              const llvm::Instruction *Context);
   void populateWithMustAliases(container_type &Facts,
                                const llvm::Instruction *Context) const;
 };
@@ -22,9 +22,10 @@
 #include "phasar/PhasarLLVM/Domain/LLVMAnalysisDomain.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMAliasInfo.h"
 #include "phasar/PhasarLLVM/TaintConfig/LLVMTaintConfig.h"
-#include "phasar/Utils/BitVectorSet.h"
+#include "phasar/Utils/DenseBitSet.h"
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 
@@ -40,7 +41,7 @@ namespace psr {
 class LLVMTypeHierarchy;
 
 struct InterMonoTaintAnalysisDomain : LLVMAnalysisDomainDefault {
-  using mono_container_t = BitVectorSet<LLVMAnalysisDomainDefault::d_t>;
+  using mono_container_t = DenseBitSet<LLVMAnalysisDomainDefault::d_t>;
 };
 
 class InterMonoTaintAnalysis
@@ -68,6 +69,8 @@ public:
   bool equal_to(const mono_container_t &Lhs,
                 const mono_container_t &Rhs) override;
 
+  mono_container_t allTop() override;
+
   mono_container_t normalFlow(n_t Inst, const mono_container_t &In) override;
 
   mono_container_t callFlow(n_t CallSite, f_t Callee,
@@ -87,6 +90,10 @@ public:
 private:
   [[maybe_unused]] const LLVMTaintConfig &Config;
   std::map<n_t, std::set<d_t>> Leaks;
+  /// Bit-positions of all values that may become tainted; filled up front.
+  /// Shared with the computed sets, such that they outlive this problem.
+  std::shared_ptr<DenseBitSetIndex<d_t>> FactIndex =
+      std::make_shared<DenseBitSetIndex<d_t>>();
 };
 
 } // namespace psr
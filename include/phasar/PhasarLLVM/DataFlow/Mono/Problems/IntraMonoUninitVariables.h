@@ -13,8 +13,9 @@
 #include "phasar/DataFlow/Mono/IntraMonoProblem.h"
 #include "phasar/PhasarLLVM/Domain/LLVMAnalysisDomain.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMAliasInfo.h"
+#include "phasar/Utils/DenseBitSet.h"
 
-#include <set>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -33,7 +34,7 @@ class LLVMBasedCFG;
 class LLVMBasedICFG;
 
 struct IntraMonoUninitVariablesDomain : LLVMAnalysisDomainDefault {
-  using mono_container_t = std::set<LLVMAnalysisDomainDefault::d_t>;
+  using mono_container_t = DenseBitSet<LLVMAnalysisDomainDefault::d_t>;
 };
 
 class IntraMonoUninitVariables
@@ -65,6 +66,13 @@ public:
   mono_container_t normalFlow(n_t Inst, const mono_container_t &In) override;
 
   std::unordered_map<n_t, mono_container_t> initialSeeds() override;
+
+private:
+  /// Bit-positions of the tracked allocas; filled up front with the allocas
+  /// of all entry points. Shared with the computed sets, such that they
+  /// outlive this problem.
+  std::shared_ptr<DenseBitSetIndex<d_t>> FactIndex =
+      std::make_shared<DenseBitSetIndex<d_t>>();
 };
 
 } // namespace psr
@@ -12,15 +12,20 @@
 
 #include "phasar/Utils/MaybeUniquePtr.h"
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallVector.h"
 
 #include "z3++.h"
 
+#include <chrono>
 #include <optional>
+#include <unordered_map>
+#include <utility>
 
 namespace llvm {
 class Value;
 class Instruction;
+class Function;
 class AllocaInst;
 class LoadInst;
 class GetElementPtrInst;
@@ -32,6 +37,12 @@ class CallBase;
 } // namespace llvm
 
 namespace psr {
+/// Translates the conditions of the branches in an LLVM module into z3::exprs.
+///
+/// All translations are memoized for the lifetime of this object, such that
+/// multiple path queries over the same code only pay for the translation
+/// once. Before the IR changes, the affected translations must be dropped
+/// with invalidate().
 class LLVMPathConstraints {
 public:
   struct ConstraintAndVariables {
@@ -39,12 +50,27 @@ public:
     llvm::SmallVector<const llvm::Value *, 4> Variables;
   };
 
+  struct Statistics {
+    /// The number of edges, for which a constraint has been requested
+    size_t NumEdgeQueries = 0;
+    /// The number of edges that needed to be translated
+    size_t NumEdgeTranslations = 0;
+    /// The number of edges, for which the memoized translation was used
+    size_t NumEdgeCacheHits = 0;
+    /// The total time spent in translating edges
+    std::chrono::nanoseconds TranslationTime{};
+  };
+
   explicit LLVMPathConstraints(z3::context *Z3Ctx = nullptr,
                                bool IgnoreDebugInstructions = true);
 
   z3::context &getContext() noexcept { return *Z3Ctx; }
   const z3::context &getContext() const noexcept { return *Z3Ctx; }
 
+  [[nodiscard]] bool ignoresDebugInstructions() const noexcept {
+    return IgnoreDebugInstructions;
+  }
+
   std::optional<z3::expr> getConstraintFromEdge(const llvm::Instruction *Curr,
                                                 const llvm::Instruction *Succ);
 
@@ -52,7 +78,24 @@ public:
   getConstraintAndVariablesFromEdge(const llvm::Instruction *Curr,
                                     const llvm::Instruction *Succ);
 
+  /// Drops all memoized translations of instructions and arguments of F.
+  ///
+  /// Call this *before* modifying F: The memoized translations are found by
+  /// looking at the function of their instructions and arguments, which are
+  /// dangling once they have been erased from F.
+  void invalidate(const llvm::Function *F);
+  /// Drops all memoized translations
+  void invalidateAll() noexcept;
+
+  [[nodiscard]] const Statistics &getStatistics() const noexcept {
+    return Stats;
+  }
+
 private:
+  [[nodiscard]] const std::optional<ConstraintAndVariables> &
+  getOrCreateEdgeConstraint(const llvm::Instruction *From,
+                            const llvm::Instruction *To);
+
   [[nodiscard]] std::optional<ConstraintAndVariables>
   internalGetConstraintAndVariablesFromEdge(const llvm::Instruction *From,
                                             const llvm::Instruction *To);
@@ -90,6 +133,13 @@ private:
 
   MaybeUniquePtr<z3::context> Z3Ctx;
   std::unordered_map<const llvm::Value *, ConstraintAndVariables> Z3Expr;
+  /// The (deduplicated) constraints of all queried edges that start at a
+  /// conditional branch
+  llvm::DenseMap<
+      std::pair<const llvm::Instruction *, const llvm::Instruction *>,
+      std::optional<ConstraintAndVariables>>
+      EdgeConstraints;
+  Statistics Stats;
   bool IgnoreDebugInstructions;
 };
 } // namespace psr
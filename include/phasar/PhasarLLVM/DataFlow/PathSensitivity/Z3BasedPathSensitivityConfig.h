@@ -20,6 +20,10 @@ namespace psr {
 struct Z3BasedPathSensitivityConfig
     : PathSensitivityConfigBase<Z3BasedPathSensitivityConfig> {
   std::optional<z3::expr> AdditionalConstraint;
+  /// The number of threads that check the feasibility of the paths
+  /// concurrently. With NumThreads == 0, uses one thread per available
+  /// hardware thread; with NumThreads == 1, all paths are checked sequentially
+  unsigned NumThreads = 1;
 
   [[nodiscard]] Z3BasedPathSensitivityConfig
   withAdditionalConstraint(const z3::expr &Constr) const &noexcept {
@@ -35,6 +39,13 @@ struct Z3BasedPathSensitivityConfig
         AdditionalConstraint ? *AdditionalConstraint && Constr : Constr;
     return std::move(*this);
   }
+
+  [[nodiscard]] Z3BasedPathSensitivityConfig
+  withNumThreads(unsigned NumThreads) const noexcept {
+    auto Ret = *this;
+    Ret.NumThreads = NumThreads;
+    return Ret;
+  }
 };
 } // namespace psr
 
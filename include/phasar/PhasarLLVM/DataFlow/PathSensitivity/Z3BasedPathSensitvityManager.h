@@ -11,6 +11,7 @@
 #define PHASAR_PHASARLLVM_PATHSENSITIVITY_Z3BASEDPATHSENSITIVITYMANAGER_H
 
 #include "phasar/DataFlow/PathSensitivity/FlowPath.h"
+#include "phasar/DataFlow/PathSensitivity/FlowPathEnumerator.h"
 #include "phasar/DataFlow/PathSensitivity/PathSensitivityManagerBase.h"
 #include "phasar/DataFlow/PathSensitivity/PathSensitivityManagerMixin.h"
 #include "phasar/PhasarLLVM/DataFlow/PathSensitivity/Z3BasedPathSensitivityConfig.h"
@@ -22,6 +23,7 @@
 
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -30,15 +32,18 @@
 #include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <system_error>
 #include <type_traits>
 
 namespace llvm {
 class Instruction;
+class Function;
 } // namespace llvm
 
 namespace psr {
 class LLVMPathConstraints;
+class Z3ConstraintCache;
 
 class Z3BasedPathSensitivityManagerBase
     : public PathSensitivityManagerBase<const llvm::Instruction *> {
@@ -48,15 +53,82 @@ public:
   static_assert(is_removable_graph_trait_v<graph_traits_t>,
                 "Invalid graph type: Must support edge-removal!");
 
+  /// A lazily computed sequence of feasible flow paths.
+  ///
+  /// Each call to next() continues the enumeration of the paths DAG where the
+  /// previous call stopped, checking the feasibility of the partial paths
+  /// incrementally. Hence, the memory consumption does not depend on the
+  /// number of paths. In contrast to pathsTo(), the paths are not
+  /// deduplicated.
+  ///
+  /// The stream refers to the LLVMPathConstraints and the Z3ConstraintCache of
+  /// the manager that created it, so they must outlive the stream.
+  class FlowPathStream {
+  public:
+    FlowPathStream(FlowPathStream &&) noexcept;
+    FlowPathStream &operator=(FlowPathStream &&) noexcept;
+    ~FlowPathStream();
+
+    /// Computes the next feasible path, or std::nullopt if there are no more
+    /// paths, or Config.NumPathsThreshold paths have already been computed
+    [[nodiscard]] std::optional<FlowPath<n_t>> next();
+
+    [[nodiscard]] size_t getNumPathsEmitted() const noexcept;
+
+  private:
+    friend class Z3BasedPathSensitivityManagerBase;
+    struct Impl;
+
+    explicit FlowPathStream(std::unique_ptr<Impl> PImpl) noexcept;
+
+    std::unique_ptr<Impl> PImpl;
+  };
+
 protected:
+  [[nodiscard]] static vertex_t getLeaf(const graph_type &Dag) {
+    for (auto Vtx : graph_traits_t::vertices(Dag)) {
+      if (graph_traits_t::outDegree(Dag, Vtx) == 0) {
+        return Vtx;
+      }
+    }
+    llvm_unreachable("Expect the DAG to have a leaf node!");
+  }
+
   z3::expr filterOutUnreachableNodes(graph_type &RevDAG, vertex_t Leaf,
                                      const Z3BasedPathSensitivityConfig &Config,
-                                     LLVMPathConstraints &LPC) const;
+                                     LLVMPathConstraints &LPC,
+                                     Z3ConstraintCache *Cache) const;
 
   FlowPathSequence<n_t>
-  filterAndFlattenRevDag(graph_type &RevDAG, vertex_t Leaf, n_t FinalInst,
+  filterAndFlattenRevDag(const graph_type &RevDAG, vertex_t Leaf, n_t FinalInst,
                          const Z3BasedPathSensitivityConfig &Config,
-                         LLVMPathConstraints &LPC) const;
+                         LLVMPathConstraints &LPC,
+                         Z3ConstraintCache *Cache) const;
+
+  /// Distributes the roots of RevDAG over Config.NumThreads workers that each
+  /// filter and flatten their part of the DAG with their own z3::context and
+  /// LLVMPathConstraints. The resulting paths are translated back into the
+  /// context of LPC, limited to Config.NumPathsThreshold in the order of their
+  /// roots and deduplicated. Hence, the result is the same as with a single
+  /// thread.
+  ///
+  /// The LLVMPathConstraints of the workers are taken from WorkerLPCs, which
+  /// is extended as needed with the settings of LPC. Passing the same
+  /// WorkerLPCs to multiple calls reuses the memoized constraints between the
+  /// queries.
+  FlowPathSequence<n_t> filterAndFlattenRevDagParallel(
+      const graph_type &RevDAG, vertex_t Leaf, n_t FinalInst,
+      const Z3BasedPathSensitivityConfig &Config, LLVMPathConstraints &LPC,
+      Z3ConstraintCache *Cache,
+      llvm::SmallVectorImpl<std::unique_ptr<LLVMPathConstraints>> &WorkerLPCs)
+      const;
+
+  /// Takes ownership of RevDAG
+  FlowPathStream
+  makeFlowPathStream(graph_type &&RevDAG, vertex_t Leaf, n_t FinalInst,
+                     const Z3BasedPathSensitivityConfig &Config,
+                     LLVMPathConstraints &LPC, Z3ConstraintCache *Cache,
+                     PathEnumerationOrder Order) const;
 
   static void deduplicatePaths(FlowPathSequence<n_t> &Paths);
 };
@@ -82,8 +154,9 @@ public:
 
   explicit Z3BasedPathSensitivityManager(
       const ExplodedSuperGraph<AnalysisDomainTy> *ESG,
-      Z3BasedPathSensitivityConfig Config, LLVMPathConstraints *LPC = nullptr)
-      : mixin_t(ESG), Config(std::move(Config)), LPC(LPC) {
+      Z3BasedPathSensitivityConfig Config, LLVMPathConstraints *LPC = nullptr,
+      Z3ConstraintCache *Cache = nullptr)
+      : mixin_t(ESG), Config(std::move(Config)), LPC(LPC), Cache(Cache) {
     if (!LPC) {
       this->LPC = std::make_unique<LLVMPathConstraints>();
     }
@@ -132,26 +205,26 @@ public:
     }
 #endif
 
-    vertex_t Leaf = [&Dag] {
-      for (auto Vtx : graph_traits_t::vertices(Dag)) {
-        if (graph_traits_t::outDegree(Dag, Vtx) == 0) {
-          return Vtx;
-        }
-      }
-      llvm_unreachable("Expect the DAG to have a leaf node!");
-    }();
+    vertex_t Leaf = getLeaf(Dag);
 
-    z3::expr Constraint = filterOutUnreachableNodes(Dag, Leaf, Config, *LPC);
+    FlowPathSequence<n_t> Ret;
+    if (Config.NumThreads != 1 && Dag.Roots.size() > 1) {
+      Ret = filterAndFlattenRevDagParallel(Dag, Leaf, Inst, Config, *LPC,
+                                           Cache, WorkerLPCs);
+    } else {
+      z3::expr Constraint =
+          filterOutUnreachableNodes(Dag, Leaf, Config, *LPC, Cache);
 
-    if (Constraint.is_false()) {
-      PHASAR_LOG_LEVEL_CAT(INFO, "PathSensitivityManager",
-                           "The query position is unreachable");
-      return FlowPathSequence<n_t>();
-    }
+      if (Constraint.is_false()) {
+        PHASAR_LOG_LEVEL_CAT(INFO, "PathSensitivityManager",
+                             "The query position is unreachable");
+        return FlowPathSequence<n_t>();
+      }
 
-    auto Ret = filterAndFlattenRevDag(Dag, Leaf, Inst, Config, *LPC);
+      Ret = filterAndFlattenRevDag(Dag, Leaf, Inst, Config, *LPC, Cache);
 
-    deduplicatePaths(Ret);
+      deduplicatePaths(Ret);
+    }
 
 #ifndef NDEBUG
 #ifdef DYNAMIC_LOG
@@ -176,10 +249,52 @@ public:
     return Ret;
   }
 
+  /// Computes the feasible paths to Inst/Fact lazily. This allows stopping
+  /// after the first witness without computing all paths before.
+  FlowPathStream pathsStreamTo(
+      n_t Inst, d_t Fact,
+      PathEnumerationOrder Order = PathEnumerationOrder::DepthFirst) const {
+    graph_type Dag = this->pathsDagTo(Inst, std::move(Fact), Config);
+    vertex_t Leaf = getLeaf(Dag);
+
+    z3::expr Constraint =
+        filterOutUnreachableNodes(Dag, Leaf, Config, *LPC, Cache);
+    if (Constraint.is_false()) {
+      PHASAR_LOG_LEVEL_CAT(INFO, "PathSensitivityManager",
+                           "The query position is unreachable");
+      Dag = graph_type{};
+    }
+
+    return makeFlowPathStream(std::move(Dag), Leaf, Inst, Config, *LPC, Cache,
+                              Order);
+  }
+
+  /// The translation of the IR into Z3 constraints that is shared between
+  /// all queries. Use its statistics to monitor the translation cost.
+  [[nodiscard]] const LLVMPathConstraints &
+  getPathConstraints() const noexcept {
+    return *LPC;
+  }
+
+  /// Drops the memoized constraints of F. Call this before modifying F (see
+  /// LLVMPathConstraints::invalidate())
+  void invalidateConstraints(const llvm::Function *F) {
+    LPC->invalidate(F);
+    for (auto &WorkerLPC : WorkerLPCs) {
+      WorkerLPC->invalidate(F);
+    }
+  }
+
 private:
   Z3BasedPathSensitivityConfig Config{};
   /// FIXME: Not using 'mutable' here
   mutable MaybeUniquePtr<LLVMPathConstraints, true> LPC{};
+  /// The LLVMPathConstraints of the workers that check paths in parallel. We
+  /// keep them between the queries to benefit from their memoization.
+  mutable llvm::SmallVector<std::unique_ptr<LLVMPathConstraints>, 0>
+      WorkerLPCs{};
+  /// Optional; may be shared between multiple managers
+  Z3ConstraintCache *Cache{};
 };
 } // namespace psr
 
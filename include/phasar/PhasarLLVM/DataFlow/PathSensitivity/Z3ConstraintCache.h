@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOW_PATHSENSITIVITY_Z3CONSTRAINTCACHE_H
+#define PHASAR_PHASARLLVM_DATAFLOW_PATHSENSITIVITY_Z3CONSTRAINTCACHE_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "nlohmann/json.hpp"
+#include "z3++.h"
+
+#include <cstddef>
+#include <mutex>
+
+namespace psr {
+
+/// Caches the outcomes of Z3 satisfiability checks of path constraints.
+///
+/// The top-level conjuncts of the asserted constraints are interned as atoms
+/// by their SMT-LIB representation, such that two conjuncts get the same atom
+/// if and only if they are structurally equal. A set of asserted constraints
+/// is identified by the set of its atoms. Besides the outcome of each checked
+/// set, the cache records an unsatisfiable core for each unsatisfiable set.
+/// Any set of constraints that includes a known core is unsatisfiable without
+/// asking the solver. As the atoms only depend on the shape of the
+/// constraints, the cache can be shared between z3::contexts and persisted
+/// across runs on the same program.
+///
+/// The cache is thread-safe; the solvers that are passed to check() are not
+/// shared.
+class Z3ConstraintCache {
+public:
+  Z3ConstraintCache() noexcept = default;
+  /// Loads a cache that has been serialized with getAsJson(). Aborts, if a
+  /// set of constraints refers to an unknown atom.
+  explicit Z3ConstraintCache(const nlohmann::json &SerializedCache);
+
+  Z3ConstraintCache(const Z3ConstraintCache &) = delete;
+  Z3ConstraintCache &operator=(const Z3ConstraintCache &) = delete;
+
+  /// Checks the satisfiability of the constraints that are currently asserted
+  /// in Solver. Calls Solver.check() only if the outcome cannot be derived
+  /// from the cache, or if RequireModel is set and the constraints are
+  /// satisfiable. So, Solver.get_model() may only be called if RequireModel is
+  /// set and the result is z3::sat.
+  z3::check_result check(z3::solver &Solver, bool RequireModel = false);
+
+  /// The number of calls to check()
+  [[nodiscard]] size_t getNumQueries() const;
+  /// The number of checks that have been answered by a recorded outcome
+  [[nodiscard]] size_t getNumHits() const;
+  /// The number of checks that have been answered by an unsatisfiable core
+  [[nodiscard]] size_t getNumCoreHits() const;
+  [[nodiscard]] size_t getNumEntries() const;
+  [[nodiscard]] size_t getNumCores() const;
+  /// The number of distinct conjuncts that have been seen
+  [[nodiscard]] size_t getNumAtoms() const;
+
+  [[nodiscard]] nlohmann::json getAsJson() const;
+  void printAsJson(llvm::raw_ostream &OS = llvm::outs()) const;
+
+private:
+  /// A sorted set of atom ids
+  using KeyTy = llvm::ArrayRef<unsigned>;
+
+  [[nodiscard]] unsigned getOrCreateAtomId(llvm::StringRef Repr);
+  [[nodiscard]] bool includesKnownCore(KeyTy Key) const;
+  [[nodiscard]] KeyTy persist(KeyTy Key);
+  void insertResult(KeyTy Key, bool Sat);
+  void insertCore(KeyTy Core);
+
+  mutable std::mutex Mtx;
+  llvm::BumpPtrAllocator Alloc;
+  llvm::StringMap<unsigned> AtomIds;
+  /// The SMT-LIB representations of the atoms, indexed by their ids. Refer to
+  /// the keys of AtomIds.
+  llvm::SmallVector<llvm::StringRef, 0> Atoms;
+  llvm::DenseMap<KeyTy, bool> Results;
+  llvm::SmallVector<KeyTy, 0> Cores;
+  /// Maps the smallest atom of each core to the indices of the cores
+  llvm::DenseMap<unsigned, llvm::SmallVector<unsigned, 2>> CoresByFirstAtom;
+
+  size_t NumQueries = 0;
+  size_t NumHits = 0;
+  size_t NumCoreHits = 0;
+};
+
+} // namespace psr
+
+#endif // PHASAR_PHASARLLVM_DATAFLOW_PATHSENSITIVITY_Z3CONSTRAINTCACHE_H
@@ -76,8 +76,10 @@ private:
 
   // PTS
   std::optional<nlohmann::json> PrecomputedPTS;
+  std::string PrecomputedPTSBinaryFile;
   AliasAnalysisType PTATy{};
   bool AllowLazyPTS{};
+  unsigned NumPTSThreads = 1;
 
   // ICF
   std::optional<nlohmann::json> PrecomputedCG;
@@ -17,16 +17,23 @@
 #include "nlohmann/json.hpp"
 
 #include <optional>
+#include <string>
 
 namespace psr {
 struct HelperAnalysisConfig {
   std::optional<nlohmann::json> PrecomputedPTS = std::nullopt;
+  /// A file containing alias sets written by LLVMAliasSet::printAsBinary();
+  /// takes precedence over PrecomputedPTS, if not empty
+  std::string PrecomputedPTSBinaryFile{};
   std::optional<nlohmann::json> PrecomputedCG = std::nullopt;
   AliasAnalysisType PTATy = AliasAnalysisType::CFLAnders;
   CallGraphAnalysisType CGTy = CallGraphAnalysisType::OTF;
   Soundness SoundnessLevel = Soundness::Soundy;
   bool AutoGlobalSupport = true;
   bool AllowLazyPTS = true;
+  /// The number of threads used to compute the alias sets if AllowLazyPTS is
+  /// false; 0 means one thread per available hardware thread
+  unsigned NumPTSThreads = 1;
   /// Preprocess a ProjectIRDB even if it gets constructed by an already
   /// existing llvm::Module
   bool PreprocessExistingModule = true;
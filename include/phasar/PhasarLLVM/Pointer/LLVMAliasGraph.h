@@ -23,6 +23,7 @@
 #include "boost/graph/adjacency_list.hpp"
 #include "nlohmann/json.hpp"
 
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -130,6 +131,24 @@ public:
       LLVMProjectIRDB &IRDB, bool UseLazyEvaluation = true,
       AliasAnalysisType PATy = AliasAnalysisType::CFLAnders);
 
+  ~LLVMAliasGraph();
+
+  /**
+   * Analyzes all function definitions of the IRDB and builds a compressed
+   * sparse row (CSR) representation of the points-to graph that is then used
+   * for the reachability queries of getAliasSet(), alias() and
+   * getReachableAllocationSites(). Adding vertices or edges afterwards, e.g.
+   * by introduceAlias() or mergeWith(), drops the CSR representation again.
+   *
+   * @brief Freezes the points-to graph for fast queries.
+   */
+  void freeze();
+
+  /**
+   * @brief Returns true if the queries use the CSR representation.
+   */
+  [[nodiscard]] bool isFrozen() const noexcept { return Frozen != nullptr; }
+
   /**
    * @brief Returns true if graph contains 0 nodes.
    */
@@ -256,13 +275,19 @@ private:
   struct AllocationSiteDFSVisitor;
   struct ReachabilityDFSVisitor;
 
+  /// The points-to graph in CSR format; defined in LLVMAliasGraph.cpp
+  struct FrozenGraph;
+
   /// The points to graph.
   graph_t PAG;
   using ValueVertexMapT = std::unordered_map<const llvm::Value *, vertex_t>;
   ValueVertexMapT ValueVertexMap;
   /// Keep track of what has already been merged into this points-to graph.
   std::unordered_set<const llvm::Function *> AnalyzedFunctions;
+  LLVMProjectIRDB *IRDB{};
   LLVMBasedAliasAnalysis PTA;
+  /// Non-null, if the graph is frozen
+  std::unique_ptr<FrozenGraph> Frozen;
 
   AliasSetOwner<AliasSetTy>::memory_resource_type MRes;
   AliasSetOwner<AliasSetTy> Owner{&MRes};
@@ -11,6 +11,7 @@
 #define PHASAR_PHASARLLVM_POINTER_LLVMALIASINFO_H_
 
 #include "phasar/Pointer/AliasInfo.h"
+#include "phasar/Pointer/CachedAliasInfo.h"
 
 namespace llvm {
 class Function;
@@ -25,6 +26,9 @@ using LLVMAliasInfoRef =
 
 using LLVMAliasInfo = AliasInfo<const llvm::Value *, const llvm::Instruction *>;
 
+using LLVMCachedAliasInfo =
+    CachedAliasInfo<const llvm::Value *, const llvm::Instruction *>;
+
 } // namespace psr
 
 #endif
@@ -16,20 +16,33 @@
 #include "phasar/Pointer/AliasResult.h"
 #include "phasar/Pointer/AliasSetOwner.h"
 #include "phasar/Utils/AnalysisProperties.h"
+#include "phasar/Utils/CompactIdSet.h"
+#include "phasar/Utils/DenseBitSet.h"
+#include "phasar/Utils/DisjointSets.h"
 #include "phasar/Utils/StableVector.h"
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallVector.h"
 
 #include "nlohmann/json.hpp"
 
+#include <memory>
+#include <optional>
 #include <utility>
+#include <vector>
 
 namespace llvm {
 class Value;
 class Instruction;
 class GlobalVariable;
+class GlobalObject;
 class Function;
+class MemoryBuffer;
 } // namespace llvm
 
 namespace psr {
@@ -56,16 +69,39 @@ public:
   /**
    * Creates points-to set(s) for all functions in the IRDB. If
    * UseLazyEvaluation is true, computes points-to-sets for functions that do
-   * not use global variables on the fly
+   * not use global variables on the fly.
+   *
+   * Otherwise, analyzes the functions on NumThreads threads. With
+   * NumThreads == 0, uses one thread per available hardware thread; with
+   * NumThreads == 1, all functions are analyzed sequentially. The resulting
+   * alias sets do not depend on NumThreads.
+   *
+   * With PATy == AliasAnalysisType::Andersen, the alias sets are computed
+   * eagerly from the whole-program LLVMAndersenAliasInfo, instead.
    */
   explicit LLVMAliasSet(LLVMProjectIRDB *IRDB, bool UseLazyEvaluation = true,
-                        AliasAnalysisType PATy = AliasAnalysisType::CFLAnders);
+                        AliasAnalysisType PATy = AliasAnalysisType::CFLAnders,
+                        unsigned NumThreads = 1);
 
   explicit LLVMAliasSet(LLVMProjectIRDB *IRDB,
                         const nlohmann::json &SerializedPTS);
 
+  /**
+   * Loads the alias sets that have previously been written by printAsBinary().
+   * The individual alias sets are only decoded from SerializedPTS when they
+   * are queried, so SerializedPTS should preferably be memory-mapped (as done
+   * by llvm::MemoryBuffer::getFile() for large files).
+   *
+   * If SerializedPTS is malformed or has been computed for a different
+   * module, it is ignored and all alias sets are computed on the fly.
+   */
+  explicit LLVMAliasSet(LLVMProjectIRDB *IRDB,
+                        std::unique_ptr<llvm::MemoryBuffer> SerializedPTS);
+
+  ~LLVMAliasSet();
+
   [[nodiscard]] inline bool isInterProcedural() const noexcept {
-    return false;
+    return getAliasAnalysisType() == AliasAnalysisType::Andersen;
   };
 
   [[nodiscard]] inline AliasAnalysisType getAliasAnalysisType() const noexcept {
@@ -78,6 +114,27 @@ public:
   [[nodiscard]] AliasSetPtrTy getAliasSet(const llvm::Value *V,
                                           const llvm::Instruction *I = nullptr);
 
+  /// Returns the alias set of V as immutable set of value-ids (see
+  /// getValueFromId()).
+  ///
+  /// All values of an alias set share the same CompactIdSet. It needs less
+  /// memory than the DenseSet returned by getAliasSet() and can be intersected
+  /// with other sets of value-ids efficiently. In contrast to getAliasSet(),
+  /// the returned set is a snapshot that does not grow when the alias set is
+  /// merged with another one later.
+  [[nodiscard]] std::shared_ptr<const CompactIdSet>
+  getCompactAliasSet(const llvm::Value *V,
+                     const llvm::Instruction *I = nullptr);
+
+  /// The value-id of V, if V is already contained in an alias set
+  [[nodiscard]] std::optional<uint32_t> getValueId(const llvm::Value *V) const {
+    return ValueIds.lookup(V);
+  }
+
+  [[nodiscard]] const llvm::Value *getValueFromId(uint32_t Id) const {
+    return ValueIds[Id];
+  }
+
   [[nodiscard]] AllocationSiteSetPtrTy
   getReachableAllocationSites(const llvm::Value *V, bool IntraProcOnly = false,
                               const llvm::Instruction *I = nullptr);
@@ -99,10 +156,49 @@ public:
 
   void printAsJson(llvm::raw_ostream &OS = llvm::outs()) const;
 
+  /// Writes the alias sets and analyzed functions in a compact binary format
+  /// that is keyed by the value-ids of the LLVMProjectIRDB and contains a
+  /// fingerprint of the functions, globals and value-ids of the analyzed
+  /// module.
+  void printAsBinary(llvm::raw_ostream &OS) const;
+
   [[nodiscard]] AnalysisProperties getAnalysisProperties() const noexcept {
     return AnalysisProperties::None;
   }
 
+  /// Increases whenever an existing alias set is merged with another one or
+  /// split up, e.g., when lazily analyzing another function. Reachable
+  /// allocation sites and snapshots of alias sets that have been obtained in
+  /// an older generation may be stale.
+  [[nodiscard]] uint64_t getGeneration() const noexcept { return Generation; }
+
+  /**
+   * Removes all alias information that has been derived from F's IR. Call
+   * this before changing F's IR or erasing F from the module, because it still
+   * reads F's IR. After changing F, call insertFunction(F).
+   *
+   * Only the alias sets that contain values used by F or by its (transitive)
+   * callers are split up, as the callers' alias sets depend on F's summary.
+   * The callers and the other functions that have contributed to these alias
+   * sets are re-analyzed by the next call to insertFunction() or the next
+   * alias query. Aliases that have
+   * been added by introduceAlias() are retained, unless they refer to F's
+   * values, whereas the ones that have been added by mergeWith() or loaded
+   * from a serialized LLVMAliasSet are recomputed from the IR.
+   *
+   * Alias sets that have been handed out by getAliasSet() before are no longer
+   * updated. With AliasAnalysisType::Andersen, all alias sets are recomputed.
+   */
+  void eraseFunction(const llvm::Function *F);
+
+  /**
+   * Computes the alias sets of F, which has been added to the module after
+   * constructing this LLVMAliasSet (see LLVMProjectIRDB::insertFunction()), or
+   * whose IR has been changed after calling eraseFunction(F). Updates the alias
+   * sets of the globals that F uses.
+   */
+  void insertFunction(llvm::Function *F);
+
   /**
    * Shows a parts of an alias set. Good for debugging when one wants to peak
    * into a points to set.
@@ -128,11 +224,23 @@ private:
 
   void computeFunctionsAliasSet(llvm::Function *F);
 
-  void addSingletonAliasSet(const llvm::Value *V);
+  void computeFunctionsAliasSetsInParallel(LLVMProjectIRDB &IRDB,
+                                           AliasAnalysisType PATy,
+                                           unsigned NumThreads);
+
+  /// Returns the id of V
+  uint32_t addSingletonAliasSet(const llvm::Value *V);
 
   void mergeAliasSets(const llvm::Value *V1, const llvm::Value *V2);
 
-  void mergeAliasSets(BoxedPtr<AliasSetTy> PTS1, BoxedPtr<AliasSetTy> PTS2);
+  void mergeAliasSets(uint32_t Id1, uint32_t Id2);
+
+  /// Creates the alias set of the partition with representative Root as
+  /// DenseSet, if not already done
+  [[nodiscard]] BoxedPtr<AliasSetTy> materializeAliasSet(uint32_t Root);
+
+  [[nodiscard]] bool inSameAliasSet(const llvm::Value *V1,
+                                    const llvm::Value *V2) const;
 
   bool interIsReachableAllocationSiteTy(const llvm::Value *V,
                                         const llvm::Value *P) const;
@@ -142,19 +250,97 @@ private:
                                         const llvm::Function *VFun,
                                         const llvm::GlobalObject *VG) const;
 
-  /// Utility function used by computeFunctionsAliasSet(...)
-  void addPointer(llvm::AAResults &AA, const llvm::DataLayout &DL,
-                  const llvm::Value *V, std::vector<const llvm::Value *> &Reps);
+  /// The representatives of the alias sets within one function; defined in
+  /// LLVMAliasSet.cpp
+  class Representatives;
+
+  /// The alias sets of a single function that are computed without touching
+  /// the LLVMAliasSet; defined in LLVMAliasSet.cpp
+  class FunctionAliasSets;
+
+  /// Merges the alias sets of one function into this LLVMAliasSet
+  void addFunctionAliasSets(const FunctionAliasSets &FunSets);
+
+  /// Builds the alias sets of all functions from the points-to sets of the
+  /// LLVMAndersenAliasInfo
+  void computeAndersenAliasSets(const LLVMProjectIRDB &IRDB);
+
+  /// The alias sets loaded from printAsBinary()'s output that are decoded on
+  /// demand; defined in LLVMAliasSet.cpp
+  class BinaryImage;
+
+  /// Adds the alias set of V that is stored in the Image to the Partition,
+  /// if not already done. Id is the value-id of V.
+  void decodeAliasSetOf(const llvm::Value *V, uint32_t Id);
+
+  /// Calls Handler with the members of every alias set, including the ones
+  /// that are not yet decoded from the Image
+  void forEachAliasSet(
+      llvm::function_ref<void(llvm::ArrayRef<const llvm::Value *>)> Handler)
+      const;
 
   [[nodiscard]] static BoxedPtr<AliasSetTy> getEmptyAliasSet();
 
+  /// Decodes all alias sets that are still in the Image and drops the Image
+  void decodeAllAliasSets();
+
+  /// Splits the alias set with representative Root into singletons
+  void dissolveAliasSet(uint32_t Root);
+
+  /// Splits all alias sets into singletons, such that they are recomputed from
+  /// scratch by completePendingUpdates()
+  void invalidateAllAliasSets();
+
+  /// Re-analyzes the functions and globals whose alias sets have been split up
+  /// by eraseFunction() or insertFunction()
+  void completePendingUpdates();
+
+  [[nodiscard]] bool isErased(uint32_t Id) const noexcept {
+    return Id < ErasedIds.size() && ErasedIds.test(Id);
+  }
+
+  LLVMProjectIRDB *IRDB{};
   LLVMBasedAliasAnalysis PTA;
   llvm::DenseSet<const llvm::Function *> AnalyzedFunctions;
 
+  /// The values that have an alias set
+  DenseBitSetIndex<const llvm::Value *> ValueIds;
+  /// The alias sets as partition of the value-ids
+  DisjointSets Partition;
+
   AliasSetOwner<AliasSetTy>::memory_resource_type MRes;
   AliasSetOwner<AliasSetTy> Owner{&MRes};
 
-  AliasSetMap AliasSets;
+  /// The alias sets that have been handed out as DenseSet, keyed by their
+  /// representative in the Partition. All boxes of one entry point to the same
+  /// set, which is kept up-to-date when merging.
+  llvm::DenseMap<uint32_t, llvm::SmallVector<BoxedPtr<AliasSetTy>, 1>>
+      MaterializedSets;
+
+  /// The alias sets that have been handed out as CompactIdSet, keyed by their
+  /// representative in the Partition. Merging two alias sets drops their
+  /// entries.
+  llvm::DenseMap<uint32_t, std::shared_ptr<const CompactIdSet>> CompactSets;
+
+  /// Non-null, if this LLVMAliasSet has been loaded from printAsBinary()'s
+  /// output
+  std::unique_ptr<BinaryImage> Image;
+
+  /// The value-ids of the values that have been removed by eraseFunction().
+  /// Their values may be dangling and are not part of any alias set anymore.
+  llvm::BitVector ErasedIds;
+
+  /// The aliases that have been added by introduceAlias(). They are re-added
+  /// after recomputing alias sets.
+  std::vector<std::pair<const llvm::Value *, const llvm::Value *>>
+      IntroducedAliases;
+
+  /// The functions and globals to re-analyze by completePendingUpdates()
+  llvm::SetVector<const llvm::Function *> PendingFunctions;
+  llvm::SetVector<const llvm::GlobalObject *> PendingGlobals;
+  bool HasPendingUpdates = false;
+
+  uint64_t Generation = 0;
 };
 
 static_assert(IsAliasInfo<LLVMAliasSet>);
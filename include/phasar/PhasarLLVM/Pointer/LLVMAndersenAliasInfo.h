@@ -0,0 +1,218 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_POINTER_LLVMANDERSENALIASINFO_H
+#define PHASAR_PHASARLLVM_POINTER_LLVMANDERSENALIASINFO_H
+
+#include "phasar/Pointer/AliasAnalysisType.h"
+#include "phasar/Pointer/AliasInfoBase.h"
+#include "phasar/Pointer/AliasInfoTraits.h"
+#include "phasar/Pointer/AliasResult.h"
+#include "phasar/Pointer/AliasSetOwner.h"
+#include "phasar/Utils/AnalysisProperties.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/SparseBitVector.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "nlohmann/json.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace llvm {
+class Value;
+class Instruction;
+} // namespace llvm
+
+namespace psr {
+
+class LLVMAndersenAliasInfo;
+class LLVMProjectIRDB;
+
+template <>
+struct AliasInfoTraits<LLVMAndersenAliasInfo>
+    : DefaultAATraits<const llvm::Value *, const llvm::Instruction *> {};
+
+/// A whole-program, field-sensitive, inclusion-based (Andersen-style)
+/// points-to analysis.
+///
+/// Solves the subset-constraints of all functions in the IRDB at once, such
+/// that the results are inter-procedural and indirect calls are resolved
+/// while solving. In each round, cycles in the constraint graph are collapsed
+/// and only the newly added points-to information is propagated in
+/// topological order (wave propagation). The points-to sets are sparse
+/// bit-vectors over abstract objects; each allocation site, global and
+/// function has one abstract object per (flattened) field, where arrays are
+/// collapsed into their element.
+///
+/// Memory that is not part of the module is modeled by a single unknown
+/// object. It contains the objects whose address escapes, i.e., that is
+/// passed to an external function or converted to an integer, and everything
+/// that is reachable from them. Pointers that are created from integers and
+/// the results of external functions may point to the unknown object and to
+/// all escaped objects, and external functions may store such pointers into
+/// the memory that is passed to them. A call to a heap-allocating function is
+/// treated as allocation site, instead.
+class LLVMAndersenAliasInfo
+    : public AnalysisPropertiesMixin<LLVMAndersenAliasInfo>,
+      public AliasInfoBaseUtils {
+public:
+  using traits_t = AliasInfoTraits<LLVMAndersenAliasInfo>;
+  using n_t = traits_t::n_t;
+  using v_t = traits_t::v_t;
+  using AliasSetTy = traits_t::AliasSetTy;
+  using AliasSetPtrTy = traits_t::AliasSetPtrTy;
+  using AllocationSiteSetPtrTy = traits_t::AllocationSiteSetPtrTy;
+
+  /// Computes the points-to sets of all pointers in the IRDB's module
+  explicit LLVMAndersenAliasInfo(const LLVMProjectIRDB &IRDB);
+
+  LLVMAndersenAliasInfo(const LLVMAndersenAliasInfo &) = delete;
+  LLVMAndersenAliasInfo &operator=(const LLVMAndersenAliasInfo &) = delete;
+  LLVMAndersenAliasInfo(LLVMAndersenAliasInfo &&) = delete;
+  LLVMAndersenAliasInfo &operator=(LLVMAndersenAliasInfo &&) = delete;
+  ~LLVMAndersenAliasInfo();
+
+  [[nodiscard]] bool isInterProcedural() const noexcept { return true; }
+
+  [[nodiscard]] AliasAnalysisType getAliasAnalysisType() const noexcept {
+    return AliasAnalysisType::Andersen;
+  }
+
+  /// V1 and V2 may alias, if they may point to the same field of an abstract
+  /// object. Pointers that are not part of the analyzed module may alias
+  /// everything.
+  [[nodiscard]] AliasResult alias(const llvm::Value *V1, const llvm::Value *V2,
+                                  const llvm::Instruction *I = nullptr);
+
+  /// All analyzed pointers that may alias V. In contrast to LLVMAliasSet, this
+  /// relation is not transitive. The returned set is a snapshot that is not
+  /// updated by introduceAlias() or mergeWith().
+  [[nodiscard]] AliasSetPtrTy getAliasSet(const llvm::Value *V,
+                                          const llvm::Instruction *I = nullptr);
+
+  [[nodiscard]] AllocationSiteSetPtrTy
+  getReachableAllocationSites(const llvm::Value *V, bool IntraProcOnly = false,
+                              const llvm::Instruction *I = nullptr);
+
+  // Checks if PotentialValue is in the reachable allocation sites of V.
+  [[nodiscard]] bool isInReachableAllocationSites(
+      const llvm::Value *V, const llvm::Value *PotentialValue,
+      bool IntraProcOnly = false, const llvm::Instruction *I = nullptr);
+
+  /// Adds the points-to sets of Other, which must have been computed for the
+  /// same module, to the ones of this
+  void mergeWith(const LLVMAndersenAliasInfo &Other);
+
+  /// Makes V1 and V2 share their points-to sets from now on
+  void introduceAlias(const llvm::Value *V1, const llvm::Value *V2,
+                      const llvm::Instruction *I = nullptr,
+                      AliasResult Kind = AliasResult::MustAlias);
+
+  /// The allocation sites, globals and functions that V may point to,
+  /// irrespective of the field. Contains nullptr, if V may point to unknown
+  /// memory.
+  [[nodiscard]] llvm::SmallVector<const llvm::Value *>
+  getPointsToSet(const llvm::Value *V) const;
+
+  /// Calls Handler for every analyzed pointer with its non-empty points-to set
+  /// (see getPointsToSet())
+  void forEachPointsToSet(
+      llvm::function_ref<void(const llvm::Value *,
+                              llvm::ArrayRef<const llvm::Value *>)>
+          Handler) const;
+
+  void print(llvm::raw_ostream &OS = llvm::outs()) const;
+
+  [[nodiscard]] nlohmann::json getAsJson() const;
+
+  void printAsJson(llvm::raw_ostream &OS = llvm::outs()) const;
+
+  [[nodiscard]] AnalysisProperties getAnalysisProperties() const noexcept {
+    return AnalysisProperties::FieldSensitive;
+  }
+
+  [[nodiscard]] size_t getNumAbstractObjects() const noexcept {
+    return Objects.size();
+  }
+
+private:
+  /// Builds and solves the constraint-graph; defined in
+  /// LLVMAndersenAliasInfo.cpp
+  class Solver;
+
+  struct AbstractObject {
+    const llvm::Value *Site{};
+    /// The node of the first field; the fields are numbered contiguously
+    uint32_t FirstNode{};
+    uint32_t NumFields{};
+  };
+
+  static constexpr uint32_t NoObject = UINT32_MAX;
+
+  /// Adds a node with an empty points-to set
+  uint32_t makeNode();
+
+  /// Adds the abstract object of Site and returns the node of its first field
+  uint32_t makeObject(const llvm::Value *Site, uint32_t NumFields);
+
+  [[nodiscard]] uint32_t findRep(uint32_t Node) const noexcept;
+
+  /// The points-to set of V, or null if V is no analyzed pointer
+  [[nodiscard]] const llvm::SparseBitVector<> *
+  getPointsToBits(const llvm::Value *V) const;
+
+  [[nodiscard]] const AbstractObject &objectOf(uint32_t Node) const {
+    return Objects[NodeObjects[Node]];
+  }
+
+  /// Builds the ReversePointsTo index, if not already done
+  void buildReversePointsTo();
+
+  /// Drops all caches that depend on the points-to sets
+  void invalidateCaches();
+
+  const LLVMProjectIRDB *IRDB{};
+
+  /// The node of each analyzed pointer
+  llvm::DenseMap<const llvm::Value *, uint32_t> ValueNodes;
+  /// The representative of each node; nodes with the same representative
+  /// share their points-to set
+  llvm::SmallVector<uint32_t, 0> Reps;
+  /// The points-to sets of the representatives as set of object-nodes
+  std::vector<llvm::SparseBitVector<>> PointsTo;
+  std::vector<AbstractObject> Objects;
+  /// The index into Objects for each allocation site, global and function
+  llvm::DenseMap<const llvm::Value *, uint32_t> SiteObjects;
+  /// The index into Objects for object-nodes, NoObject otherwise
+  llvm::SmallVector<uint32_t, 0> NodeObjects;
+
+  /// For each object-node, the representatives of the analyzed pointers that
+  /// may point to it; built on demand
+  llvm::DenseMap<uint32_t, llvm::SmallVector<uint32_t, 2>> ReversePointsTo;
+  /// The analyzed pointers per representative; built on demand
+  llvm::DenseMap<uint32_t, llvm::SmallVector<const llvm::Value *, 1>>
+      RepMembers;
+  bool HasReversePointsTo = false;
+
+  AliasSetOwner<AliasSetTy>::memory_resource_type MRes;
+  AliasSetOwner<AliasSetTy> Owner{&MRes};
+  /// The alias sets that have been handed out, keyed by representative
+  llvm::DenseMap<uint32_t, BoxedPtr<AliasSetTy>> AliasSets;
+};
+
+static_assert(IsAliasInfo<LLVMAndersenAliasInfo>);
+
+} // namespace psr
+
+#endif // PHASAR_PHASARLLVM_POINTER_LLVMANDERSENALIASINFO_H
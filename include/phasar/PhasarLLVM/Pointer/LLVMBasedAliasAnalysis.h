@@ -48,8 +48,22 @@ public:
     return AAInfos.lookup(F);
   };
 
+  /// Same as getAAResults(F), but additionally computes everything that the
+  /// alias analyses would otherwise compute on the first query and that
+  /// registers value-handles in the LLVMContext.
+  ///
+  /// Afterwards, alias queries within F only read the IR, so multiple
+  /// LLVMBasedAliasAnalysis instances can be queried concurrently for
+  /// different functions. Calls to this function and to erase() must still be
+  /// synchronized.
+  [[nodiscard]] llvm::AAResults *
+  getAAResultsForConcurrentQueries(llvm::Function *F);
+
   void erase(llvm::Function *F) noexcept;
 
+  /// Drops all alias information, including the summaries of functions that
+  /// are shared between the alias information of their callers. Call this
+  /// after changing the IR of a function.
   void clear() noexcept;
 
   [[nodiscard]] inline AliasAnalysisType
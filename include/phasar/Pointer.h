@@ -16,6 +16,7 @@
 #include "phasar/Pointer/AliasInfoTraits.h"
 #include "phasar/Pointer/AliasResult.h"
 #include "phasar/Pointer/AliasSetOwner.h"
+#include "phasar/Pointer/CachedAliasInfo.h"
 #include "phasar/Pointer/PointsToInfo.h"
 #include "phasar/Pointer/PointsToInfoBase.h"
 
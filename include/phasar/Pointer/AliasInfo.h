@@ -10,6 +10,7 @@
 #ifndef PHASAR_POINTER_ALIASINFO_H
 #define PHASAR_POINTER_ALIASINFO_H
 
+#include "phasar/Pointer/AliasInfoBase.h"
 #include "phasar/Pointer/AliasInfoTraits.h"
 #include "phasar/Pointer/AliasResult.h"
 #include "phasar/Utils/AnalysisProperties.h"
@@ -23,6 +24,7 @@
 
 #include "nlohmann/json.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <type_traits>
 
@@ -173,6 +175,14 @@ public:
     return VT->GetAnalysisProperties(AA);
   }
 
+  /// Changes whenever alias information that has been handed out before may
+  /// have become stale. Constant for alias infos that do not provide a
+  /// getGeneration() member function (see HasGeneration).
+  [[nodiscard]] uint64_t getGeneration() const noexcept {
+    assert(VT != nullptr);
+    return VT->GetGeneration(AA);
+  }
+
   template <typename T> [[nodiscard]] bool isa() const noexcept {
     return VT == &VTableFor<T>;
   }
@@ -206,6 +216,7 @@ private:
     void (*IntroduceAlias)(void *, ByConstRef<v_t>, ByConstRef<v_t>,
                            ByConstRef<n_t>, AliasResult);
     AnalysisProperties (*GetAnalysisProperties)(const void *) noexcept;
+    uint64_t (*GetGeneration)(const void *) noexcept;
     llvm::StringRef (*TypeName)() noexcept;
     void (*Destroy)(const void *) noexcept;
   };
@@ -258,6 +269,13 @@ private:
       [](const void *AA) noexcept {
         return static_cast<const ConcreteAA *>(AA)->getAnalysisProperties();
       },
+      [](const void *AA) noexcept -> uint64_t {
+        if constexpr (HasGeneration<ConcreteAA>) {
+          return static_cast<const ConcreteAA *>(AA)->getGeneration();
+        } else {
+          return 0;
+        }
+      },
       []() noexcept { return llvm::getTypeName<ConcreteAA>(); },
       [](const void *AA) noexcept {
         delete static_cast<const ConcreteAA *>(AA);
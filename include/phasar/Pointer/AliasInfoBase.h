@@ -73,10 +73,23 @@ struct IsAliasInfo<
         decltype(testAliasInfo(std::declval<T &>(),
                                std::declval<const T &>()))>>> : std::true_type {
 };
+
+template <typename T, typename = void>
+struct HasGeneration : std::false_type {};
+template <typename T>
+struct HasGeneration<
+    T, std::void_t<decltype(std::declval<const T &>().getGeneration())>>
+    : std::true_type {};
 } // namespace detail
 
 template <typename T> PSR_CONCEPT IsAliasInfo = detail::IsAliasInfo<T>::value;
 
+/// Whether the alias info T has a member function getGeneration() that
+/// changes whenever alias information that has been handed out before may
+/// have become stale, e.g., because T computes its results lazily.
+template <typename T>
+PSR_CONCEPT HasGeneration = detail::HasGeneration<T>::value;
+
 } // namespace psr
 
 #endif // PHASAR_POINTER_ALIASINFOBASE_H
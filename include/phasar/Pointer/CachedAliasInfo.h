@@ -0,0 +1,247 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_POINTER_CACHEDALIASINFO_H
+#define PHASAR_POINTER_CACHEDALIASINFO_H
+
+#include "phasar/Pointer/AliasInfo.h"
+#include "phasar/Pointer/AliasInfoBase.h"
+#include "phasar/Pointer/AliasInfoTraits.h"
+#include "phasar/Pointer/AliasResult.h"
+#include "phasar/Utils/AnalysisProperties.h"
+#include "phasar/Utils/ByRef.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "nlohmann/json.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace psr {
+
+template <typename V, typename N> class CachedAliasInfo;
+
+template <typename V, typename N>
+struct AliasInfoTraits<CachedAliasInfo<V, N>> : DefaultAATraits<V, N> {};
+
+/// Memoizes the alias sets and reachable allocation sites that are queried
+/// from an AliasInfoRef, such that repeated queries for the same pointer
+/// neither go through the type-erased interface nor recompute the reachable
+/// allocation sites. Use this in data-flow problems that query alias
+/// information while constructing flow- and edge functions.
+///
+/// If the underlying alias information is not flow-sensitive, the queries
+/// are cached independent of the instruction they are asked at.
+///
+/// Changes to the underlying alias information that are made through
+/// introduceAlias() or mergeWith() of this class invalidate the caches. So do
+/// changes that the underlying alias information reports through its
+/// getGeneration(), e.g., when a lazily evaluated LLVMAliasSet analyzes
+/// another function. When changing an underlying alias information that does
+/// not have a getGeneration() directly, call clear().
+///
+/// Implements the IsAliasInfo interface itself, so it can be passed on as
+/// AliasInfoRef.
+template <typename V, typename N>
+class CachedAliasInfo : public AnalysisPropertiesMixin<CachedAliasInfo<V, N>> {
+  using traits_t = AliasInfoTraits<CachedAliasInfo>;
+
+public:
+  using n_t = typename traits_t::n_t;
+  using v_t = typename traits_t::v_t;
+  using AliasSetTy = typename traits_t::AliasSetTy;
+  using AliasSetPtrTy = typename traits_t::AliasSetPtrTy;
+  using AllocationSiteSetPtrTy = typename traits_t::AllocationSiteSetPtrTy;
+
+  /// The reachable allocation sites, shared between all queries for the same
+  /// pointer. They stay valid after clear().
+  using SharedAllocationSiteSetPtrTy = std::shared_ptr<const AliasSetTy>;
+
+  CachedAliasInfo() noexcept = default;
+  CachedAliasInfo(AliasInfoRef<V, N> AA) noexcept
+      : AA(AA), IsFlowSensitive(AA && AA.isFlowSensitive()),
+        Generation(AA ? AA.getGeneration() : 0) {}
+
+  explicit operator bool() const noexcept { return bool(AA); }
+
+  /// The underlying alias information
+  [[nodiscard]] AliasInfoRef<V, N> getUnderlying() const noexcept {
+    return AA;
+  }
+
+  // -- Impl for IsAliasInfo:
+
+  [[nodiscard]] bool isInterProcedural() const noexcept {
+    return AA.isInterProcedural();
+  }
+  [[nodiscard]] AliasAnalysisType getAliasAnalysisType() const noexcept {
+    return AA.getAliasAnalysisType();
+  }
+
+  [[nodiscard]] AliasResult alias(ByConstRef<v_t> Pointer1,
+                                  ByConstRef<v_t> Pointer2,
+                                  ByConstRef<n_t> AtInstruction = {}) const {
+    return AA.alias(Pointer1, Pointer2, AtInstruction);
+  }
+
+  [[nodiscard]] AliasSetPtrTy getAliasSet(ByConstRef<v_t> Pointer,
+                                          ByConstRef<n_t> AtInstruction = {}) {
+    dropStaleResults();
+    auto &Ret = AliasSets[makeKey(Pointer, AtInstruction)];
+    if (!Ret) {
+      Ret = AA.getAliasSet(Pointer, AtInstruction);
+    }
+    return Ret;
+  }
+
+  [[nodiscard]] AllocationSiteSetPtrTy
+  getReachableAllocationSites(ByConstRef<v_t> Pointer,
+                              bool IntraProcOnly = false,
+                              ByConstRef<n_t> AtInstruction = {}) {
+    return std::make_unique<AliasSetTy>(*getSharedReachableAllocationSites(
+        Pointer, IntraProcOnly, AtInstruction));
+  }
+
+  // Checks if Pointer2 is a reachable allocation in the alias set of
+  // Pointer1.
+  [[nodiscard]] bool isInReachableAllocationSites(
+      ByConstRef<v_t> Pointer1, ByConstRef<v_t> Pointer2,
+      bool IntraProcOnly = false, ByConstRef<n_t> AtInstruction = {}) {
+    return getSharedReachableAllocationSites(Pointer1, IntraProcOnly,
+                                             AtInstruction)
+        ->count(Pointer2);
+  }
+
+  void print(llvm::raw_ostream &OS = llvm::outs()) const { AA.print(OS); }
+
+  [[nodiscard]] nlohmann::json getAsJson() const { return AA.getAsJson(); }
+
+  void printAsJson(llvm::raw_ostream &OS = llvm::outs()) const {
+    AA.printAsJson(OS);
+  }
+
+  void mergeWith(const CachedAliasInfo &Other) {
+    AA.mergeWith(Other.AA);
+    clear();
+  }
+
+  void introduceAlias(ByConstRef<v_t> Pointer1, ByConstRef<v_t> Pointer2,
+                      ByConstRef<n_t> AtInstruction = {},
+                      AliasResult Kind = AliasResult::MustAlias) {
+    AA.introduceAlias(Pointer1, Pointer2, AtInstruction, Kind);
+    clear();
+  }
+
+  [[nodiscard]] AnalysisProperties getAnalysisProperties() const noexcept {
+    return AA.getAnalysisProperties();
+  }
+
+  [[nodiscard]] uint64_t getGeneration() const noexcept {
+    return AA.getGeneration();
+  }
+
+  // -- Batched queries:
+
+  /// The alias sets of all Pointers in the same order. Each distinct pointer
+  /// is only queried once.
+  [[nodiscard]] llvm::SmallVector<AliasSetPtrTy>
+  getAliasSets(llvm::ArrayRef<v_t> Pointers,
+               ByConstRef<n_t> AtInstruction = {}) {
+    llvm::SmallVector<AliasSetPtrTy> Ret;
+    Ret.reserve(Pointers.size());
+    for (ByConstRef<v_t> Pointer : Pointers) {
+      Ret.push_back(getAliasSet(Pointer, AtInstruction));
+    }
+    return Ret;
+  }
+
+  /// Inserts the aliases of all Pointers into Into. An alias set that is
+  /// shared by multiple pointers is only traversed once.
+  template <typename RangeT, typename ContainerT>
+  void insertAliasesOf(const RangeT &Pointers, ContainerT &Into,
+                       ByConstRef<n_t> AtInstruction = {}) {
+    llvm::SmallPtrSet<const AliasSetTy *, 4> Seen;
+    for (ByConstRef<v_t> Pointer : Pointers) {
+      auto ASet = getAliasSet(Pointer, AtInstruction);
+      if (Seen.insert(ASet.get()).second) {
+        Into.insert(ASet->begin(), ASet->end());
+      }
+    }
+  }
+
+  /// Same as getReachableAllocationSites(), but without copying the cached
+  /// set. The returned set is a snapshot that is not updated when the
+  /// underlying alias information changes.
+  [[nodiscard]] SharedAllocationSiteSetPtrTy
+  getSharedReachableAllocationSites(ByConstRef<v_t> Pointer,
+                                    bool IntraProcOnly = false,
+                                    ByConstRef<n_t> AtInstruction = {}) {
+    dropStaleResults();
+    auto &Cache = IntraProcOnly ? IntraAllocationSites : AllocationSites;
+    auto &Ret = Cache[makeKey(Pointer, AtInstruction)];
+    if (!Ret) {
+      Ret = AA.getReachableAllocationSites(Pointer, IntraProcOnly,
+                                           AtInstruction);
+    }
+    return Ret;
+  }
+
+  /// Drops all cached query results
+  void clear() noexcept {
+    AliasSets.clear();
+    AllocationSites.clear();
+    IntraAllocationSites.clear();
+  }
+
+  [[nodiscard]] size_t getNumCachedAliasSets() const noexcept {
+    return AliasSets.size();
+  }
+
+private:
+  using KeyTy = std::pair<v_t, n_t>;
+
+  /// Clears the caches, if the underlying alias information has changed since
+  /// they have been filled
+  void dropStaleResults() {
+    assert(AA && "Cannot query a CachedAliasInfo without alias information");
+    auto CurrGeneration = AA.getGeneration();
+    if (CurrGeneration != Generation) {
+      clear();
+      Generation = CurrGeneration;
+    }
+  }
+
+  [[nodiscard]] KeyTy makeKey(ByConstRef<v_t> Pointer,
+                              ByConstRef<n_t> AtInstruction) const {
+    assert(AA && "Cannot query a CachedAliasInfo without alias information");
+    return {Pointer, IsFlowSensitive ? AtInstruction : n_t{}};
+  }
+
+  AliasInfoRef<V, N> AA{};
+  bool IsFlowSensitive = false;
+  /// The generation of AA that the cached results belong to
+  uint64_t Generation = 0;
+
+  llvm::DenseMap<KeyTy, AliasSetPtrTy> AliasSets;
+  llvm::DenseMap<KeyTy, SharedAllocationSiteSetPtrTy> AllocationSites;
+  llvm::DenseMap<KeyTy, SharedAllocationSiteSetPtrTy> IntraAllocationSites;
+};
+
+extern template class CachedAliasInfo<const llvm::Value *,
+                                      const llvm::Instruction *>;
+} // namespace psr
+
+#endif // PHASAR_POINTER_CACHEDALIASINFO_H
@@ -16,6 +16,7 @@
 #include "phasar/Utils/ByRef.h"
 #include "phasar/Utils/DOTGraph.h"
 #include "phasar/Utils/DebugOutput.h"
+#include "phasar/Utils/DenseBitSet.h"
 #include "phasar/Utils/EnumFlags.h"
 #include "phasar/Utils/EquivalenceClassMap.h"
 #include "phasar/Utils/ErrorHandling.h"
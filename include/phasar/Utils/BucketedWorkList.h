@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_BUCKETEDWORKLIST_H
+#define PHASAR_UTILS_BUCKETEDWORKLIST_H
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/// A worklist that partitions its items into a fixed number of priority
+/// buckets. pop() always takes the most recently inserted item from the
+/// non-empty bucket with the lowest index.
+///
+/// With a single bucket (the default), this is a plain LIFO worklist.
+template <typename T> class BucketedWorkList {
+public:
+  using value_type = T;
+
+  BucketedWorkList() : Buckets(1) {}
+
+  /// Re-partitions the worklist into NumBuckets buckets. The worklist must be
+  /// empty.
+  void setNumBuckets(size_t NumBuckets) {
+    assert(empty() && "Cannot re-partition a non-empty worklist");
+    assert(NumBuckets != 0);
+    Buckets.clear();
+    Buckets.resize(NumBuckets);
+    NonEmpty.clear();
+    NonEmpty.resize(NumBuckets);
+    MinBucket = 0;
+  }
+
+  [[nodiscard]] size_t getNumBuckets() const noexcept {
+    return Buckets.size();
+  }
+
+  template <typename... ArgTys>
+  void emplace(size_t Bucket, ArgTys &&...Args) {
+    assert(Bucket < Buckets.size());
+    Buckets[Bucket].emplace_back(std::forward<ArgTys>(Args)...);
+    NonEmpty.set(Bucket);
+    MinBucket = std::min(MinBucket, Bucket);
+    ++Size;
+  }
+
+  /// Inserts into the first bucket
+  template <typename... ArgTys> void emplace_back(ArgTys &&...Args) {
+    emplace(0, std::forward<ArgTys>(Args)...);
+  }
+
+  [[nodiscard]] T pop() {
+    assert(!empty() && "Cannot pop from an empty worklist");
+    if (!NonEmpty.test(MinBucket)) {
+      MinBucket = NonEmpty.find_next(MinBucket);
+    }
+
+    auto &Bucket = Buckets[MinBucket];
+    T Ret = std::move(Bucket.back());
+    Bucket.pop_back();
+    if (Bucket.empty()) {
+      NonEmpty.reset(MinBucket);
+    }
+    --Size;
+    return Ret;
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return Size == 0; }
+  [[nodiscard]] size_t size() const noexcept { return Size; }
+
+  void clear() noexcept {
+    for (auto &Bucket : Buckets) {
+      Bucket.clear();
+    }
+    NonEmpty.reset();
+    MinBucket = 0;
+    Size = 0;
+  }
+
+private:
+  llvm::SmallVector<std::vector<T>, 1> Buckets;
+  llvm::BitVector NonEmpty{1};
+  /// Lower bound of the lowest non-empty bucket
+  size_t MinBucket = 0;
+  size_t Size = 0;
+};
+
+} // namespace psr
+
+#endif // PHASAR_UTILS_BUCKETEDWORKLIST_H
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_COMPACTIDSET_H
+#define PHASAR_UTILS_COMPACTIDSET_H
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/iterator.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace psr {
+
+/// An immutable set of dense ids.
+///
+/// Small and sparse sets are stored as sorted array of the ids. Larger sets
+/// are stored as roaring bitmap: The ids are grouped by their upper 16 bits
+/// and each group stores the lower 16 bits either as sorted array or, if it
+/// has more than 4096 elements, as bitmap of 8KiB. The constructor picks the
+/// representation that needs less memory.
+///
+/// Lookup is logarithmic in the size of the set and checking two sets for a
+/// common element works on whole groups at once.
+class CompactIdSet {
+  struct Container {
+    uint16_t Key{};
+    /// The sorted lower 16 bits of the ids, if this is an array-container
+    llvm::SmallVector<uint16_t, 0> Array;
+    /// The lower 16 bits of the ids as bitmap, if this is a bitmap-container
+    llvm::SmallVector<uint64_t, 0> Bitmap;
+
+    [[nodiscard]] bool isBitmap() const noexcept { return !Bitmap.empty(); }
+    [[nodiscard]] bool contains(uint16_t Low) const noexcept;
+  };
+
+public:
+  class const_iterator
+      : public llvm::iterator_facade_base<const_iterator,
+                                          std::forward_iterator_tag, uint32_t,
+                                          std::ptrdiff_t, const uint32_t *,
+                                          uint32_t> {
+  public:
+    const_iterator() noexcept = default;
+
+    [[nodiscard]] uint32_t operator*() const noexcept { return Curr; }
+
+    const_iterator &operator++() noexcept;
+    using llvm::iterator_facade_base<const_iterator,
+                                     std::forward_iterator_tag, uint32_t,
+                                     std::ptrdiff_t, const uint32_t *,
+                                     uint32_t>::operator++;
+
+    [[nodiscard]] bool operator==(const const_iterator &Other) const noexcept {
+      return Outer == Other.Outer && Inner == Other.Inner;
+    }
+
+  private:
+    friend class CompactIdSet;
+
+    const_iterator(const CompactIdSet *Set, size_t Outer) noexcept;
+
+    void settle() noexcept;
+
+    const CompactIdSet *Set{};
+    /// The position in the Ids, or the container
+    size_t Outer{};
+    /// The position within the container
+    uint32_t Inner{};
+    uint32_t Curr{};
+  };
+  using iterator = const_iterator;
+
+  CompactIdSet() noexcept = default;
+
+  /// Creates the set of the given ids. They do not need to be sorted and may
+  /// contain duplicates.
+  explicit CompactIdSet(std::vector<uint32_t> Elements);
+
+  [[nodiscard]] bool contains(uint32_t Id) const noexcept;
+  [[nodiscard]] size_t count(uint32_t Id) const noexcept {
+    return contains(Id);
+  }
+
+  /// Checks whether this set and Other have at least one element in common
+  [[nodiscard]] bool intersects(const CompactIdSet &Other) const noexcept;
+
+  [[nodiscard]] CompactIdSet intersection(const CompactIdSet &Other) const;
+
+  [[nodiscard]] size_t size() const noexcept { return NumIds; }
+  [[nodiscard]] bool empty() const noexcept { return NumIds == 0; }
+
+  [[nodiscard]] const_iterator begin() const noexcept {
+    return const_iterator(this, 0);
+  }
+  [[nodiscard]] const_iterator end() const noexcept {
+    return const_iterator(this, isRoaring() ? Containers.size() : Ids.size());
+  }
+
+  /// Whether the ids are stored as roaring bitmap instead of a sorted array
+  [[nodiscard]] bool isRoaring() const noexcept { return !Containers.empty(); }
+
+  /// The number of bytes that this set occupies on the heap
+  [[nodiscard]] size_t getMemoryUsage() const noexcept;
+
+  [[nodiscard]] friend bool operator==(const CompactIdSet &Lhs,
+                                       const CompactIdSet &Rhs) noexcept {
+    return Lhs.size() == Rhs.size() &&
+           std::equal(Lhs.begin(), Lhs.end(), Rhs.begin());
+  }
+  [[nodiscard]] friend bool operator!=(const CompactIdSet &Lhs,
+                                       const CompactIdSet &Rhs) noexcept {
+    return !(Lhs == Rhs);
+  }
+
+private:
+  [[nodiscard]] const Container *findContainer(uint16_t Key) const noexcept;
+
+  /// Used, if the set is not roaring
+  llvm::SmallVector<uint32_t, 0> Ids;
+  /// Used, if the set is roaring; sorted by Key
+  std::vector<Container> Containers;
+  size_t NumIds = 0;
+};
+
+} // namespace psr
+
+#endif // PHASAR_UTILS_COMPACTIDSET_H
@@ -0,0 +1,81 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_COUNTINGALLOCATOR_H
+#define PHASAR_UTILS_COUNTINGALLOCATOR_H
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace psr {
+
+/// A stateful allocator that forwards to std::allocator, but keeps an exact
+/// tally of the number of bytes that are currently allocated through it.
+///
+/// All allocators that are copied or rebound from each other share the same
+/// counter. The counter must outlive all containers that use the allocator.
+template <typename T> class CountingAllocator {
+  template <typename U> friend class CountingAllocator;
+
+public:
+  using value_type = T;
+
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  explicit CountingAllocator(size_t *Counter) noexcept : Counter(Counter) {
+    assert(Counter != nullptr);
+  }
+
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U> &Other) noexcept
+      : Counter(Other.Counter) {}
+
+  [[nodiscard]] T *allocate(size_t N) {
+    auto *Ret = std::allocator<T>{}.allocate(N);
+    *Counter += N * sizeof(T);
+    return Ret;
+  }
+
+  void deallocate(T *Ptr, size_t N) noexcept {
+    assert(*Counter >= N * sizeof(T));
+    *Counter -= N * sizeof(T);
+    std::allocator<T>{}.deallocate(Ptr, N);
+  }
+
+  /// The number of bytes currently allocated through all allocators sharing
+  /// the counter with this one
+  [[nodiscard]] size_t getNumBytesAllocated() const noexcept {
+    return *Counter;
+  }
+
+  template <typename U>
+  [[nodiscard]] friend bool
+  operator==(const CountingAllocator &LHS,
+             const CountingAllocator<U> &RHS) noexcept {
+    return LHS.Counter == RHS.Counter;
+  }
+  template <typename U>
+  [[nodiscard]] friend bool
+  operator!=(const CountingAllocator &LHS,
+             const CountingAllocator<U> &RHS) noexcept {
+    return !(LHS == RHS);
+  }
+
+private:
+  size_t *Counter;
+};
+
+} // namespace psr
+
+#endif // PHASAR_UTILS_COUNTINGALLOCATOR_H
@@ -12,12 +12,23 @@
 
 #include "phasar/Utils/GraphTraits.h"
 #include "phasar/Utils/Logger.h"
+#include "phasar/Utils/TypeTraits.h"
 #include "phasar/Utils/Utilities.h"
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/IntEqClasses.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallBitVector.h"
 #include "llvm/ADT/SmallVector.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
 namespace psr {
 
 template <typename GraphTy>
@@ -27,7 +38,7 @@ createEquivalentGraphFrom(GraphTy &&G, const llvm::IntEqClasses &Eq)
     requires is_graph<GraphTy>
 #endif
 {
-  using traits_t = GraphTraits<GraphTy>;
+  using traits_t = GraphTraits<std::decay_t<GraphTy>>;
   using vertex_t = typename traits_t::vertex_t;
 
   std::decay_t<GraphTy> Ret;
@@ -83,103 +94,247 @@ createEquivalentGraphFrom(GraphTy &&G, const llvm::IntEqClasses &Eq)
   return Ret;
 }
 
-template <typename GraphTy>
-[[nodiscard]] llvm::IntEqClasses minimizeGraph(const GraphTy &G)
-#if __cplusplus >= 202002L
-    requires is_graph<GraphTy>
-#endif
-{
+namespace detail {
+template <typename T> [[nodiscard]] size_t hashGraphNode(const T &Nod) {
+  if constexpr (is_iterable_v<T>) {
+    return llvm::hash_combine_range(llvm::adl_begin(Nod), llvm::adl_end(Nod));
+  } else if constexpr (is_llvm_hashable_v<T>) {
+    using llvm::hash_value;
+    return hash_value(Nod);
+  } else if constexpr (is_std_hashable_v<T>) {
+    return std::hash<T>{}(Nod);
+  } else {
+    // Fall back to comparing all nodes for equality
+    return 0;
+  }
+}
 
+/// Assigns the same class to vertices with the same base class (e.g., the
+/// same node-tag) and the same set of (successor-class, weight) pairs.
+template <typename GraphTy> class GraphSignatureInterner {
   using traits_t = GraphTraits<GraphTy>;
   using vertex_t = typename traits_t::vertex_t;
   using edge_t = typename traits_t::edge_t;
-
-  auto DagSize = traits_t::size(G);
-  llvm::SmallVector<std::pair<vertex_t, vertex_t>> WorkList;
-  WorkList.reserve(DagSize);
-
-  const auto &Vertices = traits_t::vertices(G);
-
-  for (auto VtxBegin = Vertices.begin(), VtxEnd = Vertices.end();
-       VtxBegin != VtxEnd; ++VtxBegin) {
-    for (auto Inner = std::next(VtxBegin); Inner != VtxEnd; ++Inner) {
-      if (traits_t::node(G, *VtxBegin) == traits_t::node(G, *Inner) &&
-          traits_t::outDegree(G, *VtxBegin) == traits_t::outDegree(G, *Inner)) {
-        WorkList.emplace_back(*VtxBegin, *Inner);
+  using weight_t = std::decay_t<decltype(traits_t::weight(
+      std::declval<edge_t>()))>;
+
+public:
+  explicit GraphSignatureInterner(const GraphTy &G) noexcept : G(G) {}
+
+  /// \returns The class of Vtx, where ClassOf contains the classes of the
+  /// successors of Vtx
+  [[nodiscard]] unsigned getOrCreateClass(vertex_t Vtx, unsigned BaseClass,
+                                          llvm::ArrayRef<unsigned> ClassOf) {
+    auto Succs = getSuccessorClasses(Vtx, ClassOf);
+    auto Hash = size_t(llvm::hash_combine(
+        BaseClass, llvm::hash_combine_range(Succs.begin(), Succs.end())));
+
+    auto &Bucket = Buckets[Hash];
+    for (auto Cls : Bucket) {
+      const auto &Rep = Reps[Cls];
+      if (Rep.BaseClass == BaseClass && Rep.Succs == Succs &&
+          sameWeights(Rep.Vtx, Vtx, ClassOf)) {
+        return Cls;
       }
     }
+
+    auto Ret = unsigned(Reps.size());
+    Reps.push_back({Vtx, BaseClass, std::move(Succs)});
+    Bucket.push_back(Ret);
+    return Ret;
   }
 
-  llvm::IntEqClasses Equiv(traits_t::size(G));
+  [[nodiscard]] size_t getNumClasses() const noexcept { return Reps.size(); }
+  [[nodiscard]] vertex_t getRepresentative(unsigned Cls) const noexcept {
+    return Reps[Cls].Vtx;
+  }
+
+private:
+  struct Representative {
+    vertex_t Vtx{};
+    unsigned BaseClass{};
+    llvm::SmallVector<unsigned, 2> Succs;
+  };
 
-  auto isEquivalent = [&Equiv](edge_t LHS, edge_t RHS) {
-    if (traits_t::weight(LHS) != traits_t::weight(RHS)) {
-      return false;
+  [[nodiscard]] llvm::SmallVector<unsigned, 2>
+  getSuccessorClasses(vertex_t Vtx, llvm::ArrayRef<unsigned> ClassOf) const {
+    llvm::SmallVector<unsigned, 2> Ret;
+    for (const auto &Edge : traits_t::outEdges(G, Vtx)) {
+      Ret.push_back(ClassOf[traits_t::target(Edge)]);
     }
+    llvm::sort(Ret);
+    Ret.erase(std::unique(Ret.begin(), Ret.end()), Ret.end());
+    return Ret;
+  }
 
-    if (traits_t::target(LHS) == traits_t::target(RHS)) {
+  [[nodiscard]] bool sameWeights(vertex_t LHS, vertex_t RHS,
+                                 llvm::ArrayRef<unsigned> ClassOf) const {
+    if constexpr (std::is_same_v<weight_t, llvm::NoneType>) {
       return true;
+    } else {
+      auto Includes = [this, ClassOf](vertex_t From, vertex_t To) {
+        return llvm::all_of(traits_t::outEdges(G, From), [&](const auto &E) {
+          return llvm::any_of(traits_t::outEdges(G, To), [&](const auto &F) {
+            return ClassOf[traits_t::target(E)] ==
+                       ClassOf[traits_t::target(F)] &&
+                   traits_t::weight(E) == traits_t::weight(F);
+          });
+        });
+      };
+      return Includes(LHS, RHS) && Includes(RHS, LHS);
     }
+  }
 
-    return Equiv.findLeader(traits_t::target(LHS)) ==
-           Equiv.findLeader(traits_t::target(RHS));
-  };
+  const GraphTy &G;
+  llvm::SmallVector<Representative, 0> Reps;
+  std::unordered_map<size_t, llvm::SmallVector<unsigned, 1>> Buckets;
+};
 
-  auto makeEquivalent = [&Equiv](vertex_t LHS, vertex_t RHS) {
-    if (LHS == RHS) {
-      return;
-    }
+/// Partitions the vertices of G by their node-tags
+template <typename GraphTy>
+[[nodiscard]] llvm::SmallVector<unsigned, 0>
+computeNodeClasses(const GraphTy &G) {
+  using traits_t = GraphTraits<GraphTy>;
+  using vertex_t = typename traits_t::vertex_t;
 
-    Equiv.join(LHS, RHS);
-  };
+  llvm::SmallVector<unsigned, 0> Ret(traits_t::size(G));
+  llvm::SmallVector<vertex_t, 0> Reps;
+  std::unordered_map<size_t, llvm::SmallVector<unsigned, 1>> Buckets;
+
+  for (auto Vtx : traits_t::vertices(G)) {
+    const auto &Nod = traits_t::node(G, Vtx);
+    auto &Bucket = Buckets[hashGraphNode(Nod)];
+    auto It = llvm::find_if(Bucket, [&](unsigned Cls) {
+      return traits_t::node(G, Reps[Cls]) == Nod;
+    });
+    if (It != Bucket.end()) {
+      Ret[Vtx] = *It;
+      continue;
+    }
+    Ret[Vtx] = Reps.size();
+    Bucket.push_back(Reps.size());
+    Reps.push_back(Vtx);
+  }
+  return Ret;
+}
 
-  auto removeAt = [&WorkList](size_t I) {
-    std::swap(WorkList[I], WorkList.back());
-    WorkList.pop_back();
-    return I - 1;
-  };
+/// Computes the vertices of G in post-order, such that each vertex comes after
+/// all its successors.
+///
+/// \returns false, iff G contains a cycle
+template <typename GraphTy>
+[[nodiscard]] bool
+computePostOrder(const GraphTy &G,
+                 llvm::SmallVectorImpl<typename GraphTraits<GraphTy>::vertex_t>
+                     &PostOrder) {
+  using traits_t = GraphTraits<GraphTy>;
+  using vertex_t = typename traits_t::vertex_t;
 
-  /// NOTE: This algorithm can be further optimized, but for now it is fast
-  /// enough
-
-  bool Changed = true;
-  while (Changed) {
-    Changed = false;
-    for (size_t I = 0; I < WorkList.size(); ++I) {
-      auto [LHS, RHS] = WorkList[I];
-      bool Eq = true;
-      for (auto [LSucc, RSucc] :
-           llvm::zip(traits_t::outEdges(G, LHS), traits_t::outEdges(G, RHS))) {
-        if (!isEquivalent(LSucc, RSucc)) {
-          Eq = false;
-          break;
-        }
-      }
+  enum class State : uint8_t { Unvisited, OnStack, Done };
+  llvm::SmallVector<State, 0> States(traits_t::size(G), State::Unvisited);
+  llvm::SmallVector<std::pair<vertex_t, size_t>> Stack;
+  PostOrder.reserve(traits_t::size(G));
 
-      if (Eq) {
-        makeEquivalent(LHS, RHS);
-        I = removeAt(I);
-        Changed = true;
+  for (auto Start : traits_t::vertices(G)) {
+    if (States[Start] != State::Unvisited) {
+      continue;
+    }
+    States[Start] = State::OnStack;
+    Stack.emplace_back(Start, 0);
+
+    while (!Stack.empty()) {
+      auto &[Vtx, NextEdge] = Stack.back();
+      auto Edges = traits_t::outEdges(G, Vtx);
+      if (NextEdge == size_t(llvm::size(Edges))) {
+        States[Vtx] = State::Done;
+        PostOrder.push_back(Vtx);
+        Stack.pop_back();
         continue;
       }
 
-      if (traits_t::outDegree(G, LHS) == 2) {
-        auto LFirst = *traits_t::outEdges(G, LHS).begin();
-        auto LSecond = *std::next(traits_t::outEdges(G, LHS).begin());
-        auto RFirst = *traits_t::outEdges(G, RHS).begin();
-        auto RSecond = *std::next(traits_t::outEdges(G, RHS).begin());
-
-        if (isEquivalent(LFirst, RSecond) && isEquivalent(LSecond, RFirst)) {
-          makeEquivalent(LHS, RHS);
-          I = removeAt(I);
-          Changed = true;
-          continue;
-        }
+      auto Succ = traits_t::target(
+          *std::next(llvm::adl_begin(Edges), ptrdiff_t(NextEdge++)));
+      if (States[Succ] == State::OnStack) {
+        return false;
+      }
+      if (States[Succ] == State::Unvisited) {
+        States[Succ] = State::OnStack;
+        Stack.emplace_back(Succ, 0);
       }
     }
   }
+  return true;
+}
 
+template <typename GraphTy>
+[[nodiscard]] llvm::IntEqClasses
+toEquivalenceClasses(const GraphTy &G,
+                     const GraphSignatureInterner<GraphTy> &Interner,
+                     llvm::ArrayRef<unsigned> ClassOf) {
+  using traits_t = GraphTraits<GraphTy>;
+
+  llvm::IntEqClasses Equiv(traits_t::size(G));
+  for (auto Vtx : traits_t::vertices(G)) {
+    auto Rep = Interner.getRepresentative(ClassOf[Vtx]);
+    if (Rep != Vtx) {
+      Equiv.join(Rep, Vtx);
+    }
+  }
   Equiv.compress();
+  return Equiv;
+}
+} // namespace detail
+
+/// Computes the classes of equivalent vertices in G, such that merging the
+/// vertices of each class (see createEquivalentGraphFrom()) preserves the
+/// paths through G. Two vertices are equivalent, iff they have the same
+/// node-tag and equivalent successors.
+///
+/// For acyclic graphs, all vertices are classified in one bottom-up pass in
+/// post-order, which is linear in the size of G (up to hash-collisions). For
+/// cyclic graphs, this falls back to iterated partition refinement.
+template <typename GraphTy>
+[[nodiscard]] llvm::IntEqClasses minimizeGraph(const GraphTy &G)
+#if __cplusplus >= 202002L
+    requires is_graph<GraphTy>
+#endif
+{
+  using traits_t = GraphTraits<GraphTy>;
+  using vertex_t = typename traits_t::vertex_t;
+
+  auto DagSize = traits_t::size(G);
+  auto NodeClasses = detail::computeNodeClasses(G);
+
+  llvm::SmallVector<vertex_t, 0> PostOrder;
+  auto Equiv = [&] {
+    if (detail::computePostOrder(G, PostOrder)) {
+      // The successors of each vertex are already classified when visiting the
+      // vertex itself, so their classes are final
+      llvm::SmallVector<unsigned, 0> ClassOf(DagSize);
+      detail::GraphSignatureInterner<GraphTy> Interner(G);
+      for (auto Vtx : PostOrder) {
+        ClassOf[Vtx] =
+            Interner.getOrCreateClass(Vtx, NodeClasses[Vtx], ClassOf);
+      }
+      return detail::toEquivalenceClasses(G, Interner, ClassOf);
+    }
+
+    // Refine the partition until it is stable
+    auto ClassOf = std::move(NodeClasses);
+    size_t NumClasses = 0;
+    while (true) {
+      detail::GraphSignatureInterner<GraphTy> Interner(G);
+      llvm::SmallVector<unsigned, 0> NewClassOf(DagSize);
+      for (auto Vtx : traits_t::vertices(G)) {
+        NewClassOf[Vtx] = Interner.getOrCreateClass(Vtx, ClassOf[Vtx], ClassOf);
+      }
+      ClassOf = std::move(NewClassOf);
+      if (Interner.getNumClasses() == NumClasses) {
+        return detail::toEquivalenceClasses(G, Interner, ClassOf);
+      }
+      NumClasses = Interner.getNumClasses();
+    }
+  }();
 
   PHASAR_LOG_LEVEL_CAT(DEBUG, "GraphTraits",
                        "> Computed " << Equiv.getNumClasses()
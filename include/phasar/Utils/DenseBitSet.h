@@ -0,0 +1,349 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_DENSEBITSET_H
+#define PHASAR_UTILS_DENSEBITSET_H
+
+#include "phasar/Utils/ByRef.h"
+#include "phasar/Utils/Printer.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace psr {
+
+/// Assigns dense bit-positions to the values of type T.
+///
+/// Unlike the global index of BitVectorSet, a DenseBitSetIndex belongs to a
+/// single analysis and is shared by all DenseBitSets of that analysis. It
+/// should be filled up front with all values that the analysis may put into
+/// its sets, such that all sets of the analysis share the same compact
+/// numbering. Values that are inserted later simply get the next free
+/// position.
+template <typename T> class DenseBitSetIndex {
+public:
+  DenseBitSetIndex() noexcept = default;
+
+  template <typename RangeT> explicit DenseBitSetIndex(const RangeT &Values) {
+    for (const auto &Val : Values) {
+      getOrInsert(Val);
+    }
+  }
+
+  uint32_t getOrInsert(ByConstRef<T> Val) {
+    auto [It, Inserted] = Ids.try_emplace(Val, uint32_t(Values.size()));
+    if (Inserted) {
+      Values.push_back(Val);
+    }
+    return It->second;
+  }
+
+  [[nodiscard]] std::optional<uint32_t> lookup(ByConstRef<T> Val) const {
+    auto It = Ids.find(Val);
+    if (It == Ids.end()) {
+      return std::nullopt;
+    }
+    return It->second;
+  }
+
+  [[nodiscard]] ByConstRef<T> operator[](uint32_t Id) const {
+    assert(Id < Values.size());
+    return Values[Id];
+  }
+
+  [[nodiscard]] size_t size() const noexcept { return Values.size(); }
+  [[nodiscard]] bool empty() const noexcept { return Values.empty(); }
+
+  void reserve(size_t Capacity) {
+    Ids.reserve(Capacity);
+    Values.reserve(Capacity);
+  }
+
+private:
+  llvm::DenseMap<T, uint32_t> Ids;
+  std::vector<T> Values;
+};
+
+/// A set of values of type T that is represented as a bit-vector over the
+/// positions that a DenseBitSetIndex assigns to the values.
+///
+/// Union, intersection, difference and equality of two sets work on whole
+/// machine words at once. All sets that are combined with each other must use
+/// the same index.
+///
+/// The sets share the ownership of their index, such that they stay valid
+/// after the analysis that has created them is gone.
+///
+/// A default-constructed set has no index. It can still be compared with other
+/// sets and receive the contents of another set (e.g., via insert(), or
+/// assignment), but single values can only be inserted after it has been
+/// bound to an index that way.
+template <typename T> class DenseBitSet {
+public:
+  using value_type = T;
+  using IndexTy = DenseBitSetIndex<T>;
+
+  class const_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T *;
+    using reference = ByConstRef<T>;
+
+    const_iterator() noexcept = default;
+
+    [[nodiscard]] reference operator*() const {
+      assert(Set != nullptr && Bit >= 0);
+      return (*Set->Index)[Bit];
+    }
+
+    const_iterator &operator++() {
+      Bit = Set->Bits.find_next(Bit);
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto Ret = *this;
+      ++*this;
+      return Ret;
+    }
+
+    friend bool operator==(const const_iterator &Lhs,
+                           const const_iterator &Rhs) noexcept {
+      return Lhs.Bit == Rhs.Bit;
+    }
+    friend bool operator!=(const const_iterator &Lhs,
+                           const const_iterator &Rhs) noexcept {
+      return !(Lhs == Rhs);
+    }
+
+  private:
+    friend class DenseBitSet;
+
+    const_iterator(const DenseBitSet *Set, int Bit) noexcept
+        : Set(Set), Bit(Bit) {}
+
+    const DenseBitSet *Set{};
+    int Bit = -1;
+  };
+  using iterator = const_iterator;
+
+  DenseBitSet() noexcept = default;
+
+  explicit DenseBitSet(std::shared_ptr<IndexTy> Index)
+      : Index(std::move(Index)) {
+    assert(this->Index != nullptr);
+    Bits.reserve(this->Index->size());
+  }
+
+  DenseBitSet(std::shared_ptr<IndexTy> Index, std::initializer_list<T> IList)
+      : DenseBitSet(std::move(Index)) {
+    insert(IList.begin(), IList.end());
+  }
+
+  [[nodiscard]] IndexTy *getIndex() const noexcept { return Index.get(); }
+
+  /// Returns true, iff Val has not been in the set before
+  bool insert(ByConstRef<T> Val) {
+    assert(Index != nullptr &&
+           "Cannot insert single values into a DenseBitSet without an index");
+    auto Id = Index->getOrInsert(Val);
+    if (Id >= Bits.size()) {
+      Bits.resize(Id + 1);
+    } else if (Bits.test(Id)) {
+      return false;
+    }
+    Bits.set(Id);
+    return true;
+  }
+
+  void insert(const DenseBitSet &Other) {
+    adoptIndex(Other);
+    Bits |= Other.Bits;
+  }
+
+  template <typename InputIt> void insert(InputIt First, InputIt Last) {
+    if constexpr (std::is_same_v<InputIt, const_iterator>) {
+      if (First == Last) {
+        return;
+      }
+      // No need to go through the index
+      adoptIndex(*First.Set);
+      const auto &OtherBits = First.Set->Bits;
+      if (Bits.size() < OtherBits.size()) {
+        Bits.resize(OtherBits.size());
+      }
+      for (; First != Last; ++First) {
+        Bits.set(First.Bit);
+      }
+    } else {
+      for (; First != Last; ++First) {
+        insert(*First);
+      }
+    }
+  }
+
+  /// Returns true, iff Val has been in the set before
+  bool erase(ByConstRef<T> Val) {
+    auto Id = getId(Val);
+    if (!Id) {
+      return false;
+    }
+    bool Ret = Bits.test(*Id);
+    Bits.reset(*Id);
+    return Ret;
+  }
+
+  void erase(const DenseBitSet &Other) {
+    if (this == &Other) {
+      clear();
+      return;
+    }
+    assertCompatible(Other);
+    Bits.reset(Other.Bits);
+  }
+
+  [[nodiscard]] size_t count(ByConstRef<T> Val) const {
+    auto Id = getId(Val);
+    return Id && Bits.test(*Id);
+  }
+  [[nodiscard]] bool contains(ByConstRef<T> Val) const { return count(Val); }
+
+  [[nodiscard]] DenseBitSet setUnion(const DenseBitSet &Other) const {
+    auto Ret = *this;
+    Ret.setUnionWith(Other);
+    return Ret;
+  }
+
+  [[nodiscard]] DenseBitSet setIntersect(const DenseBitSet &Other) const {
+    auto Ret = *this;
+    Ret.setIntersectWith(Other);
+    return Ret;
+  }
+
+  void setUnionWith(const DenseBitSet &Other) { insert(Other); }
+
+  void setIntersectWith(const DenseBitSet &Other) {
+    adoptIndex(Other);
+    Bits &= Other.Bits;
+  }
+
+  /// Returns true, iff Other is a subset of this set
+  [[nodiscard]] bool includes(const DenseBitSet &Other) const {
+    assertCompatible(Other);
+    return !Other.Bits.test(Bits);
+  }
+
+  [[nodiscard]] size_t size() const noexcept { return Bits.count(); }
+  [[nodiscard]] bool empty() const noexcept { return Bits.none(); }
+
+  void clear() noexcept { Bits.clear(); }
+
+  [[nodiscard]] const_iterator begin() const noexcept {
+    return {this, Bits.find_first()};
+  }
+  [[nodiscard]] const_iterator end() const noexcept { return {this, -1}; }
+
+  /// Compares the elements of Lhs and Rhs, not their representation, i.e.,
+  /// trailing zero-words are ignored.
+  friend bool operator==(const DenseBitSet &Lhs, const DenseBitSet &Rhs) {
+    Lhs.assertCompatible(Rhs);
+    auto LhsWords = Lhs.getWords();
+    auto RhsWords = Rhs.getWords();
+    auto MinSize = std::min(LhsWords.size(), RhsWords.size());
+    if (LhsWords.take_front(MinSize) != RhsWords.take_front(MinSize)) {
+      return false;
+    }
+    auto Rest = (LhsWords.size() > RhsWords.size() ? LhsWords : RhsWords)
+                    .drop_front(MinSize);
+    return std::all_of(Rest.begin(), Rest.end(),
+                       [](auto Word) { return Word == 0; });
+  }
+
+  friend bool operator!=(const DenseBitSet &Lhs, const DenseBitSet &Rhs) {
+    return !(Lhs == Rhs);
+  }
+
+  // NOLINTNEXTLINE(readability-identifier-naming) -- needed for ADL
+  friend llvm::hash_code hash_value(const DenseBitSet &BS) noexcept {
+    auto Words = BS.getWords();
+    while (!Words.empty() && Words.back() == 0) {
+      Words = Words.drop_back();
+    }
+    return llvm::hash_combine_range(Words.begin(), Words.end());
+  }
+
+  friend llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
+                                       const DenseBitSet &BS) {
+    OS << '<';
+    bool First = true;
+    for (const auto &Val : BS) {
+      if (First) {
+        First = false;
+      } else {
+        OS << ", ";
+      }
+      OS << DToString(Val);
+    }
+    return OS << '>';
+  }
+
+private:
+  [[nodiscard]] llvm::ArrayRef<uintptr_t>
+  getWords() const noexcept {
+    // BitVector::getData() must not be called on an empty BitVector
+    if (Bits.empty()) {
+      return {};
+    }
+    return Bits.getData();
+  }
+
+  [[nodiscard]] std::optional<uint32_t> getId(ByConstRef<T> Val) const {
+    if (!Index) {
+      return std::nullopt;
+    }
+    auto Id = Index->lookup(Val);
+    if (!Id || *Id >= Bits.size()) {
+      return std::nullopt;
+    }
+    return Id;
+  }
+
+  void adoptIndex(const DenseBitSet &Other) noexcept {
+    assertCompatible(Other);
+    if (!Index) {
+      Index = Other.Index;
+    }
+  }
+
+  void assertCompatible([[maybe_unused]] const DenseBitSet &Other) const {
+    assert((!Index || !Other.Index || Index == Other.Index) &&
+           "Cannot combine DenseBitSets with different indices");
+  }
+
+  std::shared_ptr<IndexTy> Index{};
+  llvm::BitVector Bits;
+};
+
+} // namespace psr
+
+#endif // PHASAR_UTILS_DENSEBITSET_H
@@ -0,0 +1,197 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_DISJOINTSETS_H
+#define PHASAR_UTILS_DISJOINTSETS_H
+
+#include "llvm/ADT/iterator.h"
+#include "llvm/ADT/iterator_range.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace psr {
+
+/// A disjoint-set forest (union-find) over the dense ids [0, size()).
+///
+/// Uses union by size and path splitting, such that find() and unite() run in
+/// amortized near-constant time. Additionally, the members of each set are
+/// linked in a circular list, so they can be enumerated in time proportional
+/// to the size of the set.
+///
+/// Per element, this stores one parent index (or the set size, for the
+/// representatives) and one link of the member list.
+///
+/// Not thread-safe, not even for concurrent const access, as find() compresses
+/// the paths in place.
+class DisjointSets {
+public:
+  /// Iterates over the ids of the members of one set
+  class member_iterator
+      : public llvm::iterator_facade_base<member_iterator,
+                                          std::forward_iterator_tag, uint32_t,
+                                          std::ptrdiff_t, const uint32_t *,
+                                          uint32_t> {
+  public:
+    member_iterator() noexcept = default;
+
+    [[nodiscard]] uint32_t operator*() const noexcept { return Curr; }
+
+    member_iterator &operator++() noexcept {
+      Curr = Sets->Next[Curr];
+      if (Curr == First) {
+        Sets = nullptr;
+        Curr = First = 0;
+      }
+      return *this;
+    }
+    using llvm::iterator_facade_base<member_iterator,
+                                     std::forward_iterator_tag, uint32_t,
+                                     std::ptrdiff_t, const uint32_t *,
+                                     uint32_t>::operator++;
+
+    [[nodiscard]] bool operator==(const member_iterator &Other) const noexcept {
+      return Sets == Other.Sets && Curr == Other.Curr;
+    }
+
+  private:
+    friend class DisjointSets;
+
+    member_iterator(const DisjointSets *Sets, uint32_t First) noexcept
+        : Sets(Sets), First(First), Curr(First) {}
+
+    const DisjointSets *Sets{};
+    uint32_t First{};
+    uint32_t Curr{};
+  };
+
+  DisjointSets() noexcept = default;
+  explicit DisjointSets(size_t NumElements) { grow(NumElements); }
+
+  /// Adds a new singleton set and returns the id of its only element
+  uint32_t makeSet() {
+    auto Id = uint32_t(Parents.size());
+    assert(Id < RootFlag && "Too many elements for a DisjointSets");
+    Parents.push_back(RootFlag | 1);
+    Next.push_back(Id);
+    return Id;
+  }
+
+  /// Adds singleton sets until there are at least NumElements elements
+  void grow(size_t NumElements) {
+    Parents.reserve(NumElements);
+    Next.reserve(NumElements);
+    while (Parents.size() < NumElements) {
+      makeSet();
+    }
+  }
+
+  void reserve(size_t Capacity) {
+    Parents.reserve(Capacity);
+    Next.reserve(Capacity);
+  }
+
+  /// Returns the representative of the set that contains Id.
+  ///
+  /// Uses path splitting: Each element on the way is re-linked to its
+  /// grandparent. This is not observable from the outside, but find()
+  /// modifies the forest, so concurrent calls to const member functions
+  /// are not thread-safe.
+  [[nodiscard]] uint32_t find(uint32_t Id) const noexcept {
+    assert(Id < Parents.size());
+    while (!isRoot(Id)) {
+      auto Parent = Parents[Id];
+      if (!isRoot(Parent)) {
+        Parents[Id] = Parents[Parent];
+      }
+      Id = Parent;
+    }
+    return Id;
+  }
+
+  [[nodiscard]] bool isRoot(uint32_t Id) const noexcept {
+    return Parents[Id] & RootFlag;
+  }
+
+  [[nodiscard]] bool inSameSet(uint32_t Id1, uint32_t Id2) const noexcept {
+    return find(Id1) == find(Id2);
+  }
+
+  /// Merges the sets that contain Id1 and Id2.
+  ///
+  /// \returns The representative of the merged set, which is the
+  /// representative of one of the two original sets.
+  uint32_t unite(uint32_t Id1, uint32_t Id2) noexcept {
+    auto Root1 = find(Id1);
+    auto Root2 = find(Id2);
+    if (Root1 == Root2) {
+      return Root1;
+    }
+
+    if (setSize(Root1) < setSize(Root2)) {
+      std::swap(Root1, Root2);
+    }
+
+    Parents[Root1] += setSize(Root2);
+    Parents[Root2] = Root1;
+    // Splice the two circular member-lists
+    std::swap(Next[Root1], Next[Root2]);
+    return Root1;
+  }
+
+  /// Splits the set that contains Id into singleton sets, one per member.
+  ///
+  /// Runs in time proportional to the size of the set.
+  void dissolve(uint32_t Id) noexcept {
+    assert(Id < Parents.size());
+    auto Curr = Id;
+    do {
+      auto Succ = Next[Curr];
+      Parents[Curr] = RootFlag | 1;
+      Next[Curr] = Curr;
+      Curr = Succ;
+    } while (Curr != Id);
+  }
+
+  /// The number of elements in the set that contains Id
+  [[nodiscard]] size_t setSize(uint32_t Id) const noexcept {
+    return Parents[find(Id)] & ~RootFlag;
+  }
+
+  /// The ids of all elements in the set that contains Id, starting with Id
+  [[nodiscard]] llvm::iterator_range<member_iterator>
+  members(uint32_t Id) const noexcept {
+    assert(Id < Parents.size());
+    return {member_iterator(this, Id), member_iterator()};
+  }
+
+  /// The number of elements in all sets
+  [[nodiscard]] size_t size() const noexcept { return Parents.size(); }
+  [[nodiscard]] bool empty() const noexcept { return Parents.empty(); }
+
+  void clear() noexcept {
+    Parents.clear();
+    Next.clear();
+  }
+
+private:
+  static constexpr uint32_t RootFlag = uint32_t(1) << 31;
+
+  /// For a representative: RootFlag | size of the set; otherwise the parent.
+  /// Mutable, because find() compresses the paths.
+  mutable std::vector<uint32_t> Parents;
+  std::vector<uint32_t> Next;
+};
+
+} // namespace psr
+
+#endif // PHASAR_UTILS_DISJOINTSETS_H
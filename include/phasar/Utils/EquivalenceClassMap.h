@@ -14,6 +14,7 @@
 #include "llvm/ADT/iterator_range.h"
 
 #include <initializer_list>
+#include <memory>
 #include <optional>
 #include <set>
 #include <vector>
@@ -25,36 +26,57 @@ namespace psr {
 // that are equivalent are mapped to the same value. Two keys are treated as
 // equivalent and merged into a equivalence class when they refer to Values
 // that compare equal.
-template <typename KeyT, typename ValueT> struct EquivalenceClassMap {
-  template <typename... Ts> using SetType = std::set<Ts...>;
+//
+// All memory is obtained through (a rebound copy of) AllocatorT, which allows
+// clients to account for or to customize the map's memory usage.
+template <typename KeyT, typename ValueT,
+          typename AllocatorT = std::allocator<KeyT>>
+struct EquivalenceClassMap {
+  template <typename T>
+  using RebindAllocT =
+      typename std::allocator_traits<AllocatorT>::template rebind_alloc<T>;
+  template <typename T>
+  using SetType = std::set<T, std::less<T>, RebindAllocT<T>>;
   using EquivalenceClassBucketT = std::pair<SetType<KeyT>, ValueT>;
-  using StorageT = std::vector<EquivalenceClassBucketT>;
+  using StorageT = std::vector<EquivalenceClassBucketT,
+                               RebindAllocT<EquivalenceClassBucketT>>;
 
 public:
   using size_type = size_t;
   using key_type = KeyT;
   using mapped_type = ValueT;
   using value_type = EquivalenceClassBucketT;
+  using allocator_type = AllocatorT;
 
   using const_iterator = typename StorageT::const_iterator;
 
   using insert_return_type =
       std::pair<typename SetType<KeyT>::const_iterator, bool>;
 
-  EquivalenceClassMap(unsigned InitialEquivalenceClasses = 0) {
+  EquivalenceClassMap(unsigned InitialEquivalenceClasses = 0,
+                      const AllocatorT &Alloc = AllocatorT())
+      : StoredData(Alloc) {
     StoredData.reserve(InitialEquivalenceClasses);
   }
 
   template <typename InputIt>
-  EquivalenceClassMap(const InputIt &I, const InputIt &End) {
+  EquivalenceClassMap(const InputIt &I, const InputIt &End,
+                      const AllocatorT &Alloc = AllocatorT())
+      : StoredData(Alloc) {
     this->insert(I, End);
   }
 
   EquivalenceClassMap(
-      std::initializer_list<std::pair<key_type, mapped_type>> Vals) {
+      std::initializer_list<std::pair<key_type, mapped_type>> Vals,
+      const AllocatorT &Alloc = AllocatorT())
+      : StoredData(Alloc) {
     this->insert(Vals.begin(), Vals.end());
   }
 
+  [[nodiscard]] allocator_type get_allocator() const {
+    return allocator_type(StoredData.get_allocator());
+  }
+
   [[nodiscard]] inline const_iterator begin() const {
     return StoredData.begin();
   }
@@ -109,8 +131,10 @@ public:
       }
     }
 
-    StoredData.emplace_back(SetType<KeyT>{std::move(Key)}, std::move(Val));
-    return std::make_pair(StoredData.back().first.begin(), true);
+    auto &Bucket = StoredData.emplace_back(
+        SetType<KeyT>(StoredData.get_allocator()), std::move(Val));
+    Bucket.first.insert(std::move(Key));
+    return std::make_pair(Bucket.first.begin(), true);
   }
 
   // Inserts Key into the corresponding equivalence class for Value. If Value
@@ -125,8 +149,10 @@ public:
       }
     }
 
-    StoredData.emplace_back(SetType<KeyT>{Key}, std::move(Val));
-    return std::make_pair(StoredData.back().first.begin(), true);
+    auto &Bucket = StoredData.emplace_back(
+        SetType<KeyT>(StoredData.get_allocator()), std::move(Val));
+    Bucket.first.insert(Key);
+    return std::make_pair(Bucket.first.begin(), true);
   }
 
   // Return 1 if the specified key is in the map, 0 otherwise.
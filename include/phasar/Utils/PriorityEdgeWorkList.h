@@ -0,0 +1,198 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_PRIORITYEDGEWORKLIST_H
+#define PHASAR_UTILS_PRIORITYEDGEWORKLIST_H
+
+#include "phasar/Utils/ByRef.h"
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/// A worklist of control-flow edges for the monotone solvers.
+///
+/// Every node gets a dense ID and a priority. Pending edges are grouped by
+/// their source node and pop() always returns an edge whose source has the
+/// lowest priority value. Numbering the nodes of a function in reverse
+/// postorder (see addReversePostOrder()) makes the solver visit all
+/// predecessors of a node before the node itself -- except for back-edges --
+/// which reaches the fixpoint with much fewer transfer-function applications
+/// than FIFO order.
+///
+/// An in-queue bitset keyed by the node ID makes sure that every source node
+/// is queued at most once; pushing an edge that is already pending is a no-op.
+template <typename N> class PriorityEdgeWorkList {
+public:
+  using n_t = N;
+  using value_type = std::pair<n_t, n_t>;
+
+  /// Assigns IDs to all not yet numbered nodes that are reachable from Roots
+  /// via GetSuccs in reverse postorder. The priorities are ordered by Group
+  /// first and by the reverse postorder second, i.e., the nodes numbered here
+  /// come before all nodes with a higher Group.
+  ///
+  /// Nodes that are pushed without being numbered before, come last.
+  template <typename RangeT, typename SuccsFn>
+  void addReversePostOrder(const RangeT &Roots, SuccsFn GetSuccs,
+                           uint32_t Group = 0) {
+    struct Frame {
+      n_t Node;
+      llvm::SmallVector<n_t, 2> Succs;
+      size_t NextSucc = 0;
+    };
+
+    llvm::SmallVector<n_t> PostOrder;
+    std::vector<Frame> Stack;
+    auto Visit = [&](ByConstRef<n_t> Node) {
+      if (!Ids.try_emplace(Node, UINT32_MAX).second) {
+        return;
+      }
+      auto &Fr = Stack.emplace_back();
+      Fr.Node = Node;
+      for (const auto &Succ : GetSuccs(Node)) {
+        Fr.Succs.push_back(Succ);
+      }
+    };
+
+    for (const auto &Root : Roots) {
+      Visit(Root);
+      while (!Stack.empty()) {
+        auto &Top = Stack.back();
+        if (Top.NextSucc != Top.Succs.size()) {
+          // Invalidates Top
+          Visit(n_t(Top.Succs[Top.NextSucc++]));
+          continue;
+        }
+        PostOrder.push_back(std::move(Top.Node));
+        Stack.pop_back();
+      }
+    }
+
+    uint32_t Order = 0;
+    for (const auto &Node : llvm::reverse(PostOrder)) {
+      Ids[Node] = createId(Node, (uint64_t(Group) << 32) | Order++);
+    }
+  }
+
+  /// Adds the edge (Src, Dst) to the worklist, if it is not already pending.
+  /// Returns whether the edge has been added.
+  bool push(ByConstRef<n_t> Src, ByConstRef<n_t> Dst) {
+    auto Id = getOrCreateId(Src);
+    auto &Targets = Pending[Id];
+    if (llvm::is_contained(Targets, Dst)) {
+      ++NumDuplicates;
+      return false;
+    }
+
+    Targets.push_back(Dst);
+    if (!InQueue.test(Id)) {
+      InQueue.set(Id);
+      Queue.emplace(Priorities[Id], Id);
+    }
+    ++Size;
+    ++NumPushes;
+    return true;
+  }
+
+  template <typename EdgeRangeT> void pushAll(const EdgeRangeT &Edges) {
+    for (const auto &[Src, Dst] : Edges) {
+      push(Src, Dst);
+    }
+  }
+
+  [[nodiscard]] value_type pop() {
+    assert(!empty() && "Cannot pop from an empty worklist");
+    auto Id = Queue.top().second;
+    auto &Targets = Pending[Id];
+    assert(!Targets.empty());
+
+    value_type Ret{Nodes[Id], Targets.pop_back_val()};
+    if (Targets.empty()) {
+      Queue.pop();
+      InQueue.reset(Id);
+    }
+    --Size;
+    ++NumPops;
+    return Ret;
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return Size == 0; }
+  [[nodiscard]] size_t size() const noexcept { return Size; }
+
+  /// Calls Handler(Src, Dst) for all pending edges in no particular order
+  template <typename HandlerFn> void foreachPending(HandlerFn Handler) const {
+    for (auto Id : InQueue.set_bits()) {
+      for (const auto &Dst : Pending[Id]) {
+        std::invoke(Handler, Nodes[Id], Dst);
+      }
+    }
+  }
+
+  /// The number of edges that have been popped from this worklist, i.e., the
+  /// number of iterations the solver needed to reach its fixpoint
+  [[nodiscard]] size_t getNumPops() const noexcept { return NumPops; }
+  /// The number of edges that have actually been added to this worklist
+  [[nodiscard]] size_t getNumPushes() const noexcept { return NumPushes; }
+  /// The number of edges that have not been added, because they were already
+  /// pending
+  [[nodiscard]] size_t getNumDuplicates() const noexcept {
+    return NumDuplicates;
+  }
+
+  [[nodiscard]] size_t getNumNodes() const noexcept { return Nodes.size(); }
+
+private:
+  uint32_t createId(ByConstRef<n_t> Node, uint64_t Priority) {
+    auto Id = uint32_t(Nodes.size());
+    Nodes.push_back(Node);
+    Priorities.push_back(Priority);
+    Pending.emplace_back();
+    InQueue.push_back(false);
+    return Id;
+  }
+
+  uint32_t getOrCreateId(ByConstRef<n_t> Node) {
+    auto [It, Inserted] = Ids.try_emplace(Node, 0);
+    if (Inserted) {
+      It->second = createId(Node, UINT64_MAX);
+    }
+    return It->second;
+  }
+
+  using QueueEntry = std::pair<uint64_t, uint32_t>;
+
+  llvm::DenseMap<n_t, uint32_t> Ids;
+  std::vector<n_t> Nodes;
+  std::vector<uint64_t> Priorities;
+  std::vector<llvm::SmallVector<n_t, 2>> Pending;
+  llvm::BitVector InQueue;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>>
+      Queue;
+
+  size_t Size = 0;
+  size_t NumPops = 0;
+  size_t NumPushes = 0;
+  size_t NumDuplicates = 0;
+};
+
+} // namespace psr
+
+#endif // PHASAR_UTILS_PRIORITYEDGEWORKLIST_H
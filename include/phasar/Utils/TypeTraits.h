@@ -13,6 +13,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <iterator>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -33,11 +34,24 @@ template <typename T> using type_identity = std::type_identity<T>;
 // NOLINTBEGIN(readability-identifier-naming)
 namespace detail {
 
+namespace adl_iter {
+// llvm::adl_begin() has a deduced return type, so using it in an unevaluated
+// context is a hard error for non-iterable types. Look up begin() and end()
+// the same way, but SFINAE-friendly.
+using std::begin;
+using std::end;
+template <typename T>
+using begin_t = decltype(begin(std::declval<T &>())); // NOLINT
+template <typename T>
+using end_t = decltype(end(std::declval<T &>())); // NOLINT
+template <typename T>
+using elem_t = std::decay_t<decltype(*std::declval<begin_t<T>>())>; // NOLINT
+} // namespace adl_iter
+
 template <typename T, typename = void>
 struct is_iterable : std::false_type {}; // NOLINT
 template <typename T>
-struct is_iterable<T, std::void_t<decltype(llvm::adl_begin(std::declval<T>())),
-                                  decltype(llvm::adl_end(std::declval<T>()))>>
+struct is_iterable<T, std::void_t<adl_iter::begin_t<T>, adl_iter::end_t<T>>>
     : public std::true_type {};
 
 template <typename T, typename U, typename = void>
@@ -46,8 +60,7 @@ template <typename T, typename U>
 struct is_iterable_over<
     T, U,
     std::enable_if_t<is_iterable<T>::value &&
-                     std::is_same_v<U, std::decay_t<decltype(*llvm::adl_begin(
-                                           std::declval<T>()))>>>>
+                     std::is_same_v<U, adl_iter::elem_t<T>>>>
     : public std::true_type {};
 
 template <typename T> struct is_pair : std::false_type {}; // NOLINT
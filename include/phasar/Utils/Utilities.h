@@ -11,6 +11,7 @@
 #define PHASAR_UTILS_UTILITIES_H_
 
 #include "phasar/Utils/BitVectorSet.h"
+#include "phasar/Utils/DenseBitSet.h"
 #include "phasar/Utils/TypeTraits.h"
 
 #include "llvm/ADT/Hashing.h"
@@ -158,6 +159,11 @@ void intersectWith(BitVectorSet<T> &Dest, const BitVectorSet<T> &Src) {
   Dest.setIntersectWith(Src);
 }
 
+template <typename T>
+void intersectWith(DenseBitSet<T> &Dest, const DenseBitSet<T> &Src) {
+  Dest.setIntersectWith(Src);
+}
+
 llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
                               const std::vector<bool> &Bits);
 
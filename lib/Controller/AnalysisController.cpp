@@ -65,6 +65,11 @@ emitRequestedHelperAnalysisResults(AnalysisController::ControllerData &Data) {
       HA.getAliasInfo().printAsJson(OS);
     });
   }
+  if (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsBinary) {
+    WithResultFileOrStdout("/psr-pta.bin", [&HA](auto &OS) {
+      HA.getAliasInfo().printAsBinary(OS);
+    });
+  }
 
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitCGAsDot) {
     WithResultFileOrStdout("/psr-cg.txt",
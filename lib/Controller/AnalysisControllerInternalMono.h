@@ -12,9 +12,17 @@
 
 #include "phasar/DataFlow/Mono/Solver/InterMonoSolver.h"
 #include "phasar/DataFlow/Mono/Solver/IntraMonoSolver.h"
+#include "phasar/DataFlow/Mono/Solver/ParallelIntraMonoSolver.h"
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/IR/Function.h"
 
 #include "AnalysisControllerInternal.h"
 
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace psr::controller {
 
 template <typename SolverTy, typename ProblemTy, typename... ArgTys>
@@ -27,11 +35,42 @@ static void executeMonoAnalysis(AnalysisController::ControllerData &Data,
   emitRequestedDataFlowResults(Data, Solver);
 }
 
-template <typename ProblemTy, typename... ArgTys>
-static void executeIntraMonoAnalysis(AnalysisController::ControllerData &Data,
-                                     ArgTys &&...Args) {
-  executeMonoAnalysis<IntraMonoSolver_P<ProblemTy>, ProblemTy>(
-      Data, std::forward<ArgTys>(Args)...);
+/// With the entry points __ALL__, solves every function with a definition.
+/// Pass SolveInParallel = false for problems whose flow functions must not
+/// run concurrently, e.g., because they write to shared streams.
+template <typename ProblemTy, bool SolveInParallel = true>
+static void executeIntraMonoAnalysis(AnalysisController::ControllerData &Data) {
+  if (!llvm::hasSingleElement(Data.EntryPoints) ||
+      Data.EntryPoints.front() != "__ALL__") {
+    executeMonoAnalysis<IntraMonoSolver_P<ProblemTy>, ProblemTy>(
+        Data, Data.EntryPoints);
+    return;
+  }
+
+  auto Definitions = llvm::make_filter_range(
+      Data.HA->getProjectIRDB().getAllFunctions(),
+      [](const llvm::Function *Fun) { return !Fun->isDeclaration(); });
+
+  if constexpr (!SolveInParallel) {
+    std::vector<std::string> EntryPoints;
+    for (const auto *Fun : Definitions) {
+      EntryPoints.push_back(Fun->getName().str());
+    }
+    executeMonoAnalysis<IntraMonoSolver_P<ProblemTy>, ProblemTy>(
+        Data, std::move(EntryPoints));
+  } else {
+    // The functions are independent of each other, so solve them in
+    // parallel. Creating the first problem on this thread also makes sure
+    // that all required helper analyses are built before going parallel.
+    auto Problem =
+        createAnalysisProblem<ProblemTy>(*Data.HA, Data.EntryPoints);
+    ParallelIntraMonoSolver_P<ProblemTy> Solver(Problem);
+    Solver.solve(Definitions, [&Data](const llvm::Function *Fun) {
+      return createAnalysisProblem<ProblemTy>(
+          *Data.HA, std::vector<std::string>{Fun->getName().str()});
+    });
+    emitRequestedDataFlowResults(Data, Solver);
+  }
 }
 
 template <typename ProblemTy, typename... ArgTys>
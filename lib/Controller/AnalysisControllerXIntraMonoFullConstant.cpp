@@ -15,6 +15,5 @@ using namespace psr;
 
 void controller::executeIntraMonoFullConstant(
     AnalysisController::ControllerData &Data) {
-  executeIntraMonoAnalysis<IntraMonoFullConstantPropagation>(Data,
-                                                             Data.EntryPoints);
+  executeIntraMonoAnalysis<IntraMonoFullConstantPropagation>(Data);
 }
@@ -15,5 +15,7 @@ using namespace psr;
 
 void controller::executeIntraMonoSolverTest(
     AnalysisController::ControllerData &Data) {
-  executeIntraMonoAnalysis<IntraMonoSolverTest>(Data, Data.EntryPoints);
+  // The flow functions of IntraMonoSolverTest print to llvm::outs()
+  executeIntraMonoAnalysis<IntraMonoSolverTest, /*SolveInParallel=*/false>(
+      Data);
 }
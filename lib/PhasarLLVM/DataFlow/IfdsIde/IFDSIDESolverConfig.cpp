@@ -10,6 +10,7 @@
 #include "phasar/DataFlow/IfdsIde/IFDSIDESolverConfig.h"
 
 #include <ostream>
+#include <utility>
 
 using namespace std;
 using namespace psr;
@@ -37,6 +38,18 @@ bool IFDSIDESolverConfig::emitESG() const {
 bool IFDSIDESolverConfig::computePersistedSummaries() const {
   return hasFlag(Options, SolverConfigOptions::ComputePersistedSummaries);
 }
+bool IFDSIDESolverConfig::bottomUpScheduling() const {
+  return hasFlag(Options, SolverConfigOptions::BottomUpScheduling);
+}
+size_t IFDSIDESolverConfig::flowEdgeFunctionCacheLimit() const {
+  return FlowEdgeFunctionCacheLimit;
+}
+size_t IFDSIDESolverConfig::edgeFunctionNormalizationThreshold() const {
+  return EdgeFunctionNormalizationThreshold;
+}
+const std::string &IFDSIDESolverConfig::edgeLogFile() const {
+  return EdgeLogFile;
+}
 
 void IFDSIDESolverConfig::setFollowReturnsPastSeeds(bool Set) {
   setFlag(Options, SolverConfigOptions::FollowReturnsPastSeeds, Set);
@@ -56,6 +69,18 @@ void IFDSIDESolverConfig::setEmitESG(bool Set) {
 void IFDSIDESolverConfig::setComputePersistedSummaries(bool Set) {
   setFlag(Options, SolverConfigOptions::ComputePersistedSummaries, Set);
 }
+void IFDSIDESolverConfig::setBottomUpScheduling(bool Set) {
+  setFlag(Options, SolverConfigOptions::BottomUpScheduling, Set);
+}
+void IFDSIDESolverConfig::setFlowEdgeFunctionCacheLimit(size_t LimitInBytes) {
+  FlowEdgeFunctionCacheLimit = LimitInBytes;
+}
+void IFDSIDESolverConfig::setEdgeFunctionNormalizationThreshold(size_t Depth) {
+  EdgeFunctionNormalizationThreshold = Depth;
+}
+void IFDSIDESolverConfig::setEdgeLogFile(std::string Path) {
+  EdgeLogFile = std::move(Path);
+}
 
 void IFDSIDESolverConfig::setConfig(SolverConfigOptions Opt) { Options = Opt; }
 
@@ -68,7 +93,13 @@ ostream &operator<<(ostream &OS, const IFDSIDESolverConfig &SC) {
             << "\trecordEdges: " << SC.recordEdges() << "\n"
             << "\tcomputePersistedSummaries: " << SC.computePersistedSummaries()
             << "\n"
-            << "\temitESG: " << SC.emitESG();
+            << "\temitESG: " << SC.emitESG() << "\n"
+            << "\tbottomUpScheduling: " << SC.bottomUpScheduling() << "\n"
+            << "\tflowEdgeFunctionCacheLimit: "
+            << SC.flowEdgeFunctionCacheLimit() << "\n"
+            << "\tedgeFunctionNormalizationThreshold: "
+            << SC.edgeFunctionNormalizationThreshold() << "\n"
+            << "\tedgeLogFile: " << SC.edgeLogFile();
 }
 
 } // namespace psr
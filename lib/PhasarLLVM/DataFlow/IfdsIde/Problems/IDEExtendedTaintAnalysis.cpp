@@ -240,11 +240,7 @@ void IDEExtendedTaintAnalysis::populateWithMayAliases(SourceConfigTy &Facts) {
          "have precise points-to-info");
 
   SourceConfigTy Tmp = Facts;
-  for (const auto *Fact : Facts) {
-    auto Aliases = PT.getAliasSet(Fact);
-
-    Tmp.insert(Aliases->begin(), Aliases->end());
-  }
+  PT.insertAliasesOf(Facts, Tmp);
 
   Facts = std::move(Tmp);
 }
@@ -396,33 +392,10 @@ IDEExtendedTaintAnalysis::getRetFlowFunction(n_t CallSite, f_t CalleeFun,
     });
   }
 
-  /// Cache points-to-sets for the arguments of the CallSite for the case that
-  /// computing points-to-info is expensive (e.g. a demand-driven
-  /// pointer-analysis)
-  class ArgAliasCache {
-  public:
-    explicit ArgAliasCache(AliasInfoRef<v_t, n_t> PT, size_t NumArgs,
-                           bool HasPreciseAliasInfo)
-        : Vec(NumArgs * !!HasPreciseAliasInfo, nullptr), PT(PT) {}
-
-    AliasInfoRef<v_t, n_t>::AliasSetTy
-    getOrCreatePts(size_t Idx, const llvm::Value *Ptr,
-                   const llvm::Instruction *Call) {
-      auto &PSet = Vec[Idx];
-      return PSet ? *PSet : *(PSet = PT.getAliasSet(Ptr, Call));
-    }
-
-  private:
-    mutable std::vector<AliasInfoRef<v_t, n_t>::AliasSetPtrTy> Vec;
-    AliasInfoRef<v_t, n_t> PT;
-  };
-
   const auto *Call = llvm::cast<llvm::CallBase>(CallSite);
   return lambdaFlow([this, Call, CalleeFun,
-                     ExitStmt{llvm::cast<llvm::ReturnInst>(ExitStmt)},
-                     PTC{ArgAliasCache(PT, Call->arg_size(),
-                                       HasPreciseAliasInfo)}](
-                        d_t Source) mutable -> std::set<d_t> {
+                     ExitStmt{llvm::cast<llvm::ReturnInst>(ExitStmt)}](
+                        d_t Source) -> std::set<d_t> {
     if (isZeroValue(Source)) {
       return {Source};
     }
@@ -451,8 +424,9 @@ IDEExtendedTaintAnalysis::getRetFlowFunction(n_t CallSite, f_t CalleeFun,
         continue;
       }
 
-      for (const auto *Alias :
-           PTC.getOrCreatePts(FIt->getArgNo(), It->get(), Call)) {
+      // The alias sets are cached by PT, so we do not need to cache them
+      // per call-site here
+      for (const auto *Alias : *PT.getAliasSet(It->get(), Call)) {
         Ret.insert(FactFactory.withTransferFrom(Source, makeFlowFact(Alias)));
       }
     }
@@ -612,7 +586,7 @@ auto IDEExtendedTaintAnalysis::getNormalEdgeFunction(n_t Curr, d_t CurrNode,
   if (!DisableStrongUpdates) {
 
     /// Kill the PointerOp, if we store into it
-    if (CurrNode->mustAlias(makeFlowFact(PointerOp), PT)) {
+    if (CurrNode->mustAlias(makeFlowFact(PointerOp), PT.getUnderlying())) {
       return GenEdgeFunction{Curr};
     }
 
@@ -736,7 +710,8 @@ auto IDEExtendedTaintAnalysis::getSummaryEdgeFunction(n_t Curr, d_t CurrNode,
 
   // MemIntrinsic covers memset, memcpy and memmove
   if (const auto *MemSet = llvm::dyn_cast<llvm::MemIntrinsic>(Curr);
-      MemSet && CurrNode->mustAlias(makeFlowFact(MemSet->getRawDest()), PT)) {
+      MemSet && CurrNode->mustAlias(makeFlowFact(MemSet->getRawDest()),
+                          PT.getUnderlying())) {
     return GenEdgeFunction{Curr};
   }
 
@@ -25,8 +25,10 @@
 #include "phasar/Utils/TypeTraits.h"
 #include "phasar/Utils/Utilities.h"
 
+#include "llvm/ADT/APInt.h"
 #include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/IR/AbstractCallSite.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/Function.h"
@@ -43,6 +45,7 @@
 
 #include <limits>
 #include <memory>
+#include <optional>
 #include <utility>
 
 namespace psr {
@@ -274,6 +277,228 @@ auto hash_value(const BinOp &EF) noexcept {
 
 static_assert(is_llvm_hashable_v<BinOp>);
 
+/// Closed normal form for chains of additions, subtractions and
+/// multiplications with constants: Computes Scale * Source + Offset for all
+/// integral Source in [Lo, Hi] and Bottom otherwise. The interval [Lo, Hi]
+/// contains exactly those sources for which no intermediate result of the
+/// original chain overflows.
+struct AffineEdgeFunction {
+  using l_t = lca::l_t;
+
+  int64_t Scale{};
+  int64_t Offset{};
+  int64_t Lo{};
+  int64_t Hi{};
+
+  [[nodiscard]] l_t computeTarget(const l_t &Source) const {
+    const auto *Val = std::get_if<int64_t>(&Source);
+    if (!Val || *Val < Lo || *Val > Hi) {
+      return Bottom{};
+    }
+    return Scale * *Val + Offset;
+  }
+
+  static EdgeFunction<l_t>
+  compose(EdgeFunctionRef<AffineEdgeFunction> This,
+          const EdgeFunction<l_t> &SecondFunction) {
+    if (auto Default = defaultComposeOrNull(This, SecondFunction)) {
+      return Default;
+    }
+    return LCAEdgeFunctionComposer{This, SecondFunction};
+  }
+
+  static EdgeFunction<l_t>
+  join(EdgeFunctionRef<AffineEdgeFunction> This,
+       const EdgeFunction<l_t> &OtherFunction) {
+    if (auto Default = defaultJoinOrNull(This, OtherFunction)) {
+      return Default;
+    }
+    return AllBottom<l_t>{};
+  }
+
+  bool operator==(const AffineEdgeFunction &Other) const noexcept {
+    return Scale == Other.Scale && Offset == Other.Offset && Lo == Other.Lo &&
+           Hi == Other.Hi;
+  }
+
+  friend llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
+                                       const AffineEdgeFunction &EF) {
+    return OS << "Affine[" << EF.Scale << " * x + " << EF.Offset
+              << " for x in [" << EF.Lo << ", " << EF.Hi << "]]";
+  }
+};
+
+auto hash_value(const AffineEdgeFunction &EF) noexcept {
+  return llvm::hash_combine(EF.Scale, EF.Offset, EF.Lo, EF.Hi);
+}
+
+static_assert(is_llvm_hashable_v<AffineEdgeFunction>);
+
+/// Restricts [Lo, Hi] to those X, for which Min <= A * X + B <= Max holds.
+/// Returns false, iff the resulting interval is empty.
+static bool restrictPreImage(int64_t A, int64_t B, int64_t Min, int64_t Max,
+                             int64_t &Lo, int64_t &Hi) {
+  if (A == 0) {
+    return Min <= B && B <= Max;
+  }
+
+  static constexpr unsigned Width = 128;
+  auto BigA = llvm::APInt(Width, A, true);
+  auto BigB = llvm::APInt(Width, B, true);
+
+  auto LoNum = llvm::APInt(Width, Min, true) - BigB;
+  auto HiNum = llvm::APInt(Width, Max, true) - BigB;
+  if (A < 0) {
+    std::swap(LoNum, HiNum);
+  }
+  auto NewLo =
+      llvm::APIntOps::RoundingSDiv(LoNum, BigA, llvm::APInt::Rounding::UP);
+  auto NewHi =
+      llvm::APIntOps::RoundingSDiv(HiNum, BigA, llvm::APInt::Rounding::DOWN);
+
+  auto BigLo = llvm::APInt(Width, Lo, true);
+  auto BigHi = llvm::APInt(Width, Hi, true);
+  if (NewLo.sgt(BigHi) || NewHi.slt(BigLo) || NewLo.sgt(NewHi)) {
+    return false;
+  }
+  if (NewLo.sgt(BigLo)) {
+    Lo = NewLo.getSExtValue();
+  }
+  if (NewHi.slt(BigHi)) {
+    Hi = NewHi.getSExtValue();
+  }
+  return true;
+}
+
+/// Tries to fold the chain of edge functions that is rooted at EF into either
+/// a constant or an AffineEdgeFunction. Returns nullptr, if the chain contains
+/// an edge function that has no such normal form.
+static EdgeFunction<l_t> normalize(const EdgeFunction<l_t> &EF) {
+  llvm::SmallVector<EdgeFunction<l_t>> Leaves;
+  llvm::SmallVector<const EdgeFunction<l_t> *> WL = {&EF};
+  while (!WL.empty()) {
+    const auto *Curr = WL.pop_back_val();
+    if (const auto *Comp = Curr->dyn_cast<LCAEdgeFunctionComposer>()) {
+      // First is applied before Second
+      WL.push_back(&Comp->Second);
+      WL.push_back(&Comp->First);
+    } else {
+      Leaves.push_back(*Curr);
+    }
+  }
+
+  static constexpr auto IntMin = std::numeric_limits<int64_t>::min();
+  static constexpr auto IntMax = std::numeric_limits<int64_t>::max();
+
+  std::optional<l_t> Const;
+  AffineEdgeFunction Affine{1, 0, IntMin, IntMax};
+  bool HasArithmetic = false;
+
+  // Composes Affine with Y -> P * Y + Q, where Y must lie in [Min, Max].
+  // Returns false, if the coefficients of the result are not representable.
+  auto Apply = [&Affine, &Const](int64_t P, int64_t Q, int64_t Min,
+                                 int64_t Max) {
+    int64_t A{};
+    int64_t B{};
+    if (llvm::MulOverflow(P, Affine.Scale, A) ||
+        llvm::MulOverflow(P, Affine.Offset, B) ||
+        llvm::AddOverflow(B, Q, B)) {
+      return false;
+    }
+    // Y in [Min, Max] and P * Y + Q must not overflow
+    if (!restrictPreImage(Affine.Scale, Affine.Offset, Min, Max, Affine.Lo,
+                          Affine.Hi) ||
+        !restrictPreImage(A, B, IntMin, IntMax, Affine.Lo, Affine.Hi)) {
+      Const = Bottom{};
+      return true;
+    }
+    Affine.Scale = A;
+    Affine.Offset = B;
+    return true;
+  };
+
+  for (const auto &Leaf : Leaves) {
+    if (llvm::isa<EdgeIdentity<l_t>>(Leaf)) {
+      continue;
+    }
+    if (llvm::isa<GenConstant>(Leaf) || llvm::isa<AllBottom<l_t>>(Leaf)) {
+      Const = Leaf.computeTarget(Bottom{});
+      continue;
+    }
+    if (Const) {
+      if (!llvm::isa<BinOp>(Leaf) && !llvm::isa<AffineEdgeFunction>(Leaf)) {
+        return nullptr;
+      }
+      Const = Leaf.computeTarget(*Const);
+      continue;
+    }
+
+    if (const auto *Aff = Leaf.dyn_cast<AffineEdgeFunction>()) {
+      HasArithmetic = true;
+      if (!Apply(Aff->Scale, Aff->Offset, Aff->Lo, Aff->Hi)) {
+        return nullptr;
+      }
+      continue;
+    }
+
+    const auto *Op = Leaf.dyn_cast<BinOp>();
+    if (!Op) {
+      return nullptr;
+    }
+    const auto *LIC = llvm::dyn_cast<llvm::ConstantInt>(Op->Lop);
+    const auto *RIC = llvm::dyn_cast<llvm::ConstantInt>(Op->Rop);
+    if (LLVMZeroValue::isLLVMZeroValue(Op->CurrNode) && LIC && RIC) {
+      // Independent of the source value
+      Const = Leaf.computeTarget(Bottom{});
+      continue;
+    }
+
+    HasArithmetic = true;
+    bool VarIsLeft = Op->Lop == Op->CurrNode && RIC;
+    bool VarIsRight = Op->Rop == Op->CurrNode && LIC;
+    if (VarIsLeft == VarIsRight) {
+      return nullptr;
+    }
+    int64_t C = VarIsLeft ? RIC->getSExtValue() : LIC->getSExtValue();
+
+    bool Success = [&] {
+      switch (Op->Op) {
+      case llvm::Instruction::Add:
+        return Apply(1, C, IntMin, IntMax);
+      case llvm::Instruction::Sub:
+        if (VarIsRight) {
+          return Apply(-1, C, IntMin, IntMax);
+        }
+        if (C == IntMin) {
+          return false;
+        }
+        return Apply(1, -C, IntMin, IntMax);
+      case llvm::Instruction::Mul:
+        return Apply(C, 0, IntMin, IntMax);
+      default:
+        return false;
+      }
+    }();
+    if (!Success) {
+      return nullptr;
+    }
+  }
+
+  if (Const) {
+    if (const auto *Val = std::get_if<int64_t>(&*Const)) {
+      return GenConstant{*Val};
+    }
+    if (*Const == Bottom{}) {
+      return AllBottom<l_t>{};
+    }
+    return nullptr;
+  }
+  if (!HasArithmetic) {
+    return nullptr;
+  }
+  return Affine;
+}
+
 } // namespace lca
 
 IDELinearConstantAnalysis::IDELinearConstantAnalysis(
@@ -525,6 +750,14 @@ IDELinearConstantAnalysis::getNormalEdgeFunction(n_t Curr, d_t CurrNode,
   return EdgeIdentity<l_t>{};
 }
 
+EdgeFunction<lca::l_t>
+IDELinearConstantAnalysis::normalizeEdgeFunction(EdgeFunction<l_t> EF) {
+  if (auto Normalized = lca::normalize(EF)) {
+    return Normalized;
+  }
+  return EF;
+}
+
 EdgeFunction<lca::l_t> IDELinearConstantAnalysis::getCallEdgeFunction(
     n_t CallSite, d_t SrcNode, f_t /*DestinationFunction*/, d_t DestNode) {
   // Case: Passing constant integer as parameter
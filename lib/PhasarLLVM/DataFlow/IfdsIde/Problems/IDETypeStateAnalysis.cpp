@@ -263,16 +263,7 @@ auto IDETypeStateAnalysisBase::getRelevantAllocas(d_t V) -> container_type {
 }
 
 auto IDETypeStateAnalysisBase::getWMAliasSet(d_t V) -> container_type {
-  if (AliasCache.find(V) != AliasCache.end()) {
-    container_type AliasSet(AliasCache[V].begin(), AliasCache[V].end());
-    return AliasSet;
-  }
   auto PTS = PT.getAliasSet(V);
-  for (const auto *Alias : *PTS) {
-    if (hasMatchingType(Alias)) {
-      AliasCache[Alias] = *PTS;
-    }
-  }
   container_type AliasSet(PTS->begin(), PTS->end());
   return AliasSet;
 }
@@ -18,14 +18,17 @@
 #include "phasar/PhasarLLVM/DataFlow/IfdsIde/LLVMZeroValue.h"
 #include "phasar/PhasarLLVM/Domain/LLVMAnalysisDomain.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMAliasInfo.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
 #include "phasar/PhasarLLVM/TaintConfig/TaintConfigUtilities.h"
 #include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
 #include "phasar/PhasarLLVM/Utils/LLVMIRToSrc.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
+#include "phasar/Utils/CompactIdSet.h"
 #include "phasar/Utils/Logger.h"
 
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Demangle/Demangle.h"
 #include "llvm/IR/AbstractCallSite.h"
 #include "llvm/IR/GlobalVariable.h"
@@ -37,6 +40,9 @@
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <utility>
 
 namespace psr {
@@ -152,26 +158,54 @@ static bool isCompiletimeConstantData(const llvm::Value *Val) noexcept {
 }
 
 void IFDSTaintAnalysis::populateWithMayAliases(
-    container_type &Facts, const llvm::Instruction *Context) const {
+    container_type &Facts, const llvm::Instruction *Context) {
   container_type Tmp = Facts;
-  for (const auto *Fact : Facts) {
-    auto Aliases = PT.getAliasSet(Fact);
-    for (const auto *Alias : *Aliases) {
-      if (canSkipAtContext(Alias, Context)) {
-        continue;
-      }
+  auto AddAlias = [this, &Tmp, Context](const llvm::Value *Alias) {
+    if (canSkipAtContext(Alias, Context)) {
+      return;
+    }
 
-      if (isCompiletimeConstantData(Alias)) {
-        continue;
-      }
+    if (isCompiletimeConstantData(Alias)) {
+      return;
+    }
 
-      if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(Alias)) {
-        // Handle at least one level of indirection...
-        const auto *PointerOp = Load->getPointerOperand()->stripPointerCasts();
-        Tmp.insert(PointerOp);
+    if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(Alias)) {
+      // Handle at least one level of indirection...
+      const auto *PointerOp = Load->getPointerOperand()->stripPointerCasts();
+      Tmp.insert(PointerOp);
+    }
+
+    Tmp.insert(Alias);
+  };
+
+  if (auto *ASet = PT.getUnderlying().dyn_cast<LLVMAliasSet>()) {
+    // All facts of the same alias set share one CompactIdSet, so we traverse
+    // each alias set only once and never materialize it as DenseSet.
+    // Computing the alias set of a fact may merge the alias sets of facts that
+    // we have already queried; query again until all snapshots are current.
+    llvm::SmallVector<std::shared_ptr<const CompactIdSet>> Sets;
+    uint64_t Generation{};
+    do {
+      Generation = ASet->getGeneration();
+      Sets.clear();
+      for (const auto *Fact : Facts) {
+        Sets.push_back(ASet->getCompactAliasSet(Fact));
       }
+    } while (Generation != ASet->getGeneration());
 
-      Tmp.insert(Alias);
+    llvm::sort(Sets);
+    Sets.erase(std::unique(Sets.begin(), Sets.end()), Sets.end());
+    for (const auto &Set : Sets) {
+      for (uint32_t Id : *Set) {
+        AddAlias(ASet->getValueFromId(Id));
+      }
+    }
+  } else {
+    for (const auto *Fact : Facts) {
+      auto Aliases = PT.getAliasSet(Fact);
+      for (const auto *Alias : *Aliases) {
+        AddAlias(Alias);
+      }
     }
   }
 
@@ -15,11 +15,11 @@
 #include "phasar/PhasarLLVM/TaintConfig/TaintConfigUtilities.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
-#include "phasar/Utils/BitVectorSet.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/Utilities.h"
 
 #include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/InstrTypes.h"
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/Instructions.h"
@@ -36,7 +36,27 @@ InterMonoTaintAnalysis::InterMonoTaintAnalysis(
     const LLVMTaintConfig &Config, std::vector<std::string> EntryPoints)
     : InterMonoProblem<InterMonoTaintAnalysisDomain>(IRDB, TH, ICF, PT,
                                                      std::move(EntryPoints)),
-      Config(Config) {}
+      Config(Config) {
+  const auto *Mod = IRDB->getModule();
+  FactIndex->reserve(IRDB->getNumInstructions() + Mod->global_size());
+  for (const auto &Glob : Mod->globals()) {
+    FactIndex->getOrInsert(&Glob);
+  }
+  for (const auto *Fun : IRDB->getAllFunctions()) {
+    for (const auto &Arg : Fun->args()) {
+      FactIndex->getOrInsert(&Arg);
+    }
+    for (const auto &Inst : llvm::instructions(Fun)) {
+      if (!Inst.getType()->isVoidTy()) {
+        FactIndex->getOrInsert(&Inst);
+      }
+    }
+  }
+}
+
+InterMonoTaintAnalysis::mono_container_t InterMonoTaintAnalysis::allTop() {
+  return mono_container_t(FactIndex);
+}
 
 InterMonoTaintAnalysis::mono_container_t InterMonoTaintAnalysis::merge(
     const InterMonoTaintAnalysis::mono_container_t &Lhs,
@@ -87,7 +107,7 @@ InterMonoTaintAnalysis::mono_container_t InterMonoTaintAnalysis::callFlow(
     InterMonoTaintAnalysis::n_t CallSite, const llvm::Function *Callee,
     const InterMonoTaintAnalysis::mono_container_t &In) {
   PHASAR_LOG_LEVEL(DEBUG, "InterMonoTaintAnalysis::callFlow()");
-  InterMonoTaintAnalysis::mono_container_t Out;
+  InterMonoTaintAnalysis::mono_container_t Out(FactIndex);
   const auto *CS = llvm::cast<llvm::CallBase>(CallSite);
   for (unsigned Idx = 0; Idx < Callee->arg_size(); ++Idx) {
     if (In.count(CS->getArgOperand(Idx))) {
@@ -103,7 +123,7 @@ InterMonoTaintAnalysis::mono_container_t InterMonoTaintAnalysis::returnFlow(
     InterMonoTaintAnalysis::n_t /*RetSite*/,
     const InterMonoTaintAnalysis::mono_container_t &In) {
   PHASAR_LOG_LEVEL(DEBUG, "InterMonoTaintAnalysis::returnFlow()");
-  InterMonoTaintAnalysis::mono_container_t Out;
+  InterMonoTaintAnalysis::mono_container_t Out(FactIndex);
   if (const auto *Ret = llvm::dyn_cast<llvm::ReturnInst>(ExitStmt)) {
     if (In.count(Ret->getReturnValue())) {
       Out.insert(CallSite);
@@ -129,8 +149,8 @@ InterMonoTaintAnalysis::mono_container_t InterMonoTaintAnalysis::callToRetFlow(
   PHASAR_LOG_LEVEL(DEBUG, "InterMonoTaintAnalysis::callToRetFlow()");
   InterMonoTaintAnalysis::mono_container_t Out(In);
   const auto *CS = llvm::cast<llvm::CallBase>(CallSite);
-  mono_container_t Gen;
-  mono_container_t Kill;
+  mono_container_t Gen(FactIndex);
+  mono_container_t Kill(FactIndex);
   bool First = true;
   //-----------------------------------------------------------------------------
   // Handle virtual calls in the loop
@@ -146,7 +166,7 @@ InterMonoTaintAnalysis::mono_container_t InterMonoTaintAnalysis::callToRetFlow(
       First = false;
       collectSanitizedFacts(Kill, Config, CS, Callee);
     } else {
-      mono_container_t Tmp;
+      mono_container_t Tmp(FactIndex);
       collectSanitizedFacts(Tmp, Config, CS, Callee);
       intersectWith(Kill, Tmp);
     }
@@ -173,7 +193,7 @@ InterMonoTaintAnalysis::initialSeeds() {
   std::unordered_map<InterMonoTaintAnalysis::n_t,
                      InterMonoTaintAnalysis::mono_container_t>
       Seeds;
-  InterMonoTaintAnalysis::mono_container_t Facts;
+  InterMonoTaintAnalysis::mono_container_t Facts(FactIndex);
   for (unsigned Idx = 0; Idx < Main->arg_size(); ++Idx) {
     Facts.insert(getNthFunctionArgument(Main, Idx));
   }
@@ -14,9 +14,9 @@
 #include "phasar/PhasarLLVM/Pointer/LLVMAliasInfo.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
-#include "phasar/Utils/BitVectorSet.h"
 
 #include "llvm/IR/Constants.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/Value.h"
@@ -34,15 +34,21 @@ IntraMonoUninitVariables::IntraMonoUninitVariables(
     std::vector<std::string> EntryPoints)
     : IntraMonoProblem<IntraMonoUninitVariablesDomain>(IRDB, TH, CF, PT,
                                                        std::move(EntryPoints)) {
+  for (const auto &EntryPoint : this->EntryPoints) {
+    if (const auto *Fun = IRDB->getFunctionDefinition(EntryPoint)) {
+      for (const auto &Inst : llvm::instructions(Fun)) {
+        if (llvm::isa<llvm::AllocaInst>(Inst)) {
+          FactIndex->getOrInsert(&Inst);
+        }
+      }
+    }
+  }
 }
 
 IntraMonoUninitVariables::mono_container_t IntraMonoUninitVariables::merge(
     const IntraMonoUninitVariables::mono_container_t &Lhs,
     const IntraMonoUninitVariables::mono_container_t &Rhs) {
-  IntraMonoUninitVariables::mono_container_t Intersect;
-  std::set_intersection(Lhs.begin(), Lhs.end(), Rhs.begin(), Rhs.end(),
-                        std::inserter(Intersect, Intersect.begin()));
-  return Intersect;
+  return Lhs.setIntersect(Rhs);
 }
 
 bool IntraMonoUninitVariables::equal_to(
@@ -52,7 +58,7 @@ bool IntraMonoUninitVariables::equal_to(
 }
 
 IntraMonoUninitVariables::mono_container_t IntraMonoUninitVariables::allTop() {
-  return {};
+  return mono_container_t(FactIndex);
 }
 
 IntraMonoUninitVariables::mono_container_t IntraMonoUninitVariables::normalFlow(
@@ -2,6 +2,7 @@
 
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedCFG.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Timer.h"
 
 #include "llvm/Demangle/Demangle.h"
 #include "llvm/IR/Instructions.h"
@@ -44,10 +45,35 @@ auto LLVMPathConstraints::internalGetConstraintAndVariablesFromEdge(
   return std::nullopt;
 }
 
+auto LLVMPathConstraints::getOrCreateEdgeConstraint(
+    const llvm::Instruction *From, const llvm::Instruction *To)
+    -> const std::optional<ConstraintAndVariables> & {
+  if (auto It = EdgeConstraints.find({From, To});
+      It != EdgeConstraints.end()) {
+    ++Stats.NumEdgeCacheHits;
+    return It->second;
+  }
+
+  ++Stats.NumEdgeTranslations;
+  Timer TranslationTimer([this](std::chrono::nanoseconds Elapsed) {
+    Stats.TranslationTime += Elapsed;
+  });
+
+  auto CV = internalGetConstraintAndVariablesFromEdge(From, To);
+  if (CV) {
+    /// Deduplicate the Variables vector
+    std::sort(CV->Variables.begin(), CV->Variables.end());
+    CV->Variables.erase(std::unique(CV->Variables.begin(), CV->Variables.end()),
+                        CV->Variables.end());
+  }
+
+  return EdgeConstraints.try_emplace({From, To}, std::move(CV)).first->second;
+}
+
 std::optional<z3::expr>
 LLVMPathConstraints::getConstraintFromEdge(const llvm::Instruction *Curr,
                                            const llvm::Instruction *Succ) {
-  if (auto CV = internalGetConstraintAndVariablesFromEdge(Curr, Succ)) {
+  if (auto CV = getConstraintAndVariablesFromEdge(Curr, Succ)) {
     return CV->Constraint;
   }
 
@@ -57,15 +83,49 @@ LLVMPathConstraints::getConstraintFromEdge(const llvm::Instruction *Curr,
 auto LLVMPathConstraints::getConstraintAndVariablesFromEdge(
     const llvm::Instruction *Curr, const llvm::Instruction *Succ)
     -> std::optional<ConstraintAndVariables> {
-  auto CV = internalGetConstraintAndVariablesFromEdge(Curr, Succ);
-  if (CV) {
-    /// Deduplicate the Variables vector
-    std::sort(CV->Variables.begin(), CV->Variables.end());
-    CV->Variables.erase(std::unique(CV->Variables.begin(), CV->Variables.end()),
-                        CV->Variables.end());
+  ++Stats.NumEdgeQueries;
+
+  // Only edges starting at a conditional branch carry a constraint. Don't
+  // bloat the cache with all the others.
+  const auto *BI = llvm::dyn_cast<llvm::BranchInst>(Curr);
+  if (!BI || !BI->isConditional()) {
+    return std::nullopt;
   }
 
-  return CV;
+  return getOrCreateEdgeConstraint(Curr, Succ);
+}
+
+void LLVMPathConstraints::invalidate(const llvm::Function *F) {
+  auto BelongsToF = [F](const llvm::Value *V) {
+    if (const auto *Inst = llvm::dyn_cast<llvm::Instruction>(V)) {
+      return Inst->getFunction() == F;
+    }
+    if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(V)) {
+      return Arg->getParent() == F;
+    }
+    return false;
+  };
+
+  for (auto It = Z3Expr.begin(), End = Z3Expr.end(); It != End;) {
+    if (BelongsToF(It->first)) {
+      It = Z3Expr.erase(It);
+    } else {
+      ++It;
+    }
+  }
+
+  for (auto It = EdgeConstraints.begin(), End = EdgeConstraints.end();
+       It != End;) {
+    auto Curr = It++;
+    if (BelongsToF(Curr->first.first)) {
+      EdgeConstraints.erase(Curr);
+    }
+  }
+}
+
+void LLVMPathConstraints::invalidateAll() noexcept {
+  Z3Expr.clear();
+  EdgeConstraints.clear();
 }
 
 // void LLVMPathConstraints::getConstraintsInPath(
@@ -369,7 +429,7 @@ auto LLVMPathConstraints::handleCmpInst(const llvm::CmpInst *Cmp)
     break;
   }
 
-  return LhsZ3Expr;
+  return Z3Expr.try_emplace(Cmp, std::move(LhsZ3Expr)).first->second;
 }
 
 auto LLVMPathConstraints::handleBinaryOperator(
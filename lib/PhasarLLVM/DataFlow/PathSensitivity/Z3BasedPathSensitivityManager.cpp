@@ -1,17 +1,26 @@
+#include "phasar/DataFlow/PathSensitivity/FlowPathEnumerator.h"
 #include "phasar/PhasarLLVM/DataFlow/PathSensitivity/LLVMPathConstraints.h"
 #include "phasar/PhasarLLVM/DataFlow/PathSensitivity/Z3BasedPathSensitvityManager.h"
+#include "phasar/PhasarLLVM/DataFlow/PathSensitivity/Z3ConstraintCache.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
 
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/IntrinsicInst.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <vector>
 
 namespace psr {
 z3::expr Z3BasedPathSensitivityManagerBase::filterOutUnreachableNodes(
     graph_type &RevDAG, vertex_t Leaf,
-    const Z3BasedPathSensitivityConfig &Config,
-    LLVMPathConstraints &LPC) const {
+    const Z3BasedPathSensitivityConfig &Config, LLVMPathConstraints &LPC,
+    Z3ConstraintCache *Cache) const {
 
   struct FilterContext {
     llvm::BitVector Visited{};
@@ -39,8 +48,8 @@ z3::expr Z3BasedPathSensitivityManagerBase::filterOutUnreachableNodes(
   }
 
   // NOLINTNEXTLINE(readability-identifier-naming)
-  auto doFilter = [&Ctx, &RevDAG, &LPC, Leaf](auto &doFilter,
-                                              vertex_t Vtx) -> z3::expr {
+  auto doFilter = [&Ctx, &RevDAG, &LPC, Cache, Leaf](auto &doFilter,
+                                                     vertex_t Vtx) -> z3::expr {
     Ctx.Visited.set(Vtx);
     z3::expr X = Ctx.True;
     llvm::ArrayRef<n_t> PartialPath = graph_traits_t::node(RevDAG, Vtx);
@@ -76,7 +85,7 @@ z3::expr Z3BasedPathSensitivityManagerBase::filterOutUnreachableNodes(
 
       Ctx.Solver.add(Y);
 
-      auto Sat = Ctx.Solver.check();
+      auto Sat = Cache ? Cache->check(Ctx.Solver) : Ctx.Solver.check();
       if (Sat == z3::check_result::unsat) {
         Iter = graph_traits_t::removeEdge(RevDAG, Vtx, It);
         Ctx.Ctr++;
@@ -322,8 +331,9 @@ public:
 
   ConstraintPathFilter(LLVMPathConstraints &LPC,
                        const z3::expr &AdditionalConstraint,
-                       size_t *CompletedCtr) noexcept
-      : LPC(LPC), Solver(LPC.getContext()), CompletedCtr(*CompletedCtr) {
+                       size_t *CompletedCtr, Z3ConstraintCache *Cache) noexcept
+      : LPC(LPC), Solver(LPC.getContext()), Cache(Cache),
+        CompletedCtr(*CompletedCtr) {
     Solver.add(AdditionalConstraint);
     Solver.push();
     NumAtomsStack.push_back(0);
@@ -369,9 +379,11 @@ public:
       return true;
     }
 
+    /// Only the final check of a path needs a model
+    bool RequireModel = NeedSolverInvocation;
     NeedSolverInvocation = false;
 
-    auto Res = Solver.check();
+    auto Res = Cache ? Cache->check(Solver, RequireModel) : Solver.check();
     ++Ctr;
 #ifdef DYNAMIC_LOG
     if (Ctr % 10000 == 0) {
@@ -389,7 +401,7 @@ public:
     auto Ret = Res != z3::check_result::unsat;
     if (!Ret) {
       ++RejectedCtr;
-    } else {
+    } else if (RequireModel || !Cache) {
       Model = Solver.get_model();
     }
 
@@ -441,6 +453,7 @@ private:
 
   LLVMPathConstraints &LPC;
   z3::solver Solver;
+  Z3ConstraintCache *Cache{};
   llvm::SmallSetVector<const llvm::Value *, 8> SymbolicAtoms;
   llvm::SmallVector<unsigned> NumAtomsStack;
   llvm::SmallVector<const llvm::Value *> LocalAtoms;
@@ -453,10 +466,24 @@ private:
   size_t &CompletedCtr;
 };
 
+using Z3PathFilters = PathFilterList<CallStackPathFilter, ConstraintPathFilter>;
+
+static Z3PathFilters
+makeZ3PathFilters(LLVMPathConstraints &LPC,
+                  const Z3BasedPathSensitivityConfig &Config,
+                  size_t *CompletedCtr, Z3ConstraintCache *Cache) {
+  return Z3PathFilters(
+      CallStackPathFilter{},
+      ConstraintPathFilter{
+          LPC,
+          Config.AdditionalConstraint.value_or(LPC.getContext().bool_val(true)),
+          CompletedCtr, Cache});
+}
+
 auto Z3BasedPathSensitivityManagerBase::filterAndFlattenRevDag(
-    graph_type &RevDAG, vertex_t Leaf, n_t FinalInst,
-    const Z3BasedPathSensitivityConfig &Config, LLVMPathConstraints &LPC) const
-    -> FlowPathSequence<n_t> {
+    const graph_type &RevDAG, vertex_t Leaf, n_t FinalInst,
+    const Z3BasedPathSensitivityConfig &Config, LLVMPathConstraints &LPC,
+    Z3ConstraintCache *Cache) const -> FlowPathSequence<n_t> {
   /// Here, we do the following:
   /// - Traversing the ReverseDAG in a simple DFS order and maintaining the
   ///   exact path reaching the current node.
@@ -480,89 +507,191 @@ auto Z3BasedPathSensitivityManagerBase::filterAndFlattenRevDag(
 
   FlowPathSequence<n_t> Ret;
   size_t CompletedCtr = 0;
-  auto Filters = makePathFilterList(
-      CallStackPathFilter{},
-      ConstraintPathFilter{
-          LPC,
-          Config.AdditionalConstraint.value_or(LPC.getContext().bool_val(true)),
-          &CompletedCtr});
-
-  llvm::SmallVector<n_t, 0> CurrPath;
+  FlowPathEnumerator<graph_type, Z3PathFilters> Enumerator(
+      RevDAG, FinalInst, makeZ3PathFilters(LPC, Config, &CompletedCtr, Cache));
+  Enumerator.setLeaf(Leaf);
+
+  Enumerator.forEach([&Ret, &CompletedCtr,
+                      MaxNumPaths{Config.NumPathsThreshold}](
+                         llvm::ArrayRef<n_t> CurrPath, Z3PathFilters &Filters) {
+    assert(!CurrPath.empty() && "Reported paths must not be empty!");
+    auto &Constraints = std::get<ConstraintPathFilter>(Filters);
+    Ret.emplace_back(CurrPath, Constraints.getPathConstraints(),
+                     Constraints.getModel());
+    return ++CompletedCtr < MaxNumPaths;
+  });
+
+  const auto &Filters = Enumerator.getFilter();
+  PHASAR_LOG_LEVEL_CAT(DEBUG, "PathSensitivityManager",
+                       "Num Solver invocations: "
+                           << std::get<1>(Filters).getNumSolverInvocations());
 
-  n_t Prev = nullptr;
+  return Ret;
+}
 
-  auto doFilter = [FinalInst, &Prev, &Filters, &RevDAG, &CurrPath, &Ret,
-                   &CompletedCtr, MaxNumPaths{Config.NumPathsThreshold},
-                   Leaf](auto &doFilter, vertex_t Vtx) {
-    auto CurrPathSave = CurrPath.size();
-    scope_exit RestoreCurrPath = [&CurrPath, CurrPathSave] {
-      assert(CurrPathSave <= CurrPath.size());
-      CurrPath.resize(CurrPathSave);
-    };
+static z3::expr translateExpr(const z3::expr &Expr, z3::context &To) {
+  return z3::expr(To, Z3_translate(Expr.ctx(), Expr, To));
+}
 
-    const auto *PrevSave = Prev;
-    scope_exit RestorePrev = [PrevSave, &Prev] { Prev = PrevSave; };
+auto Z3BasedPathSensitivityManagerBase::filterAndFlattenRevDagParallel(
+    const graph_type &RevDAG, vertex_t Leaf, n_t FinalInst,
+    const Z3BasedPathSensitivityConfig &Config, LLVMPathConstraints &LPC,
+    Z3ConstraintCache *Cache,
+    llvm::SmallVectorImpl<std::unique_ptr<LLVMPathConstraints>> &WorkerLPCs)
+    const -> FlowPathSequence<n_t> {
+  /// z3::contexts must not be shared between threads. So, each worker gets
+  /// its own context together with a private copy of the DAG that only
+  /// contains a subset of the roots. As the workers remove edges from their
+  /// DAG, they could not share a single one anyway.
+  struct Worker {
+    LLVMPathConstraints &LPC;
+    Z3BasedPathSensitivityConfig Config;
+    graph_type Dag;
+    FlowPathSequence<n_t> Paths{};
+
+    Worker(LLVMPathConstraints &LPC, const Z3BasedPathSensitivityConfig &Config,
+           const graph_type &Dag)
+        : LPC(LPC), Config(Config), Dag(Dag) {}
+  };
 
-    Filters.saveState();
-    scope_exit RestoreFilters = [&Filters] { Filters.restoreState(); };
+  auto NumRoots = RevDAG.Roots.size();
+  auto NumThreads =
+      llvm::hardware_concurrency(Config.NumThreads).compute_thread_count();
+  auto NumWorkers = std::min<size_t>(NumRoots, NumThreads);
+  auto RootsPerWorker = (NumRoots + NumWorkers - 1) / NumWorkers;
+
+  /// Everything that touches the context of LPC must happen on this thread
+  std::vector<std::unique_ptr<Worker>> Workers;
+  Workers.reserve(NumWorkers);
+  while (WorkerLPCs.size() < NumWorkers) {
+    WorkerLPCs.push_back(std::make_unique<LLVMPathConstraints>(
+        nullptr, LPC.ignoresDebugInstructions()));
+  }
+  for (size_t I = 0; I < NumRoots; I += RootsPerWorker) {
+    auto &W = *Workers.emplace_back(std::make_unique<Worker>(
+        *WorkerLPCs[Workers.size()], Config, RevDAG));
+    if (Config.AdditionalConstraint) {
+      W.Config.AdditionalConstraint =
+          translateExpr(*Config.AdditionalConstraint, W.LPC.getContext());
+    }
+    W.Dag.Roots.assign(std::next(RevDAG.Roots.begin(), I),
+                       std::next(RevDAG.Roots.begin(),
+                                 std::min(NumRoots, I + RootsPerWorker)));
+  }
 
-    for (const auto *Inst : llvm::reverse(graph_traits_t::node(RevDAG, Vtx))) {
-      CurrPath.push_back(Inst);
-      if (!Prev) {
-        Prev = Inst;
-        continue;
-      }
+  {
+    llvm::ThreadPool Pool(llvm::hardware_concurrency(NumWorkers));
+    std::vector<std::shared_future<void>> Tasks;
+    Tasks.reserve(Workers.size());
+    for (auto &W : Workers) {
+      Tasks.push_back(Pool.async([this, &W = *W, Leaf, FinalInst, Cache] {
+        auto Constraint =
+            filterOutUnreachableNodes(W.Dag, Leaf, W.Config, W.LPC, Cache);
+        if (Constraint.is_false()) {
+          return;
+        }
+        W.Paths = filterAndFlattenRevDag(W.Dag, Leaf, FinalInst, W.Config,
+                                         W.LPC, Cache);
+      }));
+    }
+    // Propagates the first exception that was thrown by a worker
+    for (auto &Task : Tasks) {
+      Task.get();
+    }
+  }
 
-      Filters.saveEdge(Prev, Inst);
+  /// The workers got consecutive ranges of the roots and each worker reports
+  /// its paths in the order of its roots. So, concatenating their paths yields
+  /// the same order as a single enumeration over all roots. Apply the
+  /// threshold to this sequence, such that the surviving paths neither depend
+  /// on the scheduling nor on the number of workers.
+  size_t NumPaths = 0;
+  for (const auto &W : Workers) {
+    NumPaths += W->Paths.size();
+  }
+  NumPaths = std::min(NumPaths, Config.NumPathsThreshold);
 
-      Prev = Inst;
+  auto &Z3Ctx = LPC.getContext();
+  FlowPathSequence<n_t> Ret;
+  Ret.reserve(NumPaths);
+  for (auto &W : Workers) {
+    for (auto &Path : W->Paths) {
+      if (Ret.size() == NumPaths) {
+        break;
+      }
+      Ret.emplace_back(Path.Path, translateExpr(Path.Constraint, Z3Ctx),
+                       z3::model(Path.Model, Z3Ctx, z3::model::translate{}));
     }
+  }
 
-    if (Vtx == Leaf) {
-      // llvm::errs() << "> Reached Leaf!\n";
+  deduplicatePaths(Ret);
 
-      assert(!CurrPath.empty() && "Reported paths must not be empty!");
+  PHASAR_LOG_LEVEL_CAT(DEBUG, "PathSensitivityManager",
+                       "Checked " << NumRoots << " roots on " << Workers.size()
+                                  << " workers");
+  return Ret;
+}
 
-      /// Reached the end
-      /// TODO: No need to add the final inst separately anymore. Now, it
-      /// has its own PathNode and is handled implicitly
-      if (Filters.saveFinalEdge(Prev, FinalInst)) {
-        auto Model = std::get<1>(Filters).getModel();
-        Ret.emplace_back(CurrPath, std::get<1>(Filters).getPathConstraints(),
-                         Model);
-        ++CompletedCtr;
-      }
+struct Z3BasedPathSensitivityManagerBase::FlowPathStream::Impl {
+  graph_type RevDAG;
+  size_t CompletedCtr = 0;
+  size_t MaxNumPaths{};
+  FlowPathEnumerator<graph_type, Z3PathFilters> Enumerator;
+
+  Impl(graph_type &&RevDAG, vertex_t Leaf, n_t FinalInst,
+       const Z3BasedPathSensitivityConfig &Config, LLVMPathConstraints &LPC,
+       Z3ConstraintCache *Cache, PathEnumerationOrder Order)
+      : RevDAG(std::move(RevDAG)), MaxNumPaths(Config.NumPathsThreshold),
+        Enumerator(this->RevDAG, FinalInst,
+                   makeZ3PathFilters(LPC, Config, &CompletedCtr, Cache),
+                   Order) {
+    Enumerator.setLeaf(Leaf);
+  }
+};
 
-      return;
-    }
-    if (graph_traits_t::outDegree(RevDAG, Vtx) == 0) {
-      llvm::report_fatal_error("Non-leaf node has no successors!");
-    }
+Z3BasedPathSensitivityManagerBase::FlowPathStream::FlowPathStream(
+    std::unique_ptr<Impl> PImpl) noexcept
+    : PImpl(std::move(PImpl)) {}
 
-    if (CompletedCtr >= MaxNumPaths) {
-      return;
-    }
-    if (!Filters.isValid()) {
-      return;
-    }
-    /// TODO: Verify that we have no concurrent modification here and the
-    /// iterator is never dangling!
-    for (auto Edge : graph_traits_t::outEdges(RevDAG, Vtx)) {
-      doFilter(doFilter, graph_traits_t::target(Edge));
-    }
-  };
+Z3BasedPathSensitivityManagerBase::FlowPathStream::FlowPathStream(
+    FlowPathStream &&) noexcept = default;
+auto Z3BasedPathSensitivityManagerBase::FlowPathStream::operator=(
+    FlowPathStream &&) noexcept -> FlowPathStream & = default;
+Z3BasedPathSensitivityManagerBase::FlowPathStream::~FlowPathStream() = default;
 
-  for (auto Rt : graph_traits_t::roots(RevDAG)) {
-    doFilter(doFilter, Rt);
+auto Z3BasedPathSensitivityManagerBase::FlowPathStream::next()
+    -> std::optional<FlowPath<n_t>> {
+  if (!PImpl || PImpl->CompletedCtr >= PImpl->MaxNumPaths) {
+    return std::nullopt;
   }
 
-  PHASAR_LOG_LEVEL_CAT(DEBUG, "PathSensitivityManager",
-                       "Num Solver invocations: "
-                           << std::get<1>(Filters).getNumSolverInvocations());
-
+  std::optional<FlowPath<n_t>> Ret;
+  PImpl->Enumerator.next(
+      [&Ret](llvm::ArrayRef<n_t> CurrPath, Z3PathFilters &Filters) {
+        auto &Constraints = std::get<ConstraintPathFilter>(Filters);
+        Ret.emplace(CurrPath, Constraints.getPathConstraints(),
+                    Constraints.getModel());
+      });
+  if (Ret) {
+    ++PImpl->CompletedCtr;
+  }
   return Ret;
 }
 
+size_t Z3BasedPathSensitivityManagerBase::FlowPathStream::getNumPathsEmitted()
+    const noexcept {
+  return PImpl ? PImpl->Enumerator.getNumPathsEmitted() : 0;
+}
+
+auto Z3BasedPathSensitivityManagerBase::makeFlowPathStream(
+    graph_type &&RevDAG, vertex_t Leaf, n_t FinalInst,
+    const Z3BasedPathSensitivityConfig &Config, LLVMPathConstraints &LPC,
+    Z3ConstraintCache *Cache, PathEnumerationOrder Order) const
+    -> FlowPathStream {
+  return FlowPathStream(std::make_unique<FlowPathStream::Impl>(
+      std::move(RevDAG), Leaf, FinalInst, Config, LPC, Cache, Order));
+}
+
 void Z3BasedPathSensitivityManagerBase::deduplicatePaths(
     FlowPathSequence<n_t> &Paths) {
   /// Some kind of lexical sort for being able to deduplicate the paths easily
@@ -0,0 +1,292 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#include "phasar/PhasarLLVM/DataFlow/PathSensitivity/Z3ConstraintCache.h"
+
+#include "phasar/Utils/NlohmannLogging.h"
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/ErrorHandling.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace psr;
+
+static void collectConjuncts(const z3::expr &Constraint,
+                             llvm::SmallVectorImpl<z3::expr> &Into) {
+  if (Constraint.is_app() && Constraint.decl().decl_kind() == Z3_OP_AND) {
+    for (unsigned I = 0, End = Constraint.num_args(); I != End; ++I) {
+      collectConjuncts(Constraint.arg(I), Into);
+    }
+    return;
+  }
+  if (Constraint.is_true()) {
+    return;
+  }
+  Into.push_back(Constraint);
+}
+
+/// Computes an unsatisfiable subset of the (unsatisfiable) Conjuncts by
+/// tracking each conjunct with an indicator literal
+static llvm::SmallVector<unsigned>
+computeUnsatCore(z3::context &Ctx,
+                 llvm::ArrayRef<std::pair<unsigned, z3::expr>> Conjuncts) {
+  z3::solver CoreSolver(Ctx);
+  z3::expr_vector Indicators(Ctx);
+  llvm::SmallDenseMap<unsigned, unsigned> IndicatorIds;
+
+  for (unsigned Idx = 0, End = Conjuncts.size(); Idx != End; ++Idx) {
+    auto Indicator =
+        Ctx.bool_const(("__psr_core_" + std::to_string(Idx)).c_str());
+    CoreSolver.add(z3::implies(Indicator, Conjuncts[Idx].second));
+    Indicators.push_back(Indicator);
+    IndicatorIds[Indicator.id()] = Idx;
+  }
+
+  llvm::SmallVector<unsigned> Core;
+  if (CoreSolver.check(Indicators) != z3::unsat) {
+    // Should not happen; fall back to the whole set
+    for (const auto &Conj : Conjuncts) {
+      Core.push_back(Conj.first);
+    }
+    return Core;
+  }
+
+  auto UnsatCore = CoreSolver.unsat_core();
+  for (unsigned I = 0, End = UnsatCore.size(); I != End; ++I) {
+    Core.push_back(Conjuncts[IndicatorIds.lookup(UnsatCore[I].id())].first);
+  }
+  llvm::sort(Core);
+  return Core;
+}
+
+Z3ConstraintCache::Z3ConstraintCache(const nlohmann::json &SerializedCache) {
+  for (const auto &JAtom : SerializedCache.at("Atoms")) {
+    auto NumAtoms = Atoms.size();
+    if (getOrCreateAtomId(JAtom.get<std::string>()) != NumAtoms) {
+      llvm::report_fatal_error(
+          "Invalid serialized Z3ConstraintCache: Duplicate atom");
+    }
+  }
+
+  auto Load = [this](const nlohmann::json &Keys, auto Handler) {
+    for (const auto &JKey : Keys) {
+      auto Key = JKey.get<std::vector<unsigned>>();
+      if (!llvm::all_of(Key, [this](unsigned Atom) {
+            return Atom < Atoms.size();
+          })) {
+        llvm::report_fatal_error(
+            "Invalid serialized Z3ConstraintCache: Reference to an unknown "
+            "atom; the cache has " +
+            llvm::Twine(Atoms.size()) + " atoms");
+      }
+      llvm::sort(Key);
+      Key.erase(std::unique(Key.begin(), Key.end()), Key.end());
+      Handler(persist(Key));
+    }
+  };
+
+  Load(SerializedCache.at("Sat"),
+       [this](KeyTy Key) { insertResult(Key, true); });
+  Load(SerializedCache.at("Unsat"),
+       [this](KeyTy Key) { insertResult(Key, false); });
+  Load(SerializedCache.at("Cores"), [this](KeyTy Key) { insertCore(Key); });
+}
+
+z3::check_result Z3ConstraintCache::check(z3::solver &Solver,
+                                          bool RequireModel) {
+  llvm::SmallVector<z3::expr> Conjuncts;
+  auto Assertions = Solver.assertions();
+  for (unsigned I = 0, End = Assertions.size(); I != End; ++I) {
+    collectConjuncts(Assertions[I], Conjuncts);
+  }
+
+  // Structurally equal conjuncts have the same representation. Compute them
+  // before taking the lock.
+  llvm::SmallVector<std::string> Reprs;
+  Reprs.reserve(Conjuncts.size());
+  for (const auto &Conj : Conjuncts) {
+    Reprs.push_back(Conj.to_string());
+  }
+
+  llvm::SmallVector<std::pair<unsigned, z3::expr>> AtomConjuncts;
+  llvm::SmallVector<unsigned> Key;
+  {
+    std::lock_guard Lock(Mtx);
+    ++NumQueries;
+
+    AtomConjuncts.reserve(Conjuncts.size());
+    for (size_t I = 0, End = Conjuncts.size(); I != End; ++I) {
+      AtomConjuncts.emplace_back(getOrCreateAtomId(Reprs[I]),
+                                 std::move(Conjuncts[I]));
+    }
+    llvm::sort(AtomConjuncts, [](const auto &Lhs, const auto &Rhs) {
+      return Lhs.first < Rhs.first;
+    });
+    AtomConjuncts.erase(std::unique(AtomConjuncts.begin(), AtomConjuncts.end(),
+                                    [](const auto &Lhs, const auto &Rhs) {
+                                      return Lhs.first == Rhs.first;
+                                    }),
+                        AtomConjuncts.end());
+
+    Key.reserve(AtomConjuncts.size());
+    for (const auto &Conj : AtomConjuncts) {
+      Key.push_back(Conj.first);
+    }
+
+    if (auto It = Results.find(Key); It != Results.end()) {
+      if (!It->second) {
+        ++NumHits;
+        return z3::unsat;
+      }
+      if (!RequireModel) {
+        ++NumHits;
+        return z3::sat;
+      }
+    } else if (includesKnownCore(Key)) {
+      ++NumCoreHits;
+      insertResult(persist(Key), false);
+      return z3::unsat;
+    }
+  }
+
+  auto Res = Solver.check();
+  if (Res == z3::unknown) {
+    return Res;
+  }
+
+  llvm::SmallVector<unsigned> Core;
+  if (Res == z3::unsat) {
+    Core = AtomConjuncts.size() > 1
+               ? computeUnsatCore(Solver.ctx(), AtomConjuncts)
+               : Key;
+  }
+
+  std::lock_guard Lock(Mtx);
+  if (!Results.count(Key)) {
+    insertResult(persist(Key), Res == z3::sat);
+  }
+  if (Res == z3::unsat && !includesKnownCore(Core)) {
+    insertCore(persist(Core));
+  }
+  return Res;
+}
+
+size_t Z3ConstraintCache::getNumQueries() const {
+  std::lock_guard Lock(Mtx);
+  return NumQueries;
+}
+
+size_t Z3ConstraintCache::getNumHits() const {
+  std::lock_guard Lock(Mtx);
+  return NumHits;
+}
+
+size_t Z3ConstraintCache::getNumCoreHits() const {
+  std::lock_guard Lock(Mtx);
+  return NumCoreHits;
+}
+
+size_t Z3ConstraintCache::getNumEntries() const {
+  std::lock_guard Lock(Mtx);
+  return Results.size();
+}
+
+size_t Z3ConstraintCache::getNumCores() const {
+  std::lock_guard Lock(Mtx);
+  return Cores.size();
+}
+
+size_t Z3ConstraintCache::getNumAtoms() const {
+  std::lock_guard Lock(Mtx);
+  return Atoms.size();
+}
+
+unsigned Z3ConstraintCache::getOrCreateAtomId(llvm::StringRef Repr) {
+  auto [It, Inserted] = AtomIds.try_emplace(Repr, Atoms.size());
+  if (Inserted) {
+    Atoms.push_back(It->getKey());
+  }
+  return It->second;
+}
+
+bool Z3ConstraintCache::includesKnownCore(KeyTy Key) const {
+  for (auto Atom : Key) {
+    auto It = CoresByFirstAtom.find(Atom);
+    if (It == CoresByFirstAtom.end()) {
+      continue;
+    }
+    for (auto CoreIdx : It->second) {
+      const auto &Core = Cores[CoreIdx];
+      if (std::includes(Key.begin(), Key.end(), Core.begin(), Core.end())) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+auto Z3ConstraintCache::persist(KeyTy Key) -> KeyTy {
+  if (Key.empty()) {
+    return {};
+  }
+  auto *Mem = Alloc.Allocate<unsigned>(Key.size());
+  std::uninitialized_copy(Key.begin(), Key.end(), Mem);
+  return {Mem, Key.size()};
+}
+
+void Z3ConstraintCache::insertResult(KeyTy Key, bool Sat) {
+  Results.try_emplace(Key, Sat);
+}
+
+void Z3ConstraintCache::insertCore(KeyTy Core) {
+  if (Core.empty()) {
+    // The empty set of constraints is always satisfiable
+    return;
+  }
+  CoresByFirstAtom[Core.front()].push_back(Cores.size());
+  Cores.push_back(Core);
+}
+
+nlohmann::json Z3ConstraintCache::getAsJson() const {
+  std::lock_guard Lock(Mtx);
+
+  nlohmann::json Sat = nlohmann::json::array();
+  nlohmann::json Unsat = nlohmann::json::array();
+  for (const auto &[Key, IsSat] : Results) {
+    (IsSat ? Sat : Unsat).push_back(Key.vec());
+  }
+
+  nlohmann::json JCores = nlohmann::json::array();
+  for (const auto &Core : Cores) {
+    JCores.push_back(Core.vec());
+  }
+
+  nlohmann::json JAtoms = nlohmann::json::array();
+  for (auto Atom : Atoms) {
+    JAtoms.push_back(Atom.str());
+  }
+
+  return {
+      {"Atoms", std::move(JAtoms)},
+      {"Sat", std::move(Sat)},
+      {"Unsat", std::move(Unsat)},
+      {"Cores", std::move(JCores)},
+  };
+}
+
+void Z3ConstraintCache::printAsJson(llvm::raw_ostream &OS) const {
+  OS << getAsJson();
+}
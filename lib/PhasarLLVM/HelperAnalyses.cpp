@@ -4,6 +4,7 @@
 #include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/IO.h"
 
 #include <memory>
 #include <string>
@@ -27,8 +28,10 @@ HelperAnalyses::HelperAnalyses(std::string IRFile,
                                std::vector<std::string> EntryPoints,
                                HelperAnalysisConfig Config) noexcept
     : IRFile(std::move(IRFile)),
-      PrecomputedPTS(std::move(Config.PrecomputedPTS)), PTATy(Config.PTATy),
-      AllowLazyPTS(Config.AllowLazyPTS),
+      PrecomputedPTS(std::move(Config.PrecomputedPTS)),
+      PrecomputedPTSBinaryFile(std::move(Config.PrecomputedPTSBinaryFile)),
+      PTATy(Config.PTATy),
+      AllowLazyPTS(Config.AllowLazyPTS), NumPTSThreads(Config.NumPTSThreads),
       PrecomputedCG(std::move(Config.PrecomputedCG)),
       EntryPoints(std::move(EntryPoints)), CGTy(Config.CGTy),
       SoundnessLevel(Config.SoundnessLevel),
@@ -69,11 +72,14 @@ LLVMProjectIRDB &HelperAnalyses::getProjectIRDB() {
 
 LLVMAliasSet &HelperAnalyses::getAliasInfo() {
   if (!PT) {
-    if (PrecomputedPTS.has_value()) {
+    if (!PrecomputedPTSBinaryFile.empty()) {
+      PT = std::make_unique<LLVMAliasSet>(&getProjectIRDB(),
+                                          readFile(PrecomputedPTSBinaryFile));
+    } else if (PrecomputedPTS.has_value()) {
       PT = std::make_unique<LLVMAliasSet>(&getProjectIRDB(), *PrecomputedPTS);
     } else {
       PT = std::make_unique<LLVMAliasSet>(&getProjectIRDB(), AllowLazyPTS,
-                                          PTATy);
+                                          PTATy, NumPTSThreads);
     }
   }
   return *PT;
@@ -18,7 +18,9 @@
 #include "phasar/Utils/PAMMMacros.h"
 #include "phasar/Utils/Utilities.h"
 
+#include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/InstIterator.h"
@@ -32,9 +34,98 @@
 #include "boost/graph/graph_utility.hpp"
 #include "boost/graph/graphviz.hpp"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace psr {
+namespace {
+bool isAllocationSite(const llvm::Value *V) {
+  if (llvm::isa<llvm::AllocaInst>(V)) {
+    return true;
+  }
+  if (llvm::isa<llvm::CallInst>(V) || llvm::isa<llvm::InvokeInst>(V)) {
+    const auto *Callee = llvm::cast<llvm::CallBase>(V)->getCalledFunction();
+    return Callee != nullptr && isHeapAllocatingFunction(Callee);
+  }
+  return false;
+}
+} // namespace
+
+struct LLVMAliasGraph::FrozenGraph {
+  /// The neighbours of vertex Vtx are Adjacent[Offsets[Vtx]] up to (excluding)
+  /// Adjacent[Offsets[Vtx + 1]]
+  llvm::SmallVector<uint32_t, 0> Offsets;
+  llvm::SmallVector<uint32_t, 0> Adjacent;
+  /// The value of each vertex
+  llvm::SmallVector<const llvm::Value *, 0> Values;
+  llvm::BitVector IsAllocationSite;
+
+  /// Scratch space for the traversals: a vertex is visited in the current
+  /// traversal, iff its entry in Visited equals Epoch
+  llvm::SmallVector<uint32_t, 0> Visited;
+  uint32_t Epoch = 0;
+  llvm::SmallVector<uint32_t, 0> Queue;
+
+  explicit FrozenGraph(const graph_t &PAG) {
+    auto NumVertices = boost::num_vertices(PAG);
+    Offsets.assign(NumVertices + 1, 0);
+    Values.reserve(NumVertices);
+    IsAllocationSite.resize(NumVertices);
+    Visited.assign(NumVertices, 0);
+
+    for (auto Vtx : boost::make_iterator_range(boost::vertices(PAG))) {
+      Values.push_back(PAG[Vtx].V);
+      if (PAG[Vtx].V && isAllocationSite(PAG[Vtx].V)) {
+        IsAllocationSite.set(Vtx);
+      }
+    }
+
+    // The graph is undirected, so each edge is stored in both directions
+    for (auto Edge : boost::make_iterator_range(boost::edges(PAG))) {
+      ++Offsets[boost::source(Edge, PAG) + 1];
+      ++Offsets[boost::target(Edge, PAG) + 1];
+    }
+    for (size_t Vtx = 0; Vtx != NumVertices; ++Vtx) {
+      Offsets[Vtx + 1] += Offsets[Vtx];
+    }
+    Adjacent.resize(Offsets.back());
+    llvm::SmallVector<uint32_t, 0> Next(Offsets.begin(),
+                                        std::prev(Offsets.end()));
+    for (auto Edge : boost::make_iterator_range(boost::edges(PAG))) {
+      auto Src = boost::source(Edge, PAG);
+      auto Tgt = boost::target(Edge, PAG);
+      Adjacent[Next[Src]++] = Tgt;
+      Adjacent[Next[Tgt]++] = Src;
+    }
+  }
+
+  /// Calls Handler for each vertex that is reachable from Start, including
+  /// Start itself, in breadth-first order
+  template <typename HandlerFn>
+  void forEachReachableVertex(uint32_t Start, HandlerFn Handler) {
+    if (++Epoch == 0) {
+      std::fill(Visited.begin(), Visited.end(), 0);
+      Epoch = 1;
+    }
+    Queue.clear();
+    Queue.push_back(Start);
+    Visited[Start] = Epoch;
+    for (size_t Head = 0; Head != Queue.size(); ++Head) {
+      auto Vtx = Queue[Head];
+      Handler(Vtx);
+      for (auto Idx = Offsets[Vtx], End = Offsets[Vtx + 1]; Idx != End;
+           ++Idx) {
+        auto Succ = Adjacent[Idx];
+        if (Visited[Succ] != Epoch) {
+          Visited[Succ] = Epoch;
+          Queue.push_back(Succ);
+        }
+      }
+    }
+  }
+};
+
 struct LLVMAliasGraph::AllocationSiteDFSVisitor : boost::default_dfs_visitor {
   // collect the allocation sites that are found
   AliasSetTy &AllocationSites;
@@ -136,7 +227,20 @@ std::string LLVMAliasGraph::EdgeProperties::getValueAsString() const {
 
 LLVMAliasGraph::LLVMAliasGraph(LLVMProjectIRDB &IRDB, bool UseLazyEvaluation,
                                AliasAnalysisType PATy)
-    : PTA(IRDB, UseLazyEvaluation, PATy) {}
+    : IRDB(&IRDB), PTA(IRDB, UseLazyEvaluation, PATy) {}
+
+LLVMAliasGraph::~LLVMAliasGraph() = default;
+
+void LLVMAliasGraph::freeze() {
+  for (auto &F : *IRDB->getModule()) {
+    if (!F.isDeclaration()) {
+      computeAliasGraph(&F);
+    }
+  }
+  if (!Frozen) {
+    Frozen = std::make_unique<FrozenGraph>(PAG);
+  }
+}
 
 void LLVMAliasGraph::computeAliasGraph(const llvm::Value *V) {
   // FIXME when fixed in LLVM
@@ -152,6 +256,7 @@ void LLVMAliasGraph::computeAliasGraph(llvm::Function *F) {
   PAMM_GET_INSTANCE;
   PHASAR_LOG_LEVEL(DEBUG, "Analyzing function: " << F->getName());
   AnalyzedFunctions.insert(F);
+  Frozen.reset();
   llvm::AAResults &AA = *PTA.getAAResults(F);
   bool EvalAAMD = true;
 
@@ -207,29 +312,29 @@ void LLVMAliasGraph::computeAliasGraph(llvm::Function *F) {
 
   INC_COUNTER("GS Pointer", Pointers.size(), Core);
 
+  auto GetPointeeSize = [&DL](const llvm::Value *P) -> uint64_t {
+    llvm::Type *ElTy = !P->getType()->isOpaquePointerTy()
+                           ? P->getType()->getNonOpaquePointerElementType()
+                           : nullptr;
+    return ElTy && ElTy->isSized() ? DL.getTypeStoreSize(ElTy)
+                                   : llvm::MemoryLocation::UnknownSize;
+  };
+
   // make vertices for all pointers
+  llvm::SmallVector<vertex_t, 0> Vertices;
+  llvm::SmallVector<uint64_t, 0> Sizes;
+  Vertices.reserve(Pointers.size());
+  Sizes.reserve(Pointers.size());
   for (auto *P : Pointers) {
-    ValueVertexMap[P] = boost::add_vertex(VertexProperties(P), PAG);
+    auto Vtx = boost::add_vertex(VertexProperties(P), PAG);
+    ValueVertexMap[P] = Vtx;
+    Vertices.push_back(Vtx);
+    Sizes.push_back(GetPointeeSize(P));
   }
-  // iterate over the worklist, and run the full (n^2)/2 disambiguations
-  const auto MapEnd = ValueVertexMap.end();
-  for (auto I1 = ValueVertexMap.begin(); I1 != MapEnd; ++I1) {
-    llvm::Type *I1ElTy =
-        !I1->first->getType()->isOpaquePointerTy()
-            ? I1->first->getType()->getNonOpaquePointerElementType()
-            : nullptr;
-    const uint64_t I1Size = I1ElTy && I1ElTy->isSized()
-                                ? DL.getTypeStoreSize(I1ElTy)
-                                : llvm::MemoryLocation::UnknownSize;
-    for (auto I2 = std::next(I1); I2 != MapEnd; ++I2) {
-      llvm::Type *I2ElTy =
-          !I2->first->getType()->isOpaquePointerTy()
-              ? I2->first->getType()->getNonOpaquePointerElementType()
-              : nullptr;
-      const uint64_t I2Size = I2ElTy && I2ElTy->isSized()
-                                  ? DL.getTypeStoreSize(I2ElTy)
-                                  : llvm::MemoryLocation::UnknownSize;
-      switch (AA.alias(I1->first, I1Size, I2->first, I2Size)) {
+  // iterate over the pointers of F, and run the full (n^2)/2 disambiguations
+  for (size_t I1 = 0, End = Pointers.size(); I1 != End; ++I1) {
+    for (size_t I2 = I1 + 1; I2 != End; ++I2) {
+      switch (AA.alias(Pointers[I1], Sizes[I1], Pointers[I2], Sizes[I2])) {
       case llvm::AliasResult::NoAlias:
         break;
       case llvm::AliasResult::MayAlias: // no break
@@ -237,7 +342,7 @@ void LLVMAliasGraph::computeAliasGraph(llvm::Function *F) {
       case llvm::AliasResult::PartialAlias: // no break
         [[fallthrough]];
       case llvm::AliasResult::MustAlias:
-        boost::add_edge(I1->second, I2->second, PAG);
+        boost::add_edge(Vertices[I1], Vertices[I2], PAG);
         break;
       default:
         break;
@@ -268,6 +373,16 @@ auto LLVMAliasGraph::getReachableAllocationSites(
     const llvm::Instruction * /*I*/) -> AllocationSiteSetPtrTy {
   computeAliasGraph(V);
   auto AllocSites = std::make_unique<AliasSetTy>();
+  if (Frozen) {
+    if (auto It = ValueVertexMap.find(V); It != ValueVertexMap.end()) {
+      Frozen->forEachReachableVertex(It->second, [&](uint32_t Vtx) {
+        if (Frozen->IsAllocationSite.test(Vtx)) {
+          AllocSites->insert(Frozen->Values[Vtx]);
+        }
+      });
+    }
+    return AllocSites;
+  }
   AllocationSiteDFSVisitor AllocVis(*AllocSites, {});
   vector<boost::default_color_type> ColorMap(boost::num_vertices(PAG));
   boost::depth_first_visit(
@@ -293,6 +408,7 @@ void LLVMAliasGraph::mergeWith(const LLVMAliasGraph &OtherPTI) {
   boost::associative_property_map<vertex_map_t> VertexMapWrapper(
       OldToNewVertexMapping);
   boost::copy_graph(OtherPTI.PAG, PAG, boost::orig_to_copy(VertexMapWrapper));
+  Frozen.reset();
   for (const auto &OtherValues : OtherPTI.ValueVertexMap) {
     auto Search = OldToNewVertexMapping.find(OtherValues.second);
     if (Search != OldToNewVertexMapping.end()) {
@@ -310,6 +426,7 @@ void LLVMAliasGraph::introduceAlias(const llvm::Value *V1,
   auto Vert1 = ValueVertexMap[V1];
   auto Vert2 = ValueVertexMap[V2];
   boost::add_edge(Vert1, Vert2, I, PAG);
+  Frozen.reset();
 }
 
 vector<pair<unsigned, const llvm::Value *>>
@@ -369,16 +486,7 @@ auto LLVMAliasGraph::getAliasSet(const llvm::Value *V,
   PAMM_GET_INSTANCE;
   INC_COUNTER("[Calls] getAliasSet", 1, Full);
   START_TIMER("Alias-Set Computation", Full);
-  const auto *VF = retrieveFunction(V);
-  computeAliasGraph(VF);
-  // check if the graph contains a corresponding vertex
-  set<vertex_t> ReachableVertices;
-  ReachabilityDFSVisitor Vis(ReachableVertices);
-  vector<boost::default_color_type> ColorMap(boost::num_vertices(PAG));
-  boost::depth_first_visit(
-      PAG, ValueVertexMap.at(V), Vis,
-      boost::make_iterator_property_map(
-          ColorMap.begin(), boost::get(boost::vertex_index, PAG), ColorMap[0]));
+  computeAliasGraph(V);
   auto ResultSet = [this, V] {
     auto &Ret = Cache[V];
 
@@ -389,8 +497,23 @@ auto LLVMAliasGraph::getAliasSet(const llvm::Value *V,
     return Ret;
   }();
 
-  for (auto Vertex : ReachableVertices) {
-    ResultSet->insert(PAG[Vertex].V);
+  if (Frozen) {
+    Frozen->forEachReachableVertex(ValueVertexMap.at(V), [&](uint32_t Vtx) {
+      ResultSet->insert(Frozen->Values[Vtx]);
+    });
+  } else {
+    // check if the graph contains a corresponding vertex
+    set<vertex_t> ReachableVertices;
+    ReachabilityDFSVisitor Vis(ReachableVertices);
+    vector<boost::default_color_type> ColorMap(boost::num_vertices(PAG));
+    boost::depth_first_visit(PAG, ValueVertexMap.at(V), Vis,
+                             boost::make_iterator_property_map(
+                                 ColorMap.begin(),
+                                 boost::get(boost::vertex_index, PAG),
+                                 ColorMap[0]));
+    for (auto Vertex : ReachableVertices) {
+      ResultSet->insert(PAG[Vertex].V);
+    }
   }
   PAUSE_TIMER("Alias-Set Computation", Full);
   ADD_TO_HISTOGRAM("Points-to", ResultSet->size(), 1, Full);
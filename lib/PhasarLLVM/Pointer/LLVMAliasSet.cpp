@@ -11,6 +11,7 @@
 
 #include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMAliasInfo.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAndersenAliasInfo.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
 #include "phasar/Pointer/AliasAnalysisType.h"
@@ -19,10 +20,16 @@
 #include "phasar/Utils/NlohmannLogging.h"
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/CaptureTracking.h"
+#include "llvm/Analysis/ValueTracking.h"
 #include "llvm/IR/Argument.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/Function.h"
@@ -32,22 +39,36 @@
 #include "llvm/IR/InstrTypes.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/Module.h"
+#include "llvm/IR/TypeFinder.h"
 #include "llvm/IR/Value.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 
 #include "nlohmann/json.hpp"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cstdlib>
+#include <future>
 #include <iomanip>
 #include <iterator>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace psr {
 
@@ -56,13 +77,19 @@ template class BoxedConstPtr<LLVMAliasInfo::AliasSetTy>;
 template class AliasSetOwner<LLVMAliasInfo::AliasSetTy>;
 
 LLVMAliasSet::LLVMAliasSet(LLVMProjectIRDB *IRDB, bool UseLazyEvaluation,
-                           AliasAnalysisType PATy)
-    : PTA(*IRDB, UseLazyEvaluation, PATy) {
+                           AliasAnalysisType PATy, unsigned NumThreads)
+    // In the parallel case, the worker threads use their own
+    // LLVMBasedAliasAnalysis. With Andersen, the alias sets are computed from
+    // LLVMAndersenAliasInfo, instead.
+    : IRDB(IRDB), PTA(*IRDB,
+                      UseLazyEvaluation || NumThreads != 1 ||
+                          PATy == AliasAnalysisType::Andersen,
+                      PATy) {
   assert(IRDB != nullptr);
 
   auto NumGlobals = IRDB->getNumGlobals();
-  AliasSets.reserve(NumGlobals);
-  Owner.reserve(NumGlobals);
+  ValueIds.reserve(NumGlobals);
+  Partition.reserve(NumGlobals);
 
   PHASAR_LOG_LEVEL_CAT(
       INFO, "LLVMAliasSet",
@@ -70,6 +97,15 @@ LLVMAliasSet::LLVMAliasSet(LLVMProjectIRDB *IRDB, bool UseLazyEvaluation,
           << std::chrono::steady_clock::now().time_since_epoch().count());
   auto *M = IRDB->getModule();
 
+  if (PATy == AliasAnalysisType::Andersen) {
+    // Whole-program analysis; there is nothing left to compute lazily
+    computeAndersenAliasSets(*IRDB);
+  } else if (!UseLazyEvaluation && NumThreads != 1) {
+    // After that, the loops below only merge the alias sets of the globals
+    // with the ones of their users
+    computeFunctionsAliasSetsInParallel(*IRDB, PATy, NumThreads);
+  }
+
   // compute points-to information for all globals
 
   for (const auto &G : M->globals()) {
@@ -97,7 +133,7 @@ LLVMAliasSet::LLVMAliasSet(LLVMProjectIRDB *IRDB, bool UseLazyEvaluation,
 
 LLVMAliasSet::LLVMAliasSet(LLVMProjectIRDB *IRDB,
                            const nlohmann::json &SerializedPTS)
-    : PTA(*IRDB, true) {
+    : IRDB(IRDB), PTA(*IRDB, true) {
   assert(IRDB != nullptr);
   // Assume, we already have validated the json schema
 
@@ -112,10 +148,9 @@ LLVMAliasSet::LLVMAliasSet(LLVMProjectIRDB *IRDB,
   /// Deserialize the AliasSets - an array of arrays (both are to be
   /// interpreted as sets of metadata-ids)
 
-  Owner.reserve(Sets.size());
   for (const auto &PtsJson : Sets) {
     assert(PtsJson.is_array());
-    auto PTS = Owner.acquire();
+    std::optional<uint32_t> First;
     for (const auto &Alias : PtsJson) {
       const auto AliasStr = Alias.get<std::string>();
       const auto *Inst = fromMetaDataId(*IRDB, AliasStr);
@@ -124,8 +159,12 @@ LLVMAliasSet::LLVMAliasSet(LLVMProjectIRDB *IRDB,
         continue;
       }
 
-      AliasSets[Inst] = PTS;
-      PTS->insert(Inst);
+      auto Id = addSingletonAliasSet(Inst);
+      if (First) {
+        mergeAliasSets(*First, Id);
+      } else {
+        First = Id;
+      }
     }
   }
 
@@ -150,14 +189,306 @@ LLVMAliasSet::LLVMAliasSet(LLVMProjectIRDB *IRDB,
   }
 }
 
+// The binary format written by printAsBinary(). All integers are stored
+// little-endian:
+//
+//   BinaryHeader
+//   uint32_t AnalyzedFunctions[NumAnalyzedFunctions]
+//   uint32_t SetOffsets[NumSets + 1]
+//   uint64_t Members[NumValues]    // Set I is Members[SetOffsets[I], ...)
+//   uint64_t SortedKeys[NumValues] // The Members in ascending order
+//   uint32_t KeySets[NumValues]    // The set that contains SortedKeys[I]
+//
+// Values are stored as keys: Instructions and global variables by their id in
+// the LLVMProjectIRDB, arguments as (Fun + 1) << 32 | ArgNo and functions as
+// (Fun + 1) << 32 | UINT32_MAX, where Fun is the position of the function in
+// the module. The AnalyzedFunctions are stored by their position as well.
+//
+// The ModuleFingerprint identifies the module that the keys refer to (see
+// ValueKeys::getModuleFingerprint()).
+
+namespace {
+using ulittle32_t = llvm::support::ulittle32_t;
+using ulittle64_t = llvm::support::ulittle64_t;
+
+struct BinaryHeader {
+  ulittle64_t Magic;
+  ulittle32_t Version;
+  ulittle32_t NumAnalyzedFunctions;
+  ulittle64_t ModuleFingerprint;
+  ulittle32_t NumSets;
+  ulittle32_t NumValues;
+};
+static_assert(sizeof(BinaryHeader) == 32);
+
+/// "PSRALIAS"
+constexpr uint64_t BinaryMagic = 0x5341494c41525350;
+constexpr uint32_t BinaryVersion = 2;
+
+/// Translates between values and their keys in the binary format
+class ValueKeys {
+public:
+  explicit ValueKeys(const LLVMProjectIRDB &IRDB) : IRDB(IRDB) {
+    const auto *M = IRDB.getModule();
+    Functions.reserve(M->size());
+    FunctionIndices.reserve(M->size());
+    for (const auto &F : *M) {
+      FunctionIndices.try_emplace(&F, Functions.size());
+      Functions.push_back(&F);
+    }
+  }
+
+  [[nodiscard]] std::optional<uint64_t> getKey(const llvm::Value *V) const {
+    if (auto Id = IRDB.getValueId(V)) {
+      return *Id;
+    }
+    if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(V)) {
+      return makeKey(Arg->getParent(), Arg->getArgNo());
+    }
+    if (const auto *F = llvm::dyn_cast<llvm::Function>(V)) {
+      return makeKey(F, UINT32_MAX);
+    }
+    return std::nullopt;
+  }
+
+  [[nodiscard]] const llvm::Value *getValue(uint64_t Key) const {
+    auto FunIdx = Key >> 32;
+    if (FunIdx == 0) {
+      return IRDB.getValueFromId(Key);
+    }
+
+    const auto *F = getFunction(FunIdx - 1);
+    auto ArgNo = uint32_t(Key);
+    if (!F || ArgNo == UINT32_MAX) {
+      return F;
+    }
+    return ArgNo < F->arg_size() ? F->getArg(ArgNo) : nullptr;
+  }
+
+  [[nodiscard]] uint32_t getFunctionIndex(const llvm::Function *F) const {
+    return FunctionIndices.lookup(F);
+  }
+
+  [[nodiscard]] const llvm::Function *getFunction(uint64_t Idx) const {
+    return Idx < Functions.size() ? Functions[Idx] : nullptr;
+  }
+
+  /// A stable hash of everything the keys depend on: The names, arities and
+  /// instruction counts of the functions in module order, the names of the
+  /// global variables and the IRDB ids of both. Much cheaper than hashing the
+  /// whole module, as it does not look at the instructions themselves.
+  [[nodiscard]] uint64_t getModuleFingerprint() const {
+    llvm::SmallString<0> Buf;
+    llvm::raw_svector_ostream OS(Buf);
+    llvm::support::endian::Writer Writer(OS, llvm::support::little);
+    auto WriteId = [&](const llvm::Value *V) {
+      auto Id = IRDB.getValueId(V);
+      Writer.write(Id ? uint64_t(*Id) : UINT64_MAX);
+    };
+
+    for (const auto *F : Functions) {
+      OS << F->getName() << '\0';
+      Writer.write(uint32_t(F->arg_size()));
+      Writer.write(uint32_t(F->getInstructionCount()));
+      WriteId(F->isDeclaration() ? nullptr : &F->getEntryBlock().front());
+    }
+    for (const auto &Glob : IRDB.getModule()->globals()) {
+      OS << Glob.getName() << '\0';
+      WriteId(&Glob);
+    }
+    return llvm::xxHash64(Buf);
+  }
+
+private:
+  [[nodiscard]] uint64_t makeKey(const llvm::Function *F,
+                                 uint32_t ArgNo) const {
+    return (uint64_t(getFunctionIndex(F)) + 1) << 32 | ArgNo;
+  }
+
+  const LLVMProjectIRDB &IRDB;
+  std::vector<const llvm::Function *> Functions;
+  llvm::DenseMap<const llvm::Function *, uint32_t> FunctionIndices;
+};
+} // namespace
+
+class LLVMAliasSet::BinaryImage {
+public:
+  /// Returns nullptr, if Buffer does not contain alias sets for IRDB's module
+  [[nodiscard]] static std::unique_ptr<BinaryImage>
+  create(const LLVMProjectIRDB &IRDB,
+         std::unique_ptr<llvm::MemoryBuffer> Buf) {
+    auto Data = Buf->getBuffer();
+    if (Data.size() < sizeof(BinaryHeader)) {
+      PHASAR_LOG_LEVEL(ERROR, "Truncated alias sets: "
+                                  << Buf->getBufferIdentifier());
+      return nullptr;
+    }
+
+    const auto *Header = reinterpret_cast<const BinaryHeader *>(Data.data());
+    if (Header->Magic != BinaryMagic || Header->Version != BinaryVersion) {
+      PHASAR_LOG_LEVEL(ERROR, "Unsupported alias-set format: "
+                                  << Buf->getBufferIdentifier());
+      return nullptr;
+    }
+    ValueKeys Keys(IRDB);
+    if (Header->ModuleFingerprint != Keys.getModuleFingerprint()) {
+      PHASAR_LOG_LEVEL(ERROR, "The alias sets in "
+                                  << Buf->getBufferIdentifier()
+                                  << " have been computed for another module");
+      return nullptr;
+    }
+
+    size_t NumFuns = Header->NumAnalyzedFunctions;
+    size_t NumSets = Header->NumSets;
+    size_t NumValues = Header->NumValues;
+    size_t ExpectedSize = sizeof(BinaryHeader) +
+                          (NumFuns + NumSets + 1 + NumValues) * 4 +
+                          NumValues * 2 * 8;
+    if (Data.size() != ExpectedSize) {
+      PHASAR_LOG_LEVEL(ERROR, "Truncated alias sets: "
+                                  << Buf->getBufferIdentifier());
+      return nullptr;
+    }
+
+    return std::unique_ptr<BinaryImage>(
+        new BinaryImage(std::move(Keys), std::move(Buf), *Header));
+  }
+
+  [[nodiscard]] const ValueKeys &keys() const noexcept { return Keys; }
+
+  [[nodiscard]] llvm::ArrayRef<ulittle32_t> analyzedFunctions() const {
+    return AnalyzedFunctions;
+  }
+
+  [[nodiscard]] size_t getNumSets() const noexcept { return Decoded.size(); }
+
+  [[nodiscard]] bool isDecoded(uint32_t Set) const { return Decoded.test(Set); }
+  void markDecoded(uint32_t Set) { Decoded.set(Set); }
+
+  /// The set that contains the value with the given Key, if any
+  [[nodiscard]] std::optional<uint32_t> findSet(uint64_t Key) const {
+    const auto *It = llvm::partition_point(
+        SortedKeys, [Key](uint64_t Elem) { return Elem < Key; });
+    if (It == SortedKeys.end() || *It != Key) {
+      return std::nullopt;
+    }
+    uint32_t Set = KeySets[std::distance(SortedKeys.begin(), It)];
+    if (Set >= getNumSets()) {
+      return std::nullopt;
+    }
+    return Set;
+  }
+
+  /// The keys of the members of Set
+  [[nodiscard]] llvm::ArrayRef<ulittle64_t> members(uint32_t Set) const {
+    uint32_t Begin = SetOffsets[Set];
+    uint32_t End = SetOffsets[Set + 1];
+    if (Begin > End || End > Members.size()) {
+      PHASAR_LOG_LEVEL(WARNING, "Invalid alias set: " << Set);
+      return {};
+    }
+    return Members.slice(Begin, End - Begin);
+  }
+
+private:
+  BinaryImage(ValueKeys Keys, std::unique_ptr<llvm::MemoryBuffer> Buf,
+              const BinaryHeader &Header)
+      : Buf(std::move(Buf)), Keys(std::move(Keys)), Decoded(Header.NumSets) {
+    const auto *Ptr = this->Buf->getBufferStart() + sizeof(BinaryHeader);
+    auto Take = [&Ptr](auto &Arr, size_t Size) {
+      using ElemTy = typename std::decay_t<decltype(Arr)>::value_type;
+      Arr = llvm::makeArrayRef(reinterpret_cast<const ElemTy *>(Ptr), Size);
+      Ptr += Size * sizeof(ElemTy);
+    };
+
+    Take(AnalyzedFunctions, Header.NumAnalyzedFunctions);
+    Take(SetOffsets, Header.NumSets + 1);
+    Take(Members, Header.NumValues);
+    Take(SortedKeys, Header.NumValues);
+    Take(KeySets, Header.NumValues);
+    assert(Ptr == this->Buf->getBufferEnd());
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer> Buf;
+  ValueKeys Keys;
+  llvm::BitVector Decoded;
+
+  llvm::ArrayRef<ulittle32_t> AnalyzedFunctions;
+  llvm::ArrayRef<ulittle32_t> SetOffsets;
+  llvm::ArrayRef<ulittle64_t> Members;
+  llvm::ArrayRef<ulittle64_t> SortedKeys;
+  llvm::ArrayRef<ulittle32_t> KeySets;
+};
+
+LLVMAliasSet::LLVMAliasSet(LLVMProjectIRDB *IRDB,
+                           std::unique_ptr<llvm::MemoryBuffer> SerializedPTS)
+    : IRDB(IRDB), PTA(*IRDB, true) {
+  assert(IRDB != nullptr);
+  assert(SerializedPTS != nullptr);
+
+  PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMAliasSet",
+                       "Load precomputed points-to info from "
+                           << SerializedPTS->getBufferIdentifier());
+
+  Image = BinaryImage::create(*IRDB, std::move(SerializedPTS));
+  if (!Image) {
+    // Fall back to computing the alias sets on the fly
+    return;
+  }
+
+  AnalyzedFunctions.reserve(Image->analyzedFunctions().size());
+  for (uint32_t FunIdx : Image->analyzedFunctions()) {
+    if (const auto *F = Image->keys().getFunction(FunIdx)) {
+      AnalyzedFunctions.insert(F);
+    } else {
+      PHASAR_LOG_LEVEL(WARNING, "Invalid Function: " << FunIdx);
+    }
+  }
+}
+
+LLVMAliasSet::~LLVMAliasSet() = default;
+
+void LLVMAliasSet::decodeAliasSetOf(const llvm::Value *V, uint32_t Id) {
+  auto Key = Image->keys().getKey(V);
+  if (!Key) {
+    return;
+  }
+  auto Set = Image->findSet(*Key);
+  if (!Set || Image->isDecoded(*Set)) {
+    return;
+  }
+
+  // Mark the set first, such that adding its members does not decode it again
+  Image->markDecoded(*Set);
+  for (uint64_t MemberKey : Image->members(*Set)) {
+    const auto *Member = Image->keys().getValue(MemberKey);
+    if (!Member) {
+      PHASAR_LOG_LEVEL(WARNING, "Invalid Value-Id: " << MemberKey);
+      continue;
+    }
+    if (Member != V) {
+      auto MemberId = addSingletonAliasSet(Member);
+      mergeAliasSets(Id, MemberId);
+    }
+  }
+}
+
 void LLVMAliasSet::computeValuesAliasSet(const llvm::Value *V) {
   if (!isInterestingPointer(V)) {
     // don't need to do anything
     return;
   }
+  if (HasPendingUpdates) {
+    completePendingUpdates();
+  }
   // Add set for the queried value if none exists, yet
   addSingletonAliasSet(V);
-  if (const auto *G = llvm::dyn_cast<llvm::GlobalObject>(V)) {
+  if (isInterProcedural()) {
+    // The alias sets of the globals are already complete
+    computeFunctionsAliasSet(
+        const_cast<llvm::Function *> // NOLINT - FIXME when it is fixed in LLVM
+        (retrieveFunction(V)));
+  } else if (const auto *G = llvm::dyn_cast<llvm::GlobalObject>(V)) {
     // A global object can be a function or a global variable. We need to
     // consider functions here, too, because function pointer magic may be
     // used by the target program. Add a set for global object.
@@ -195,17 +526,19 @@ void LLVMAliasSet::computeValuesAliasSet(const llvm::Value *V) {
   }
 }
 
-void LLVMAliasSet::addSingletonAliasSet(const llvm::Value *V) {
-  auto [It, Inserted] = AliasSets.try_emplace(V, nullptr);
-
-  if (!Inserted) {
-    assert(It->second->count(V));
-    return;
+uint32_t LLVMAliasSet::addSingletonAliasSet(const llvm::Value *V) {
+  auto Id = ValueIds.getOrInsert(V);
+  if (Id == Partition.size()) {
+    Partition.makeSet();
+    if (Image) {
+      decodeAliasSetOf(V, Id);
+    }
+  } else if (Id < ErasedIds.size()) {
+    // V may have been allocated at the address of an erased value
+    ErasedIds.reset(Id);
   }
-
-  auto PTS = Owner.acquire();
-  PTS->insert(V);
-  It->second = PTS;
+  assert(Id < Partition.size());
+  return Id;
 }
 
 void LLVMAliasSet::mergeAliasSets(const llvm::Value *V1,
@@ -214,51 +547,92 @@ void LLVMAliasSet::mergeAliasSets(const llvm::Value *V1,
     return;
   }
 
-  auto SearchV1 = AliasSets.find(V1);
-  assert(SearchV1 != AliasSets.end());
-
-  auto SearchV2 = AliasSets.find(V2);
-  assert(SearchV2 != AliasSets.end());
-
-  mergeAliasSets(SearchV1->second, SearchV2->second);
+  // V1 and V2 may be missing, if their alias sets have been deserialized, as
+  // not every value is serialized; or they may not be decoded, yet
+  auto Id1 = addSingletonAliasSet(V1);
+  auto Id2 = addSingletonAliasSet(V2);
+  mergeAliasSets(Id1, Id2);
 }
 
-void LLVMAliasSet::mergeAliasSets(BoxedPtr<AliasSetTy> PTS1,
-                                  BoxedPtr<AliasSetTy> PTS2) {
-  if (PTS1 == PTS2 || PTS1.get() == PTS2.get()) {
+void LLVMAliasSet::mergeAliasSets(uint32_t Id1, uint32_t Id2) {
+  auto Root1 = Partition.find(Id1);
+  auto Root2 = Partition.find(Id2);
+  if (Root1 == Root2) {
     return;
   }
 
-  assert(PTS1 && PTS1.get());
-  assert(PTS2 && PTS2.get());
+  ++Generation;
+  CompactSets.erase(Root1);
+  CompactSets.erase(Root2);
 
-  auto [SmallerSet, LargerSet] = [&]() {
-    if (PTS1->size() > PTS2->size()) {
-      return std::make_pair(PTS2, PTS1);
+  auto Boxes1 = MaterializedSets.find(Root1);
+  auto Boxes2 = MaterializedSets.find(Root2);
+  if (Boxes1 == MaterializedSets.end() && Boxes2 == MaterializedSets.end()) {
+    // The common case: Nobody has looked at the DenseSets, yet
+    Partition.unite(Root1, Root2);
+    return;
+  }
+
+  // Keep the DenseSets that have already been handed out up-to-date
+  if (Boxes1 == MaterializedSets.end()) {
+    std::swap(Root1, Root2);
+    std::swap(Boxes1, Boxes2);
+  }
+  auto Boxes = std::move(Boxes1->second);
+  MaterializedSets.erase(Boxes1);
+
+  if (Boxes2 == MaterializedSets.end()) {
+    auto &PTS = *Boxes.front();
+    PTS.reserve(PTS.size() + Partition.setSize(Root2));
+    for (auto Member : Partition.members(Root2)) {
+      PTS.insert(ValueIds[Member]);
+    }
+  } else {
+    auto OtherBoxes = std::move(Boxes2->second);
+    MaterializedSets.erase(Boxes2);
+    if (Boxes.front()->size() < OtherBoxes.front()->size()) {
+      std::swap(Boxes, OtherBoxes);
     }
-    return std::make_pair(PTS1, PTS2);
-  }();
 
-  // reindex the contents of the smaller set
-  // for (const auto *Ptr : *SmallerSet) {
-  //   AliasSets[Ptr] = LargerSet;
-  // }
+    // add smaller set to larger one and get rid of the smaller set
+    auto *LargerSet = Boxes.front().get();
+    auto *ToDelete = OtherBoxes.front().get();
+    LargerSet->insert(ToDelete->begin(), ToDelete->end());
+    for (auto Box : OtherBoxes) {
+      *Box.value() = LargerSet;
+    }
+    Boxes.append(OtherBoxes.begin(), OtherBoxes.end());
+    Owner.release(ToDelete);
+  }
 
-  // add smaller set to larger one and get rid of the smaller set
-  LargerSet->reserve(LargerSet->size() + SmallerSet->size());
-  LargerSet->insert(SmallerSet->begin(), SmallerSet->end());
+  auto Root = Partition.unite(Root1, Root2);
+  MaterializedSets.try_emplace(Root, std::move(Boxes));
+}
 
-  // *SmallerSet.value() = LargerSet.get();
-  auto *ToDelete = SmallerSet.get();
-  for (const auto *Vals : *SmallerSet) {
-    auto PTS = AliasSets[Vals];
-    if (PTS.get() == ToDelete) {
+auto LLVMAliasSet::materializeAliasSet(uint32_t Root) -> BoxedPtr<AliasSetTy> {
+  assert(Partition.isRoot(Root));
+  auto &Boxes = MaterializedSets[Root];
+  if (!Boxes.empty()) {
+    return Boxes.front();
+  }
 
-      *PTS.value() = LargerSet.get();
-    }
+  auto PTS = Owner.acquire();
+  PTS->reserve(Partition.setSize(Root));
+  for (auto Member : Partition.members(Root)) {
+    PTS->insert(ValueIds[Member]);
   }
+  Boxes.push_back(PTS);
+  return PTS;
+}
 
-  Owner.release(ToDelete);
+bool LLVMAliasSet::inSameAliasSet(const llvm::Value *V1,
+                                  const llvm::Value *V2) const {
+  auto Id1 = ValueIds.lookup(V1);
+  if (!Id1) {
+    return false;
+  }
+  auto Id2 = ValueIds.lookup(V2);
+  return Id2 && Partition.inSameSet(*Id1, *Id2);
 }
 
 bool LLVMAliasSet::interIsReachableAllocationSiteTy(
@@ -341,14 +715,174 @@ static bool mayAlias(llvm::AAResults &AA, const llvm::DataLayout &DL,
   return false;
 }
 
-void LLVMAliasSet::addPointer(llvm::AAResults &AA, const llvm::DataLayout &DL,
-                              const llvm::Value *V,
-                              std::vector<const llvm::Value *> &Reps) {
+/// The representatives of the alias sets of one function.
+///
+/// Querying AA for all pairs of pointers and representatives is quadratic in
+/// the number of pointers of a function. However, BasicAA proves NoAlias
+/// purely based on the underlying objects of two pointers, if
+///  - both are different identified objects (allocas, globals, noalias calls),
+///  - one is a non-escaping local object and the other one comes from a call,
+///    load or inttoptr, or
+///  - one is a function argument and the other one is function-local.
+/// None of the alias analyses preceding BasicAA yields anything but NoAlias
+/// or MayAlias for pointers with different underlying objects.
+///
+/// So, we categorize the representatives by their underlying objects and only
+/// query AA for the representatives whose category is not known to be NoAlias
+/// with V's category. This yields exactly the same alias sets as querying all
+/// representatives.
+class LLVMAliasSet::Representatives {
+public:
+  [[nodiscard]] const llvm::Value *operator[](unsigned Slot) const noexcept {
+    assert(Slots[Slot] && "Accessing a removed representative");
+    return Slots[Slot];
+  }
+
+  /// Computes the underlying object of V and its category
+  [[nodiscard]] std::pair<const llvm::Value *, unsigned>
+  classify(const llvm::Value *V) {
+    // Mirrors the lookup in BasicAA's aliasCheck()
+    const auto *Obj = llvm::getUnderlyingObject(
+        V->stripPointerCastsForAliasAnalysis(), MaxLookupSearchDepth);
+
+    if (llvm::isIdentifiedObject(Obj)) {
+      if (!llvm::isIdentifiedFunctionLocal(Obj)) {
+        return {Obj, Global};
+      }
+      return {Obj, llvm::isNonEscapingLocalObject(Obj, &IsCapturedCache)
+                       ? NonEscapingLocal
+                       : EscapingLocal};
+    }
+    if (llvm::isa<llvm::CallBase>(Obj) || llvm::isa<llvm::LoadInst>(Obj) ||
+        llvm::isa<llvm::IntToPtrInst>(Obj)) {
+      return {Obj, EscapeSource};
+    }
+    if (llvm::isa<llvm::Argument>(Obj)) {
+      return {Obj, Argument};
+    }
+    return {Obj, Other};
+  }
+
+  void push_back(const llvm::Value *Rep,
+                 std::pair<const llvm::Value *, unsigned> ObjAndCategory) {
+    auto [Obj, Cat] = ObjAndCategory;
+    auto Slot = unsigned(Slots.size());
+    Slots.push_back(Rep);
+    ByCategory[Cat].push_back(Slot);
+    if (Cat < NumIdentifiedCategories) {
+      ByObject[Obj].push_back(Slot);
+    }
+  }
+
+  /// Keeps the slots of all other representatives stable
+  void erase(unsigned Slot) noexcept { Slots[Slot] = nullptr; }
+
+  /// Collects the slots of all representatives that may alias a pointer with
+  /// the given underlying object and category in insertion order
+  void getCandidates(std::pair<const llvm::Value *, unsigned> ObjAndCategory,
+                     llvm::SmallVectorImpl<unsigned> &Into) const {
+    auto [Obj, Cat] = ObjAndCategory;
+    Into.clear();
+    if (Cat < NumIdentifiedCategories) {
+      if (auto It = ByObject.find(Obj); It != ByObject.end()) {
+        Into.append(It->second.begin(), It->second.end());
+      }
+    }
+    for (unsigned RepCat = 0; RepCat != NumCategories; ++RepCat) {
+      if (MayAlias[Cat][RepCat]) {
+        Into.append(ByCategory[RepCat].begin(), ByCategory[RepCat].end());
+      }
+    }
+
+    llvm::erase_if(Into, [this](unsigned Slot) { return !Slots[Slot]; });
+    std::sort(Into.begin(), Into.end());
+  }
+
+private:
+  /// Same as in BasicAliasAnalysis.cpp
+  static constexpr unsigned MaxLookupSearchDepth = 6;
+
+  enum Category : unsigned {
+    // Identified objects
+    Global,
+    EscapingLocal,
+    NonEscapingLocal,
+    // Unidentified objects
+    EscapeSource,
+    Argument,
+    Other,
+  };
+  static constexpr unsigned NumIdentifiedCategories = EscapeSource;
+  static constexpr unsigned NumCategories = Other + 1;
+
+  /// Whether pointers of two categories may alias at all. Identified objects
+  /// only alias themselves, which is handled by ByObject.
+  static constexpr bool MayAlias[NumCategories][NumCategories] = {
+      // Global
+      {false, false, false, true, true, true},
+      // EscapingLocal
+      {false, false, false, true, false, true},
+      // NonEscapingLocal
+      {false, false, false, false, false, true},
+      // EscapeSource
+      {true, true, false, true, true, true},
+      // Argument
+      {true, false, false, true, true, true},
+      // Other
+      {true, true, true, true, true, true},
+  };
+
+  std::vector<const llvm::Value *> Slots;
+  std::array<llvm::SmallVector<unsigned, 0>, NumCategories> ByCategory;
+  llvm::DenseMap<const llvm::Value *, llvm::SmallVector<unsigned, 2>> ByObject;
+  llvm::SmallDenseMap<const llvm::Value *, bool, 8> IsCapturedCache;
+};
+
+/// The alias sets of one function.
+///
+/// Computing them only requires the AAResults for the function and reads the
+/// IR, but does not modify the LLVMAliasSet. Hence, the alias sets of
+/// multiple functions can be computed concurrently and merged afterwards.
+class LLVMAliasSet::FunctionAliasSets {
+public:
+  FunctionAliasSets() noexcept = default;
+  FunctionAliasSets(llvm::AAResults &AA, const llvm::Function &F);
+
+  /// The values that have an alias set
+  DenseBitSetIndex<const llvm::Value *> ValueIds;
+  /// The alias sets as partition of the value-ids
+  DisjointSets Partition;
+
+private:
+  uint32_t addSingletonAliasSet(const llvm::Value *V) {
+    auto Id = ValueIds.getOrInsert(V);
+    if (Id == Partition.size()) {
+      Partition.makeSet();
+    }
+    return Id;
+  }
+
+  void mergeAliasSets(uint32_t Id1, uint32_t Id2) noexcept {
+    Partition.unite(Id1, Id2);
+  }
+
+  void addPointer(llvm::AAResults &AA, const llvm::DataLayout &DL,
+                  const llvm::Value *V, Representatives &Reps);
+};
+
+void LLVMAliasSet::FunctionAliasSets::addPointer(llvm::AAResults &AA,
+                                                 const llvm::DataLayout &DL,
+                                                 const llvm::Value *V,
+                                                 Representatives &Reps) {
   llvm::SmallVector<unsigned> ToMerge;
 
-  for (unsigned It = 0, End = Reps.size(); It < End; ++It) {
-    if (mayAlias(AA, DL, V, Reps[It])) {
-      ToMerge.push_back(It);
+  auto VObj = Reps.classify(V);
+  llvm::SmallVector<unsigned> Candidates;
+  Reps.getCandidates(VObj, Candidates);
+
+  for (auto Slot : Candidates) {
+    if (mayAlias(AA, DL, V, Reps[Slot])) {
+      ToMerge.push_back(Slot);
     }
   }
 
@@ -362,51 +896,34 @@ void LLVMAliasSet::addPointer(llvm::AAResults &AA, const llvm::DataLayout &DL,
   // within the same alias set.
 
   if (ToMerge.empty()) {
-    Reps.push_back(V);
+    Reps.push_back(V, VObj);
     addSingletonAliasSet(V);
   } else if (ToMerge.size() == 1) {
-    auto PTS = AliasSets[Reps[ToMerge[0]]];
-    assert(PTS && "Only added to Reps together with a "
-                  "\"addSingletonAliasSet\" call");
-
-    if (auto VPTS = AliasSets.find(V); VPTS != AliasSets.end()) {
-      mergeAliasSets(PTS, VPTS->second);
-    } else {
-      AliasSets[V] = PTS;
-      PTS->insert(V);
-    }
+    mergeAliasSets(addSingletonAliasSet(V),
+                   addSingletonAliasSet(Reps[ToMerge[0]]));
 
     if (V->getType() != Reps[ToMerge[0]]->getType()) {
-      Reps.push_back(V);
+      Reps.push_back(V, VObj);
     }
 
   } else {
-    auto PTS = AliasSets[Reps[ToMerge[0]]];
+    auto RepId = addSingletonAliasSet(Reps[ToMerge[0]]);
     llvm::SmallPtrSet<const llvm::Type *, 6> OccurringTypes{
         Reps[ToMerge[0]]->getType()};
-    llvm::SmallVector<unsigned> ToRemove;
 
     for (auto Idx : llvm::makeArrayRef(ToMerge).slice(1)) {
-      mergeAliasSets(PTS, AliasSets[Reps[Idx]]);
+      mergeAliasSets(RepId, addSingletonAliasSet(Reps[Idx]));
       if (auto [Unused, Inserted] = OccurringTypes.insert(Reps[Idx]->getType());
           !Inserted) {
-        ToRemove.push_back(Idx);
+        Reps.erase(Idx);
       }
     }
 
-    if (auto VPTS = AliasSets.find(V); VPTS != AliasSets.end()) {
-      mergeAliasSets(PTS, VPTS->second);
-    } else {
-      AliasSets[V] = PTS;
-      PTS->insert(V);
-    }
-
-    Reps.erase(remove_by_index(Reps, ToRemove.begin(), ToRemove.end()),
-               Reps.end());
+    mergeAliasSets(RepId, addSingletonAliasSet(V));
 
     if (auto [Unused, Inserted] = OccurringTypes.insert(V->getType());
         Inserted) {
-      Reps.push_back(V);
+      Reps.push_back(V, VObj);
     }
   }
 }
@@ -441,33 +958,21 @@ static void addIfGlobal(llvm::DenseSet<const llvm::Value *> &UsedGlobals,
   }
 }
 
-void LLVMAliasSet::computeFunctionsAliasSet(llvm::Function *F) {
-  // F may be null
-  if (!F) {
-    return;
-  }
-  // check if we already analyzed the function
-  if (auto [Unused, Inserted] = AnalyzedFunctions.insert(F);
-      !Inserted || F->isDeclaration()) {
-    return;
-  }
-  PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMAliasSet",
-                       "Analyzing function: " << F->getName());
-
-  llvm::AAResults &AA = *PTA.getAAResults(F);
+LLVMAliasSet::FunctionAliasSets::FunctionAliasSets(llvm::AAResults &AA,
+                                                   const llvm::Function &F) {
   bool EvalAAMD = true;
 
-  const llvm::DataLayout &DL = F->getParent()->getDataLayout();
+  const llvm::DataLayout &DL = F.getParent()->getDataLayout();
 
   auto addPointer = [this, &AA, &DL](const llvm::Value *V, // NOLINT
-                                     std::vector<const llvm::Value *> &Reps) {
+                                     Representatives &Reps) {
     return this->addPointer(AA, DL, V, Reps);
   };
 
-  std::vector<const llvm::Value *> Pointers;
+  Representatives Pointers;
   llvm::DenseSet<const llvm::Value *> UsedGlobals;
 
-  for (auto &Inst : llvm::instructions(F)) {
+  for (const auto &Inst : llvm::instructions(F)) {
     if (Inst.getType()->isPointerTy()) {
       // Add all pointer instructions.
       addPointer(&Inst, Pointers);
@@ -475,28 +980,25 @@ void LLVMAliasSet::computeFunctionsAliasSet(llvm::Function *F) {
 
     if (EvalAAMD && llvm::isa<llvm::StoreInst>(&Inst)) {
 
-      auto *Store = llvm::cast<llvm::StoreInst>(&Inst);
-      auto *SVO = Store->getValueOperand();
-      auto *SPO = Store->getPointerOperand();
+      const auto *Store = llvm::cast<llvm::StoreInst>(&Inst);
+      const auto *SVO = Store->getValueOperand();
+      const auto *SPO = Store->getPointerOperand();
       if (SVO->getType()->isPointerTy()) {
 
         if (llvm::isa<llvm::Function>(SVO)) {
-          addSingletonAliasSet(SVO);
-          addSingletonAliasSet(SPO);
-          mergeAliasSets(SVO, SPO);
+          auto SVOId = addSingletonAliasSet(SVO);
+          mergeAliasSets(SVOId, addSingletonAliasSet(SPO));
         }
-        if (auto *SVOCE = llvm::dyn_cast<llvm::ConstantExpr>(SVO)) {
+        if (const auto *SVOCE = llvm::dyn_cast<llvm::ConstantExpr>(SVO)) {
           if (SVOCE->isCast()) {
-            auto *RHS = SVOCE->getOperand(0);
+            const auto *RHS = SVOCE->getOperand(0);
 
-            addSingletonAliasSet(SPO);
+            auto SPOId = addSingletonAliasSet(SPO);
             if (RHS->getType()->isPointerTy()) {
-              addSingletonAliasSet(RHS);
-              mergeAliasSets(RHS, SPO);
+              mergeAliasSets(addSingletonAliasSet(RHS), SPOId);
             }
 
-            addSingletonAliasSet(SVOCE);
-            mergeAliasSets(SVOCE, SPO);
+            mergeAliasSets(addSingletonAliasSet(SVOCE), SPOId);
           }
         }
       }
@@ -505,8 +1007,8 @@ void LLVMAliasSet::computeFunctionsAliasSet(llvm::Function *F) {
     /// The operands/arguments of instructions should already be inserted,
     /// because of the SSA form
 
-    if (auto *Call = llvm::dyn_cast<llvm::CallBase>(&Inst)) {
-      llvm::Value *Callee = Call->getCalledOperand();
+    if (const auto *Call = llvm::dyn_cast<llvm::CallBase>(&Inst)) {
+      const llvm::Value *Callee = Call->getCalledOperand();
       // Skip actual functions for direct function calls.
       if (!llvm::isa<llvm::Function>(Callee) && isInterestingPointer(Callee) &&
           !llvm::isa<llvm::Instruction>(Callee)) {
@@ -514,7 +1016,7 @@ void LLVMAliasSet::computeFunctionsAliasSet(llvm::Function *F) {
       }
 
       // Consider arguments.
-      for (llvm::Use &DataOp : Call->data_ops()) {
+      for (const llvm::Use &DataOp : Call->data_ops()) {
         addIfGlobal(UsedGlobals, DataOp);
         if (!llvm::isa<llvm::Instruction>(DataOp) &&
             isInterestingPointer(DataOp)) {
@@ -523,7 +1025,7 @@ void LLVMAliasSet::computeFunctionsAliasSet(llvm::Function *F) {
       }
     } else {
       // Consider all operands; the instructions we have already seen
-      for (auto &Op : Inst.operands()) {
+      for (const auto &Op : Inst.operands()) {
         addIfGlobal(UsedGlobals, Op);
         if (!llvm::isa<llvm::Instruction>(Op) && isInterestingPointer(Op)) {
           addPointer(Op, Pointers);
@@ -532,22 +1034,170 @@ void LLVMAliasSet::computeFunctionsAliasSet(llvm::Function *F) {
     }
   }
 
-  for (auto &I : F->args()) {
+  for (const auto &I : F.args()) {
     if (I.getType()->isPointerTy()) {
       // Add all pointer arguments.
       addPointer(&I, Pointers);
     }
   }
 
-  auto NumGlobals = UsedGlobals.size();
-
-  Pointers.reserve(Pointers.size() + NumGlobals);
   for (const auto *Glob : UsedGlobals) {
     addPointer(Glob, Pointers);
   }
+}
+
+void LLVMAliasSet::addFunctionAliasSets(const FunctionAliasSets &FunSets) {
+  auto NumValues = FunSets.ValueIds.size();
+  llvm::SmallVector<uint32_t, 0> Ids;
+  Ids.reserve(NumValues);
+  for (uint32_t FunId = 0; FunId != NumValues; ++FunId) {
+    Ids.push_back(addSingletonAliasSet(FunSets.ValueIds[FunId]));
+  }
+  for (uint32_t FunId = 0; FunId != NumValues; ++FunId) {
+    if (auto FunRoot = FunSets.Partition.find(FunId); FunRoot != FunId) {
+      mergeAliasSets(Ids[FunRoot], Ids[FunId]);
+    }
+  }
+}
+
+void LLVMAliasSet::computeFunctionsAliasSet(llvm::Function *F) {
+  // F may be null
+  if (!F) {
+    return;
+  }
+  // check if we already analyzed the function
+  if (auto [Unused, Inserted] = AnalyzedFunctions.insert(F);
+      !Inserted || F->isDeclaration()) {
+    return;
+  }
+  PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMAliasSet",
+                       "Analyzing function: " << F->getName());
+
+  FunctionAliasSets FunSets(*PTA.getAAResults(F), *F);
 
   // we no longer need the LLVM representation
   PTA.erase(F);
+
+  addFunctionAliasSets(FunSets);
+}
+
+void LLVMAliasSet::computeAndersenAliasSets(const LLVMProjectIRDB &IRDB) {
+  LLVMAndersenAliasInfo Andersen(IRDB);
+
+  // The alias sets form a partition, so pointers that may point to the same
+  // abstract object, irrespective of the field, share an alias set
+  llvm::DenseMap<const llvm::Value *, uint32_t> SiteIds;
+  Andersen.forEachPointsToSet(
+      [&](const llvm::Value *V, llvm::ArrayRef<const llvm::Value *> Sites) {
+        auto Id = addSingletonAliasSet(V);
+        for (const auto *Site : Sites) {
+          auto [It, Inserted] = SiteIds.try_emplace(Site, Id);
+          if (!Inserted) {
+            mergeAliasSets(It->second, Id);
+          }
+        }
+      });
+
+  for (const auto &F : *IRDB.getModule()) {
+    if (!F.isDeclaration()) {
+      AnalyzedFunctions.insert(&F);
+    }
+  }
+}
+
+/// Computes everything that LLVM computes lazily and caches on the types of M
+/// when first queried, such that the types are only read afterwards
+static void precomputeTypeProperties(const llvm::Module &M) {
+  const auto &DL = M.getDataLayout();
+  llvm::TypeFinder StructTypes;
+  StructTypes.run(M, /*onlyNamed*/ false);
+  for (auto *STy : StructTypes) {
+    // Caches whether STy is sized in STy itself
+    if (STy->isSized()) {
+      // Caches the StructLayout in the DataLayout
+      (void)DL.getStructLayout(STy);
+    }
+  }
+}
+
+void LLVMAliasSet::computeFunctionsAliasSetsInParallel(LLVMProjectIRDB &IRDB,
+                                                       AliasAnalysisType PATy,
+                                                       unsigned NumThreads) {
+  auto &M = *IRDB.getModule();
+  std::vector<llvm::Function *> Functions;
+  for (auto &F : M) {
+    if (!F.isDeclaration() && !AnalyzedFunctions.count(&F)) {
+      Functions.push_back(&F);
+    }
+  }
+
+  auto NumWorkers = std::min<size_t>(
+      Functions.size(),
+      llvm::hardware_concurrency(NumThreads).compute_thread_count());
+  if (NumWorkers <= 1) {
+    for (auto *F : Functions) {
+      computeFunctionsAliasSet(F);
+    }
+    return;
+  }
+
+  PHASAR_LOG_LEVEL_CAT(INFO, "LLVMAliasSet",
+                       "Analyzing " << Functions.size() << " functions on "
+                                    << NumWorkers << " threads");
+
+  precomputeTypeProperties(M);
+
+  // Each worker computes the AAResults for its functions in its own
+  // FunctionAnalysisManager. However, some of the analyses register
+  // value-handles in the shared LLVMContext when being computed or
+  // destroyed. So, we guard these parts with ContextMtx and make sure that
+  // the alias queries themselves only read the IR.
+  std::vector<std::unique_ptr<LLVMBasedAliasAnalysis>> WorkerPTAs;
+  WorkerPTAs.reserve(NumWorkers);
+  for (size_t I = 0; I < NumWorkers; ++I) {
+    WorkerPTAs.push_back(
+        std::make_unique<LLVMBasedAliasAnalysis>(IRDB, true, PATy));
+  }
+
+  std::vector<FunctionAliasSets> Results(Functions.size());
+  std::atomic_size_t NextFunction = 0;
+  std::mutex ContextMtx;
+
+  {
+    llvm::ThreadPool Pool(llvm::hardware_concurrency(NumWorkers));
+    std::vector<std::shared_future<void>> Tasks;
+    Tasks.reserve(NumWorkers);
+    for (auto &WorkerPTA : WorkerPTAs) {
+      Tasks.push_back(Pool.async([&, &WorkerPTA = *WorkerPTA] {
+        for (size_t Idx = NextFunction++; Idx < Functions.size();
+             Idx = NextFunction++) {
+          auto *F = Functions[Idx];
+          llvm::AAResults *AA{};
+          {
+            std::lock_guard Lck(ContextMtx);
+            AA = WorkerPTA.getAAResultsForConcurrentQueries(F);
+          }
+
+          Results[Idx] = FunctionAliasSets(*AA, *F);
+
+          std::lock_guard Lck(ContextMtx);
+          WorkerPTA.erase(F);
+        }
+      }));
+    }
+    // Propagates the first exception that was thrown by a worker
+    for (auto &Task : Tasks) {
+      Task.get();
+    }
+  }
+
+  // Merge in the order of the functions, such that the alias sets do not
+  // depend on the scheduling of the workers
+  for (size_t Idx = 0, End = Functions.size(); Idx != End; ++Idx) {
+    AnalyzedFunctions.insert(Functions[Idx]);
+    addFunctionAliasSets(Results[Idx]);
+    Results[Idx] = {};
+  }
 }
 
 AliasResult LLVMAliasSet::alias(const llvm::Value *V1, const llvm::Value *V2,
@@ -558,8 +1208,8 @@ AliasResult LLVMAliasSet::alias(const llvm::Value *V1, const llvm::Value *V2,
   }
   computeValuesAliasSet(V1);
   computeValuesAliasSet(V2);
-  return AliasSets[V1]->count(V2) ? AliasResult::MayAlias
-                                  : AliasResult::NoAlias;
+  return inSameAliasSet(V1, V2) ? AliasResult::MayAlias
+                                : AliasResult::NoAlias;
 }
 
 auto LLVMAliasSet::getEmptyAliasSet() -> BoxedPtr<AliasSetTy> {
@@ -578,13 +1228,37 @@ auto LLVMAliasSet::getAliasSet(const llvm::Value *V,
   }
   // compute V's points-to set
   computeValuesAliasSet(V);
-  if (auto It = AliasSets.find(V); It != AliasSets.end()) {
-    return It->second;
+  if (auto Id = ValueIds.lookup(V)) {
+    return materializeAliasSet(Partition.find(*Id));
   }
   // if we still can't find its value return an empty set
   return getEmptyAliasSet();
 }
 
+auto LLVMAliasSet::getCompactAliasSet(
+    const llvm::Value *V, [[maybe_unused]] const llvm::Instruction *I)
+    -> std::shared_ptr<const CompactIdSet> {
+  static const auto EmptySet = std::make_shared<const CompactIdSet>();
+
+  if (!isInterestingPointer(V)) {
+    return EmptySet;
+  }
+  computeValuesAliasSet(V);
+  auto Id = ValueIds.lookup(V);
+  if (!Id) {
+    return EmptySet;
+  }
+
+  auto Root = Partition.find(*Id);
+  auto &Set = CompactSets[Root];
+  if (!Set) {
+    auto Members = Partition.members(Root);
+    Set = std::make_shared<const CompactIdSet>(
+        std::vector<uint32_t>(Members.begin(), Members.end()));
+  }
+  return Set;
+}
+
 auto LLVMAliasSet::getReachableAllocationSites(
     const llvm::Value *V, bool IntraProcOnly,
     [[maybe_unused]] const llvm::Instruction *I) -> AllocationSiteSetPtrTy {
@@ -597,10 +1271,18 @@ auto LLVMAliasSet::getReachableAllocationSites(
   }
   computeValuesAliasSet(V);
 
-  const auto PTS = AliasSets[V];
+  auto Id = ValueIds.lookup(V);
+  if (!Id) {
+    return AllocSites;
+  }
+  auto PTS = llvm::map_range(Partition.members(*Id),
+                             [this](uint32_t Member) -> const llvm::Value * {
+                               return ValueIds[Member];
+                             });
+
   // consider the full inter-procedural points-to/alias information
   if (!IntraProcOnly) {
-    for (const auto *P : *PTS) {
+    for (const auto *P : PTS) {
       if (interIsReachableAllocationSiteTy(V, P)) {
         AllocSites->insert(P);
       }
@@ -613,7 +1295,7 @@ auto LLVMAliasSet::getReachableAllocationSites(
     // We may not be able to retrieve a function for the given value since some
     // pointer values can exist outside functions, for instance, in case of
     // vtables, etc.
-    for (const auto *P : *PTS) {
+    for (const auto *P : PTS) {
       if (intraIsReachableAllocationSiteTy(V, P, VFun, VG)) {
         AllocSites->insert(P);
       }
@@ -643,8 +1325,7 @@ bool LLVMAliasSet::isInReachableAllocationSites(
   }
 
   if (PVIsReachableAllocationSiteType) {
-    const auto PTS = AliasSets[V];
-    return PTS->count(PotentialValue);
+    return inSameAliasSet(V, PotentialValue);
   }
 
   return false;
@@ -656,30 +1337,13 @@ void LLVMAliasSet::mergeWith(const LLVMAliasSet &OtherPTI) {
   AnalyzedFunctions.insert(OtherPTI.AnalyzedFunctions.begin(),
                            OtherPTI.AnalyzedFunctions.end());
   // merge points-to sets
-  for (const auto &[KeyPtr, Set] : OtherPTI.AliasSets) {
-    bool FoundElemPtr = false;
-    for (const auto *ElemPtr : *Set) {
-      // check if a pointer of other is already present in this
-
-      if (auto Search = AliasSets.find(ElemPtr); Search != AliasSets.end()) {
-        // if so, copy its elements
-        FoundElemPtr = true;
-        Search->second->insert(Set->begin(), Set->end());
-        // and reindex its elements
-        for (const auto *ElemPtr : *Set) {
-          AliasSets.insert({ElemPtr, Search->second});
-        }
-        break;
-      }
+  OtherPTI.forEachAliasSet([this](llvm::ArrayRef<const llvm::Value *> Set) {
+    auto First = addSingletonAliasSet(Set.front());
+    for (const auto *V : Set.drop_front()) {
+      auto Id = addSingletonAliasSet(V);
+      mergeAliasSets(First, Id);
     }
-    // if none of the pointers of a set of other is known in this, we need to
-    // perform a copy
-    if (!FoundElemPtr) {
-      auto PTS = Owner.acquire();
-      *PTS = *Set;
-      AliasSets.try_emplace(KeyPtr, PTS);
-    }
-  }
+  });
 }
 
 void LLVMAliasSet::introduceAlias(const llvm::Value *V1, const llvm::Value *V2,
@@ -694,6 +1358,292 @@ void LLVMAliasSet::introduceAlias(const llvm::Value *V1, const llvm::Value *V2,
   computeValuesAliasSet(V1);
   computeValuesAliasSet(V2);
   mergeAliasSets(V1, V2);
+  // Keep the alias, when the alias sets of V1 or V2 are recomputed
+  IntroducedAliases.emplace_back(V1, V2);
+}
+
+/// Whether V is an argument or instruction of F
+static bool isLocalTo(const llvm::Value *V, const llvm::Function *F) {
+  if (const auto *Inst = llvm::dyn_cast<llvm::Instruction>(V)) {
+    return Inst->getFunction() == F;
+  }
+  if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(V)) {
+    return Arg->getParent() == F;
+  }
+  return false;
+}
+
+/// Collects the values that the alias sets of F may have been computed from:
+/// F's arguments and instructions, and the constants and globals they use,
+/// including the ones in the initializers of used globals (cf. addIfGlobal()).
+static void
+collectReferencedValues(const llvm::Function &F,
+                        llvm::SmallVectorImpl<const llvm::Value *> &Into) {
+  llvm::SmallPtrSet<const llvm::Value *, 16> Seen;
+  llvm::SmallVector<const llvm::Constant *> WorkList;
+  auto Push = [&](const llvm::Value *V) {
+    const auto *C = llvm::dyn_cast<llvm::Constant>(V);
+    if (C && Seen.insert(C).second) {
+      Into.push_back(C);
+      WorkList.push_back(C);
+    }
+  };
+
+  for (const auto &Arg : F.args()) {
+    Into.push_back(&Arg);
+  }
+  for (const auto &Inst : llvm::instructions(F)) {
+    Into.push_back(&Inst);
+    for (const auto &Op : Inst.operands()) {
+      Push(Op);
+    }
+  }
+
+  while (!WorkList.empty()) {
+    const auto *Curr = WorkList.pop_back_val();
+    if (const auto *Glob = llvm::dyn_cast<llvm::GlobalVariable>(Curr)) {
+      if (Glob->hasInitializer()) {
+        Push(Glob->getInitializer());
+      }
+    } else if (llvm::isa<llvm::ConstantExpr>(Curr) ||
+               llvm::isa<llvm::ConstantAggregate>(Curr)) {
+      for (const auto &Op : Curr->operands()) {
+        Push(Op);
+      }
+    }
+  }
+}
+
+/// Collects the functions that use the constant C, either directly or through
+/// other constants
+static void
+collectUserFunctions(const llvm::Constant *C,
+                     llvm::SetVector<const llvm::Function *> &Into) {
+  llvm::SmallPtrSet<const llvm::User *, 16> Seen;
+  llvm::SmallVector<const llvm::User *> WorkList{C};
+  while (!WorkList.empty()) {
+    const auto *Curr = WorkList.pop_back_val();
+    for (const auto *User : Curr->users()) {
+      if (const auto *Inst = llvm::dyn_cast<llvm::Instruction>(User)) {
+        if (Inst->getParent()) {
+          Into.insert(Inst->getFunction());
+        }
+      } else if (llvm::isa<llvm::Constant>(User) && Seen.insert(User).second) {
+        WorkList.push_back(User);
+      }
+    }
+  }
+}
+
+void LLVMAliasSet::decodeAllAliasSets() {
+  if (!Image) {
+    return;
+  }
+  for (uint32_t ImageSet = 0, End = Image->getNumSets(); ImageSet != End;
+       ++ImageSet) {
+    if (Image->isDecoded(ImageSet)) {
+      continue;
+    }
+    // Adding any member decodes the whole set
+    for (uint64_t Key : Image->members(ImageSet)) {
+      if (const auto *V = Image->keys().getValue(Key)) {
+        addSingletonAliasSet(V);
+        break;
+      }
+    }
+  }
+  Image.reset();
+}
+
+void LLVMAliasSet::dissolveAliasSet(uint32_t Root) {
+  assert(Partition.isRoot(Root));
+  ++Generation;
+  CompactSets.erase(Root);
+  // The DenseSets that have been handed out become snapshots
+  MaterializedSets.erase(Root);
+  Partition.dissolve(Root);
+}
+
+void LLVMAliasSet::invalidateAllAliasSets() {
+  for (uint32_t Root = 0, End = Partition.size(); Root != End; ++Root) {
+    if (Partition.isRoot(Root) && Partition.setSize(Root) > 1) {
+      dissolveAliasSet(Root);
+    }
+  }
+  CompactSets.clear();
+  MaterializedSets.clear();
+  AnalyzedFunctions.clear();
+  HasPendingUpdates = true;
+}
+
+/// Collects the functions that call F directly or through other callers of F
+static void
+collectTransitiveCallers(const llvm::Function *F,
+                         llvm::SetVector<const llvm::Function *> &Into) {
+  llvm::SmallVector<const llvm::Function *> WorkList{F};
+  while (!WorkList.empty()) {
+    const auto *Callee = WorkList.pop_back_val();
+    for (const auto *User : Callee->users()) {
+      const auto *CB = llvm::dyn_cast<llvm::CallBase>(User);
+      if (!CB || CB->getCalledFunction() != Callee || !CB->getParent()) {
+        continue;
+      }
+      const auto *Caller = CB->getFunction();
+      if (Caller != F && Into.insert(Caller)) {
+        WorkList.push_back(Caller);
+      }
+    }
+  }
+}
+
+void LLVMAliasSet::eraseFunction(const llvm::Function *F) {
+  assert(F != nullptr);
+  PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMAliasSet",
+                       "Erasing function: " << F->getName());
+
+  // The Image may refer to F's values, so decode it while they still exist
+  decodeAllAliasSets();
+
+  llvm::erase_if(IntroducedAliases, [F](const auto &Alias) {
+    return isLocalTo(Alias.first, F) || isLocalTo(Alias.second, F);
+  });
+
+  llvm::SmallVector<const llvm::Value *> Referenced;
+  collectReferencedValues(*F, Referenced);
+
+  PendingFunctions.remove(F);
+  PendingGlobals.remove(F);
+
+  // The alias information of F is cached in PTA, including the summaries of F
+  // and its callers that are shared between the alias information of their
+  // callers
+  PTA.clear();
+
+  if (isInterProcedural()) {
+    invalidateAllAliasSets();
+  } else {
+    // The alias sets of F's callers are derived from F's summary
+    llvm::SetVector<const llvm::Function *> Contributors;
+    collectTransitiveCallers(F, Contributors);
+
+    llvm::SmallDenseSet<uint32_t> Roots;
+    auto AddRootsOf = [&](llvm::ArrayRef<const llvm::Value *> Values) {
+      for (const auto *V : Values) {
+        if (auto Id = ValueIds.lookup(V)) {
+          Roots.insert(Partition.find(*Id));
+        }
+      }
+    };
+    AddRootsOf(Referenced);
+    for (const auto *Caller : Contributors) {
+      llvm::SmallVector<const llvm::Value *> CallerReferenced;
+      collectReferencedValues(*Caller, CallerReferenced);
+      AddRootsOf(CallerReferenced);
+    }
+
+    // All functions that may have contributed to the alias sets that we split
+    // up need to be re-analyzed
+    for (auto Root : Roots) {
+      for (auto Member : Partition.members(Root)) {
+        const auto *V = ValueIds[Member];
+        if (isLocalTo(V, F)) {
+          continue;
+        }
+        if (const auto *Inst = llvm::dyn_cast<llvm::Instruction>(V)) {
+          Contributors.insert(Inst->getFunction());
+        } else if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(V)) {
+          Contributors.insert(Arg->getParent());
+        } else if (const auto *C = llvm::dyn_cast<llvm::Constant>(V)) {
+          collectUserFunctions(C, Contributors);
+          const auto *G = llvm::dyn_cast<llvm::GlobalObject>(C);
+          if (G && G != F) {
+            PendingGlobals.insert(G);
+          }
+        }
+      }
+    }
+
+    for (auto Root : Roots) {
+      dissolveAliasSet(Root);
+    }
+
+    for (const auto *Contributor : Contributors) {
+      if (Contributor != F && AnalyzedFunctions.erase(Contributor)) {
+        PendingFunctions.insert(Contributor);
+      }
+    }
+    AnalyzedFunctions.erase(F);
+    HasPendingUpdates |= !PendingFunctions.empty() || !Roots.empty();
+  }
+
+  // F's arguments and instructions have singleton alias sets now
+  ErasedIds.resize(Partition.size());
+  for (const auto *V : Referenced) {
+    if (!isLocalTo(V, F)) {
+      continue;
+    }
+    if (auto Id = ValueIds.lookup(V)) {
+      ErasedIds.set(*Id);
+    }
+  }
+}
+
+void LLVMAliasSet::insertFunction(llvm::Function *F) {
+  assert(F != nullptr);
+  assert(F->getParent() == IRDB->getModule() &&
+         "The function F should be present in the module of the IRDB!");
+  PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMAliasSet",
+                       "Inserting function: " << F->getName());
+
+  if (isInterProcedural()) {
+    // Any function may change the points-to sets of the whole program
+    if (!HasPendingUpdates && !AnalyzedFunctions.count(F)) {
+      invalidateAllAliasSets();
+    }
+    if (HasPendingUpdates) {
+      completePendingUpdates();
+    }
+    return;
+  }
+
+  // The alias summaries that PTA shares between functions may be derived from
+  // F's old IR
+  PTA.clear();
+
+  // F may be used as function pointer by other functions
+  computeValuesAliasSet(F);
+  computeFunctionsAliasSet(F);
+
+  // Link the globals that F uses with their uses in F
+  llvm::SmallVector<const llvm::Value *> Referenced;
+  collectReferencedValues(*F, Referenced);
+  for (const auto *V : Referenced) {
+    if (llvm::isa<llvm::GlobalObject>(V)) {
+      computeValuesAliasSet(V);
+    }
+  }
+}
+
+void LLVMAliasSet::completePendingUpdates() {
+  HasPendingUpdates = false;
+
+  if (isInterProcedural()) {
+    computeAndersenAliasSets(*IRDB);
+  } else {
+    auto Functions = std::exchange(PendingFunctions, {});
+    auto Globals = std::exchange(PendingGlobals, {});
+    for (const auto *F : Functions) {
+      // NOLINTNEXTLINE - FIXME when it is fixed in LLVM
+      computeFunctionsAliasSet(const_cast<llvm::Function *>(F));
+    }
+    for (const auto *G : Globals) {
+      computeValuesAliasSet(G);
+    }
+  }
+
+  for (auto [V1, V2] : IntroducedAliases) {
+    mergeAliasSets(V1, V2);
+  }
 }
 
 nlohmann::json LLVMAliasSet::getAsJson() const {
@@ -702,10 +1652,10 @@ nlohmann::json LLVMAliasSet::getAsJson() const {
   /// Serialize the AliasSets
   auto &Sets = J["AliasSets"];
 
-  for (const AliasSetTy *PTS : Owner.getAllAliasSets()) {
+  forEachAliasSet([&Sets](llvm::ArrayRef<const llvm::Value *> Set) {
     auto PtsJson = nlohmann::json::array();
-    for (const auto *Alias : *PTS) {
-      auto Id = getMetaDataID(Alias);
+    for (const auto *V : Set) {
+      auto Id = getMetaDataID(V);
       if (Id != "-1") {
         PtsJson.push_back(std::move(Id));
       }
@@ -713,7 +1663,7 @@ nlohmann::json LLVMAliasSet::getAsJson() const {
     if (!PtsJson.empty()) {
       Sets.push_back(std::move(PtsJson));
     }
-  }
+  });
 
   /// Serialize the AnalyzedFunctions
   auto &Fns = J["AnalyzedFunctions"];
@@ -727,15 +1677,106 @@ void LLVMAliasSet::printAsJson(llvm::raw_ostream &OS) const {
   OS << getAsJson();
 }
 
-void LLVMAliasSet::print(llvm::raw_ostream &OS) const {
-  for (const auto &[V, PTS] : AliasSets) {
-    OS << "V: " << llvmIRToString(V) << '\n';
-    for (const auto &Ptr : *PTS) {
-      OS << "\tpoints to -> " << llvmIRToString(Ptr) << '\n';
+void LLVMAliasSet::printAsBinary(llvm::raw_ostream &OS) const {
+  ValueKeys Keys(*IRDB);
+
+  llvm::SmallVector<uint32_t, 0> SetOffsets = {0};
+  llvm::SmallVector<uint64_t, 0> Members;
+  forEachAliasSet([&](llvm::ArrayRef<const llvm::Value *> Set) {
+    auto NumMembers = Members.size();
+    for (const auto *V : Set) {
+      if (auto Key = Keys.getKey(V)) {
+        Members.push_back(*Key);
+      }
     }
+    if (Members.size() != NumMembers) {
+      SetOffsets.push_back(Members.size());
+    }
+  });
+  auto NumSets = uint32_t(SetOffsets.size() - 1);
+
+  llvm::SmallVector<std::pair<uint64_t, uint32_t>, 0> KeySets;
+  KeySets.reserve(Members.size());
+  for (uint32_t Set = 0; Set != NumSets; ++Set) {
+    for (auto Idx = SetOffsets[Set]; Idx != SetOffsets[Set + 1]; ++Idx) {
+      KeySets.emplace_back(Members[Idx], Set);
+    }
+  }
+  llvm::sort(KeySets);
+
+  llvm::SmallVector<uint32_t, 0> Funs;
+  Funs.reserve(AnalyzedFunctions.size());
+  for (const auto *F : AnalyzedFunctions) {
+    Funs.push_back(Keys.getFunctionIndex(F));
+  }
+  llvm::sort(Funs);
+
+  llvm::support::endian::Writer Writer(OS, llvm::support::little);
+  Writer.write(BinaryMagic);
+  Writer.write(BinaryVersion);
+  Writer.write(uint32_t(Funs.size()));
+  Writer.write(Keys.getModuleFingerprint());
+  Writer.write(NumSets);
+  Writer.write(uint32_t(Members.size()));
+
+  Writer.write<uint32_t>(Funs);
+  Writer.write<uint32_t>(SetOffsets);
+  Writer.write<uint64_t>(Members);
+  for (auto [Key, Unused] : KeySets) {
+    Writer.write(Key);
+  }
+  for (auto [Unused, Set] : KeySets) {
+    Writer.write(Set);
   }
 }
 
+void LLVMAliasSet::forEachAliasSet(
+    llvm::function_ref<void(llvm::ArrayRef<const llvm::Value *>)> Handler)
+    const {
+  llvm::SmallVector<const llvm::Value *> Set;
+  for (uint32_t Root = 0, End = Partition.size(); Root != End; ++Root) {
+    if (!Partition.isRoot(Root) || isErased(Root)) {
+      continue;
+    }
+    Set.clear();
+    for (auto Member : Partition.members(Root)) {
+      Set.push_back(ValueIds[Member]);
+    }
+    Handler(Set);
+  }
+
+  if (!Image) {
+    return;
+  }
+  // The sets that have not been decoded, yet, are disjoint from the Partition
+  for (uint32_t ImageSet = 0, End = Image->getNumSets(); ImageSet != End;
+       ++ImageSet) {
+    if (Image->isDecoded(ImageSet)) {
+      continue;
+    }
+    Set.clear();
+    for (uint64_t Key : Image->members(ImageSet)) {
+      if (const auto *V = Image->keys().getValue(Key)) {
+        Set.push_back(V);
+      }
+    }
+    if (!Set.empty()) {
+      Handler(Set);
+    }
+  }
+}
+
+void LLVMAliasSet::print(llvm::raw_ostream &OS) const {
+  forEachAliasSet([&OS](llvm::ArrayRef<const llvm::Value *> Set) {
+    for (const auto *V : Set) {
+      OS << "V: " << llvmIRToString(V) << '\n';
+      for (const auto *Alias : Set) {
+        OS << "\tpoints to -> " << llvmIRToString(Alias) << '\n';
+      }
+    }
+  });
+}
+
 void LLVMAliasSet::peakIntoAliasSet(const AliasSetMap::value_type &ValueSetPair,
                                     int Peak) {
   llvm::outs() << "Value: ";
@@ -758,19 +1799,25 @@ void LLVMAliasSet::peakIntoAliasSet(const AliasSetMap::value_type &ValueSetPair,
 
 void LLVMAliasSet::drawAliasSetsDistribution(int Peak) const {
   std::vector<std::pair<size_t, unsigned>> SizeAmountPairs;
-
-  for (const auto &ValueSetPair : AliasSets) {
-    auto Search =
-        std::find_if(SizeAmountPairs.begin(), SizeAmountPairs.end(),
-                     [&ValueSetPair](const auto &Entry) {
-                       return Entry.first == ValueSetPair.second->size();
-                     });
+  AliasSetTy BiggestSet;
+
+  forEachAliasSet([&](llvm::ArrayRef<const llvm::Value *> Set) {
+    // Counts every value with an alias set of that size
+    auto SetSize = Set.size();
+    auto Search = std::find_if(
+        SizeAmountPairs.begin(), SizeAmountPairs.end(),
+        [SetSize](const auto &Entry) { return Entry.first == SetSize; });
     if (Search != SizeAmountPairs.end()) {
-      Search->second++;
+      Search->second += SetSize;
     } else {
-      SizeAmountPairs.emplace_back(ValueSetPair.second->size(), 1);
+      SizeAmountPairs.emplace_back(SetSize, SetSize);
     }
-  }
+
+    if (SetSize > BiggestSet.size()) {
+      BiggestSet.clear();
+      BiggestSet.insert(Set.begin(), Set.end());
+    }
+  });
 
   std::sort(SizeAmountPairs.begin(), SizeAmountPairs.end(),
             [](const auto &KVPair1, const auto &KVPair2) {
@@ -792,14 +1839,10 @@ void LLVMAliasSet::drawAliasSetsDistribution(int Peak) const {
   }
   llvm::outs() << "\n";
 
-  if (Peak) {
-    for (const auto &ValueSetPair : AliasSets) {
-      if (ValueSetPair.second->size() == SizeAmountPairs.back().first) {
-        llvm::outs() << "Peak into one of the biggest points sets.\n";
-        peakIntoAliasSet(ValueSetPair, Peak);
-        return;
-      }
-    }
+  if (Peak && !BiggestSet.empty()) {
+    auto *PTSPtr = &BiggestSet;
+    llvm::outs() << "Peak into one of the biggest points sets.\n";
+    peakIntoAliasSet({*BiggestSet.begin(), &PTSPtr}, Peak);
   }
 }
 
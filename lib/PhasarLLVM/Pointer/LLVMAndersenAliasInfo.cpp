@@ -0,0 +1,1323 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#include "phasar/PhasarLLVM/Pointer/LLVMAndersenAliasInfo.h"
+
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
+#include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/NlohmannLogging.h"
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/SparseBitVector.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GetElementPtrTypeIterator.h"
+#include "llvm/IR/GlobalAlias.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Operator.h"
+#include "llvm/Support/Casting.h"
+
+#include "nlohmann/json.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <optional>
+#include <utility>
+
+using namespace psr;
+
+/// Objects with more (flattened) fields are analyzed field-insensitively
+static constexpr uint32_t MaxObjectFields = 1024;
+
+/// Handler is called with each field-node that is Offset fields behind the
+/// object-node ObjNode. If Offset is out of bounds, e.g. because of casts
+/// between unrelated types, Handler is called with all fields of the object.
+template <typename AbstractObjectT, typename HandlerT>
+static void forEachField(const AbstractObjectT &Obj, uint32_t ObjNode,
+                         uint32_t Offset, HandlerT Handler) {
+  if (Obj.NumFields == 1) {
+    Handler(Obj.FirstNode);
+    return;
+  }
+
+  auto Field = uint64_t(ObjNode - Obj.FirstNode) + Offset;
+  if (Field < Obj.NumFields) {
+    Handler(uint32_t(Obj.FirstNode + Field));
+    return;
+  }
+
+  for (uint32_t Idx = 0; Idx != Obj.NumFields; ++Idx) {
+    Handler(Obj.FirstNode + Idx);
+  }
+}
+
+namespace psr {
+
+class LLVMAndersenAliasInfo::Solver {
+public:
+  Solver(LLVMAndersenAliasInfo &Result, const llvm::Module &M)
+      : Result(Result), M(M) {}
+
+  void generateConstraints();
+
+  void solve();
+
+private:
+  enum class ConstraintKind : uint8_t {
+    /// Other ⊇ *(Node + Offset)
+    Load,
+    /// *(Node + Offset) ⊇ Other
+    Store,
+    /// Other ⊇ Node + Offset
+    Offset,
+    /// Resolves the indirect call CallSites[Other] with the functions that
+    /// Node points to
+    Call,
+  };
+
+  struct Constraint {
+    ConstraintKind Kind{};
+    uint32_t Other{};
+    uint32_t Offset{};
+  };
+
+  /// The offset of a Load or Store, whose target is not known
+  static constexpr uint32_t AllFields = UINT32_MAX;
+
+  struct FunctionNodes {
+    std::optional<uint32_t> Ret;
+    std::optional<uint32_t> VarArgs;
+  };
+
+  uint32_t makeNode();
+  uint32_t makeObject(const llvm::Value *Site, llvm::Type *Ty);
+
+  [[nodiscard]] uint32_t numFields(llvm::Type *Ty);
+  [[nodiscard]] bool carriesPointers(llvm::Type *Ty);
+  /// The field offset of the pointer that GEP computes relative to its base;
+  /// std::nullopt, if it cannot be determined statically
+  [[nodiscard]] std::optional<uint32_t>
+  getFieldOffset(const llvm::GEPOperator &GEP);
+
+  /// The node of V, if V may hold a pointer
+  std::optional<uint32_t> getNode(const llvm::Value *V);
+  FunctionNodes &getFunctionNodes(const llvm::Function &F);
+
+  void addCopy(uint32_t From, uint32_t To);
+  void addComplex(uint32_t Node, Constraint C);
+  void addGEP(uint32_t Dst, const llvm::GEPOperator &GEP);
+  void addMemCopy(const llvm::Value *Dst, const llvm::Value *Src);
+  void addInitializer(const AbstractObject &Obj, uint32_t Offset,
+                      const llvm::Constant *Init);
+  /// The pointers that Int has been computed from escape to unknown memory
+  void escapeIntOperands(const llvm::Value *Int);
+
+  void visitInstruction(const llvm::Instruction &I);
+  void visitCall(const llvm::CallBase &CB);
+  void bindCall(const llvm::CallBase &CB, const llvm::Function &Callee);
+
+  uint32_t findRep(uint32_t Node);
+  void unite(uint32_t Rep, uint32_t Node);
+
+  /// Collapses the cycles of copy-edges and returns the representatives in
+  /// topological order
+  std::vector<uint32_t> collapseCycles();
+  void propagate(llvm::ArrayRef<uint32_t> TopoOrder);
+  void processComplexConstraints();
+  void apply(const Constraint &C, const llvm::SparseBitVector<> &Pts);
+
+  LLVMAndersenAliasInfo &Result;
+  const llvm::Module &M;
+
+  /// The only field of the unknown object, i.e., the memory that is not part
+  /// of the module. Its points-to set contains the unknown object itself and
+  /// all objects whose address has escaped.
+  uint32_t Unknown{};
+
+  /// The copy-edges; their targets may no longer be representatives
+  std::vector<llvm::SparseBitVector<>> Succs;
+  std::vector<llvm::SmallVector<Constraint, 0>> Complex;
+  /// The parts of the points-to sets that have already been propagated along
+  /// the copy-edges
+  std::vector<llvm::SparseBitVector<>> PrevPts;
+  /// The parts of the points-to sets that have already been passed to the
+  /// complex constraints
+  std::vector<llvm::SparseBitVector<>> PrevComplexPts;
+
+  llvm::DenseMap<const llvm::Function *, FunctionNodes> FunNodes;
+  std::vector<const llvm::CallBase *> CallSites;
+  /// The callees that the indirect calls have already been bound to
+  llvm::DenseSet<std::pair<const llvm::CallBase *, const llvm::Function *>>
+      BoundCalls;
+
+  llvm::DenseMap<llvm::Type *, uint32_t> FieldCounts;
+  llvm::DenseMap<llvm::Type *, bool> PointerCarriers;
+
+  bool Solving = false;
+  bool Changed = false;
+};
+
+} // namespace psr
+
+uint32_t LLVMAndersenAliasInfo::Solver::makeNode() {
+  auto Node = Result.makeNode();
+  Succs.emplace_back();
+  Complex.emplace_back();
+  PrevPts.emplace_back();
+  PrevComplexPts.emplace_back();
+  return Node;
+}
+
+uint32_t LLVMAndersenAliasInfo::Solver::makeObject(const llvm::Value *Site,
+                                                   llvm::Type *Ty) {
+  auto NumFields = Ty ? numFields(Ty) : 1;
+  if (NumFields > MaxObjectFields) {
+    NumFields = 1;
+  }
+  auto First = Result.makeObject(Site, NumFields);
+  for (uint32_t Idx = 0; Idx != NumFields; ++Idx) {
+    Succs.emplace_back();
+    Complex.emplace_back();
+    PrevPts.emplace_back();
+    PrevComplexPts.emplace_back();
+  }
+  return First;
+}
+
+uint32_t LLVMAndersenAliasInfo::Solver::numFields(llvm::Type *Ty) {
+  if (auto It = FieldCounts.find(Ty); It != FieldCounts.end()) {
+    return It->second;
+  }
+
+  uint64_t Ret = 1;
+  if (auto *STy = llvm::dyn_cast<llvm::StructType>(Ty)) {
+    if (STy->getNumElements() != 0) {
+      Ret = 0;
+      for (auto *ElemTy : STy->elements()) {
+        Ret += numFields(ElemTy);
+      }
+    }
+  } else if (auto *ATy = llvm::dyn_cast<llvm::ArrayType>(Ty)) {
+    Ret = numFields(ATy->getElementType());
+  } else if (auto *VTy = llvm::dyn_cast<llvm::VectorType>(Ty)) {
+    Ret = numFields(VTy->getElementType());
+  }
+
+  // Saturate, such that the offsets cannot overflow
+  auto Count = uint32_t(std::min<uint64_t>(Ret, MaxObjectFields + 1));
+  FieldCounts[Ty] = Count;
+  return Count;
+}
+
+bool LLVMAndersenAliasInfo::Solver::carriesPointers(llvm::Type *Ty) {
+  if (Ty->isPointerTy()) {
+    return true;
+  }
+  if (!Ty->isAggregateType() && !Ty->isVectorTy()) {
+    return false;
+  }
+  if (auto It = PointerCarriers.find(Ty); It != PointerCarriers.end()) {
+    return It->second;
+  }
+
+  bool Ret = false;
+  if (auto *STy = llvm::dyn_cast<llvm::StructType>(Ty)) {
+    Ret = llvm::any_of(STy->elements(),
+                       [this](llvm::Type *ElemTy) {
+                         return carriesPointers(ElemTy);
+                       });
+  } else if (auto *ATy = llvm::dyn_cast<llvm::ArrayType>(Ty)) {
+    Ret = carriesPointers(ATy->getElementType());
+  } else if (auto *VTy = llvm::dyn_cast<llvm::VectorType>(Ty)) {
+    Ret = carriesPointers(VTy->getElementType());
+  }
+  PointerCarriers[Ty] = Ret;
+  return Ret;
+}
+
+std::optional<uint32_t>
+LLVMAndersenAliasInfo::Solver::getFieldOffset(const llvm::GEPOperator &GEP) {
+  uint32_t Offset = 0;
+  for (auto GTI = llvm::gep_type_begin(GEP), End = llvm::gep_type_end(GEP);
+       GTI != End; ++GTI) {
+    const auto *Idx = GTI.getOperand();
+    if (auto *STy = GTI.getStructTypeOrNull()) {
+      auto FieldIdx = llvm::cast<llvm::ConstantInt>(Idx)->getZExtValue();
+      for (unsigned Field = 0; Field != FieldIdx; ++Field) {
+        Offset += numFields(STy->getElementType(Field));
+      }
+      Offset = std::min(Offset, MaxObjectFields + 1);
+      continue;
+    }
+
+    if (GTI == llvm::gep_type_begin(GEP)) {
+      // Pointer arithmetic stays within the same (collapsed) array, unless it
+      // is computed in bytes
+      const auto *CIdx = llvm::dyn_cast<llvm::ConstantInt>(Idx);
+      if (GEP.getSourceElementType()->isIntegerTy(8) &&
+          (!CIdx || !CIdx->isZero())) {
+        return std::nullopt;
+      }
+    }
+    // Array elements are collapsed
+  }
+  return Offset;
+}
+
+std::optional<uint32_t>
+LLVMAndersenAliasInfo::Solver::getNode(const llvm::Value *V) {
+  if (!carriesPointers(V->getType()) || llvm::isa<llvm::ConstantData>(V) ||
+      llvm::isa<llvm::BlockAddress>(V)) {
+    return std::nullopt;
+  }
+  if (auto It = Result.ValueNodes.find(V); It != Result.ValueNodes.end()) {
+    return It->second;
+  }
+
+  auto Node = makeNode();
+  Result.ValueNodes[V] = Node;
+  // Nodes that are added while solving may start with a non-empty points-to
+  // set or new constraints
+  Changed |= Solving;
+
+  if (const auto *GO = llvm::dyn_cast<llvm::GlobalObject>(V)) {
+    auto ObjIdx = Result.SiteObjects.find(GO);
+    auto Obj = ObjIdx != Result.SiteObjects.end()
+                   ? Result.Objects[ObjIdx->second].FirstNode
+                   : makeObject(GO, nullptr);
+    Result.PointsTo[Node].set(Obj);
+  } else if (const auto *GA = llvm::dyn_cast<llvm::GlobalAlias>(V)) {
+    if (auto Aliasee = getNode(GA->getAliasee())) {
+      addCopy(*Aliasee, Node);
+    }
+  } else if (const auto *CE = llvm::dyn_cast<llvm::ConstantExpr>(V)) {
+    switch (CE->getOpcode()) {
+    case llvm::Instruction::GetElementPtr:
+      addGEP(Node, *llvm::cast<llvm::GEPOperator>(CE));
+      break;
+    case llvm::Instruction::BitCast:
+    case llvm::Instruction::AddrSpaceCast:
+      if (auto Op = getNode(CE->getOperand(0))) {
+        addCopy(*Op, Node);
+      }
+      break;
+    case llvm::Instruction::Select:
+      for (const auto &Op : llvm::drop_begin(CE->operands())) {
+        if (auto OpNode = getNode(Op)) {
+          addCopy(*OpNode, Node);
+        }
+      }
+      break;
+    case llvm::Instruction::IntToPtr:
+      escapeIntOperands(CE->getOperand(0));
+      addCopy(Unknown, Node);
+      break;
+    default:
+      // Conservatively, the pointer may point anywhere
+      addCopy(Unknown, Node);
+      break;
+    }
+  } else if (const auto *CA = llvm::dyn_cast<llvm::ConstantAggregate>(V)) {
+    // Aggregates that are not stored in memory are field-insensitive
+    for (const auto &Op : CA->operands()) {
+      if (auto OpNode = getNode(Op)) {
+        addCopy(*OpNode, Node);
+      }
+    }
+  }
+
+  return Node;
+}
+
+auto LLVMAndersenAliasInfo::Solver::getFunctionNodes(const llvm::Function &F)
+    -> FunctionNodes & {
+  auto [It, Inserted] = FunNodes.try_emplace(&F);
+  if (Inserted) {
+    std::optional<uint32_t> Ret;
+    std::optional<uint32_t> VarArgs;
+    if (carriesPointers(F.getReturnType())) {
+      Ret = makeNode();
+    }
+    if (F.isVarArg()) {
+      VarArgs = makeNode();
+    }
+    // makeNode() does not touch FunNodes, so It is still valid
+    It->second = {Ret, VarArgs};
+  }
+  return It->second;
+}
+
+uint32_t LLVMAndersenAliasInfo::Solver::findRep(uint32_t Node) {
+  auto &Reps = Result.Reps;
+  auto Rep = Node;
+  while (Reps[Rep] != Rep) {
+    Rep = Reps[Rep];
+  }
+  while (Reps[Node] != Rep) {
+    Node = std::exchange(Reps[Node], Rep);
+  }
+  return Rep;
+}
+
+void LLVMAndersenAliasInfo::Solver::addCopy(uint32_t From, uint32_t To) {
+  if (!Solving) {
+    if (From != To) {
+      Succs[From].set(To);
+    }
+    return;
+  }
+
+  From = findRep(From);
+  To = findRep(To);
+  if (From == To || !Succs[From].test_and_set(To)) {
+    return;
+  }
+  // The new edge has not seen the points-to set of From, yet
+  if (Result.PointsTo[To] |= Result.PointsTo[From]) {
+    Changed = true;
+  }
+}
+
+void LLVMAndersenAliasInfo::Solver::addComplex(uint32_t Node, Constraint C) {
+  if (!Solving) {
+    Complex[Node].push_back(C);
+    return;
+  }
+
+  // The new constraint has not seen the points-to set of Node, yet
+  Node = findRep(Node);
+  Complex[Node].push_back(C);
+  auto Pts = Result.PointsTo[Node];
+  apply(C, Pts);
+}
+
+void LLVMAndersenAliasInfo::Solver::addGEP(uint32_t Dst,
+                                           const llvm::GEPOperator &GEP) {
+  auto Base = getNode(GEP.getPointerOperand());
+  if (!Base) {
+    return;
+  }
+
+  auto Offset = getFieldOffset(GEP);
+  if (Offset == 0) {
+    addCopy(*Base, Dst);
+  } else {
+    addComplex(*Base,
+               {ConstraintKind::Offset, Dst, Offset.value_or(AllFields)});
+  }
+}
+
+void LLVMAndersenAliasInfo::Solver::addMemCopy(const llvm::Value *Dst,
+                                               const llvm::Value *Src) {
+  auto DstNode = getNode(Dst);
+  auto SrcNode = getNode(Src);
+  if (!DstNode || !SrcNode) {
+    return;
+  }
+
+  // The copied memory is treated field-insensitively
+  auto Tmp = makeNode();
+  addComplex(*SrcNode, {ConstraintKind::Load, Tmp, AllFields});
+  addComplex(*DstNode, {ConstraintKind::Store, Tmp, AllFields});
+}
+
+void LLVMAndersenAliasInfo::Solver::addInitializer(
+    const AbstractObject &Obj, uint32_t Offset, const llvm::Constant *Init) {
+  if (llvm::isa<llvm::ConstantData>(Init)) {
+    // No pointers in here
+    return;
+  }
+
+  if (const auto *CS = llvm::dyn_cast<llvm::ConstantStruct>(Init)) {
+    auto *STy = CS->getType();
+    for (unsigned Idx = 0, End = CS->getNumOperands(); Idx != End; ++Idx) {
+      addInitializer(Obj, Offset, CS->getOperand(Idx));
+      Offset += numFields(STy->getElementType(Idx));
+    }
+    return;
+  }
+
+  if (llvm::isa<llvm::ConstantArray>(Init) ||
+      llvm::isa<llvm::ConstantVector>(Init)) {
+    for (const auto &Elem : Init->operands()) {
+      addInitializer(Obj, Offset, llvm::cast<llvm::Constant>(Elem));
+    }
+    return;
+  }
+
+  if (auto Node = getNode(Init)) {
+    forEachField(Obj, Obj.FirstNode, Offset,
+                 [this, Node](uint32_t Field) { addCopy(*Node, Field); });
+  }
+}
+
+void LLVMAndersenAliasInfo::Solver::escapeIntOperands(const llvm::Value *Int) {
+  const auto *CE = llvm::dyn_cast<llvm::ConstantExpr>(Int);
+  if (!CE) {
+    return;
+  }
+  if (CE->getOpcode() == llvm::Instruction::PtrToInt) {
+    if (auto Ptr = getNode(CE->getOperand(0))) {
+      addCopy(*Ptr, Unknown);
+    }
+    return;
+  }
+  for (const auto &Op : CE->operands()) {
+    escapeIntOperands(Op);
+  }
+}
+
+/// The type of the object that the heap-allocating call CB creates, if it is
+/// unambiguously casted to it
+static llvm::Type *getHeapObjectType(const llvm::CallBase &CB) {
+  llvm::Type *Ret = nullptr;
+  for (const auto *User : CB.users()) {
+    const auto *Cast = llvm::dyn_cast<llvm::BitCastInst>(User);
+    if (!Cast || Cast->getType()->isOpaquePointerTy()) {
+      continue;
+    }
+    auto *ElemTy = Cast->getType()->getNonOpaquePointerElementType();
+    if (Ret && Ret != ElemTy) {
+      return nullptr;
+    }
+    Ret = ElemTy;
+  }
+  return Ret && Ret->isSized() ? Ret : nullptr;
+}
+
+void LLVMAndersenAliasInfo::Solver::bindCall(const llvm::CallBase &CB,
+                                             const llvm::Function &Callee) {
+  if (Callee.isIntrinsic()) {
+    switch (Callee.getIntrinsicID()) {
+    case llvm::Intrinsic::memcpy:
+    case llvm::Intrinsic::memcpy_inline:
+    case llvm::Intrinsic::memmove:
+      addMemCopy(CB.getArgOperand(0), CB.getArgOperand(1));
+      break;
+    default:
+      break;
+    }
+    return;
+  }
+
+  if (Callee.isDeclaration()) {
+    bool IsHeapAllocating = isHeapAllocatingFunction(&Callee);
+    if (!IsHeapAllocating) {
+      // The callee may store unknown pointers into the memory that is passed
+      // to it, e.g., into out-parameters, and may keep its address
+      for (const auto &Arg : CB.args()) {
+        if (auto ArgNode = getNode(Arg)) {
+          addCopy(*ArgNode, Unknown);
+        }
+      }
+    }
+
+    auto Ret = getNode(&CB);
+    if (!Ret || !CB.getType()->isPointerTy()) {
+      return;
+    }
+    if (!IsHeapAllocating) {
+      // The callee may return a pointer into unknown memory or into one of
+      // its arguments
+      addCopy(Unknown, *Ret);
+    }
+
+    uint32_t Obj = 0;
+    if (auto It = Result.SiteObjects.find(&CB);
+        It != Result.SiteObjects.end()) {
+      Obj = Result.Objects[It->second].FirstNode;
+    } else {
+      Obj = makeObject(&CB, IsHeapAllocating ? getHeapObjectType(CB) : nullptr);
+    }
+    if (Result.PointsTo[findRep(*Ret)].test_and_set(Obj)) {
+      Changed = true;
+    }
+
+    if (Callee.getName() == "realloc" && CB.arg_size() != 0) {
+      addMemCopy(&CB, CB.getArgOperand(0));
+    }
+    return;
+  }
+
+  auto &Nodes = getFunctionNodes(Callee);
+  auto VarArgs = Nodes.VarArgs;
+  auto Ret = Nodes.Ret;
+  for (unsigned Idx = 0, End = CB.arg_size(); Idx != End; ++Idx) {
+    auto Arg = getNode(CB.getArgOperand(Idx));
+    if (!Arg) {
+      continue;
+    }
+    if (Idx < Callee.arg_size()) {
+      if (auto Param = getNode(Callee.getArg(Idx))) {
+        addCopy(*Arg, *Param);
+      }
+    } else if (VarArgs) {
+      addCopy(*Arg, *VarArgs);
+    }
+  }
+
+  if (Ret && carriesPointers(CB.getType())) {
+    if (auto RetVal = getNode(&CB)) {
+      addCopy(*Ret, *RetVal);
+    }
+  }
+}
+
+void LLVMAndersenAliasInfo::Solver::visitCall(const llvm::CallBase &CB) {
+  if (CB.isInlineAsm()) {
+    return;
+  }
+
+  const auto *Callee = llvm::dyn_cast<llvm::Function>(
+      CB.getCalledOperand()->stripPointerCastsAndAliases());
+  if (Callee) {
+    bindCall(CB, *Callee);
+    return;
+  }
+
+  if (auto FunPtr = getNode(CB.getCalledOperand())) {
+    auto CSIdx = uint32_t(CallSites.size());
+    CallSites.push_back(&CB);
+    addComplex(*FunPtr, {ConstraintKind::Call, CSIdx, 0});
+  }
+}
+
+void LLVMAndersenAliasInfo::Solver::visitInstruction(
+    const llvm::Instruction &I) {
+  auto CopyOperands = [this, &I](auto Operands) {
+    auto Dst = getNode(&I);
+    if (!Dst) {
+      return;
+    }
+    for (const auto &Op : Operands) {
+      if (auto Src = getNode(Op)) {
+        addCopy(*Src, *Dst);
+      }
+    }
+  };
+
+  if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
+    auto Obj = makeObject(Alloca, Alloca->getAllocatedType());
+    Result.PointsTo[*getNode(Alloca)].set(Obj);
+  } else if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(&I)) {
+    auto Dst = getNode(Load);
+    auto Ptr = getNode(Load->getPointerOperand());
+    if (Dst && Ptr) {
+      // First-class aggregates span multiple fields
+      auto Offset = Load->getType()->isPointerTy() ? 0 : AllFields;
+      addComplex(*Ptr, {ConstraintKind::Load, *Dst, Offset});
+    }
+  } else if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(&I)) {
+    const auto *Val = Store->getValueOperand();
+    auto Src = getNode(Val);
+    auto Ptr = getNode(Store->getPointerOperand());
+    if (Src && Ptr) {
+      auto Offset = Val->getType()->isPointerTy() ? 0 : AllFields;
+      addComplex(*Ptr, {ConstraintKind::Store, *Src, Offset});
+    }
+  } else if (const auto *GEP = llvm::dyn_cast<llvm::GetElementPtrInst>(&I)) {
+    if (auto Dst = getNode(GEP)) {
+      addGEP(*Dst, *llvm::cast<llvm::GEPOperator>(GEP));
+    }
+  } else if (llvm::isa<llvm::BitCastInst>(I) ||
+             llvm::isa<llvm::AddrSpaceCastInst>(I) ||
+             llvm::isa<llvm::FreezeInst>(I)) {
+    CopyOperands(llvm::makeArrayRef(I.op_begin(), 1));
+  } else if (const auto *Phi = llvm::dyn_cast<llvm::PHINode>(&I)) {
+    CopyOperands(Phi->incoming_values());
+  } else if (const auto *Select = llvm::dyn_cast<llvm::SelectInst>(&I)) {
+    CopyOperands(llvm::drop_begin(Select->operands()));
+  } else if (llvm::isa<llvm::ExtractValueInst>(I) ||
+             llvm::isa<llvm::ExtractElementInst>(I)) {
+    CopyOperands(llvm::makeArrayRef(I.op_begin(), 1));
+  } else if (llvm::isa<llvm::InsertValueInst>(I) ||
+             llvm::isa<llvm::InsertElementInst>(I)) {
+    CopyOperands(llvm::makeArrayRef(I.op_begin(), 2));
+  } else if (llvm::isa<llvm::ShuffleVectorInst>(I)) {
+    CopyOperands(llvm::makeArrayRef(I.op_begin(), 2));
+  } else if (const auto *Ret = llvm::dyn_cast<llvm::ReturnInst>(&I)) {
+    const auto *RetVal = Ret->getReturnValue();
+    auto FunRet = getFunctionNodes(*Ret->getFunction()).Ret;
+    if (RetVal && FunRet) {
+      if (auto Src = getNode(RetVal)) {
+        addCopy(*Src, *FunRet);
+      }
+    }
+  } else if (const auto *CB = llvm::dyn_cast<llvm::CallBase>(&I)) {
+    visitCall(*CB);
+  } else if (const auto *CmpXchg =
+                 llvm::dyn_cast<llvm::AtomicCmpXchgInst>(&I)) {
+    auto Ptr = getNode(CmpXchg->getPointerOperand());
+    auto Src = getNode(CmpXchg->getNewValOperand());
+    if (Ptr && Src) {
+      addComplex(*Ptr, {ConstraintKind::Store, *Src, 0});
+    }
+    if (auto Dst = getNode(CmpXchg); Ptr && Dst) {
+      addComplex(*Ptr, {ConstraintKind::Load, *Dst, 0});
+    }
+  } else if (const auto *RMW = llvm::dyn_cast<llvm::AtomicRMWInst>(&I)) {
+    auto Ptr = getNode(RMW->getPointerOperand());
+    auto Src = getNode(RMW->getValOperand());
+    if (Ptr && Src) {
+      addComplex(*Ptr, {ConstraintKind::Store, *Src, 0});
+    }
+    if (auto Dst = getNode(RMW); Ptr && Dst) {
+      addComplex(*Ptr, {ConstraintKind::Load, *Dst, 0});
+    }
+  } else if (const auto *VAArg = llvm::dyn_cast<llvm::VAArgInst>(&I)) {
+    auto Dst = getNode(VAArg);
+    auto VarArgs = getFunctionNodes(*VAArg->getFunction()).VarArgs;
+    if (Dst && VarArgs) {
+      addCopy(*VarArgs, *Dst);
+    }
+  } else if (const auto *PtrToInt = llvm::dyn_cast<llvm::PtrToIntInst>(&I)) {
+    // The integer may be turned into a pointer again anywhere
+    if (auto Src = getNode(PtrToInt->getPointerOperand())) {
+      addCopy(*Src, Unknown);
+    }
+  } else if (const auto *IntToPtr = llvm::dyn_cast<llvm::IntToPtrInst>(&I)) {
+    escapeIntOperands(IntToPtr->getOperand(0));
+    addCopy(Unknown, *getNode(IntToPtr));
+  } else if (auto Dst = getNode(&I)) {
+    // Conservatively, pointers from other instructions, e.g., landingpads, may
+    // point anywhere
+    addCopy(Unknown, *Dst);
+  }
+}
+
+void LLVMAndersenAliasInfo::Solver::generateConstraints() {
+  // Unknown memory may contain pointers to all escaped objects, including
+  // itself, and its content escapes as well. So, everything that is reachable
+  // from an escaped object escapes, and unknown pointers may be stored in it.
+  Unknown = makeObject(nullptr, nullptr);
+  Result.PointsTo[Unknown].set(Unknown);
+  addComplex(Unknown, {ConstraintKind::Load, Unknown, AllFields});
+  addComplex(Unknown, {ConstraintKind::Store, Unknown, AllFields});
+
+  // The abstract objects of the globals must exist before their first use
+  for (const auto &G : M.globals()) {
+    makeObject(&G, G.getValueType());
+  }
+  for (const auto &F : M) {
+    makeObject(&F, nullptr);
+  }
+
+  for (const auto &G : M.globals()) {
+    (void)getNode(&G);
+    if (G.hasInitializer()) {
+      const auto &Obj = Result.Objects[Result.SiteObjects.lookup(&G)];
+      addInitializer(Obj, 0, G.getInitializer());
+    }
+  }
+
+  for (const auto &F : M) {
+    (void)getNode(&F);
+    if (F.isDeclaration()) {
+      continue;
+    }
+    for (const auto &Arg : F.args()) {
+      (void)getNode(&Arg);
+    }
+    for (const auto &I : llvm::instructions(F)) {
+      visitInstruction(I);
+    }
+  }
+}
+
+void LLVMAndersenAliasInfo::Solver::unite(uint32_t Rep, uint32_t Node) {
+  assert(Rep != Node);
+  Result.Reps[Node] = Rep;
+  Result.PointsTo[Rep] |= Result.PointsTo[Node];
+  Result.PointsTo[Node].clear();
+
+  // Conservatively, only what both have seen has been propagated
+  PrevPts[Rep] &= PrevPts[Node];
+  PrevPts[Node].clear();
+  PrevComplexPts[Rep] &= PrevComplexPts[Node];
+  PrevComplexPts[Node].clear();
+
+  Succs[Rep] |= Succs[Node];
+  Succs[Node].clear();
+  Complex[Rep].append(Complex[Node].begin(), Complex[Node].end());
+  Complex[Node].clear();
+}
+
+std::vector<uint32_t> LLVMAndersenAliasInfo::Solver::collapseCycles() {
+  // Iterative variant of Tarjan's algorithm
+  auto NumNodes = uint32_t(Result.Reps.size());
+  std::vector<uint32_t> Index(NumNodes, 0);
+  std::vector<uint32_t> LowLink(NumNodes, 0);
+  std::vector<bool> OnStack(NumNodes, false);
+  std::vector<uint32_t> SCCStack;
+  std::vector<uint32_t> Order;
+  Order.reserve(NumNodes);
+
+  struct Frame {
+    uint32_t Node;
+    llvm::SparseBitVector<>::iterator Succ;
+  };
+  std::vector<Frame> CallStack;
+  uint32_t NextIndex = 1;
+
+  auto Visit = [&](uint32_t Node) {
+    Index[Node] = LowLink[Node] = NextIndex++;
+    SCCStack.push_back(Node);
+    OnStack[Node] = true;
+    CallStack.push_back({Node, Succs[Node].begin()});
+  };
+
+  for (uint32_t Start = 0; Start != NumNodes; ++Start) {
+    if (Result.Reps[Start] != Start || Index[Start] != 0) {
+      continue;
+    }
+
+    Visit(Start);
+    while (!CallStack.empty()) {
+      auto &Top = CallStack.back();
+      auto Node = Top.Node;
+      if (Top.Succ != Succs[Node].end()) {
+        auto Succ = findRep(*Top.Succ++);
+        if (Succ == Node) {
+          continue;
+        }
+        if (Index[Succ] == 0) {
+          // Invalidates Top
+          Visit(Succ);
+        } else if (OnStack[Succ]) {
+          LowLink[Node] = std::min(LowLink[Node], Index[Succ]);
+        }
+        continue;
+      }
+
+      CallStack.pop_back();
+      if (!CallStack.empty()) {
+        auto Parent = CallStack.back().Node;
+        LowLink[Parent] = std::min(LowLink[Parent], LowLink[Node]);
+      }
+      if (LowLink[Node] != Index[Node]) {
+        continue;
+      }
+
+      // Node is the root of an SCC; All frames of its members are finished
+      uint32_t Member = 0;
+      do {
+        Member = SCCStack.back();
+        SCCStack.pop_back();
+        OnStack[Member] = false;
+        if (Member != Node) {
+          unite(Node, Member);
+        }
+      } while (Member != Node);
+      Succs[Node].reset(Node);
+      Order.push_back(Node);
+    }
+  }
+
+  // Tarjan's algorithm finds the SCCs in reverse topological order
+  std::reverse(Order.begin(), Order.end());
+  return Order;
+}
+
+void LLVMAndersenAliasInfo::Solver::propagate(
+    llvm::ArrayRef<uint32_t> TopoOrder) {
+  llvm::SparseBitVector<> Delta;
+  for (auto Node : TopoOrder) {
+    const auto &Pts = Result.PointsTo[Node];
+    Delta.intersectWithComplement(Pts, PrevPts[Node]);
+    if (Delta.empty()) {
+      continue;
+    }
+    PrevPts[Node] = Pts;
+
+    for (auto Succ : Succs[Node]) {
+      auto SuccRep = findRep(Succ);
+      if (SuccRep != Node) {
+        Result.PointsTo[SuccRep] |= Delta;
+      }
+    }
+  }
+}
+
+void LLVMAndersenAliasInfo::Solver::apply(const Constraint &C,
+                                          const llvm::SparseBitVector<> &Pts) {
+  switch (C.Kind) {
+  case ConstraintKind::Load:
+    for (auto Obj : Pts) {
+      forEachField(Result.objectOf(Obj), Obj, C.Offset,
+                   [this, &C](uint32_t Field) { addCopy(Field, C.Other); });
+    }
+    break;
+  case ConstraintKind::Store:
+    for (auto Obj : Pts) {
+      forEachField(Result.objectOf(Obj), Obj, C.Offset,
+                   [this, &C](uint32_t Field) { addCopy(C.Other, Field); });
+    }
+    break;
+  case ConstraintKind::Offset: {
+    auto Dst = findRep(C.Other);
+    for (auto Obj : Pts) {
+      forEachField(Result.objectOf(Obj), Obj, C.Offset,
+                   [this, Dst](uint32_t Field) {
+                     if (Result.PointsTo[Dst].test_and_set(Field)) {
+                       Changed = true;
+                     }
+                   });
+    }
+    break;
+  }
+  case ConstraintKind::Call: {
+    const auto *CS = CallSites[C.Other];
+    for (auto Obj : Pts) {
+      const auto &Target = Result.objectOf(Obj);
+      const auto *Callee = llvm::dyn_cast_or_null<llvm::Function>(Target.Site);
+      if (Callee && Obj == Target.FirstNode &&
+          BoundCalls.insert({CS, Callee}).second) {
+        bindCall(*CS, *Callee);
+      }
+    }
+    break;
+  }
+  }
+}
+
+void LLVMAndersenAliasInfo::Solver::processComplexConstraints() {
+  llvm::SparseBitVector<> Delta;
+  for (uint32_t Node = 0; Node != Complex.size(); ++Node) {
+    if (Complex[Node].empty() || Result.Reps[Node] != Node) {
+      continue;
+    }
+    Delta.intersectWithComplement(Result.PointsTo[Node], PrevComplexPts[Node]);
+    if (Delta.empty()) {
+      continue;
+    }
+    PrevComplexPts[Node] |= Delta;
+
+    // Applying a constraint may add nodes and constraints, so do not hold
+    // references into Complex
+    for (size_t Idx = 0; Idx != Complex[Node].size(); ++Idx) {
+      auto C = Complex[Node][Idx];
+      apply(C, Delta);
+    }
+  }
+}
+
+void LLVMAndersenAliasInfo::Solver::solve() {
+  Solving = true;
+  size_t NumRounds = 0;
+  do {
+    ++NumRounds;
+    Changed = false;
+    propagate(collapseCycles());
+    processComplexConstraints();
+  } while (Changed);
+
+  PHASAR_LOG_LEVEL_CAT(INFO, "LLVMAndersenAliasInfo",
+                       "Solved " << Result.Reps.size() << " nodes with "
+                                 << Result.Objects.size()
+                                 << " abstract objects in " << NumRounds
+                                 << " rounds");
+
+  // Only the points-to sets of the values are needed from now on
+  llvm::BitVector IsValueRep(Result.Reps.size());
+  for (auto [V, Node] : Result.ValueNodes) {
+    IsValueRep.set(findRep(Node));
+  }
+  for (uint32_t Node = 0, End = Result.Reps.size(); Node != End; ++Node) {
+    (void)findRep(Node);
+    if (!IsValueRep.test(Node)) {
+      Result.PointsTo[Node].clear();
+    }
+  }
+}
+
+LLVMAndersenAliasInfo::LLVMAndersenAliasInfo(const LLVMProjectIRDB &IRDB)
+    : IRDB(&IRDB) {
+  PHASAR_LOG_LEVEL_CAT(
+      INFO, "LLVMAndersenAliasInfo",
+      "Start constructing LLVMAndersenAliasInfo "
+          << std::chrono::steady_clock::now().time_since_epoch().count());
+
+  Solver S(*this, *IRDB.getModule());
+  S.generateConstraints();
+  S.solve();
+
+  PHASAR_LOG_LEVEL_CAT(
+      INFO, "LLVMAndersenAliasInfo",
+      "LLVMAndersenAliasInfo completed "
+          << std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+LLVMAndersenAliasInfo::~LLVMAndersenAliasInfo() = default;
+
+uint32_t LLVMAndersenAliasInfo::makeNode() {
+  auto Node = uint32_t(Reps.size());
+  Reps.push_back(Node);
+  PointsTo.emplace_back();
+  NodeObjects.push_back(NoObject);
+  return Node;
+}
+
+uint32_t LLVMAndersenAliasInfo::makeObject(const llvm::Value *Site,
+                                           uint32_t NumFields) {
+  assert(NumFields != 0);
+  auto ObjIdx = uint32_t(Objects.size());
+  auto First = uint32_t(Reps.size());
+  for (uint32_t Idx = 0; Idx != NumFields; ++Idx) {
+    NodeObjects[makeNode()] = ObjIdx;
+  }
+  Objects.push_back({Site, First, NumFields});
+  SiteObjects[Site] = ObjIdx;
+  return First;
+}
+
+uint32_t LLVMAndersenAliasInfo::findRep(uint32_t Node) const noexcept {
+  while (Reps[Node] != Node) {
+    Node = Reps[Node];
+  }
+  return Node;
+}
+
+const llvm::SparseBitVector<> *
+LLVMAndersenAliasInfo::getPointsToBits(const llvm::Value *V) const {
+  auto It = ValueNodes.find(V);
+  if (It == ValueNodes.end()) {
+    return nullptr;
+  }
+  return &PointsTo[findRep(It->second)];
+}
+
+void LLVMAndersenAliasInfo::buildReversePointsTo() {
+  if (HasReversePointsTo) {
+    return;
+  }
+  HasReversePointsTo = true;
+
+  for (auto [V, Node] : ValueNodes) {
+    if (!isInterestingPointer(V)) {
+      continue;
+    }
+    auto Rep = findRep(Node);
+    auto &Members = RepMembers[Rep];
+    if (Members.empty()) {
+      for (auto Obj : PointsTo[Rep]) {
+        ReversePointsTo[Obj].push_back(Rep);
+      }
+    }
+    Members.push_back(V);
+  }
+}
+
+void LLVMAndersenAliasInfo::invalidateCaches() {
+  ReversePointsTo.clear();
+  RepMembers.clear();
+  HasReversePointsTo = false;
+  AliasSets.clear();
+}
+
+AliasResult
+LLVMAndersenAliasInfo::alias(const llvm::Value *V1, const llvm::Value *V2,
+                             [[maybe_unused]] const llvm::Instruction *I) {
+  if (!isInterestingPointer(V1) || !isInterestingPointer(V2)) {
+    return AliasResult::NoAlias;
+  }
+  if (V1 == V2) {
+    return AliasResult::MustAlias;
+  }
+
+  const auto *Pts1 = getPointsToBits(V1);
+  const auto *Pts2 = getPointsToBits(V2);
+  if (!Pts1 || !Pts2) {
+    return AliasResult::MayAlias;
+  }
+  return Pts1->intersects(*Pts2) ? AliasResult::MayAlias
+                                 : AliasResult::NoAlias;
+}
+
+auto LLVMAndersenAliasInfo::getAliasSet(
+    const llvm::Value *V, [[maybe_unused]] const llvm::Instruction *I)
+    -> AliasSetPtrTy {
+  if (!isInterestingPointer(V)) {
+    static AliasSetTy EmptySet{};
+    static AliasSetTy *EmptySetPtr = &EmptySet;
+    return &EmptySetPtr;
+  }
+
+  auto It = ValueNodes.find(V);
+  if (It == ValueNodes.end()) {
+    auto Set = Owner.acquire();
+    Set->insert(V);
+    return Set;
+  }
+
+  auto Rep = findRep(It->second);
+  auto &Set = AliasSets[Rep];
+  if (Set) {
+    return Set;
+  }
+
+  buildReversePointsTo();
+  Set = Owner.acquire();
+  Set->insert(V);
+  Set->insert(RepMembers[Rep].begin(), RepMembers[Rep].end());
+
+  llvm::SmallDenseSet<uint32_t> VisitedReps = {Rep};
+  for (auto Obj : PointsTo[Rep]) {
+    for (auto Pointer : ReversePointsTo[Obj]) {
+      if (VisitedReps.insert(Pointer).second) {
+        const auto &Members = RepMembers[Pointer];
+        Set->insert(Members.begin(), Members.end());
+      }
+    }
+  }
+  return Set;
+}
+
+/// Allocas and heap-allocating calls are allocation sites
+static bool isAllocationSite(const llvm::Value *Site,
+                             const llvm::Function *VFun, bool IntraProcOnly) {
+  const llvm::Function *SiteFun = nullptr;
+  if (!Site) {
+    // Unknown memory
+    return false;
+  }
+  if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(Site)) {
+    SiteFun = Alloca->getFunction();
+  } else if (const auto *CS = llvm::dyn_cast<llvm::CallBase>(Site)) {
+    const auto *Callee = CS->getCalledFunction();
+    if (!Callee || !isHeapAllocatingFunction(Callee)) {
+      return false;
+    }
+    SiteFun = CS->getFunction();
+  } else {
+    return false;
+  }
+  return !IntraProcOnly || SiteFun == VFun;
+}
+
+auto LLVMAndersenAliasInfo::getReachableAllocationSites(
+    const llvm::Value *V, bool IntraProcOnly,
+    [[maybe_unused]] const llvm::Instruction *I) -> AllocationSiteSetPtrTy {
+  auto AllocSites = std::make_unique<AliasSetTy>();
+  if (!isInterestingPointer(V)) {
+    return AllocSites;
+  }
+  const auto *Pts = getPointsToBits(V);
+  if (!Pts) {
+    return AllocSites;
+  }
+
+  const auto *VFun = retrieveFunction(V);
+  // Globals may point to the allocation sites of all functions
+  bool Intra = IntraProcOnly && !llvm::isa<llvm::GlobalObject>(V);
+  for (auto Obj : *Pts) {
+    const auto *Site = objectOf(Obj).Site;
+    if (isAllocationSite(Site, VFun, Intra)) {
+      AllocSites->insert(Site);
+    }
+  }
+
+  if (Intra && VFun) {
+    /// Arguments are no allocation sites, but in the inTRAprocedural case, they
+    /// act as such
+    for (const auto &Arg : VFun->args()) {
+      const auto *ArgPts = getPointsToBits(&Arg);
+      if (ArgPts && ArgPts->intersects(*Pts)) {
+        AllocSites->insert(&Arg);
+      }
+    }
+  }
+  return AllocSites;
+}
+
+bool LLVMAndersenAliasInfo::isInReachableAllocationSites(
+    const llvm::Value *V, const llvm::Value *PotentialValue, bool IntraProcOnly,
+    const llvm::Instruction *I) {
+  return getReachableAllocationSites(V, IntraProcOnly, I)
+      ->count(PotentialValue);
+}
+
+void LLVMAndersenAliasInfo::mergeWith(const LLVMAndersenAliasInfo &Other) {
+  assert(IRDB->getModule() == Other.IRDB->getModule());
+
+  for (auto [V, OtherNode] : Other.ValueNodes) {
+    const auto &OtherPts = Other.PointsTo[Other.findRep(OtherNode)];
+    if (OtherPts.empty()) {
+      continue;
+    }
+
+    auto [It, Inserted] = ValueNodes.try_emplace(V);
+    if (Inserted) {
+      It->second = makeNode();
+    }
+    auto Rep = findRep(It->second);
+
+    // The object-nodes of Other do not match ours
+    for (auto OtherObj : OtherPts) {
+      const auto &Obj = Other.objectOf(OtherObj);
+      auto ObjIdx = SiteObjects.find(Obj.Site);
+      uint32_t First = ObjIdx == SiteObjects.end()
+                           ? makeObject(Obj.Site, Obj.NumFields)
+                           : Objects[ObjIdx->second].FirstNode;
+      forEachField(objectOf(First), First, OtherObj - Obj.FirstNode,
+                   [this, Rep](uint32_t Field) { PointsTo[Rep].set(Field); });
+    }
+  }
+
+  invalidateCaches();
+}
+
+void LLVMAndersenAliasInfo::introduceAlias(
+    const llvm::Value *V1, const llvm::Value *V2,
+    [[maybe_unused]] const llvm::Instruction *I,
+    [[maybe_unused]] AliasResult Kind) {
+  if (!isInterestingPointer(V1) || !isInterestingPointer(V2)) {
+    return;
+  }
+
+  auto GetRep = [this](const llvm::Value *V) {
+    auto [It, Inserted] = ValueNodes.try_emplace(V);
+    if (Inserted) {
+      It->second = makeNode();
+    }
+    return findRep(It->second);
+  };
+  auto Rep1 = GetRep(V1);
+  auto Rep2 = GetRep(V2);
+  if (Rep1 == Rep2) {
+    return;
+  }
+
+  Reps[Rep2] = Rep1;
+  PointsTo[Rep1] |= PointsTo[Rep2];
+  PointsTo[Rep2].clear();
+  invalidateCaches();
+}
+
+llvm::SmallVector<const llvm::Value *>
+LLVMAndersenAliasInfo::getPointsToSet(const llvm::Value *V) const {
+  llvm::SmallVector<const llvm::Value *> Ret;
+  const auto *Pts = getPointsToBits(V);
+  if (!Pts) {
+    return Ret;
+  }
+
+  // The fields of an object are adjacent
+  auto PrevObj = NoObject;
+  for (auto Obj : *Pts) {
+    if (NodeObjects[Obj] != PrevObj) {
+      PrevObj = NodeObjects[Obj];
+      Ret.push_back(Objects[PrevObj].Site);
+    }
+  }
+  return Ret;
+}
+
+void LLVMAndersenAliasInfo::forEachPointsToSet(
+    llvm::function_ref<void(const llvm::Value *,
+                            llvm::ArrayRef<const llvm::Value *>)>
+        Handler) const {
+  for (auto [V, Node] : ValueNodes) {
+    if (!isInterestingPointer(V)) {
+      continue;
+    }
+    auto Pts = getPointsToSet(V);
+    if (!Pts.empty()) {
+      Handler(V, Pts);
+    }
+  }
+}
+
+/// Calls Handler with each pointer of M that may be queried, in the order of M
+template <typename HandlerT>
+static void forEachModuleValue(const llvm::Module &M, HandlerT Handler) {
+  for (const auto &G : M.globals()) {
+    Handler(&G);
+  }
+  for (const auto &F : M) {
+    Handler(&F);
+    for (const auto &Arg : F.args()) {
+      Handler(&Arg);
+    }
+    for (const auto &I : llvm::instructions(F)) {
+      Handler(&I);
+    }
+  }
+}
+
+void LLVMAndersenAliasInfo::print(llvm::raw_ostream &OS) const {
+  forEachModuleValue(*IRDB->getModule(), [this, &OS](const llvm::Value *V) {
+    const auto *Pts = getPointsToBits(V);
+    if (!Pts || Pts->empty()) {
+      return;
+    }
+    OS << "V: " << llvmIRToString(V) << '\n';
+    for (auto Obj : *Pts) {
+      const auto &Target = objectOf(Obj);
+      OS << "\tpoints to -> "
+         << (Target.Site ? llvmIRToString(Target.Site) : "<unknown memory>");
+      if (Target.NumFields != 1) {
+        OS << " [field " << (Obj - Target.FirstNode) << ']';
+      }
+      OS << '\n';
+    }
+  });
+}
+
+/// Functions do not have a metadata-id, so use their name instead
+static std::string getSiteId(const llvm::Value *Site) {
+  if (!Site) {
+    return "unknown";
+  }
+  if (const auto *F = llvm::dyn_cast<llvm::Function>(Site)) {
+    return F->getName().str();
+  }
+  return getMetaDataID(Site);
+}
+
+nlohmann::json LLVMAndersenAliasInfo::getAsJson() const {
+  nlohmann::json J;
+  auto &Sets = J["PointsToSets"];
+  Sets = nlohmann::json::object();
+
+  forEachModuleValue(*IRDB->getModule(), [&](const llvm::Value *V) {
+    const auto *Pts = getPointsToBits(V);
+    if (!Pts || Pts->empty()) {
+      return;
+    }
+    auto Id = getMetaDataID(V);
+    if (Id == "-1") {
+      return;
+    }
+
+    auto PtsJson = nlohmann::json::array();
+    for (auto Obj : *Pts) {
+      const auto &Target = objectOf(Obj);
+      PtsJson.push_back({{"Site", getSiteId(Target.Site)},
+                         {"Field", Obj - Target.FirstNode}});
+    }
+    Sets[Id] = std::move(PtsJson);
+  });
+  return J;
+}
+
+void LLVMAndersenAliasInfo::printAsJson(llvm::raw_ostream &OS) const {
+  OS << getAsJson();
+}
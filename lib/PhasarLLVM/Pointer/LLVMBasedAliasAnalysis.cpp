@@ -17,6 +17,7 @@
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/AssumptionCache.h"
 #include "llvm/Analysis/BasicAliasAnalysis.h"
 #include "llvm/Analysis/ScopedNoAliasAA.h"
 #include "llvm/Analysis/TypeBasedAliasAnalysis.h"
@@ -42,6 +43,10 @@ struct LLVMBasedAliasAnalysis::Impl {
   llvm::PassBuilder PB{};
   llvm::FunctionAnalysisManager FAM{};
   llvm::FunctionPassManager FPM{};
+  /// The CFLAndersAA results of all functions share the summaries of their
+  /// callees
+  std::shared_ptr<cfl::CFLAndersAAResult::SummaryCache> CFLAndersSummaries =
+      std::make_shared<cfl::CFLAndersAAResult::SummaryCache>();
 };
 
 static void printResults(llvm::AliasResult AR, bool P, const llvm::Value *V1,
@@ -105,6 +110,30 @@ void LLVMBasedAliasAnalysis::computeAliasInfo(llvm::Function &Fun) {
   AAInfos.insert(std::make_pair(&Fun, &AAR));
 }
 
+llvm::AAResults *
+LLVMBasedAliasAnalysis::getAAResultsForConcurrentQueries(llvm::Function *F) {
+  auto *AAR = getAAResults(F);
+  auto &FAM = PImpl->FAM;
+
+  // The AssumptionCache (used by BasicAA) scans the function on first use
+  (void)FAM.getResult<llvm::AssumptionAnalysis>(*F).assumptions();
+
+  // The CFL analyses build their summaries on the first query
+  switch (PATy) {
+  case AliasAnalysisType::CFLAnders:
+    // The summary of F may be shared already, which is not enough for queries
+    FAM.getResult<cfl::CFLAndersAA>(*F).ensureScanned(*F);
+    break;
+  case AliasAnalysisType::CFLSteens:
+    (void)FAM.getResult<llvm::CFLSteensAA>(*F).getAliasSummary(*F);
+    break;
+  default:
+    break;
+  }
+
+  return AAR;
+}
+
 void LLVMBasedAliasAnalysis::erase(llvm::Function *F) noexcept {
   // after we clear all stuff, we need to set it up for the next function-wise
   // analysis
@@ -115,6 +144,7 @@ void LLVMBasedAliasAnalysis::erase(llvm::Function *F) noexcept {
 void LLVMBasedAliasAnalysis::clear() noexcept {
   AAInfos.clear();
   PImpl->FAM.clear();
+  PImpl->CFLAndersSummaries->clear();
 }
 
 LLVMBasedAliasAnalysis::LLVMBasedAliasAnalysis(LLVMProjectIRDB &IRDB,
@@ -126,7 +156,7 @@ LLVMBasedAliasAnalysis::LLVMBasedAliasAnalysis(LLVMProjectIRDB &IRDB,
     llvm::AAManager AA;
     switch (PATy) {
     case AliasAnalysisType::CFLAnders:
-      AA.registerFunctionAnalysis<llvm::CFLAndersAA>();
+      AA.registerFunctionAnalysis<cfl::CFLAndersAA>();
       break;
     case AliasAnalysisType::CFLSteens:
       AA.registerFunctionAnalysis<llvm::CFLSteensAA>();
@@ -145,6 +175,11 @@ LLVMBasedAliasAnalysis::LLVMBasedAliasAnalysis(LLVMProjectIRDB &IRDB,
     AA.registerFunctionAnalysis<llvm::BasicAA>();
     return AA;
   });
+  // Phasar's CFLAndersAA is not known to the PassBuilder, so register it
+  // ourselves, sharing the summaries between all functions
+  PImpl->FAM.registerPass([Summaries = PImpl->CFLAndersSummaries] {
+    return cfl::CFLAndersAA(Summaries);
+  });
   PImpl->PB.registerFunctionAnalyses(PImpl->FAM);
 
   if (!UseLazyEvaluation) {
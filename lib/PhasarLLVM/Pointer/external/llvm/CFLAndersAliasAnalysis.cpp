@@ -52,8 +52,11 @@
 // run on. Realistically, this likely isn't a problem until we allow
 // FunctionPasses to run concurrently.
 
-#include "llvm/Analysis/CFLAndersAliasAnalysis.h"
+#include "CFLAndersAliasAnalysis.h"
 
+#include "phasar/Utils/PAMMMacros.h"
+
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseMapInfo.h"
 #include "llvm/ADT/DenseSet.h"
@@ -64,15 +67,15 @@
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/MemoryLocation.h"
+#include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/IR/Argument.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/PassManager.h"
 #include "llvm/IR/Type.h"
-#include "llvm/InitializePasses.h"
-#include "llvm/Pass.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/ScopedPrinter.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "AliasAnalysisSummary.h"
@@ -81,6 +84,7 @@
 #include <algorithm>
 #include <bitset>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -89,14 +93,17 @@
 
 using namespace llvm;
 using namespace llvm::cflaa;
+using namespace psr::cfl;
 
 #define DEBUG_TYPE "cfl-anders-aa"
 
 CFLAndersAAResult::CFLAndersAAResult(
-    std::function<const TargetLibraryInfo &(Function &F)> GetTLI)
-    : GetTLI(std::move(GetTLI)) {}
+    std::function<const TargetLibraryInfo &(Function &F)> GetTLI,
+    std::shared_ptr<SummaryCache> Summaries)
+    : GetTLI(std::move(GetTLI)), Summaries(std::move(Summaries)) {}
 CFLAndersAAResult::CFLAndersAAResult(CFLAndersAAResult &&RHS)
-    : AAResultBase(std::move(RHS)), GetTLI(std::move(RHS.GetTLI)) {}
+    : AAResultBase(std::move(RHS)), GetTLI(std::move(RHS.GetTLI)),
+      Summaries(std::move(RHS.Summaries)) {}
 CFLAndersAAResult::~CFLAndersAAResult() = default;
 
 namespace {
@@ -159,10 +166,19 @@ bool operator==(OffsetInstantiatedValue LHS, OffsetInstantiatedValue RHS) {
   return LHS.IVal == RHS.IVal && LHS.Offset == RHS.Offset;
 }
 
+// Returns the memory that a SmallDenseMap or SmallDenseSet has allocated in
+// addition to its inline buckets
+template <typename SmallMapT> static size_t getHeapSize(const SmallMapT &Map) {
+  auto Size = Map.getMemorySize();
+  return Size > sizeof(Map) ? Size : 0;
+}
+
 // We use ReachabilitySet to keep track of value aliases (The nonterminal "V" in
 // the paper) during the analysis.
 class ReachabilitySet {
-  using ValueStateMap = DenseMap<InstantiatedValue, StateSet>;
+  // Most nodes are only reachable from a few others, so keep them inline.
+  // Otherwise, each node would allocate at least 64 buckets.
+  using ValueStateMap = SmallDenseMap<InstantiatedValue, StateSet, 4>;
   using ValueReachMap = DenseMap<InstantiatedValue, ValueStateMap>;
 
   ValueReachMap ReachMap;
@@ -197,12 +213,19 @@ public:
   iterator_range<const_value_iterator> value_mappings() const {
     return make_range<const_value_iterator>(ReachMap.begin(), ReachMap.end());
   }
+
+  size_t getMemorySize() const {
+    size_t Size = ReachMap.getMemorySize();
+    for (const auto &Mapping : ReachMap)
+      Size += getHeapSize(Mapping.second);
+    return Size;
+  }
 };
 
 // We use AliasMemSet to keep track of all memory aliases (the nonterminal "M"
 // in the paper) during the analysis.
 class AliasMemSet {
-  using MemSet = DenseSet<InstantiatedValue>;
+  using MemSet = SmallDenseSet<InstantiatedValue, 4>;
   using MemMapType = DenseMap<InstantiatedValue, MemSet>;
 
   MemMapType MemMap;
@@ -223,6 +246,13 @@ public:
       return nullptr;
     return &Itr->second;
   }
+
+  size_t getMemorySize() const {
+    size_t Size = MemMap.getMemorySize();
+    for (const auto &Mapping : MemMap)
+      Size += getHeapSize(Mapping.second);
+    return Size;
+  }
 };
 
 // We use AliasAttrMap to keep track of the AliasAttr of each node.
@@ -328,7 +358,10 @@ class CFLAndersAAResult::FunctionInfo {
   /// Since the alias relation is symmetric, to save some space we assume values
   /// are properly ordered: if a and b alias each other, and a < b, then b is in
   /// AliasMap[a] but not vice versa.
-  DenseMap<const Value *, std::vector<OffsetValue>> AliasMap;
+  /// The lists of all values are stored back to back in AliasLists, so AliasMap
+  /// only holds the first index and the size of each list.
+  DenseMap<const Value *, std::pair<unsigned, unsigned>> AliasMap;
+  std::vector<OffsetValue> AliasLists;
 
   /// Map a value to its corresponding AliasAttrs
   DenseMap<const Value *, AliasAttrs> AttrMap;
@@ -336,14 +369,26 @@ class CFLAndersAAResult::FunctionInfo {
   /// Summary of externally visible effects.
   AliasSummary Summary;
 
+  /// Whether Summary depends on a summary that was not fully available,
+  /// because the call graph is recursive
+  bool DependsOnRecursion;
+
   Optional<AliasAttrs> getAttrs(const Value *) const;
 
 public:
   FunctionInfo(const Function &, const SmallVectorImpl<Value *> &,
-               const ReachabilitySet &, const AliasAttrMap &);
+               const ReachabilitySet &, const AliasAttrMap &,
+               bool DependsOnRecursion);
 
   bool mayAlias(const Value *, LocationSize, const Value *, LocationSize) const;
   const AliasSummary &getAliasSummary() const { return Summary; }
+  bool dependsOnRecursion() const { return DependsOnRecursion; }
+
+  size_t getMemorySize() const {
+    return AliasMap.getMemorySize() +
+           AliasLists.capacity() * sizeof(OffsetValue) +
+           AttrMap.getMemorySize() + sizeof(Summary);
+  }
 };
 
 static bool hasReadOnlyState(StateSet Set) {
@@ -383,25 +428,30 @@ static void populateAttrMap(DenseMap<const Value *, AliasAttrs> &AttrMap,
   }
 }
 
-static void
-populateAliasMap(DenseMap<const Value *, std::vector<OffsetValue>> &AliasMap,
-                 const ReachabilitySet &ReachSet) {
+static void populateAliasMap(
+    DenseMap<const Value *, std::pair<unsigned, unsigned>> &AliasMap,
+    std::vector<OffsetValue> &AliasLists, const ReachabilitySet &ReachSet) {
   for (const auto &OuterMapping : ReachSet.value_mappings()) {
     // AliasMap only cares about top-level values
     if (OuterMapping.first.DerefLevel > 0)
       continue;
 
-    auto Val = OuterMapping.first.Val;
-    auto &AliasList = AliasMap[Val];
+    unsigned Begin = AliasLists.size();
     for (const auto &InnerMapping : OuterMapping.second) {
       // Again, AliasMap only cares about top-level values
       if (InnerMapping.first.DerefLevel == 0)
-        AliasList.push_back(OffsetValue{InnerMapping.first.Val, UnknownOffset});
+        AliasLists.push_back(
+            OffsetValue{InnerMapping.first.Val, UnknownOffset});
     }
+    if (AliasLists.size() == Begin)
+      continue;
 
     // Sort AliasList for faster lookup
-    llvm::sort(AliasList);
+    std::sort(AliasLists.begin() + Begin, AliasLists.end());
+    unsigned Size = AliasLists.size() - Begin;
+    AliasMap[OuterMapping.first.Val] = {Begin, Size};
   }
+  AliasLists.shrink_to_fit();
 }
 
 static void populateExternalRelations(
@@ -503,10 +553,12 @@ static void populateExternalAttributes(
 
 CFLAndersAAResult::FunctionInfo::FunctionInfo(
     const Function &Fn, const SmallVectorImpl<Value *> &RetVals,
-    const ReachabilitySet &ReachSet, const AliasAttrMap &AMap) {
+    const ReachabilitySet &ReachSet, const AliasAttrMap &AMap,
+    bool DependsOnRecursion)
+    : DependsOnRecursion(DependsOnRecursion) {
   populateAttrMap(AttrMap, AMap);
   populateExternalAttributes(Summary.RetParamAttributes, Fn, RetVals, AMap);
-  populateAliasMap(AliasMap, ReachSet);
+  populateAliasMap(AliasMap, AliasLists, ReachSet);
   populateExternalRelations(Summary.RetParamRelations, Fn, RetVals, ReachSet);
 }
 
@@ -549,15 +601,17 @@ bool CFLAndersAAResult::FunctionInfo::mayAlias(
 
   auto Itr = AliasMap.find(LHS);
   if (Itr != AliasMap.end()) {
+    auto AliasList = makeArrayRef(AliasLists).slice(Itr->second.first,
+                                                    Itr->second.second);
 
     // Find out all (X, Offset) where X == RHS
     auto Comparator = [](OffsetValue LHS, OffsetValue RHS) {
       return std::less<const Value *>()(LHS.Val, RHS.Val);
     };
 #ifdef EXPENSIVE_CHECKS
-    assert(llvm::is_sorted(Itr->second, Comparator));
+    assert(llvm::is_sorted(AliasList, Comparator));
 #endif
-    auto RangePair = std::equal_range(Itr->second.begin(), Itr->second.end(),
+    auto RangePair = std::equal_range(AliasList.begin(), AliasList.end(),
                                       OffsetValue{RHS, 0}, Comparator);
 
     if (RangePair.first != RangePair.second) {
@@ -659,6 +713,10 @@ static void processWorkListItem(const WorkListItem &Item, const CFLGraph &Graph,
       MemSet.insert(*FromNodeBelow, *ToNodeBelow)) {
     propagate(*FromNodeBelow, *ToNodeBelow,
               MatchState::FlowFromMemAliasNoReadWrite, ReachSet, WorkList);
+    // The aliases of each node are stored inline, so they move when a new
+    // node gets added to ReachSet. The propagation above has added
+    // ToNodeBelow, such that the loop below does not add any new node.
+    assert(!ReachSet.reachableValueAliases(*ToNodeBelow).empty());
     for (const auto &Mapping : ReachSet.reachableValueAliases(*FromNodeBelow)) {
       auto Src = Mapping.first;
       auto MemAliasPropagate = [&](MatchState FromState, MatchState ToState) {
@@ -781,34 +839,136 @@ static AliasAttrMap buildAttrMap(const CFLGraph &Graph,
   return AttrMap;
 }
 
+// An estimate of the memory that Graph has allocated. CFLGraph is shared with
+// LLVM's copy of the analysis, so this cannot be a member of it. The buckets
+// of its value map are estimated by the number of values.
+static size_t getGraphMemorySize(const CFLGraph &Graph) {
+  size_t Size = 0;
+  for (const auto &Mapping : Graph.value_mappings()) {
+    const auto &ValInfo = Mapping.second;
+    Size += sizeof(Mapping) +
+            ValInfo.getNumLevels() * sizeof(CFLGraph::NodeInfo);
+    for (unsigned I = 0, E = ValInfo.getNumLevels(); I < E; ++I) {
+      const auto &Info = ValInfo.getNodeInfoAtLevel(I);
+      Size += (Info.Edges.capacity() + Info.ReverseEdges.capacity()) *
+              sizeof(CFLGraph::Edge);
+    }
+  }
+  return Size;
+}
+
+// The phases of buildInfoFrom(), which are timed with PAMM. The time spent in
+// scanning the callees is not included in the graph construction.
+static constexpr llvm::StringLiteral GraphConstructionTimerId =
+    "CFLAnders Graph Construction";
+static constexpr llvm::StringLiteral ReachabilityTimerId =
+    "CFLAnders Reachability Fixpoint";
+static constexpr llvm::StringLiteral SummaryTimerId =
+    "CFLAnders Summary Building";
+
+static void startTimer([[maybe_unused]] llvm::StringRef TimerId) {
+  using namespace psr;
+  PAMM_GET_INSTANCE;
+  START_TIMER(TimerId, Full);
+}
+
+static void pauseTimer([[maybe_unused]] llvm::StringRef TimerId) {
+  using namespace psr;
+  PAMM_GET_INSTANCE;
+  PAUSE_TIMER(TimerId, Full);
+}
+
+static void registerStatistics() {
+  // PAMM does not allow registering the same id twice
+  [[maybe_unused]] static const bool Registered = [] {
+    using namespace psr;
+    PAMM_GET_INSTANCE;
+    REG_COUNTER("CFLAnders Scanned Functions", 0, Full);
+    REG_COUNTER("CFLAnders Shared Summaries Used", 0, Full);
+    REG_COUNTER("CFLAnders Reachability Propagations", 0, Full);
+    REG_HISTOGRAM("CFLAnders Time per Function [us]", Full);
+    REG_HISTOGRAM("CFLAnders Memory per Function [bytes]", Full);
+    return true;
+  }();
+}
+
+// Reports the time that has been spent in buildInfoFrom(Fn), excluding the
+// callees, and an estimate of the memory that it needed. Both are summed over
+// all scans of Fn.
+static void reportScan([[maybe_unused]] const Function &Fn,
+                       [[maybe_unused]] std::chrono::microseconds Time,
+                       [[maybe_unused]] size_t MemorySize,
+                       [[maybe_unused]] size_t NumPropagations) {
+  using namespace psr;
+  registerStatistics();
+  PAMM_GET_INSTANCE;
+  INC_COUNTER("CFLAnders Scanned Functions", 1, Full);
+  INC_COUNTER("CFLAnders Reachability Propagations", NumPropagations, Full);
+  ADD_TO_HISTOGRAM("CFLAnders Time per Function [us]", Fn.getName(),
+                   Time.count(), Full);
+  ADD_TO_HISTOGRAM("CFLAnders Memory per Function [bytes]", Fn.getName(),
+                   MemorySize, Full);
+}
+
+static void reportSharedSummaryUse() {
+  using namespace psr;
+  registerStatistics();
+  PAMM_GET_INSTANCE;
+  INC_COUNTER("CFLAnders Shared Summaries Used", 1, Full);
+}
+
 CFLAndersAAResult::FunctionInfo
 CFLAndersAAResult::buildInfoFrom(const Function &Fn) {
+  auto Start = std::chrono::steady_clock::now();
+
+  startTimer(GraphConstructionTimerId);
   CFLGraphBuilder<CFLAndersAAResult> GraphBuilder(
       *this, GetTLI(const_cast<Function &>(Fn)),
       // Cast away the constness here due to GraphBuilder's API requirement
       const_cast<Function &>(Fn));
   auto &Graph = GraphBuilder.getCFLGraph();
+  pauseTimer(GraphConstructionTimerId);
 
+  startTimer(ReachabilityTimerId);
   ReachabilitySet ReachSet;
-  AliasMemSet MemSet;
-
-  std::vector<WorkListItem> WorkList, NextList;
-  initializeWorkList(WorkList, ReachSet, Graph);
-  // TODO: make sure we don't stop before the fix point is reached
-  while (!WorkList.empty()) {
-    for (const auto &Item : WorkList)
-      processWorkListItem(Item, Graph, ReachSet, MemSet, NextList);
+  size_t NumPropagations = 0;
+  size_t MemorySize = 0;
+  {
+    AliasMemSet MemSet;
+
+    std::vector<WorkListItem> WorkList, NextList;
+    initializeWorkList(WorkList, ReachSet, Graph);
+    // TODO: make sure we don't stop before the fix point is reached
+    while (!WorkList.empty()) {
+      NumPropagations += WorkList.size();
+      for (const auto &Item : WorkList)
+        processWorkListItem(Item, Graph, ReachSet, MemSet, NextList);
+
+      NextList.swap(WorkList);
+      NextList.clear();
+    }
 
-    NextList.swap(WorkList);
-    NextList.clear();
+    // This is when the most memory is in use
+    MemorySize = getGraphMemorySize(Graph) + ReachSet.getMemorySize() +
+                 MemSet.getMemorySize();
   }
+  pauseTimer(ReachabilityTimerId);
 
+  startTimer(SummaryTimerId);
   // Now that we have all the reachability info, propagate AliasAttrs according
   // to it
   auto IValueAttrMap = buildAttrMap(Graph, ReachSet);
 
-  return FunctionInfo(Fn, GraphBuilder.getReturnValues(), ReachSet,
-                      std::move(IValueAttrMap));
+  FunctionInfo Info(Fn, GraphBuilder.getReturnValues(), ReachSet,
+                    std::move(IValueAttrMap),
+                    ScanStack.back().DependsOnRecursion);
+  pauseTimer(SummaryTimerId);
+
+  auto Time = std::chrono::steady_clock::now() - Start -
+              ScanStack.back().CalleeTime;
+  reportScan(Fn, std::chrono::duration_cast<std::chrono::microseconds>(Time),
+             MemorySize + Info.getMemorySize(), NumPropagations);
+  return Info;
 }
 
 void CFLAndersAAResult::scan(const Function &Fn) {
@@ -817,10 +977,26 @@ void CFLAndersAAResult::scan(const Function &Fn) {
   assert(InsertPair.second &&
          "Trying to scan a function that has already been cached");
 
+  // Fn is a callee of the function whose graph is being built
+  auto Start = std::chrono::steady_clock::now();
+  if (!ScanStack.empty())
+    pauseTimer(GraphConstructionTimerId);
+
   // Note that we can't do Cache[Fn] = buildSetsFrom(Fn) here: the function call
   // may get evaluated after operator[], potentially triggering a DenseMap
   // resize and invalidating the reference returned by operator[]
+  ScanStack.emplace_back();
   auto FunInfo = buildInfoFrom(Fn);
+  ScanStack.pop_back();
+
+  if (!ScanStack.empty()) {
+    ScanStack.back().CalleeTime += std::chrono::steady_clock::now() - Start;
+    startTimer(GraphConstructionTimerId);
+  }
+
+  if (Summaries && !FunInfo.dependsOnRecursion())
+    Summaries->insert(Fn, FunInfo.getAliasSummary());
+
   Cache[&Fn] = std::move(FunInfo);
   Handles.emplace_front(const_cast<Function *>(&Fn), this);
 }
@@ -839,14 +1015,62 @@ CFLAndersAAResult::ensureCached(const Function &Fn) {
   return Iter->second;
 }
 
+void CFLAndersAAResult::ensureScanned(const Function &Fn) {
+  (void)ensureCached(Fn);
+}
+
 const AliasSummary *CFLAndersAAResult::getAliasSummary(const Function &Fn) {
+  if (Summaries) {
+    if (const auto *Summary = Summaries->lookup(Fn)) {
+      reportSharedSummaryUse();
+      return Summary;
+    }
+  }
+
   auto &FunInfo = ensureCached(Fn);
+  // If Fn is still being scanned, the caller of Fn must do without its
+  // summary. This makes the caller's summary depend on where the scan started,
+  // so it must not be shared.
+  if ((!FunInfo.hasValue() || FunInfo->dependsOnRecursion()) &&
+      !ScanStack.empty())
+    ScanStack.back().DependsOnRecursion = true;
+
   if (FunInfo.hasValue())
     return &FunInfo->getAliasSummary();
   else
     return nullptr;
 }
 
+CFLAndersAAResult::SummaryCache::SummaryCache() = default;
+CFLAndersAAResult::SummaryCache::~SummaryCache() = default;
+
+const AliasSummary *
+CFLAndersAAResult::SummaryCache::lookup(const Function &Fn) const {
+  auto Iter = Summaries.find(&Fn);
+  if (Iter == Summaries.end())
+    return nullptr;
+  return Iter->second.get();
+}
+
+void CFLAndersAAResult::SummaryCache::insert(const Function &Fn,
+                                             const AliasSummary &Summary) {
+  auto &Entry = Summaries[&Fn];
+  if (Entry)
+    return;
+
+  Entry = std::make_unique<AliasSummary>(Summary);
+  Handles.emplace_front(const_cast<Function *>(&Fn), this);
+}
+
+void CFLAndersAAResult::SummaryCache::evict(const Function *Fn) {
+  Summaries.erase(Fn);
+}
+
+void CFLAndersAAResult::SummaryCache::clear() {
+  Summaries.clear();
+  Handles.clear();
+}
+
 AliasResult CFLAndersAAResult::query(const MemoryLocation &LocA,
                                      const MemoryLocation &LocB) {
   auto *ValA = LocA.Ptr;
@@ -902,33 +1126,15 @@ AliasResult CFLAndersAAResult::alias(const MemoryLocation &LocA,
 
 AnalysisKey CFLAndersAA::Key;
 
+CFLAndersAA::CFLAndersAA()
+    : Summaries(std::make_shared<CFLAndersAAResult::SummaryCache>()) {}
+CFLAndersAA::CFLAndersAA(
+    std::shared_ptr<CFLAndersAAResult::SummaryCache> Summaries)
+    : Summaries(std::move(Summaries)) {}
+
 CFLAndersAAResult CFLAndersAA::run(Function &F, FunctionAnalysisManager &AM) {
   auto GetTLI = [&AM](Function &F) -> TargetLibraryInfo & {
     return AM.getResult<TargetLibraryAnalysis>(F);
   };
-  return CFLAndersAAResult(GetTLI);
-}
-
-char CFLAndersAAWrapperPass::ID = 0;
-INITIALIZE_PASS(CFLAndersAAWrapperPass, "cfl-anders-aa",
-                "Inclusion-Based CFL Alias Analysis", false, true)
-
-ImmutablePass *llvm::createCFLAndersAAWrapperPass() {
-  return new CFLAndersAAWrapperPass();
-}
-
-CFLAndersAAWrapperPass::CFLAndersAAWrapperPass() : ImmutablePass(ID) {
-  initializeCFLAndersAAWrapperPassPass(*PassRegistry::getPassRegistry());
-}
-
-void CFLAndersAAWrapperPass::initializePass() {
-  auto GetTLI = [this](Function &F) -> TargetLibraryInfo & {
-    return this->getAnalysis<TargetLibraryInfoWrapperPass>().getTLI(F);
-  };
-  Result.reset(new CFLAndersAAResult(GetTLI));
-}
-
-void CFLAndersAAWrapperPass::getAnalysisUsage(AnalysisUsage &AU) const {
-  AU.setPreservesAll();
-  AU.addRequired<TargetLibraryInfoWrapperPass>();
+  return CFLAndersAAResult(GetTLI, Summaries);
 }
@@ -9,18 +9,22 @@
 /// This is the interface for LLVM's inclusion-based alias analysis
 /// implemented with CFL graph reachability.
 ///
+/// Phasar's copy differs from the one that ships with LLVM, so it lives in the
+/// namespace psr::cfl to not clash with the definitions in libLLVM.
+///
 //===----------------------------------------------------------------------===//
 
-#ifndef LLVM_ANALYSIS_CFLANDERSALIASANALYSIS_H
-#define LLVM_ANALYSIS_CFLANDERSALIASANALYSIS_H
+#ifndef PHASAR_PHASARLLVM_POINTER_EXTERNAL_LLVM_CFLANDERSALIASANALYSIS_H
+#define PHASAR_PHASARLLVM_POINTER_EXTERNAL_LLVM_CFLANDERSALIASANALYSIS_H
 
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Optional.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/CFLAliasAnalysisUtils.h"
 #include "llvm/IR/PassManager.h"
-#include "llvm/Pass.h"
 
+#include <chrono>
 #include <forward_list>
 #include <memory>
 
@@ -36,14 +40,36 @@ struct AliasSummary;
 
 } // end namespace cflaa
 
-class CFLAndersAAResult : public AAResultBase<CFLAndersAAResult> {
-  friend AAResultBase<CFLAndersAAResult>;
+} // end namespace llvm
+
+namespace psr::cfl {
+
+using llvm::AAQueryInfo;
+using llvm::AnalysisInfoMixin;
+using llvm::AnalysisKey;
+using llvm::DenseMap;
+using llvm::Function;
+using llvm::FunctionAnalysisManager;
+using llvm::MemoryLocation;
+using llvm::Optional;
+using llvm::PreservedAnalyses;
+using llvm::SmallVector;
+using llvm::TargetLibraryInfo;
+namespace cflaa = llvm::cflaa;
+
+class CFLAndersAAResult : public llvm::AAResultBase<CFLAndersAAResult> {
+  friend llvm::AAResultBase<CFLAndersAAResult>;
 
   class FunctionInfo;
 
 public:
+  class SummaryCache;
+
+  /// If Summaries is given, the summaries of the scanned functions are shared
+  /// with all other results that use the same SummaryCache.
   explicit CFLAndersAAResult(
-      std::function<const TargetLibraryInfo &(Function &F)> GetTLI);
+      std::function<const TargetLibraryInfo &(Function &F)> GetTLI,
+      std::shared_ptr<SummaryCache> Summaries = nullptr);
   CFLAndersAAResult(CFLAndersAAResult &&RHS);
   ~CFLAndersAAResult();
 
@@ -61,9 +87,13 @@ public:
   /// Return nullptr if the summary is not found or not available
   const cflaa::AliasSummary *getAliasSummary(const Function &);
 
-  AliasResult query(const MemoryLocation &, const MemoryLocation &);
-  AliasResult alias(const MemoryLocation &, const MemoryLocation &,
-                    AAQueryInfo &);
+  /// Build the alias information that queries within the given function
+  /// need, unless it is in the cache already
+  void ensureScanned(const Function &Fn);
+
+  llvm::AliasResult query(const MemoryLocation &, const MemoryLocation &);
+  llvm::AliasResult alias(const MemoryLocation &, const MemoryLocation &,
+                          AAQueryInfo &);
 
 private:
   /// Ensures that the given function is available in the cache.
@@ -76,8 +106,23 @@ private:
   /// Build summary for a given function
   FunctionInfo buildInfoFrom(const Function &);
 
+  /// The state of a function that is currently being scanned
+  struct ScanState {
+    /// Whether the summary depends on the summary of a function that was not
+    /// fully available, because the call graph is recursive
+    bool DependsOnRecursion = false;
+    /// The time spent in scanning the callees
+    std::chrono::steady_clock::duration CalleeTime{};
+  };
+
   std::function<const TargetLibraryInfo &(Function &F)> GetTLI;
 
+  /// The summaries shared with the results for other functions, if any
+  std::shared_ptr<SummaryCache> Summaries;
+
+  /// The functions that are currently being scanned, innermost last
+  SmallVector<ScanState, 4> ScanStack;
+
   /// Cached mapping of Functions to their StratifiedSets.
   /// If a function's sets are currently being built, it is marked
   /// in the cache as an Optional without a value. This way, if we
@@ -88,6 +133,41 @@ private:
   std::forward_list<cflaa::FunctionHandle<CFLAndersAAResult>> Handles;
 };
 
+/// The alias summaries of functions, shared between the CFLAndersAAResults of
+/// different functions.
+///
+/// The analysis manager holds one result per function, and each of them
+/// needs the summaries of all (transitive) callees. Sharing them means every
+/// function is scanned once and not once per caller.
+///
+/// A summary is only shared if it does not depend on a recursive call whose
+/// summary was not available yet, so sharing does not change any results. The
+/// summaries must be cleared when the IR of a function changes.
+class CFLAndersAAResult::SummaryCache {
+public:
+  SummaryCache();
+  SummaryCache(const SummaryCache &) = delete;
+  SummaryCache &operator=(const SummaryCache &) = delete;
+  ~SummaryCache();
+
+  /// Returns nullptr if there is no shared summary for Fn
+  const cflaa::AliasSummary *lookup(const Function &Fn) const;
+
+  void insert(const Function &Fn, const cflaa::AliasSummary &Summary);
+
+  /// Evict the given function from cache
+  void evict(const Function *Fn);
+
+  void clear();
+
+  size_t size() const { return Summaries.size(); }
+
+private:
+  DenseMap<const Function *, std::unique_ptr<cflaa::AliasSummary>> Summaries;
+
+  std::forward_list<cflaa::FunctionHandle<SummaryCache>> Handles;
+};
+
 /// Analysis pass providing a never-invalidated alias analysis result.
 ///
 /// FIXME: We really should refactor CFL to use the analysis more heavily, and
@@ -100,29 +180,18 @@ class CFLAndersAA : public AnalysisInfoMixin<CFLAndersAA> {
 public:
   using Result = CFLAndersAAResult;
 
-  CFLAndersAAResult run(Function &F, FunctionAnalysisManager &AM);
-};
+  /// All results of this analysis share the summaries of the functions they
+  /// scan
+  CFLAndersAA();
+  explicit CFLAndersAA(
+      std::shared_ptr<CFLAndersAAResult::SummaryCache> Summaries);
 
-/// Legacy wrapper pass to provide the CFLAndersAAResult object.
-class CFLAndersAAWrapperPass : public ImmutablePass {
-  std::unique_ptr<CFLAndersAAResult> Result;
-
-public:
-  static char ID;
-
-  CFLAndersAAWrapperPass();
-
-  CFLAndersAAResult &getResult() { return *Result; }
-  const CFLAndersAAResult &getResult() const { return *Result; }
+  CFLAndersAAResult run(Function &F, FunctionAnalysisManager &AM);
 
-  void initializePass() override;
-  void getAnalysisUsage(AnalysisUsage &AU) const override;
+private:
+  std::shared_ptr<CFLAndersAAResult::SummaryCache> Summaries;
 };
 
-// createCFLAndersAAWrapperPass - This pass implements a set-based approach to
-// alias analysis.
-ImmutablePass *createCFLAndersAAWrapperPass();
-
-} // end namespace llvm
+} // namespace psr::cfl
 
-#endif // LLVM_ANALYSIS_CFLANDERSALIASANALYSIS_H
+#endif // PHASAR_PHASARLLVM_POINTER_EXTERNAL_LLVM_CFLANDERSALIASANALYSIS_H
@@ -0,0 +1,19 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#include "phasar/Pointer/CachedAliasInfo.h"
+
+#include "phasar/Pointer/AliasInfoBase.h"
+
+namespace psr {
+static_assert(IsAliasInfo<
+              CachedAliasInfo<const llvm::Value *, const llvm::Instruction *>>);
+
+template class CachedAliasInfo<const llvm::Value *, const llvm::Instruction *>;
+} // namespace psr
@@ -0,0 +1,260 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#include "phasar/Utils/CompactIdSet.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace psr;
+
+/// An array-container with more elements would be larger than a bitmap
+static constexpr size_t ArrayContainerLimit = 4096;
+static constexpr size_t BitmapWords = (size_t(1) << 16) / 64;
+
+static uint16_t highBits(uint32_t Id) noexcept { return uint16_t(Id >> 16); }
+static uint16_t lowBits(uint32_t Id) noexcept { return uint16_t(Id); }
+
+static bool testBit(llvm::ArrayRef<uint64_t> Bitmap, uint16_t Low) noexcept {
+  return Bitmap[Low / 64] & (uint64_t(1) << (Low % 64));
+}
+
+/// Checks whether the sorted ranges A and B have a common element
+template <typename T>
+static bool intersectsSorted(llvm::ArrayRef<T> A,
+                             llvm::ArrayRef<T> B) noexcept {
+  if (A.size() > B.size()) {
+    std::swap(A, B);
+  }
+  if (A.empty() || A.front() > B.back() || B.front() > A.back()) {
+    return false;
+  }
+
+  if (A.size() * 16 < B.size()) {
+    // Binary search is cheaper than walking both ranges
+    return llvm::any_of(A, [B](T Elem) {
+      return std::binary_search(B.begin(), B.end(), Elem);
+    });
+  }
+
+  const auto *AIt = A.begin();
+  const auto *BIt = B.begin();
+  while (AIt != A.end() && BIt != B.end()) {
+    if (*AIt < *BIt) {
+      ++AIt;
+    } else if (*BIt < *AIt) {
+      ++BIt;
+    } else {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool CompactIdSet::Container::contains(uint16_t Low) const noexcept {
+  if (isBitmap()) {
+    return testBit(Bitmap, Low);
+  }
+  return std::binary_search(Array.begin(), Array.end(), Low);
+}
+
+CompactIdSet::CompactIdSet(std::vector<uint32_t> Elements) {
+  if (!std::is_sorted(Elements.begin(), Elements.end())) {
+    std::sort(Elements.begin(), Elements.end());
+  }
+  Elements.erase(std::unique(Elements.begin(), Elements.end()), Elements.end());
+  NumIds = Elements.size();
+
+  auto GroupEnd = [&Elements](auto It) {
+    auto Key = highBits(*It);
+    return std::partition_point(It, Elements.end(), [Key](uint32_t Id) {
+      return highBits(Id) == Key;
+    });
+  };
+
+  size_t RoaringSize = 0;
+  for (auto It = Elements.begin(); It != Elements.end();) {
+    auto End = GroupEnd(It);
+    auto Card = size_t(std::distance(It, End));
+    RoaringSize += sizeof(Container) + (Card > ArrayContainerLimit
+                                            ? BitmapWords * sizeof(uint64_t)
+                                            : Card * sizeof(uint16_t));
+    It = End;
+  }
+
+  if (RoaringSize >= NumIds * sizeof(uint32_t)) {
+    Ids.assign(Elements.begin(), Elements.end());
+    return;
+  }
+
+  for (auto It = Elements.begin(); It != Elements.end();) {
+    auto End = GroupEnd(It);
+    auto &Cont = Containers.emplace_back();
+    Cont.Key = highBits(*It);
+    if (size_t(std::distance(It, End)) > ArrayContainerLimit) {
+      Cont.Bitmap.resize(BitmapWords);
+      for (; It != End; ++It) {
+        auto Low = lowBits(*It);
+        Cont.Bitmap[Low / 64] |= uint64_t(1) << (Low % 64);
+      }
+    } else {
+      Cont.Array.reserve(std::distance(It, End));
+      for (; It != End; ++It) {
+        Cont.Array.push_back(lowBits(*It));
+      }
+    }
+  }
+}
+
+auto CompactIdSet::findContainer(uint16_t Key) const noexcept
+    -> const Container * {
+  auto It = llvm::partition_point(
+      Containers, [Key](const Container &Cont) { return Cont.Key < Key; });
+  if (It == Containers.end() || It->Key != Key) {
+    return nullptr;
+  }
+  return &*It;
+}
+
+bool CompactIdSet::contains(uint32_t Id) const noexcept {
+  if (!isRoaring()) {
+    return std::binary_search(Ids.begin(), Ids.end(), Id);
+  }
+  const auto *Cont = findContainer(highBits(Id));
+  return Cont && Cont->contains(lowBits(Id));
+}
+
+bool CompactIdSet::intersects(const CompactIdSet &Other) const noexcept {
+  if (empty() || Other.empty()) {
+    return false;
+  }
+
+  if (!isRoaring() && !Other.isRoaring()) {
+    return intersectsSorted<uint32_t>(Ids, Other.Ids);
+  }
+  if (!isRoaring() || !Other.isRoaring()) {
+    const auto &Sorted = isRoaring() ? Other : *this;
+    const auto &Roaring = isRoaring() ? *this : Other;
+    return llvm::any_of(
+        Sorted.Ids, [&Roaring](uint32_t Id) { return Roaring.contains(Id); });
+  }
+
+  auto LhsIt = Containers.begin();
+  auto RhsIt = Other.Containers.begin();
+  while (LhsIt != Containers.end() && RhsIt != Other.Containers.end()) {
+    if (LhsIt->Key < RhsIt->Key) {
+      ++LhsIt;
+      continue;
+    }
+    if (RhsIt->Key < LhsIt->Key) {
+      ++RhsIt;
+      continue;
+    }
+
+    const auto &Lhs = *LhsIt++;
+    const auto &Rhs = *RhsIt++;
+    if (Lhs.isBitmap() && Rhs.isBitmap()) {
+      for (size_t I = 0; I < BitmapWords; ++I) {
+        if (Lhs.Bitmap[I] & Rhs.Bitmap[I]) {
+          return true;
+        }
+      }
+    } else if (Lhs.isBitmap() || Rhs.isBitmap()) {
+      const auto &Arr = Lhs.isBitmap() ? Rhs.Array : Lhs.Array;
+      const auto &Bitmap = Lhs.isBitmap() ? Lhs.Bitmap : Rhs.Bitmap;
+      if (llvm::any_of(Arr, [&Bitmap](uint16_t Low) {
+            return testBit(Bitmap, Low);
+          })) {
+        return true;
+      }
+    } else if (intersectsSorted<uint16_t>(Lhs.Array, Rhs.Array)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+CompactIdSet CompactIdSet::intersection(const CompactIdSet &Other) const {
+  const auto &Smaller = size() <= Other.size() ? *this : Other;
+  const auto &Larger = size() <= Other.size() ? Other : *this;
+
+  std::vector<uint32_t> Common;
+  for (auto Id : Smaller) {
+    if (Larger.contains(Id)) {
+      Common.push_back(Id);
+    }
+  }
+  return CompactIdSet(std::move(Common));
+}
+
+size_t CompactIdSet::getMemoryUsage() const noexcept {
+  size_t Ret =
+      Ids.capacity_in_bytes() + Containers.capacity() * sizeof(Container);
+  for (const auto &Cont : Containers) {
+    Ret += Cont.Array.capacity_in_bytes() + Cont.Bitmap.capacity_in_bytes();
+  }
+  return Ret;
+}
+
+CompactIdSet::const_iterator::const_iterator(const CompactIdSet *Set,
+                                             size_t Outer) noexcept
+    : Set(Set), Outer(Outer) {
+  settle();
+}
+
+void CompactIdSet::const_iterator::settle() noexcept {
+  if (!Set->isRoaring()) {
+    if (Outer < Set->Ids.size()) {
+      Curr = Set->Ids[Outer];
+    }
+    return;
+  }
+
+  const auto &Containers = Set->Containers;
+  for (; Outer < Containers.size(); ++Outer, Inner = 0) {
+    const auto &Cont = Containers[Outer];
+    uint32_t Base = uint32_t(Cont.Key) << 16;
+    if (!Cont.isBitmap()) {
+      if (Inner < Cont.Array.size()) {
+        Curr = Base | Cont.Array[Inner];
+        return;
+      }
+      continue;
+    }
+
+    // Find the next set bit at or after position Inner
+    for (auto Word = Inner / 64; Word < BitmapWords; ++Word) {
+      auto Bits = Cont.Bitmap[Word];
+      if (Word == Inner / 64) {
+        Bits &= ~uint64_t(0) << (Inner % 64);
+      }
+      if (Bits) {
+        Inner = Word * 64 + llvm::countTrailingZeros(Bits);
+        Curr = Base | Inner;
+        return;
+      }
+    }
+  }
+  // end()
+  Inner = 0;
+}
+
+auto CompactIdSet::const_iterator::operator++() noexcept -> const_iterator & {
+  if (Set->isRoaring()) {
+    ++Inner;
+  } else {
+    ++Outer;
+  }
+  settle();
+  return *this;
+}
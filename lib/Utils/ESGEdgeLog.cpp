@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#include "phasar/DataFlow/IfdsIde/Solver/ESGEdgeLog.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/ScopeExit.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <system_error>
+
+using namespace psr;
+
+ESGEdgeRecordBuffer::ESGEdgeRecordBuffer() noexcept = default;
+ESGEdgeRecordBuffer::~ESGEdgeRecordBuffer() = default;
+ESGEdgeRecordBuffer::ESGEdgeRecordBuffer(ESGEdgeRecordBuffer &&) noexcept =
+    default;
+ESGEdgeRecordBuffer &
+ESGEdgeRecordBuffer::operator=(ESGEdgeRecordBuffer &&) noexcept = default;
+
+void ESGEdgeRecordBuffer::streamTo(const llvm::Twine &Path) {
+  assert(Stream == nullptr && "The ESGEdgeRecordBuffer is already streaming");
+
+  std::error_code EC;
+  llvm::SmallString<256> Buf;
+  auto PathRef = Path.toNullTerminatedStringRef(Buf);
+  auto OFS = std::make_unique<llvm::raw_fd_ostream>(PathRef, EC);
+  if (EC) {
+    throw std::system_error(EC);
+  }
+
+  foreachChunk([&OFS](llvm::ArrayRef<ESGEdgeRecord> Recs) {
+    OFS->write(reinterpret_cast<const char *>(Recs.data()),
+               Recs.size() * sizeof(ESGEdgeRecord));
+  });
+  NumStreamed = NumRecords;
+
+  // From now on, we only need one chunk that is reused over and over again
+  if (Chunks.size() > 1) {
+    Chunks.erase(Chunks.begin() + 1, Chunks.end());
+  }
+  if (!Chunks.empty()) {
+    Pos = Chunks.front().get();
+    End = Pos + ChunkSize;
+  }
+
+  Stream = std::move(OFS);
+  StreamPath = PathRef.str();
+}
+
+void ESGEdgeRecordBuffer::grow() {
+  if (Stream && !Chunks.empty()) {
+    // The current chunk is full; write it out and reuse its memory
+    Pos = Chunks.front().get();
+    Stream->write(reinterpret_cast<const char *>(Pos),
+                  ChunkSize * sizeof(ESGEdgeRecord));
+    NumStreamed += ChunkSize;
+    return;
+  }
+
+  // Intentionally uninitialized
+  Chunks.push_back(std::unique_ptr<ESGEdgeRecord[]>(
+      new ESGEdgeRecord[ChunkSize])); // NOLINT
+  Pos = Chunks.back().get();
+  End = Pos + ChunkSize;
+}
+
+static void readExactly(llvm::sys::fs::file_t File,
+                        llvm::MutableArrayRef<char> Buf) {
+  while (!Buf.empty()) {
+    auto NumRead = llvm::sys::fs::readNativeFile(File, Buf);
+    if (!NumRead) {
+      throw std::system_error(llvm::errorToErrorCode(NumRead.takeError()));
+    }
+    if (*NumRead == 0) {
+      // The file is shorter than the number of records that we have streamed
+      throw std::system_error(std::make_error_code(std::errc::io_error));
+    }
+    Buf = Buf.drop_front(*NumRead);
+  }
+}
+
+void ESGEdgeRecordBuffer::foreachChunk(
+    llvm::function_ref<void(llvm::ArrayRef<ESGEdgeRecord>)> Handler) const {
+  if (NumStreamed) {
+    assert(Stream != nullptr);
+    Stream->flush();
+
+    auto FileOrErr = llvm::sys::fs::openNativeFileForRead(StreamPath);
+    if (!FileOrErr) {
+      throw std::system_error(llvm::errorToErrorCode(FileOrErr.takeError()));
+    }
+    auto File = *FileOrErr;
+    auto CloseFile =
+        llvm::make_scope_exit([&File] { llvm::sys::fs::closeFile(File); });
+
+    // Intentionally uninitialized
+    std::unique_ptr<ESGEdgeRecord[]> Buf(
+        new ESGEdgeRecord[ChunkSize]); // NOLINT
+    for (size_t Remaining = NumStreamed; Remaining;) {
+      auto NumRecs = std::min(Remaining, ChunkSize);
+      readExactly(File, llvm::makeMutableArrayRef(
+                            reinterpret_cast<char *>(Buf.get()),
+                            NumRecs * sizeof(ESGEdgeRecord)));
+      Handler(llvm::makeArrayRef(Buf.get(), NumRecs));
+      Remaining -= NumRecs;
+    }
+  }
+
+  if (Chunks.empty()) {
+    return;
+  }
+
+  for (size_t I = 0, NumFull = Chunks.size() - 1; I != NumFull; ++I) {
+    Handler(llvm::makeArrayRef(Chunks[I].get(), ChunkSize));
+  }
+  Handler(llvm::makeArrayRef(Chunks.back().get(), Pos));
+}
+
+void ESGEdgeRecordBuffer::clear() noexcept {
+  Chunks.clear();
+  Pos = End = nullptr;
+  NumRecords = 0;
+  NumStreamed = 0;
+  Stream = nullptr;
+  StreamPath.clear();
+}
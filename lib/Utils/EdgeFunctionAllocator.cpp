@@ -0,0 +1,190 @@
+/******************************************************************************
+ * Copyright (c) 2024 Fabian Schiebel.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#include "phasar/DataFlow/IfdsIde/EdgeFunctionAllocator.h"
+
+#include <array>
+#include <cassert>
+#include <mutex>
+#include <new>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+
+constexpr size_t NumSizeClasses = EdgeFunctionAllocator::NumSizeClasses;
+
+/// Number of chunks that are moved between a thread-cache and the global pool
+/// at once
+constexpr size_t BatchSize = 64;
+/// Once a thread-cache holds more than this many chunks of one size-class, it
+/// returns BatchSize of them to the global pool
+constexpr size_t MaxCachedChunks = 4 * BatchSize;
+
+constexpr size_t getChunkSize(size_t SizeClass) noexcept {
+  return (SizeClass + 1) * EdgeFunctionAllocator::Granularity;
+}
+
+struct FreeChunk {
+  FreeChunk *Next;
+};
+
+/// Intrusive singly-linked list of unused chunks
+struct FreeList {
+  FreeChunk *Head = nullptr;
+  size_t Size = 0;
+
+  void push(void *Ptr) noexcept {
+    Head = new (Ptr) FreeChunk{Head};
+    ++Size;
+  }
+
+  [[nodiscard]] void *pop() noexcept {
+    assert(Head != nullptr);
+    auto *Ret = Head;
+    Head = Ret->Next;
+    --Size;
+    return Ret;
+  }
+
+  /// Moves up to N chunks from this list to Into
+  void transferTo(FreeList &Into, size_t N) noexcept {
+    while (N-- && Head) {
+      Into.push(pop());
+    }
+  }
+};
+
+class GlobalPool {
+public:
+  void refill(FreeList &Into, size_t SizeClass) {
+    std::lock_guard Lck(Mtx);
+    auto &Free = FreeLists[SizeClass];
+    if (!Free.Head) {
+      allocateSlab(Free, SizeClass);
+    }
+    Free.transferTo(Into, BatchSize);
+  }
+
+  void release(FreeList &From, size_t SizeClass, size_t N) noexcept {
+    std::lock_guard Lck(Mtx);
+    From.transferTo(FreeLists[SizeClass], N);
+  }
+
+  [[nodiscard]] void *allocateOne(size_t SizeClass) {
+    std::lock_guard Lck(Mtx);
+    auto &Free = FreeLists[SizeClass];
+    if (!Free.Head) {
+      allocateSlab(Free, SizeClass);
+    }
+    return Free.pop();
+  }
+
+  void releaseOne(void *Ptr, size_t SizeClass) noexcept {
+    std::lock_guard Lck(Mtx);
+    FreeLists[SizeClass].push(Ptr);
+  }
+
+  [[nodiscard]] EdgeFunctionAllocator::Statistics getStatistics() noexcept {
+    std::lock_guard Lck(Mtx);
+    return {Slabs.size(), Slabs.size() * EdgeFunctionAllocator::SlabSize};
+  }
+
+private:
+  void allocateSlab(FreeList &Into, size_t SizeClass) {
+    auto *Slab = static_cast<char *>(
+        ::operator new(EdgeFunctionAllocator::SlabSize,
+                       std::align_val_t{EdgeFunctionAllocator::Granularity}));
+    Slabs.push_back(Slab);
+
+    auto ChunkSize = getChunkSize(SizeClass);
+    auto NumChunks = EdgeFunctionAllocator::SlabSize / ChunkSize;
+    // Push in reverse order, such that consecutive allocations are adjacent in
+    // memory
+    for (size_t I = NumChunks; I; --I) {
+      Into.push(Slab + (I - 1) * ChunkSize);
+    }
+  }
+
+  std::mutex Mtx;
+  std::array<FreeList, NumSizeClasses> FreeLists{};
+  std::vector<void *> Slabs;
+};
+
+GlobalPool &getGlobalPool() {
+  // Intentionally leaked: Edge functions with static storage duration may be
+  // destroyed after the pool would have been destroyed otherwise.
+  static auto *Pool = new GlobalPool();
+  return *Pool;
+}
+
+struct ThreadCache {
+  std::array<FreeList, NumSizeClasses> FreeLists{};
+
+  ~ThreadCache();
+
+  void flush() noexcept {
+    for (size_t SC = 0; SC != NumSizeClasses; ++SC) {
+      if (FreeLists[SC].Head) {
+        getGlobalPool().release(FreeLists[SC], SC, FreeLists[SC].Size);
+      }
+    }
+  }
+};
+
+// Trivially destructible, so it remains valid after the ThreadCache of the
+// same thread has been destroyed
+thread_local bool ThreadCacheDestroyed = false;
+thread_local ThreadCache TC;
+
+ThreadCache::~ThreadCache() {
+  flush();
+  ThreadCacheDestroyed = true;
+}
+
+} // namespace
+
+void *EdgeFunctionAllocator::allocateChunk(size_t SizeClass) {
+  assert(SizeClass < NumSizeClasses);
+  if (ThreadCacheDestroyed) {
+    return getGlobalPool().allocateOne(SizeClass);
+  }
+
+  auto &Free = TC.FreeLists[SizeClass];
+  if (!Free.Head) {
+    getGlobalPool().refill(Free, SizeClass);
+  }
+  return Free.pop();
+}
+
+void EdgeFunctionAllocator::deallocateChunk(void *Ptr,
+                                            size_t SizeClass) noexcept {
+  assert(SizeClass < NumSizeClasses);
+  if (ThreadCacheDestroyed) {
+    getGlobalPool().releaseOne(Ptr, SizeClass);
+    return;
+  }
+
+  auto &Free = TC.FreeLists[SizeClass];
+  Free.push(Ptr);
+  if (Free.Size > MaxCachedChunks) {
+    getGlobalPool().release(Free, SizeClass, BatchSize);
+  }
+}
+
+void EdgeFunctionAllocator::flushThreadCache() noexcept {
+  if (!ThreadCacheDestroyed) {
+    TC.flush();
+  }
+}
+
+auto EdgeFunctionAllocator::getStatistics() noexcept -> Statistics {
+  return getGlobalPool().getStatistics();
+}
@@ -29,6 +29,18 @@ llvm::raw_ostream &psr::operator<<(llvm::raw_ostream &OS,
   OS << "    Avg Depth:\t\t\t" << llvm::format("%g\n", S.AvgDepth);
   OS << "    Avg Unique Depth:\t\t" << llvm::format("%g\n", S.AvgUniqueDepth);
 
+  OS << "Cache Memory:\n";
+  OS << "  Limit (bytes):\t\t\t" << S.CacheMemoryLimit << '\n';
+  OS << "  Total (bytes):\t\t\t" << S.getCacheMemoryUsage() << '\n';
+  for (const auto &[FFBytes, EFBytes, NumEvicted, EFK] :
+       llvm::zip(S.FFCacheBytes, S.EFCacheBytes, S.NumEvictedCacheEntries,
+                 EFKind)) {
+    OS << "  Kind: " << EFK << ":\n";
+    OS << "    FlowFunctions (bytes):\t" << FFBytes << '\n';
+    OS << "    EdgeFunctions (bytes):\t" << EFBytes << '\n';
+    OS << "    Evicted Entries:\t\t" << NumEvicted << '\n';
+  }
+
   OS << "Jump Functions:\n";
   OS << "  Total #JumpFunctions:\t\t" << S.TotalNumJF << '\n';
   OS << "  Unique JumpFunctions:\t\t" << S.UniqueNumJF << '\n';
@@ -45,5 +57,12 @@ llvm::raw_ostream &psr::operator<<(llvm::raw_ostream &OS,
   OS << "    Avg Unique Depth:\t\t" << llvm::format("%g\n", S.AvgUniqueJFDepth);
   OS << "    Avg JF Object Depth:\t" << llvm::format("%g\n", S.AvgJFObjDepth);
 
+  OS << "Normalization:\n";
+  OS << "  Normalized EdgeFunctions:\t" << S.NumNormalizedEFs << '\n';
+  OS << "  Avg Depth Before:\t\t"
+     << llvm::format("%g\n", S.AvgDepthBeforeNormalization);
+  OS << "  Avg Depth After:\t\t"
+     << llvm::format("%g\n", S.AvgDepthAfterNormalization);
+
   return OS;
 }
@@ -0,0 +1,13 @@
+int main(int argc, char **argv) {
+  int a = 3;
+  int b = 0;
+  for (int i = 0; i < argc; ++i) {
+    if (i % 2) {
+      b = a + 1;
+    } else {
+      b = a * 2;
+    }
+  }
+  int c = a + b;
+  return c;
+}
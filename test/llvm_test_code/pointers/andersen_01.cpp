@@ -0,0 +1,20 @@
+struct Pair {
+  int *First;
+  int *Second;
+};
+
+static int *identity(int *P) { return P; }
+
+static void assignFirst(Pair *Dst, int *P) { Dst->First = P; }
+
+int main() {
+  int A = 0;
+  int B = 1;
+  Pair Pr;
+  assignFirst(&Pr, &A);
+  Pr.Second = &B;
+  int *(*Fn)(int *) = &identity;
+  int *X = Fn(Pr.First);
+  int *Y = Pr.Second;
+  return *X + *Y;
+}
@@ -0,0 +1,14 @@
+int main(int Argc, char ** /*Argv*/) {
+  int A = 0;
+  int B = 1;
+  int *P = &A;
+  int *Q = &B;
+  int *R = nullptr;
+  // The pointers are copied in a cycle
+  for (int I = 0; I < Argc; ++I) {
+    R = P;
+    P = Q;
+    Q = R;
+  }
+  return *P + *Q + *R;
+}
@@ -0,0 +1,17 @@
+using IdFn = int *(*)(int *);
+using GetterFn = IdFn (*)();
+
+static int *identity(int *P) { return P; }
+
+static IdFn getIdentity() { return &identity; }
+
+int main() {
+  int A = 0;
+  int B = 1;
+  // Each indirect call can only be resolved after the previous one
+  GetterFn Getter = &getIdentity;
+  IdFn Fn = Getter();
+  int *X = Fn(&A);
+  int *Y = &B;
+  return *X + *Y;
+}
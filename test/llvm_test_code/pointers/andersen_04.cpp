@@ -0,0 +1,16 @@
+#include <cstdint>
+
+extern "C" void getPtr(int **Out);
+
+int main() {
+  int A = 0;
+  int B = 1;
+  int *P = &A;
+  // B escapes, so the pointer that is created from the integer may point to it
+  auto Addr = reinterpret_cast<std::uintptr_t>(&B);
+  int *Q = reinterpret_cast<int *>(Addr);
+  // The external function may write any escaped pointer into R
+  int *R = nullptr;
+  getPtr(&R);
+  return *P + *Q + *R;
+}
@@ -14,6 +14,7 @@
 #include "phasar/Controller/AnalysisControllerEmitterOptions.h"
 #include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
 #include "phasar/PhasarLLVM/HelperAnalyses.h"
+#include "phasar/PhasarLLVM/HelperAnalysisConfig.h"
 #include "phasar/PhasarLLVM/Passes/GeneralStatisticsAnalysis.h"
 #include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
 #include "phasar/Pointer/AliasAnalysisType.h"
@@ -111,6 +112,13 @@ cl::opt<AliasAnalysisType> AliasTypeOpt(
 cl::alias AliasTypeAlias("P", cl::aliasopt(AliasTypeOpt),
                          cl::desc("Alias for --alias-analysis"),
                          cl::cat(PsrCat));
+cl::opt<unsigned> PTAThreadsOpt(
+    "pta-threads",
+    cl::desc("Number of threads used to compute the alias sets of all "
+             "functions up front, which happens when emitting the points-to "
+             "info. The alias sets do not depend on it. 0 means one thread per "
+             "available hardware thread"),
+    cl::init(1), cl::cat(PsrCat), cl::Hidden);
 
 cl::opt<CallGraphAnalysisType> CGTypeOpt(
     "call-graph-analysis", cl::desc("Set the call-graph algorithm to be used"),
@@ -203,6 +211,8 @@ PSR_OPTION_FLAG(EmitPTAAsDotOpt, "emit-pta-as-dot",
                 "Emit the points-to information as DOT graph");
 PSR_OPTION_FLAG(EmitPTAAsJsonOpt, "emit-pta-as-json",
                 "Emit the points-to information as json");
+PSR_OPTION_FLAG(EmitPTAAsBinaryOpt, "emit-pta-as-binary",
+                "Emit the points-to information in a compact binary format");
 PSR_OPTION_FLAG(EmitStatsAsJsonOpt, "emit-statistics-as-json",
                 "Emit the statistics information as json");
 PSR_OPTION_FLAG(FollowReturnPastSeedsOpt, "follow-return-past-seeds",
@@ -221,10 +231,34 @@ PSR_OPTION_FLAG(
     "Let the IFDS/IDE Solver record all ESG edges whole solving the dataflow "
     "problem. This can have massive performance impact",
     cl::Hidden);
+PSR_OPTION_FLAG(
+    BottomUpSchedulingOpt, "bottom-up-scheduling",
+    "Let the IDE Solver process the call-graph SCCs callee-first, such that "
+    "procedure summaries are completed before their callers continue",
+    cl::Hidden);
 PSR_OPTION_FLAG(PersistedSummariesOpt, "persisted-summaries",
                 "Let the IFDS/IDE Solver compute persisted procedure summaries "
                 "(Currently not supported)",
                 cl::Hidden);
+cl::opt<size_t> FEFCacheLimitOpt(
+    "fef-cache-limit",
+    cl::desc("Maximum memory (in MiB) the entries of the IFDS/IDE Solver's "
+             "flow- and edge function cache may occupy, not counting the "
+             "shared flow- and edge function objects themselves. Least "
+             "recently used entries are evicted and recomputed on demand. 0 "
+             "means unbounded"),
+    cl::init(0), cl::cat(PsrCat), cl::Hidden);
+cl::opt<size_t> EFNormalizationThresholdOpt(
+    "ef-normalization-threshold",
+    cl::desc("Composition depth above which the IDE Solver lets the analysis "
+             "normalize composed edge functions. 0 means never"),
+    cl::init(0), cl::cat(PsrCat), cl::Hidden);
+cl::opt<std::string> EdgeLogFileOpt(
+    "edge-log-file",
+    cl::desc("Stream the exploded super-graph edges recorded by the IFDS/IDE "
+             "Solver to this file instead of keeping them in memory (requires "
+             "--record-edges)"),
+    cl::cat(PsrCat), cl::Hidden);
 
 cl::opt<std::string>
     LoadPTAFromJsonOpt("load-pta-from-json",
@@ -232,6 +266,12 @@ cl::opt<std::string>
                                 "via emit-pta-as-json from the given file"),
                        cl::cat(PsrCat));
 
+cl::opt<std::string> LoadPTAFromBinaryOpt(
+    "load-pta-from-binary",
+    cl::desc("Load the points-to info previously exported via "
+             "emit-pta-as-binary from the given file"),
+    cl::cat(PsrCat));
+
 cl::opt<std::string> LoadCGFromJsonOpt(
     "load-cg-from-json",
     cl::desc("Load the persisted call-graph previously exported via "
@@ -306,11 +346,11 @@ void validateParamAnalysisConfig() {
   }
 }
 
-void validatePTAJsonFile() {
-  if (!LoadPTAFromJsonOpt.empty() &&
-      !(std::filesystem::exists(LoadPTAFromJsonOpt.getValue()) &&
-        !std::filesystem::is_directory(LoadPTAFromJsonOpt.getValue()))) {
-    llvm::errs() << "Points-to info file '" << LoadPTAFromJsonOpt
+void validatePTAFile(const cl::opt<std::string> &PTAFileOpt) {
+  if (!PTAFileOpt.empty() &&
+      !(std::filesystem::exists(PTAFileOpt.getValue()) &&
+        !std::filesystem::is_directory(PTAFileOpt.getValue()))) {
+    llvm::errs() << "Points-to info file '" << PTAFileOpt
                  << "' does not exist!\n";
     exit(1);
   }
@@ -364,7 +404,8 @@ int main(int Argc, const char **Argv) {
   validateParamCallGraphAnalysis();
   validateSoundnessFlag();
   validateParamAnalysisConfig();
-  validatePTAJsonFile();
+  validatePTAFile(LoadPTAFromJsonOpt);
+  validatePTAFile(LoadPTAFromBinaryOpt);
 
   [[maybe_unused]] auto &PConfig = PhasarConfig::getPhasarConfig();
 
@@ -417,6 +458,9 @@ int main(int Argc, const char **Argv) {
   if (EmitPTAAsJsonOpt) {
     EmitterOptions |= AnalysisControllerEmitterOptions::EmitPTAAsJson;
   }
+  if (EmitPTAAsBinaryOpt) {
+    EmitterOptions |= AnalysisControllerEmitterOptions::EmitPTAAsBinary;
+  }
   if (StatisticsOpt) {
     EmitterOptions |= AnalysisControllerEmitterOptions::EmitStatisticsAsText;
   }
@@ -430,6 +474,11 @@ int main(int Argc, const char **Argv) {
   SolverConfig.setRecordEdges(RecordEdgesOpt || EmitESGAsDotOpt);
   SolverConfig.setComputePersistedSummaries(PersistedSummariesOpt);
   SolverConfig.setEmitESG(EmitESGAsDotOpt);
+  SolverConfig.setBottomUpScheduling(BottomUpSchedulingOpt);
+  SolverConfig.setFlowEdgeFunctionCacheLimit(FEFCacheLimitOpt * 1024 * 1024);
+  SolverConfig.setEdgeFunctionNormalizationThreshold(
+      EFNormalizationThresholdOpt);
+  SolverConfig.setEdgeLogFile(EdgeLogFileOpt);
 
   std::optional<nlohmann::json> PrecomputedAliasSet;
   if (!LoadPTAFromJsonOpt.empty()) {
@@ -448,11 +497,18 @@ int main(int Argc, const char **Argv) {
   }
 
   // setup IRDB as source code manager
-  HelperAnalyses HA(std::move(ModuleOpt.getValue()),
-                    std::move(PrecomputedAliasSet), AliasTypeOpt,
-                    !AnalysisController::needsToEmitPTA(EmitterOptions),
-                    EntryOpt, std::move(PrecomputedCallGraph), CGTypeOpt,
-                    SoundnessOpt, AutoGlobalsOpt);
+  HelperAnalysisConfig HAConfig;
+  HAConfig.PrecomputedPTS = std::move(PrecomputedAliasSet);
+  HAConfig.PrecomputedPTSBinaryFile = LoadPTAFromBinaryOpt.getValue();
+  HAConfig.PTATy = AliasTypeOpt;
+  HAConfig.AllowLazyPTS = !AnalysisController::needsToEmitPTA(EmitterOptions);
+  HAConfig.NumPTSThreads = PTAThreadsOpt;
+  HAConfig.PrecomputedCG = std::move(PrecomputedCallGraph);
+  HAConfig.CGTy = CGTypeOpt;
+  HAConfig.SoundnessLevel = SoundnessOpt;
+  HAConfig.AutoGlobalSupport = AutoGlobalsOpt;
+  HelperAnalyses HA(std::move(ModuleOpt.getValue()), EntryOpt,
+                    std::move(HAConfig));
   if (!HA.getProjectIRDB().isValid()) {
     // Note: Error message has already been printed
     return 1;
@@ -0,0 +1,70 @@
+#include "phasar/ControlFlow/CallGraphSCCs.h"
+
+#include "gtest/gtest.h"
+
+#include <map>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+using CGTy = std::map<int, std::vector<int>>;
+
+CallGraphSCCs<int> computeSCCs(const CGTy &CG) {
+  std::vector<int> Funs;
+  for (const auto &[Fun, Callees] : CG) {
+    Funs.push_back(Fun);
+  }
+  return CallGraphSCCs<int>::compute(
+      Funs, [&CG](int Fun) -> const std::vector<int> & { return CG.at(Fun); });
+}
+} // namespace
+
+TEST(CallGraphSCCsTest, calleesBeforeCallers) {
+  // 0 -> 1 -> 2 -> 3
+  //      1 -> 3
+  CGTy CG = {{0, {1}}, {1, {2, 3}}, {2, {3}}, {3, {}}};
+  auto SCCs = computeSCCs(CG);
+
+  EXPECT_EQ(4U, SCCs.getNumSCCs());
+  EXPECT_LT(SCCs.getSCCIndex(3), SCCs.getSCCIndex(2));
+  EXPECT_LT(SCCs.getSCCIndex(2), SCCs.getSCCIndex(1));
+  EXPECT_LT(SCCs.getSCCIndex(1), SCCs.getSCCIndex(0));
+}
+
+TEST(CallGraphSCCsTest, recursion) {
+  // 0 -> 1 <-> 2 -> 3, 3 -> 3, 0 -> 4
+  CGTy CG = {{0, {1, 4}}, {1, {2}}, {2, {1, 3}}, {3, {3}}, {4, {}}};
+  auto SCCs = computeSCCs(CG);
+
+  EXPECT_EQ(4U, SCCs.getNumSCCs());
+  EXPECT_TRUE(SCCs.inSameSCC(1, 2));
+  EXPECT_FALSE(SCCs.inSameSCC(0, 1));
+  EXPECT_FALSE(SCCs.inSameSCC(2, 3));
+  EXPECT_LT(SCCs.getSCCIndex(3), SCCs.getSCCIndex(1));
+  EXPECT_LT(SCCs.getSCCIndex(1), SCCs.getSCCIndex(0));
+  EXPECT_LT(SCCs.getSCCIndex(4), SCCs.getSCCIndex(0));
+
+  // Unknown functions come last
+  EXPECT_EQ(SCCs.getNumSCCs(), SCCs.getSCCIndex(42));
+}
+
+TEST(CallGraphSCCsTest, deepCallChain) {
+  // Must not overflow the stack
+  constexpr int Depth = 100000;
+  CGTy CG;
+  for (int I = 0; I < Depth; ++I) {
+    CG[I] = {I + 1};
+  }
+  CG[Depth] = {0};
+
+  auto SCCs = computeSCCs(CG);
+  EXPECT_EQ(1U, SCCs.getNumSCCs());
+  EXPECT_EQ(size_t(Depth + 1), SCCs.getNumFunctions());
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,159 @@
+#include "phasar/DataFlow/IfdsIde/Solver/ESGEdgeLog.h"
+
+#include "phasar/DataFlow/IfdsIde/EdgeFunctionUtils.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+using LogTy = ESGEdgeLog<std::string, int, int>;
+using EdgeTy = std::tuple<std::string, int, std::string, int, ESGEdgeKind>;
+
+std::vector<EdgeTy> getEdges(const LogTy &Log) {
+  std::vector<EdgeTy> Ret;
+  Log.foreachEdge([&Ret](const auto &From, int FromFact, const auto &To,
+                         int ToFact, ESGEdgeKind Kind) {
+    Ret.emplace_back(From, FromFact, To, ToFact, Kind);
+  });
+  return Ret;
+}
+} // namespace
+
+TEST(ESGEdgeLogTest, recordsEdgesInOrder) {
+  LogTy Log;
+  Log.saveEdges("a", 0, "b", std::set<int>{0, 1}, ESGEdgeKind::Normal);
+  Log.saveEdges("b", 1, "c", std::set<int>{2}, ESGEdgeKind::Call);
+  Log.saveEdges("c", 2, "d", std::set<int>{}, ESGEdgeKind::Normal);
+  Log.saveEdges("d", 3, "b", std::set<int>{1}, ESGEdgeKind::Ret);
+
+  std::vector<EdgeTy> Expected = {
+      {"a", 0, "b", 0, ESGEdgeKind::Normal},
+      {"a", 0, "b", 1, ESGEdgeKind::Normal},
+      {"b", 1, "c", 2, ESGEdgeKind::Call},
+      {"d", 3, "b", 1, ESGEdgeKind::Ret},
+  };
+  EXPECT_EQ(Expected, getEdges(Log));
+  // Including the kill-record for fact 2 at c --> d
+  EXPECT_EQ(5U, Log.size());
+  EXPECT_EQ(4U, Log.getNumNodes());
+  EXPECT_EQ(4U, Log.getNumFacts());
+
+  // The killed fact is still reported, but without targets
+  auto Intra = Log.getPathEdges(/*InterProc*/ false);
+  ASSERT_TRUE(Intra.contains("c", "d"));
+  const auto &Killed = Intra.get("c", "d");
+  ASSERT_EQ(1U, Killed.count(2));
+  EXPECT_TRUE(Killed.at(2).empty());
+}
+
+TEST(ESGEdgeLogTest, pathEdgesAreDeduplicated) {
+  LogTy Log;
+  Log.saveEdges("a", 0, "b", std::set<int>{0, 1}, ESGEdgeKind::Normal);
+  Log.saveEdges("a", 0, "b", std::set<int>{1, 2}, ESGEdgeKind::CallToRet);
+  Log.saveEdges("a", 0, "c", std::set<int>{3}, ESGEdgeKind::Call);
+  EXPECT_EQ(5U, Log.size());
+
+  auto Intra = Log.getPathEdges(/*InterProc*/ false);
+  ASSERT_TRUE(Intra.contains("a", "b"));
+  EXPECT_FALSE(Intra.contains("a", "c"));
+  EXPECT_EQ((std::set<int>{0, 1, 2}), Intra.get("a", "b").at(0));
+
+  auto Inter = Log.getPathEdges(/*InterProc*/ true);
+  ASSERT_TRUE(Inter.contains("a", "c"));
+  EXPECT_FALSE(Inter.contains("a", "b"));
+  EXPECT_EQ((std::set<int>{3}), Inter.get("a", "c").at(0));
+}
+
+TEST(ESGEdgeLogTest, edgeFunctions) {
+  LogTy Log;
+  Log.saveEdgeFunction("a", 0, "b", 1, AllBottom<int>{1});
+  Log.saveEdgeFunction("b", 1, "c", 1, AllBottom<int>{2});
+  Log.saveEdgeFunction("a", 0, "b", 1, AllBottom<int>{3});
+
+  auto EFs = Log.getEdgeFunctions("a", 0, "b", 1);
+  ASSERT_EQ(2U, EFs.size());
+  EXPECT_EQ(1, EFs[0].computeTarget(0));
+  EXPECT_EQ(3, EFs[1].computeTarget(0));
+
+  EXPECT_EQ(1U, Log.getEdgeFunctions("b", 1, "c", 1).size());
+  EXPECT_TRUE(Log.getEdgeFunctions("a", 0, "c", 1).empty());
+  EXPECT_TRUE(Log.getEdgeFunctions("x", 0, "b", 1).empty());
+}
+
+TEST(ESGEdgeLogTest, spansMultipleChunks) {
+  constexpr int NumEdges = 3 * ESGEdgeRecordBuffer::ChunkSize + 17;
+
+  LogTy Log;
+  for (int I = 0; I != NumEdges; ++I) {
+    Log.saveEdges("a", I, "b", std::set<int>{I + 1}, ESGEdgeKind::Normal);
+  }
+  EXPECT_EQ(size_t(NumEdges), Log.size());
+
+  auto Edges = getEdges(Log);
+  ASSERT_EQ(size_t(NumEdges), Edges.size());
+  for (int I = 0; I != NumEdges; ++I) {
+    EXPECT_EQ(I, std::get<1>(Edges[I]));
+    EXPECT_EQ(I + 1, std::get<3>(Edges[I]));
+  }
+}
+
+TEST(ESGEdgeLogTest, streamToFile) {
+  constexpr int NumEdges = 2 * ESGEdgeRecordBuffer::ChunkSize + 5;
+
+  llvm::SmallString<128> Path;
+  ASSERT_FALSE(
+      llvm::sys::fs::createTemporaryFile("esg-edge-log", "bin", Path));
+
+  LogTy Log;
+  // Edges recorded before streaming starts must not get lost
+  Log.saveEdges("x", -1, "a", std::set<int>{0}, ESGEdgeKind::Call);
+  Log.streamTo(Path);
+  ASSERT_TRUE(Log.getRecords().isStreaming());
+
+  for (int I = 0; I != NumEdges; ++I) {
+    Log.saveEdges("a", I, "b", std::set<int>{I + 1}, ESGEdgeKind::Normal);
+  }
+  EXPECT_EQ(size_t(NumEdges + 1), Log.size());
+  EXPECT_EQ(ESGEdgeRecordBuffer::ChunkSize * sizeof(ESGEdgeRecord),
+            Log.getRecords().getMemoryUsage());
+
+  auto Edges = getEdges(Log);
+  ASSERT_EQ(size_t(NumEdges + 1), Edges.size());
+  EXPECT_EQ(EdgeTy("x", -1, "a", 0, ESGEdgeKind::Call), Edges[0]);
+  for (int I = 0; I != NumEdges; ++I) {
+    EXPECT_EQ(EdgeTy("a", I, "b", I + 1, ESGEdgeKind::Normal), Edges[I + 1]);
+  }
+
+  // The streamed records are read back one chunk at a time
+  size_t MaxRangeSize = 0;
+  Log.getRecords().foreachChunk(
+      [&MaxRangeSize](llvm::ArrayRef<ESGEdgeRecord> Recs) {
+        MaxRangeSize = std::max(MaxRangeSize, Recs.size());
+      });
+  EXPECT_EQ(ESGEdgeRecordBuffer::ChunkSize, MaxRangeSize);
+
+  uint64_t FileSize = 0;
+  ASSERT_FALSE(llvm::sys::fs::file_size(Path, FileSize));
+  // The pre-existing edge and all full chunks have been written out
+  EXPECT_EQ((1 + 2 * ESGEdgeRecordBuffer::ChunkSize) * sizeof(ESGEdgeRecord),
+            FileSize);
+
+  Log.clear();
+  llvm::sys::fs::remove(Path);
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,129 @@
+#include "phasar/DataFlow/IfdsIde/EdgeFunctionAllocator.h"
+
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+template <size_t N> struct BigEdgeFunction {
+  using l_t = int;
+
+  [[nodiscard]] int computeTarget(int /*Source*/) const { return Data[0]; }
+
+  static psr::EdgeFunction<int>
+  compose(psr::EdgeFunctionRef<BigEdgeFunction> This,
+          const psr::EdgeFunction<int> & /*SecondFunction*/) {
+    return This;
+  }
+
+  static psr::EdgeFunction<int>
+  join(psr::EdgeFunctionRef<BigEdgeFunction> This,
+       const psr::EdgeFunction<int> & /*OtherFunction*/) {
+    return This;
+  }
+
+  bool operator==(const BigEdgeFunction &Other) const noexcept {
+    return Data == Other.Data;
+  }
+
+  BigEdgeFunction(int Val, size_t *NumDestroyed = nullptr) noexcept
+      : NumDestroyed(NumDestroyed) {
+    Data[0] = Val;
+  }
+  BigEdgeFunction(const BigEdgeFunction &) = default;
+  ~BigEdgeFunction() {
+    if (NumDestroyed) {
+      ++*NumDestroyed;
+    }
+  }
+
+  std::array<int, N> Data{};
+  size_t *NumDestroyed{};
+};
+} // namespace
+
+using namespace psr;
+
+TEST(EdgeFunctionAllocatorTest, reusesFreedChunks) {
+  using T = std::array<char, 40>;
+  static_assert(EdgeFunctionAllocator::IsPoolable<T>);
+
+  void *Mem1 = EdgeFunctionAllocator::allocate<T>();
+  EdgeFunctionAllocator::deallocate<T>(Mem1);
+  void *Mem2 = EdgeFunctionAllocator::allocate<T>();
+  EXPECT_EQ(Mem1, Mem2);
+  EdgeFunctionAllocator::deallocate<T>(Mem2);
+}
+
+TEST(EdgeFunctionAllocatorTest, distinctLiveChunks) {
+  using T = std::array<char, 24>;
+  std::vector<void *> Chunks;
+  std::set<void *> Unique;
+  // More than one slab-worth of chunks
+  for (size_t I = 0; I != 2 * EdgeFunctionAllocator::SlabSize / 32; ++I) {
+    void *Mem = EdgeFunctionAllocator::allocate<T>();
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(Mem) %
+                      EdgeFunctionAllocator::Granularity);
+    Chunks.push_back(Mem);
+    Unique.insert(Mem);
+  }
+  EXPECT_EQ(Chunks.size(), Unique.size());
+  EXPECT_GE(EdgeFunctionAllocator::getStatistics().NumSlabs, 2U);
+
+  for (void *Mem : Chunks) {
+    EdgeFunctionAllocator::deallocate<T>(Mem);
+  }
+}
+
+TEST(EdgeFunctionAllocatorTest, heapAllocatedEdgeFunctions) {
+  size_t NumDestroyed = 0;
+  {
+    EdgeFunction<int> Small = BigEdgeFunction<4>(42, &NumDestroyed);
+    EdgeFunction<int> Large = BigEdgeFunction<128>(1337, &NumDestroyed);
+    static_assert(EdgeFunctionAllocator::IsPoolable<BigEdgeFunction<4>>);
+    static_assert(!EdgeFunctionAllocator::IsPoolable<BigEdgeFunction<128>>);
+
+    // The temporaries
+    EXPECT_EQ(2U, NumDestroyed);
+    EXPECT_TRUE(Small.isRefCounted());
+    EXPECT_TRUE(Large.isRefCounted());
+    EXPECT_EQ(42, Small.computeTarget(0));
+    EXPECT_EQ(1337, Large.computeTarget(0));
+
+    auto SmallCopy = Small;
+    Small = nullptr;
+    EXPECT_EQ(2U, NumDestroyed);
+    EXPECT_EQ(42, SmallCopy.computeTarget(0));
+  }
+  EXPECT_EQ(4U, NumDestroyed);
+}
+
+TEST(EdgeFunctionAllocatorTest, crossThreadDeallocation) {
+  static constexpr size_t NumEFs = 1000;
+  std::vector<EdgeFunction<int>> EFs;
+  EFs.reserve(NumEFs);
+
+  std::thread Producer([&EFs] {
+    for (size_t I = 0; I != NumEFs; ++I) {
+      EFs.emplace_back(std::in_place_type<BigEdgeFunction<8>>, int(I));
+    }
+  });
+  Producer.join();
+
+  for (size_t I = 0; I != NumEFs; ++I) {
+    EXPECT_EQ(int(I), EFs[I].computeTarget(0));
+  }
+  EFs.clear();
+  EdgeFunctionAllocator::flushThreadCache();
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
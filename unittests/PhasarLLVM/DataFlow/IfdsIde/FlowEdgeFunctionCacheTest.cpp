@@ -0,0 +1,89 @@
+#include "phasar/DataFlow/IfdsIde/Solver/FlowEdgeFunctionCache.h"
+
+#include "phasar/DataFlow/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/HelperAnalyses.h"
+#include "phasar/PhasarLLVM/SimpleAnalysisConstructor.h"
+
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+/// Small enough that every analyzed program exceeds it
+constexpr size_t TinyCacheLimit = 512;
+
+size_t getNumEvictedCacheEntries(const EdgeFunctionStats &Stats) {
+  size_t Ret = 0;
+  for (size_t I = 0; I != EdgeFunctionKindCount; ++I) {
+    Ret += Stats.getNumEvictedCacheEntries(EdgeFunctionKind(I));
+  }
+  return Ret;
+}
+
+class FlowEdgeFunctionCacheTest
+    : public ::testing::TestWithParam<std::string_view> {
+protected:
+  static constexpr auto PathToLlFiles =
+      PHASAR_BUILD_SUBFOLDER("linear_constant/");
+  const std::vector<std::string> EntryPoints = {"main"};
+};
+} // namespace
+
+TEST_P(FlowEdgeFunctionCacheTest, EvictionPreservesResults) {
+  HelperAnalyses HA(PathToLlFiles + GetParam(), EntryPoints);
+  auto &ICFG = HA.getICFG();
+
+  auto LCAProblem = createAnalysisProblem<IDELinearConstantAnalysis>(
+      HA, EntryPoints);
+
+  IDESolver UnboundedSolver(LCAProblem, &ICFG);
+  auto UnboundedResults = UnboundedSolver.solve();
+  auto UnboundedStats = UnboundedSolver.getEdgeFunctionStatistics();
+  EXPECT_EQ(0U, UnboundedStats.getCacheMemoryLimit());
+  EXPECT_EQ(0U, getNumEvictedCacheEntries(UnboundedStats));
+  EXPECT_GT(UnboundedStats.getCacheMemoryUsage(), TinyCacheLimit);
+
+  // The solver picks up the limit from the problem's config on construction
+  LCAProblem.getIFDSIDESolverConfig().setFlowEdgeFunctionCacheLimit(
+      TinyCacheLimit);
+  IDESolver BoundedSolver(LCAProblem, &ICFG);
+  auto BoundedResults = BoundedSolver.solve();
+  auto BoundedStats = BoundedSolver.getEdgeFunctionStatistics();
+  EXPECT_EQ(TinyCacheLimit, BoundedStats.getCacheMemoryLimit());
+  EXPECT_GT(getNumEvictedCacheEntries(BoundedStats), 0U);
+  EXPECT_LE(BoundedStats.getCacheMemoryUsage(), TinyCacheLimit);
+
+  // Evicted flow- and edge functions are recomputed on demand and must yield
+  // the same results
+  auto UnboundedCells = UnboundedResults.getAllResultEntries();
+  auto BoundedCells = BoundedResults.getAllResultEntries();
+  EXPECT_EQ(UnboundedCells.size(), BoundedCells.size());
+  for (const auto &Cell : UnboundedCells) {
+    EXPECT_EQ(Cell.getValue(),
+              BoundedResults.resultAt(Cell.getRowKey(), Cell.getColumnKey()));
+  }
+}
+
+static constexpr std::string_view LCATestFiles[] = {
+    "branch_03_cpp_dbg.ll", "while_02_cpp_dbg.ll",
+    "call_01_cpp_dbg.ll",   "call_05_cpp_dbg.ll",
+    "call_07_cpp_dbg.ll",   "call_11_cpp_dbg.ll",
+    "recursion_01_cpp_dbg.ll",
+};
+
+INSTANTIATE_TEST_SUITE_P(FlowEdgeFunctionCacheTest, FlowEdgeFunctionCacheTest,
+                         ::testing::ValuesIn(LCATestFiles));
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
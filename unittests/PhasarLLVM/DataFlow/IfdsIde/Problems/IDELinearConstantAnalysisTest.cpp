@@ -32,7 +32,9 @@ protected:
   void SetUp() override { ValueAnnotationPass::resetValueID(); }
 
   IDELinearConstantAnalysis::lca_results_t
-  doAnalysis(llvm::StringRef LlvmFilePath, bool PrintDump = false) {
+  doAnalysis(llvm::StringRef LlvmFilePath, bool PrintDump = false,
+             size_t NormalizationThreshold = 0,
+             bool BottomUpScheduling = false) {
     HelperAnalyses HA(PathToLlFiles + LlvmFilePath, EntryPoints);
 
     // Compute the ICFG to possibly create the runtime model
@@ -45,6 +47,10 @@ protected:
         HA,
         std::vector{HasGlobalCtor ? LLVMBasedICFG::GlobalCRuntimeModelName.str()
                                   : "main"});
+    LCAProblem.getIFDSIDESolverConfig().setEdgeFunctionNormalizationThreshold(
+        NormalizationThreshold);
+    LCAProblem.getIFDSIDESolverConfig().setBottomUpScheduling(
+        BottomUpScheduling);
     IDESolver LCASolver(LCAProblem, &ICFG);
     LCASolver.solve();
     if (PrintDump) {
@@ -813,6 +819,97 @@ TEST_F(IDELinearConstantAnalysisTest, HandleModuloByZero) {
   compareResults(Results, GroundTruth);
 }
 
+/* ============== NORMALIZATION TESTS ============== */
+TEST_F(IDELinearConstantAnalysisTest, HandleCallTest_02Normalized) {
+  auto Results = doAnalysis("call_02_cpp_dbg.ll", false, 1);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("_Z3fooi", 1, "a", 2);
+  GroundTruth.emplace("_Z3fooi", 2, "a", 2);
+
+  GroundTruth.emplace("main", 7, "i", 42);
+  GroundTruth.emplace("main", 8, "i", 42);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["main"].find(6) == Results["main"].end());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleRecursionTest_01Normalized) {
+  auto Results = doAnalysis("recursion_01_cpp_dbg.ll", false, 1);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 10, "j", -1);
+  GroundTruth.emplace("main", 11, "j", -1);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["_Z9decrementi"].find(2) ==
+              Results["_Z9decrementi"].end());
+  EXPECT_TRUE(Results["_Z9decrementi"].find(4) ==
+              Results["_Z9decrementi"].end());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleAddOverflowNormalized) {
+  auto Results = doAnalysis("overflow_add_cpp_dbg.ll", false, 1);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 6, "i", 9223372036854775806);
+  compareResults(Results, GroundTruth);
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleMulOverflowNormalized) {
+  auto Results = doAnalysis("overflow_mul_cpp_dbg.ll", false, 1);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 6, "i", 9223372036854775806);
+  compareResults(Results, GroundTruth);
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleCallTest_07BottomUp) {
+  auto Results = doAnalysis("call_07_cpp_dbg.ll", false, 0, true);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 6, "i", 42);
+  GroundTruth.emplace("main", 7, "i", 42);
+  GroundTruth.emplace("main", 7, "j", 43);
+  GroundTruth.emplace("main", 8, "i", 42);
+  GroundTruth.emplace("main", 8, "j", 43);
+  GroundTruth.emplace("main", 8, "k", 44);
+  GroundTruth.emplace("main", 9, "i", 42);
+  GroundTruth.emplace("main", 9, "j", 43);
+  GroundTruth.emplace("main", 9, "k", 44);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["_Z9incrementi"].find(1) ==
+              Results["_Z9incrementi"].end());
+  EXPECT_TRUE(Results["_Z9incrementi"].find(2) ==
+              Results["_Z9incrementi"].end());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleRecursionTest_03BottomUp) {
+  auto Results = doAnalysis("recursion_03_cpp_dbg.ll", false, 0, true);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 9, "a", 1);
+  GroundTruth.emplace("main", 10, "a", 1);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["_Z3fooj"].find(1) == Results["_Z3fooj"].end());
+  EXPECT_TRUE(Results["_Z3fooj"].find(3) == Results["_Z3fooj"].end());
+  EXPECT_TRUE(Results["_Z3fooj"].find(5) == Results["_Z3fooj"].end());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleGlobalsTest_07BottomUp) {
+  // The scheduling order must not affect the results. The IR traces refer to
+  // different modules, so only compare the values.
+  auto GetValues = [](const IDELinearConstantAnalysis::lca_results_t &Res) {
+    std::set<LCACompactResult_t> Ret;
+    for (const auto &[FName, LineToResult] : Res) {
+      for (const auto &[Line, Result] : LineToResult) {
+        for (const auto &[Var, Val] : Result.VariableToValue) {
+          Ret.emplace(FName, Line, Var, Val);
+        }
+      }
+    }
+    return Ret;
+  };
+
+  auto Results = doAnalysis("global_07_cpp_dbg.ll");
+  auto BottomUpResults =
+      doAnalysis("global_07_cpp_dbg.ll", false, 0, /*BottomUpScheduling*/ true);
+  EXPECT_FALSE(GetValues(Results).empty());
+  EXPECT_EQ(GetValues(Results), GetValues(BottomUpResults));
+}
+
 // main function for the test case
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
@@ -0,0 +1,79 @@
+#include "phasar/DataFlow/Mono/Contexts/CallStringCTX.h"
+
+#include "llvm/ADT/DenseMap.h"
+
+#include "gtest/gtest.h"
+
+#include <unordered_set>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+template <unsigned K>
+std::vector<int> getCallString(const CallStringCTX<int, K> &CS) {
+  auto Ref = CS.getCallString();
+  return {Ref.begin(), Ref.end()};
+}
+} // namespace
+
+TEST(CallStringCTXTest, isKLimited) {
+  CallStringCTX<int, 2> CS;
+  EXPECT_TRUE(CS.empty());
+  CS.push_back(1);
+  CS.push_back(2);
+  CS.push_back(3);
+  EXPECT_EQ(2U, CS.size());
+  EXPECT_EQ((std::vector<int>{2, 3}), getCallString(CS));
+
+  EXPECT_EQ(3, CS.pop_back());
+  EXPECT_EQ(2, CS.pop_back());
+  EXPECT_TRUE(CS.empty());
+  EXPECT_EQ(0, CS.pop_back());
+
+  EXPECT_THROW((CallStringCTX<int, 2>{1, 2, 3}), std::runtime_error);
+}
+
+TEST(CallStringCTXTest, equalityAndHash) {
+  CallStringCTX<int, 3> CS1{1, 2};
+  CallStringCTX<int, 3> CS2;
+  CS2.push_back(1);
+  CS2.push_back(2);
+  EXPECT_EQ(CS1, CS2);
+  EXPECT_EQ(CS1.getHash(), CS2.getHash());
+
+  CS2.push_back(3);
+  EXPECT_NE(CS1, CS2);
+  EXPECT_TRUE(CS1 < CS2);
+  EXPECT_EQ(3, CS2.pop_back());
+  EXPECT_EQ(CS1, CS2);
+  EXPECT_EQ(CS1.getHash(), CS2.getHash());
+
+  std::unordered_set<CallStringCTX<int, 3>> Set = {CS1, CS2, {}, {2, 1}};
+  EXPECT_EQ(3U, Set.size());
+}
+
+TEST(CallStringCTXTest, denseMapKey) {
+  llvm::DenseMap<CallStringCTX<int, 2>, int> Map;
+  for (int I = 0; I != 100; ++I) {
+    CallStringCTX<int, 2> CS;
+    CS.push_back(I);
+    CS.push_back(I + 1);
+    Map[CS] = I;
+  }
+  Map[{}] = -1;
+  EXPECT_EQ(101U, Map.size());
+  EXPECT_EQ(42, Map.lookup({42, 43}));
+  EXPECT_EQ(-1, Map.lookup({}));
+  EXPECT_EQ(0U, Map.count({43, 42}));
+
+  Map.erase({42, 43});
+  EXPECT_EQ(0U, Map.count({42, 43}));
+  EXPECT_EQ(100U, Map.size());
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -10,6 +10,7 @@
 #include "phasar/PhasarLLVM/DataFlow/Mono/Problems/IntraMonoFullConstantPropagation.h"
 
 #include "phasar/DataFlow/Mono/Solver/IntraMonoSolver.h"
+#include "phasar/DataFlow/Mono/Solver/ParallelIntraMonoSolver.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
 #include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
 #include "phasar/PhasarLLVM/HelperAnalyses.h"
@@ -20,17 +21,93 @@
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
 
+#include "llvm/IR/InstIterator.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "TestConfig.h"
 #include "gtest/gtest.h"
 
+#include <deque>
 #include <set>
 #include <string>
 #include <tuple>
+#include <utility>
 
 using namespace psr;
 
+namespace {
+/// The FIFO-ordered fixpoint iteration that the IntraMonoSolver used before
+/// it switched to a priority-ordered worklist. Serves as baseline for the
+/// number of iterations.
+template <typename AnalysisDomainTy>
+class FIFOIntraMonoSolver : public IntraMonoSolver<AnalysisDomainTy> {
+  using base_t = IntraMonoSolver<AnalysisDomainTy>;
+  using n_t = typename AnalysisDomainTy::n_t;
+
+public:
+  using base_t::base_t;
+
+  void solve() override {
+    auto &IMProblem = this->IMProblem;
+    auto &Analysis = this->Analysis;
+    const auto *CFG = this->CFG;
+
+    std::deque<std::pair<n_t, n_t>> Worklist;
+    for (const auto &EntryPoint : IMProblem.getEntryPoints()) {
+      const auto *Function =
+          IMProblem.getProjectIRDB()->getFunctionDefinition(EntryPoint);
+      if (!Function) {
+        continue;
+      }
+      auto ControlFlowEdges = CFG->getAllControlFlowEdges(Function);
+      Worklist.insert(Worklist.end(), ControlFlowEdges.begin(),
+                      ControlFlowEdges.end());
+      for (auto Inst : CFG->getAllInstructionsOf(Function)) {
+        Analysis.insert(std::make_pair(Inst, IMProblem.allTop()));
+      }
+    }
+    for (auto &[Node, FlowFacts] : IMProblem.initialSeeds()) {
+      Analysis[Node].insert(FlowFacts.begin(), FlowFacts.end());
+    }
+
+    while (!Worklist.empty()) {
+      auto [Src, Dst] = Worklist.front();
+      Worklist.pop_front();
+      ++NumIterations;
+      auto Out = IMProblem.normalFlow(Src, Analysis[Src]);
+      if (CFG->isBranchTarget(Src, Dst)) {
+        for (auto Pred : CFG->getPredsOf(Dst)) {
+          if (Pred != Src) {
+            Out = IMProblem.merge(Out,
+                                  IMProblem.normalFlow(Pred, Analysis[Pred]));
+          }
+        }
+      }
+      if (!IMProblem.equal_to(Out, Analysis[Dst])) {
+        Analysis[Dst] = Out;
+        for (auto Succ : CFG->getSuccsOf(Dst)) {
+          Worklist.push_back({Dst, Succ});
+        }
+      }
+    }
+    for (auto &[Node, FlowFacts] : Analysis) {
+      FlowFacts = IMProblem.normalFlow(Node, FlowFacts);
+    }
+  }
+
+  [[nodiscard]] size_t getNumFIFOIterations() const noexcept {
+    return NumIterations;
+  }
+
+private:
+  size_t NumIterations = 0;
+};
+
+template <typename ProblemTy>
+FIFOIntraMonoSolver(ProblemTy &)
+    -> FIFOIntraMonoSolver<typename ProblemTy::ProblemAnalysisDomain>;
+} // namespace
+
 /* ============== TEST FIXTURE ============== */
 class IntraMonoFullConstantPropagationTest : public ::testing::Test {
 protected:
@@ -129,6 +206,53 @@ TEST_F(IntraMonoFullConstantPropagationTest, BasicTest_06) {
                               true);
 }
 
+TEST_F(IntraMonoFullConstantPropagationTest, ParallelMatchesSequential) {
+  HelperAnalyses HA(PathToLlFiles + "full_constant/basic_06_cpp.ll",
+                    EntryPoints);
+
+  auto FCP = createAnalysisProblem<IntraMonoFullConstantPropagation>(
+      HA, EntryPoints);
+  IntraMonoSolver IMSolver(FCP);
+  IMSolver.solve();
+
+  ParallelIntraMonoSolver ParSolver(FCP, 2);
+  ParSolver.solve(HA.getProjectIRDB().getAllFunctions(),
+                  [&HA](const llvm::Function *Fun) {
+                    return createAnalysisProblem<
+                        IntraMonoFullConstantPropagation>(
+                        HA, std::vector<std::string>{Fun->getName().str()});
+                  });
+
+  const auto *Main = HA.getProjectIRDB().getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  for (const auto &Inst : llvm::instructions(Main)) {
+    EXPECT_TRUE(IMSolver.getResultsAt(&Inst) == ParSolver.getResultsAt(&Inst))
+        << "Results differ at " << llvmIRToString(&Inst);
+  }
+  // The parallel solver additionally solves all other functions
+  EXPECT_LE(IMSolver.getNumIterations(), ParSolver.getNumIterations());
+}
+
+TEST_F(IntraMonoFullConstantPropagationTest, FewerIterationsThanFIFO) {
+  HelperAnalyses HA(PathToLlFiles + "full_constant/loop_01_cpp.ll",
+                    EntryPoints);
+
+  auto FCP = createAnalysisProblem<IntraMonoFullConstantPropagation>(
+      HA, EntryPoints);
+  IntraMonoSolver IMSolver(FCP);
+  IMSolver.solve();
+  FIFOIntraMonoSolver FIFOSolver(FCP);
+  FIFOSolver.solve();
+
+  const auto *Main = HA.getProjectIRDB().getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  for (const auto &Inst : llvm::instructions(Main)) {
+    EXPECT_TRUE(IMSolver.getResultsAt(&Inst) == FIFOSolver.getResultsAt(&Inst))
+        << "Results differ at " << llvmIRToString(&Inst);
+  }
+  EXPECT_LT(IMSolver.getNumIterations(), FIFOSolver.getNumFIFOIterations());
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
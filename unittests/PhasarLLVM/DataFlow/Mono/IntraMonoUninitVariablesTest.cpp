@@ -11,6 +11,7 @@
 
 #include "phasar/Config/Configuration.h"
 #include "phasar/DataFlow/Mono/Solver/IntraMonoSolver.h"
+#include "phasar/DataFlow/Mono/Solver/ParallelIntraMonoSolver.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedCFG.h"
 #include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
 #include "phasar/PhasarLLVM/HelperAnalyses.h"
@@ -21,6 +22,7 @@
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
 
+#include "llvm/IR/InstIterator.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "TestConfig.h"
@@ -81,6 +83,43 @@ TEST_F(IntraMonoUninitVariablesTest, Basic_02) {
   doAnalysisAndCompareResults("basic_02_cpp.ll", GroundTruth, true);
 }
 
+TEST_F(IntraMonoUninitVariablesTest, ParallelResultsOutliveProblems) {
+  HelperAnalyses HA(PathToLLFiles + "basic_02_cpp.ll", EntryPoints);
+
+  auto Uninit =
+      createAnalysisProblem<IntraMonoUninitVariables>(HA, EntryPoints);
+  IntraMonoSolver Solver(Uninit);
+  Solver.solve();
+
+  // The per-function problems, and with them the problems' fact indices, are
+  // destroyed before solve() returns
+  ParallelIntraMonoSolver ParSolver(Uninit, 2);
+  ParSolver.solve(HA.getProjectIRDB().getAllFunctions(),
+                  [&HA](const llvm::Function *Fun) {
+                    return createAnalysisProblem<IntraMonoUninitVariables>(
+                        HA, std::vector<std::string>{Fun->getName().str()});
+                  });
+  ASSERT_FALSE(ParSolver.getAllResults().empty());
+
+  using FactSetTy = std::set<const llvm::Value *>;
+  const auto *Main = HA.getProjectIRDB().getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  for (const auto &Inst : llvm::instructions(Main)) {
+    auto Expected = Solver.getResultsAt(&Inst);
+    auto Actual = ParSolver.getResultsAt(&Inst);
+    EXPECT_EQ(FactSetTy(Expected.begin(), Expected.end()),
+              FactSetTy(Actual.begin(), Actual.end()))
+        << "Results differ at " << llvmIRToString(&Inst);
+  }
+
+  // Reading the facts of all results must not touch freed memory
+  for (const auto &[Inst, Facts] : ParSolver.getAllResults()) {
+    for (const auto *Fact : Facts) {
+      EXPECT_NE(nullptr, Fact);
+    }
+  }
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
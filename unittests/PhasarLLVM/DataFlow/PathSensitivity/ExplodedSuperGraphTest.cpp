@@ -0,0 +1,211 @@
+#include "phasar/DataFlow/PathSensitivity/ExplodedSuperGraph.h"
+
+#include "phasar/DataFlow/IfdsIde/Solver/ESGEdgeKind.h"
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+
+#include "gtest/gtest.h"
+#include "nlohmann/json.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+struct DomainTy {
+  using n_t = const llvm::Instruction *;
+  using d_t = const llvm::Value *;
+};
+
+using ESGTy = ExplodedSuperGraph<DomainTy>;
+
+class ExplodedSuperGraphTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    Mod = std::make_unique<llvm::Module>("esg", Ctx);
+    auto *I32 = llvm::Type::getInt32Ty(Ctx);
+    auto *Fun = llvm::Function::Create(
+        llvm::FunctionType::get(I32, {I32, I32}, false),
+        llvm::Function::ExternalLinkage, "f", *Mod);
+    auto *Entry = llvm::BasicBlock::Create(Ctx, "entry", Fun);
+    llvm::IRBuilder<> IRB(Entry);
+
+    auto *ArgA = Fun->getArg(0);
+    auto *ArgB = Fun->getArg(1);
+    auto *Add = IRB.CreateAdd(ArgA, ArgB);
+    auto *Add2 = IRB.CreateAdd(Add, ArgA);
+    auto *Ret = IRB.CreateRet(Add2);
+    Insts = {llvm::cast<llvm::Instruction>(Add),
+             llvm::cast<llvm::Instruction>(Add2), Ret};
+    A = ArgA;
+    B = ArgB;
+    Zero = llvm::ConstantInt::get(I32, 0);
+    Facts = {Zero, A, B};
+  }
+
+  /// Creates an ESG where (Insts[2], B) has a neighbor
+  ESGTy buildESG() {
+    ESGTy ESG(Zero);
+    auto Save = [&ESG](const llvm::Instruction *Curr,
+                       const llvm::Value *CurrFact,
+                       const llvm::Instruction *Succ,
+                       const llvm::Value *SuccFact) {
+      ESG.saveEdges(Curr, CurrFact, Succ, std::vector{SuccFact},
+                    ESGEdgeKind::Normal);
+    };
+
+    Save(Insts[0], Zero, Insts[1], A);
+    Save(Insts[0], Zero, Insts[1], B);
+    Save(Insts[1], A, Insts[2], B);
+    Save(Insts[1], B, Insts[2], B);
+    // Already present
+    Save(Insts[1], B, Insts[2], B);
+    return ESG;
+  }
+
+  static void expectSameGraph(const ESGTy &Expected, const ESGTy &Actual) {
+    ASSERT_EQ(Expected.size(), Actual.size());
+    for (auto [Exp, Act] : llvm::zip(Expected.nodes(), Actual.nodes())) {
+      EXPECT_EQ(Exp.id(), Act.id());
+      EXPECT_EQ(Exp.value(), Act.value());
+      EXPECT_EQ(Exp.source(), Act.source());
+      EXPECT_EQ(bool(Exp.predecessor()), bool(Act.predecessor()));
+      if (Exp.predecessor()) {
+        EXPECT_EQ(Exp.predecessor().id(), Act.predecessor().id());
+      }
+
+      std::vector<size_t> ExpNBs;
+      std::vector<size_t> ActNBs;
+      for (auto NB : Exp.neighbors()) {
+        ExpNBs.push_back(NB.id());
+      }
+      for (auto NB : Act.neighbors()) {
+        ActNBs.push_back(NB.id());
+      }
+      EXPECT_EQ(ExpNBs, ActNBs);
+    }
+  }
+
+  llvm::LLVMContext Ctx;
+  std::unique_ptr<llvm::Module> Mod;
+  const llvm::Value *Zero{};
+  const llvm::Value *A{};
+  const llvm::Value *B{};
+  std::vector<const llvm::Instruction *> Insts;
+  std::vector<const llvm::Value *> Facts;
+};
+
+TEST_F(ExplodedSuperGraphTest, FinalizeKeepsNeighbors) {
+  auto ESG = buildESG();
+  ESGTy Unfinalized(ESG);
+  ASSERT_EQ(4U, ESG.size());
+
+  auto Nod = ESG.getNodeOrNull(Insts[2], B);
+  ASSERT_TRUE(Nod);
+  EXPECT_EQ(1U, Nod.getNumNeighbors());
+  EXPECT_EQ(A, Nod.predecessor().value());
+  EXPECT_EQ(B, (*Nod.neighbors().begin()).predecessor().value());
+
+  ESG.finalize();
+  EXPECT_TRUE(ESG.isFinalized());
+  expectSameGraph(Unfinalized, ESG);
+  EXPECT_EQ(Nod, ESG.getNodeOrNull(Insts[2], B));
+
+  // Adding another predecessor after finalization
+  ESG.saveEdges(Insts[1], Zero, Insts[2], std::vector{B}, ESGEdgeKind::Normal);
+  EXPECT_FALSE(ESG.isFinalized());
+  EXPECT_EQ(2U, ESG.getNodeOrNull(Insts[2], B).getNumNeighbors());
+  EXPECT_FALSE(ESG.getNodeOrNull(Insts[0], A));
+}
+
+TEST_F(ExplodedSuperGraphTest, JsonRoundTrip) {
+  auto ESG = buildESG();
+  auto IndexOf = [](const auto &Vec, const auto *Elem) {
+    return std::distance(Vec.begin(), llvm::find(Vec, Elem));
+  };
+
+  auto Serialized = ESG.getAsJson(
+      [&](const llvm::Instruction *Inst) { return IndexOf(Insts, Inst); },
+      [&](const llvm::Value *Fact) { return IndexOf(Facts, Fact); });
+
+  // Go through the textual representation as if the ESG had been loaded from
+  // disk
+  auto Deserialized = ESGTy::fromJson(
+      nlohmann::json::parse(Serialized.dump()),
+      [&](const nlohmann::json &J) { return Insts[J.get<size_t>()]; },
+      [&](const nlohmann::json &J) { return Facts[J.get<size_t>()]; });
+
+  EXPECT_TRUE(Deserialized.isFinalized());
+  EXPECT_EQ(Zero, Deserialized.getZeroValue());
+  expectSameGraph(ESG, Deserialized);
+  for (const auto *Inst : Insts) {
+    for (const auto *Fact : Facts) {
+      auto Expected = ESG.getNodeOrNull(Inst, Fact);
+      auto Actual = Deserialized.getNodeOrNull(Inst, Fact);
+      ASSERT_EQ(bool(Expected), bool(Actual));
+      if (Expected) {
+        EXPECT_EQ(Expected.id(), Actual.id());
+      }
+    }
+  }
+}
+
+TEST_F(ExplodedSuperGraphTest, JsonRejectsInvalidIds) {
+  auto IndexOf = [](const auto &Vec, const auto *Elem) {
+    return std::distance(Vec.begin(), llvm::find(Vec, Elem));
+  };
+  auto Serialized = buildESG().getAsJson(
+      [&](const llvm::Instruction *Inst) { return IndexOf(Insts, Inst); },
+      [&](const llvm::Value *Fact) { return IndexOf(Facts, Fact); });
+
+  auto Load = [this](const nlohmann::json &J) {
+    return ESGTy::fromJson(
+        J,
+        [&](const nlohmann::json &JInst) {
+          return Insts[JInst.get<size_t>()];
+        },
+        [&](const nlohmann::json &JFact) {
+          return Facts[JFact.get<size_t>()];
+        });
+  };
+
+  auto UnknownFact = Serialized;
+  UnknownFact["NodeFacts"][0] = Facts.size();
+  EXPECT_DEATH(Load(UnknownFact), "unknown instruction or flow fact");
+
+  auto UnknownPred = Serialized;
+  UnknownPred["Predecessors"][0] = 42;
+  EXPECT_DEATH(Load(UnknownPred), "non-existing node");
+
+  auto UnknownNeighbor = Serialized;
+  UnknownNeighbor["Neighbors"][0] = 42;
+  EXPECT_DEATH(Load(UnknownNeighbor), "non-existing node");
+
+  auto UnknownVertex = Serialized;
+  UnknownVertex["VertexIds"][0] = 42;
+  EXPECT_DEATH(Load(UnknownVertex), "non-existing node");
+
+  auto UnknownVertexKey = Serialized;
+  UnknownVertexKey["VertexKeys"][0] = uint64_t(Insts.size()) << 32;
+  EXPECT_DEATH(Load(UnknownVertexKey), "unknown instruction or flow fact");
+
+  auto DescendingOffsets = Serialized;
+  DescendingOffsets["NeighborOffsets"][1] = 1;
+  DescendingOffsets["NeighborOffsets"][2] = 0;
+  EXPECT_DEATH(Load(DescendingOffsets), "not ascending");
+}
+
+} // namespace
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
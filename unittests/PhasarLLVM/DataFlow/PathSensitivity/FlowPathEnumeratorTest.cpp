@@ -0,0 +1,122 @@
+#include "phasar/DataFlow/PathSensitivity/FlowPathEnumerator.h"
+
+#include "phasar/Utils/AdjacencyList.h"
+
+#include "llvm/ADT/SmallVector.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace psr;
+
+namespace {
+using GraphTy = AdjacencyList<llvm::SmallVector<int, 0>>;
+using traits_t = GraphTraits<GraphTy>;
+
+/// A reversed DAG with two diamonds (vertex:[node-tag]):
+///   0:[1] -> {2:[4,3], 1:[2]} -> 3:[5] -> {4:[6], 5:[7]} -> 6:[8]
+GraphTy makeDiamonds() {
+  GraphTy G;
+  traits_t::addNode(G, llvm::SmallVector<int, 0>{1});
+  traits_t::addNode(G, llvm::SmallVector<int, 0>{2});
+  traits_t::addNode(G, llvm::SmallVector<int, 0>{4, 3});
+  traits_t::addNode(G, llvm::SmallVector<int, 0>{5});
+  traits_t::addNode(G, llvm::SmallVector<int, 0>{6});
+  traits_t::addNode(G, llvm::SmallVector<int, 0>{7});
+  traits_t::addNode(G, llvm::SmallVector<int, 0>{8});
+  traits_t::addRoot(G, 0);
+  traits_t::addEdge(G, 0, 2);
+  traits_t::addEdge(G, 0, 1);
+  traits_t::addEdge(G, 1, 3);
+  traits_t::addEdge(G, 2, 3);
+  traits_t::addEdge(G, 3, 4);
+  traits_t::addEdge(G, 3, 5);
+  traits_t::addEdge(G, 4, 6);
+  traits_t::addEdge(G, 5, 6);
+  return G;
+}
+
+/// Rejects all paths that contain Forbidden
+struct ForbidNodeFilter {
+  int Forbidden{};
+  llvm::SmallVector<bool> Valid{true};
+
+  void saveState() { Valid.push_back(Valid.back()); }
+  void restoreState() { Valid.pop_back(); }
+  void saveEdge(int /*Prev*/, int Curr) {
+    if (Curr == Forbidden) {
+      Valid.back() = false;
+    }
+  }
+  [[nodiscard]] bool isValid() const { return Valid.back(); }
+  bool saveFinalEdge(int /*Prev*/, int /*Final*/) const { return isValid(); }
+};
+
+template <typename EnumeratorT>
+std::vector<std::vector<int>> collect(EnumeratorT &Enumerator) {
+  std::vector<std::vector<int>> Ret;
+  Enumerator.forEach([&Ret](llvm::ArrayRef<int> Path, const auto & /*F*/) {
+    Ret.emplace_back(Path.begin(), Path.end());
+  });
+  return Ret;
+}
+} // namespace
+
+TEST(FlowPathEnumeratorTest, DepthFirst) {
+  auto G = makeDiamonds();
+  FlowPathEnumerator<GraphTy> Enumerator(G);
+  std::vector<std::vector<int>> Expected = {
+      {1, 3, 4, 5, 6, 8},
+      {1, 3, 4, 5, 7, 8},
+      {1, 2, 5, 6, 8},
+      {1, 2, 5, 7, 8},
+  };
+  EXPECT_EQ(Expected, collect(Enumerator));
+  EXPECT_EQ(4U, Enumerator.getNumPathsEmitted());
+  EXPECT_FALSE(Enumerator.next([](auto &&...) {}));
+}
+
+TEST(FlowPathEnumeratorTest, ShortestFirst) {
+  auto G = makeDiamonds();
+  FlowPathEnumerator<GraphTy> Enumerator(G, 0, {},
+                                         PathEnumerationOrder::ShortestFirst);
+  auto Paths = collect(Enumerator);
+  ASSERT_EQ(4U, Paths.size());
+  for (size_t I = 1; I < Paths.size(); ++I) {
+    EXPECT_LE(Paths[I - 1].size(), Paths[I].size());
+  }
+  EXPECT_EQ(5U, Paths.front().size());
+}
+
+TEST(FlowPathEnumeratorTest, StopsEarlyAndFilters) {
+  auto G = makeDiamonds();
+  FlowPathEnumerator<GraphTy, ForbidNodeFilter> Enumerator(G, 0, {7});
+
+  std::vector<int> First;
+  EXPECT_TRUE(Enumerator.next([&First](llvm::ArrayRef<int> Path, auto &) {
+    First.assign(Path.begin(), Path.end());
+  }));
+  EXPECT_EQ((std::vector<int>{1, 3, 4, 5, 6, 8}), First);
+
+  // The remaining paths must not contain 7
+  EXPECT_EQ((std::vector<std::vector<int>>{{1, 2, 5, 6, 8}}),
+            collect(Enumerator));
+}
+
+TEST(FlowPathEnumeratorTest, NonLeafDeadEndIsFatal) {
+  auto G = makeDiamonds();
+  // Vertex 7 has no successors, but is not the leaf of the DAG
+  traits_t::addNode(G, llvm::SmallVector<int, 0>{9});
+  traits_t::addEdge(G, 3, 7);
+
+  FlowPathEnumerator<GraphTy> Enumerator(G);
+  Enumerator.setLeaf(6);
+  EXPECT_DEATH(collect(Enumerator), "Non-leaf node has no successors!");
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
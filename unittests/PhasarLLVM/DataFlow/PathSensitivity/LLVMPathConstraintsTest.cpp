@@ -0,0 +1,101 @@
+#include "phasar/PhasarLLVM/DataFlow/PathSensitivity/LLVMPathConstraints.h"
+
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+
+#include "gtest/gtest.h"
+#include "z3++.h"
+
+#include <memory>
+
+using namespace psr;
+
+namespace {
+class LLVMPathConstraintsTest : public ::testing::Test {
+protected:
+  /// int f() { int x; if (x > 42) return 1; return 0; }
+  void SetUp() override {
+    Mod = std::make_unique<llvm::Module>("lpc", Ctx);
+    auto *I32 = llvm::Type::getInt32Ty(Ctx);
+    Fun = llvm::Function::Create(llvm::FunctionType::get(I32, false),
+                                 llvm::Function::ExternalLinkage, "f", *Mod);
+    auto *Entry = llvm::BasicBlock::Create(Ctx, "entry", Fun);
+    auto *Then = llvm::BasicBlock::Create(Ctx, "then", Fun);
+    auto *Else = llvm::BasicBlock::Create(Ctx, "else", Fun);
+
+    llvm::IRBuilder<> IRB(Entry);
+    auto *X = IRB.CreateAlloca(I32, nullptr, "x");
+    auto *XVal = IRB.CreateLoad(I32, X);
+    auto *Cmp = IRB.CreateICmpSGT(XVal, IRB.getInt32(42));
+    Load = XVal;
+    Br = IRB.CreateCondBr(Cmp, Then, Else);
+
+    IRB.SetInsertPoint(Then);
+    ThenRet = IRB.CreateRet(IRB.getInt32(1));
+    IRB.SetInsertPoint(Else);
+    ElseRet = IRB.CreateRet(IRB.getInt32(0));
+  }
+
+  llvm::LLVMContext Ctx;
+  std::unique_ptr<llvm::Module> Mod;
+  llvm::Function *Fun{};
+  const llvm::Instruction *Load{};
+  const llvm::Instruction *Br{};
+  const llvm::Instruction *ThenRet{};
+  const llvm::Instruction *ElseRet{};
+};
+
+TEST_F(LLVMPathConstraintsTest, MemoizesEdgeConstraints) {
+  LLVMPathConstraints LPC;
+
+  auto ThenConstr = LPC.getConstraintFromEdge(Br, ThenRet);
+  ASSERT_TRUE(ThenConstr.has_value());
+  auto ThenAgain = LPC.getConstraintFromEdge(Br, ThenRet);
+  ASSERT_TRUE(ThenAgain.has_value());
+  EXPECT_TRUE(z3::eq(*ThenConstr, *ThenAgain));
+
+  auto ElseConstr = LPC.getConstraintAndVariablesFromEdge(Br, ElseRet);
+  ASSERT_TRUE(ElseConstr.has_value());
+  EXPECT_EQ(1U, ElseConstr->Variables.size());
+
+  // Not a conditional branch
+  EXPECT_FALSE(LPC.getConstraintFromEdge(Load, Br).has_value());
+
+  const auto &Stats = LPC.getStatistics();
+  EXPECT_EQ(4U, Stats.NumEdgeQueries);
+  EXPECT_EQ(2U, Stats.NumEdgeTranslations);
+  EXPECT_EQ(1U, Stats.NumEdgeCacheHits);
+
+  // Both branches at the same time are infeasible
+  z3::solver Solver(LPC.getContext());
+  Solver.add(*ThenConstr);
+  Solver.add(ElseConstr->Constraint);
+  EXPECT_EQ(z3::unsat, Solver.check());
+}
+
+TEST_F(LLVMPathConstraintsTest, InvalidatesFunction) {
+  LLVMPathConstraints LPC;
+  ASSERT_TRUE(LPC.getConstraintFromEdge(Br, ThenRet).has_value());
+  ASSERT_TRUE(LPC.getConstraintFromEdge(Br, ThenRet).has_value());
+  EXPECT_EQ(1U, LPC.getStatistics().NumEdgeTranslations);
+
+  LPC.invalidate(Fun);
+  ASSERT_TRUE(LPC.getConstraintFromEdge(Br, ThenRet).has_value());
+  EXPECT_EQ(2U, LPC.getStatistics().NumEdgeTranslations);
+
+  LPC.invalidateAll();
+  ASSERT_TRUE(LPC.getConstraintFromEdge(Br, ThenRet).has_value());
+  EXPECT_EQ(3U, LPC.getStatistics().NumEdgeTranslations);
+  EXPECT_EQ(1U, LPC.getStatistics().NumEdgeCacheHits);
+}
+} // namespace
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
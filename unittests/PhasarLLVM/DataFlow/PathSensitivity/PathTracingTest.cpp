@@ -31,13 +31,23 @@
 #include "gtest/gtest.h"
 
 #include <cassert>
+#include <cstdint>
 #include <fstream>
 #include <memory>
 #include <new>
 #include <string>
 #include <system_error>
+#include <vector>
 
 namespace {
+struct LambdaAnalysisConfig {
+  size_t MaxDAGDepth = SIZE_MAX;
+  unsigned NumThreads = 1;
+  size_t MaxNumPaths = SIZE_MAX;
+  /// Whether to compute the paths through pathsStreamTo() instead of pathsTo()
+  bool Lazy = false;
+};
+
 // ============== TEST FIXTURE ============== //
 class PathTracingTest : public ::testing::Test {
 public:
@@ -111,7 +121,7 @@ protected:
 
   psr::FlowPathSequence<const llvm::Instruction *>
   doLambdaAnalysis(const std::string &LlvmFilePath,
-                   size_t MaxDAGDepth = SIZE_MAX) {
+                   const LambdaAnalysisConfig &LAConfig = {}) {
     IRDB = std::make_unique<psr::LLVMProjectIRDB>(PathToLlFiles + LlvmFilePath);
     psr::LLVMTypeHierarchy TH(*IRDB);
     psr::LLVMAliasSet PT(IRDB.get());
@@ -138,12 +148,38 @@ protected:
 
     psr::Z3BasedPathSensitivityManager<psr::IDEExtendedTaintAnalysisDomain> PSM(
         &Solver.getExplicitESG(),
-        psr::Z3BasedPathSensitivityConfig().withDAGDepthThreshold(MaxDAGDepth),
+        psr::Z3BasedPathSensitivityConfig()
+            .withDAGDepthThreshold(LAConfig.MaxDAGDepth)
+            .withNumPathsThreshold(LAConfig.MaxNumPaths)
+            .withNumThreads(LAConfig.NumThreads),
         &LPC);
 
+    if (LAConfig.Lazy) {
+      psr::FlowPathSequence<const llvm::Instruction *> Ret;
+      auto Stream = PSM.pathsStreamTo(LastInst, Analysis.getZeroValue());
+      while (auto Path = Stream.next()) {
+        Ret.push_back(std::move(*Path));
+      }
+      return Ret;
+    }
     return PSM.pathsTo(LastInst, Analysis.getZeroValue());
   }
 
+  /// The paths to the end of main in inter_05_cpp.ll when only considering
+  /// the last 3 levels of the DAG
+  static std::vector<std::vector<unsigned>> lambdaInterDepth3_05GroundTruth() {
+    return {
+        {44, 45, 46, 47, 0,  1,  2,  3,  4,  5,  6,  7,
+         8,  9,  10, 13, 14, 48, 49, 50, 51, 52, 55, 56},
+        {44, 45, 46, 47, 0,  1,  2,  3,  4,  5,  6,  7,  8,
+         9,  10, 13, 14, 48, 49, 50, 51, 52, 53, 54, 55, 56},
+        {44, 45, 46, 47, 0,  1,  2,  3,  4,  5,  6, 7,
+         11, 12, 13, 14, 48, 49, 50, 51, 52, 55, 56},
+        {44, 45, 46, 47, 0,  1,  2,  3,  4,  5,  6,  7, 11,
+         12, 13, 14, 48, 49, 50, 51, 52, 53, 54, 55, 56},
+    };
+  }
+
   void comparePaths(
       const psr::FlowPathSequence<const llvm::Instruction *> &AnalyzedPaths,
       const std::vector<std::vector<unsigned>> &GroundTruth) {
@@ -331,18 +367,59 @@ TEST_F(PathTracingTest, Lambda_Inter_Depth3_05) {
   // psr::Logger::initializeStderrLogger(psr::SeverityLevel::DEBUG,
   // "PathSensitivityManager");
   /// We have 4 branches ==> 16 paths
-  auto PathsVec = doLambdaAnalysis("inter_05_cpp.ll", /*MaxDAGDepth*/ 3);
-  comparePaths(PathsVec,
-               {
-                   {44, 45, 46, 47, 0,  1,  2,  3,  4,  5,  6,  7,
-                    8,  9,  10, 13, 14, 48, 49, 50, 51, 52, 55, 56},
-                   {44, 45, 46, 47, 0,  1,  2,  3,  4,  5,  6,  7,  8,
-                    9,  10, 13, 14, 48, 49, 50, 51, 52, 53, 54, 55, 56},
-                   {44, 45, 46, 47, 0,  1,  2,  3,  4,  5,  6, 7,
-                    11, 12, 13, 14, 48, 49, 50, 51, 52, 55, 56},
-                   {44, 45, 46, 47, 0,  1,  2,  3,  4,  5,  6,  7, 11,
-                    12, 13, 14, 48, 49, 50, 51, 52, 53, 54, 55, 56},
-               });
+  LambdaAnalysisConfig LAConfig;
+  LAConfig.MaxDAGDepth = 3;
+  auto PathsVec = doLambdaAnalysis("inter_05_cpp.ll", LAConfig);
+  comparePaths(PathsVec, lambdaInterDepth3_05GroundTruth());
+}
+
+TEST_F(PathTracingTest, Lambda_Inter_Depth3_05_Parallel) {
+  /// Same as Lambda_Inter_Depth3_05, but with the roots of the DAG being
+  /// distributed over multiple threads
+  LambdaAnalysisConfig LAConfig;
+  LAConfig.MaxDAGDepth = 3;
+  LAConfig.NumThreads = 4;
+  auto PathsVec = doLambdaAnalysis("inter_05_cpp.ll", LAConfig);
+  comparePaths(PathsVec, lambdaInterDepth3_05GroundTruth());
+}
+
+TEST_F(PathTracingTest, Lambda_Inter_Depth3_05_ParallelThreshold) {
+  /// Limiting the number of paths must keep the same paths, no matter on how
+  /// many threads the roots of the DAG are distributed
+  auto GetPathIds = [](const auto &Paths) {
+    std::vector<std::vector<unsigned>> Ret;
+    for (const auto &Path : Paths) {
+      auto &Ids = Ret.emplace_back();
+      for (const auto *Inst : Path) {
+        Ids.push_back(std::stoul(psr::getMetaDataID(Inst)));
+      }
+    }
+    return Ret;
+  };
+
+  LambdaAnalysisConfig LAConfig;
+  LAConfig.MaxDAGDepth = 3;
+  LAConfig.MaxNumPaths = 5;
+  auto Expected = GetPathIds(doLambdaAnalysis("inter_05_cpp.ll", LAConfig));
+  EXPECT_EQ(5U, Expected.size());
+
+  for (unsigned NumThreads : {2, 3, 4}) {
+    // The IRDB is re-created, so the memoized constraints are stale
+    LPC.invalidateAll();
+    LAConfig.NumThreads = NumThreads;
+    EXPECT_EQ(Expected,
+              GetPathIds(doLambdaAnalysis("inter_05_cpp.ll", LAConfig)))
+        << "With " << NumThreads << " threads";
+  }
+}
+
+TEST_F(PathTracingTest, Lambda_Inter_Depth3_05_Lazy) {
+  /// Same as Lambda_Inter_Depth3_05, but enumerating the paths one at a time
+  LambdaAnalysisConfig LAConfig;
+  LAConfig.MaxDAGDepth = 3;
+  LAConfig.Lazy = true;
+  auto PathsVec = doLambdaAnalysis("inter_05_cpp.ll", LAConfig);
+  comparePaths(PathsVec, lambdaInterDepth3_05GroundTruth());
 }
 
 TEST_F(PathTracingTest, Handle_Inter_06) {
@@ -406,7 +483,9 @@ TEST_F(PathTracingTest, Lambda_Inter_07) {
 TEST_F(PathTracingTest, Lambda_Inter_Depth3_07) {
   // psr::Logger::initializeStderrLogger(psr::SeverityLevel::DEBUG,
   // "PathSensitivityManager");
-  auto PathsVec = doLambdaAnalysis("inter_07_cpp.ll", /*MaxDAGDepth*/ 3);
+  LambdaAnalysisConfig LAConfig;
+  LAConfig.MaxDAGDepth = 3;
+  auto PathsVec = doLambdaAnalysis("inter_07_cpp.ll", LAConfig);
   comparePaths(PathsVec, {
                              {0, 1, 2, 3, 4, 5, 6, 7, 40, 41, 49, 50},
                              {0, 1, 2, 3, 4, 5, 6, 7, 47, 48, 49, 50},
@@ -0,0 +1,133 @@
+#include "phasar/PhasarLLVM/DataFlow/PathSensitivity/Z3ConstraintCache.h"
+
+#include "gtest/gtest.h"
+#include "nlohmann/json.hpp"
+#include "z3++.h"
+
+using namespace psr;
+
+TEST(Z3ConstraintCacheTest, RecordsOutcomes) {
+  z3::context Ctx;
+  auto X = Ctx.int_const("x");
+  Z3ConstraintCache Cache;
+
+  z3::solver Solver(Ctx);
+  Solver.add(X > 0);
+  Solver.add(X < 10);
+  EXPECT_EQ(z3::sat, Cache.check(Solver));
+  EXPECT_EQ(0U, Cache.getNumHits());
+
+  // The same set of constraints in a different order and shape
+  z3::solver Solver2(Ctx);
+  Solver2.add(X < 10 && X > 0);
+  EXPECT_EQ(z3::sat, Cache.check(Solver2));
+  EXPECT_EQ(1U, Cache.getNumHits());
+
+  // Requiring a model forces a solver invocation
+  EXPECT_EQ(z3::sat, Cache.check(Solver2, /*RequireModel*/ true));
+  EXPECT_EQ(1U, Cache.getNumHits());
+  auto Val = Solver2.get_model().eval(X, true).get_numeral_int();
+  EXPECT_GT(Val, 0);
+  EXPECT_LT(Val, 10);
+}
+
+TEST(Z3ConstraintCacheTest, PrunesExtensionsOfUnsatCores) {
+  z3::context Ctx;
+  auto X = Ctx.int_const("x");
+  auto Y = Ctx.int_const("y");
+  Z3ConstraintCache Cache;
+
+  z3::solver Solver(Ctx);
+  Solver.add(Y == 3);
+  Solver.add(X > 5);
+  Solver.add(X < 2);
+  EXPECT_EQ(z3::unsat, Cache.check(Solver));
+  // The core does not contain the unrelated constraint on y
+  EXPECT_EQ(1U, Cache.getNumCores());
+
+  z3::solver Solver2(Ctx);
+  Solver2.add(X < 2);
+  Solver2.add(Y > 42);
+  Solver2.add(X > 5);
+  EXPECT_EQ(z3::unsat, Cache.check(Solver2));
+  EXPECT_EQ(1U, Cache.getNumCoreHits());
+
+  Solver2.reset();
+  Solver2.add(X < 2);
+  Solver2.add(Y > 42);
+  EXPECT_EQ(z3::sat, Cache.check(Solver2));
+  EXPECT_EQ(1U, Cache.getNumCoreHits());
+}
+
+TEST(Z3ConstraintCacheTest, PersistsAcrossContexts) {
+  nlohmann::json Serialized;
+  {
+    z3::context Ctx;
+    auto X = Ctx.int_const("x");
+    Z3ConstraintCache Cache;
+    z3::solver Solver(Ctx);
+    Solver.add(X > 5 && X < 2);
+    EXPECT_EQ(z3::unsat, Cache.check(Solver));
+    Serialized = Cache.getAsJson();
+  }
+
+  z3::context Ctx;
+  auto X = Ctx.int_const("x");
+  Z3ConstraintCache Cache(Serialized);
+  EXPECT_EQ(1U, Cache.getNumEntries());
+
+  z3::solver Solver(Ctx);
+  Solver.add(X < 2);
+  Solver.add(X > 5);
+  EXPECT_EQ(z3::unsat, Cache.check(Solver));
+  EXPECT_EQ(1U, Cache.getNumHits());
+}
+
+TEST(Z3ConstraintCacheTest, DistinguishesAllDifferentConjuncts) {
+  z3::context Ctx;
+  auto X = Ctx.int_const("x");
+  auto Y = Ctx.int_const("y");
+  Z3ConstraintCache Cache;
+
+  z3::solver Solver(Ctx);
+  Solver.add(X > 5 && X < 2);
+  EXPECT_EQ(z3::unsat, Cache.check(Solver));
+  EXPECT_EQ(2U, Cache.getNumAtoms());
+
+  // Only structurally equal conjuncts share an atom; a similar, but different
+  // constraint must be checked by the solver
+  z3::solver Solver2(Ctx);
+  Solver2.add(Y > 5 && X < 2);
+  EXPECT_EQ(z3::sat, Cache.check(Solver2));
+  EXPECT_EQ(3U, Cache.getNumAtoms());
+  EXPECT_EQ(0U, Cache.getNumHits());
+  EXPECT_EQ(0U, Cache.getNumCoreHits());
+}
+
+TEST(Z3ConstraintCacheTest, RejectsInvalidSerializedCache) {
+  nlohmann::json Serialized;
+  {
+    z3::context Ctx;
+    auto X = Ctx.int_const("x");
+    Z3ConstraintCache Cache;
+    z3::solver Solver(Ctx);
+    Solver.add(X > 5 && X < 2);
+    EXPECT_EQ(z3::unsat, Cache.check(Solver));
+    Serialized = Cache.getAsJson();
+  }
+  ASSERT_EQ(2U, Serialized["Atoms"].size());
+
+  auto UnknownAtom = Serialized;
+  UnknownAtom["Unsat"][0][0] = 2;
+  EXPECT_DEATH(Z3ConstraintCache{UnknownAtom}, "unknown atom");
+
+  auto DuplicateAtom = Serialized;
+  DuplicateAtom["Atoms"][1] = DuplicateAtom["Atoms"][0];
+  EXPECT_DEATH(Z3ConstraintCache{DuplicateAtom}, "Duplicate atom");
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,104 @@
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasGraph.h"
+
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/IR/InstIterator.h"
+
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+using namespace psr;
+
+namespace {
+/// All pointers of the function definitions in IRDB
+llvm::SmallVector<const llvm::Value *>
+getPointers(const LLVMProjectIRDB &IRDB) {
+  llvm::SmallVector<const llvm::Value *> Pointers;
+  for (const auto *F : IRDB.getAllFunctions()) {
+    if (F->isDeclaration()) {
+      continue;
+    }
+    for (const auto &Arg : F->args()) {
+      if (Arg.getType()->isPointerTy()) {
+        Pointers.push_back(&Arg);
+      }
+    }
+    for (const auto &I : llvm::instructions(F)) {
+      if (I.getType()->isPointerTy()) {
+        Pointers.push_back(&I);
+      }
+    }
+  }
+  return Pointers;
+}
+
+class LLVMAliasGraphTest : public ::testing::TestWithParam<std::string> {
+protected:
+  void SetUp() override { ValueAnnotationPass::resetValueID(); }
+};
+} // namespace
+
+TEST_P(LLVMAliasGraphTest, FrozenGraphYieldsSameResults) {
+  LLVMProjectIRDB IRDB(unittest::PathToLLTestFiles + GetParam());
+  ASSERT_TRUE(IRDB.isValid());
+
+  LLVMAliasGraph Graph(IRDB, false);
+  LLVMAliasGraph FrozenGraph(IRDB, false);
+  FrozenGraph.freeze();
+  ASSERT_TRUE(FrozenGraph.isFrozen());
+
+  auto Pointers = getPointers(IRDB);
+  ASSERT_FALSE(Pointers.empty());
+  for (const auto *P : Pointers) {
+    EXPECT_EQ(*Graph.getAliasSet(P), *FrozenGraph.getAliasSet(P));
+    EXPECT_EQ(*Graph.getReachableAllocationSites(P),
+              *FrozenGraph.getReachableAllocationSites(P));
+  }
+  for (const auto *P1 : Pointers) {
+    for (const auto *P2 : Pointers) {
+      EXPECT_EQ(Graph.alias(P1, P2), FrozenGraph.alias(P1, P2));
+    }
+  }
+
+  // All queried functions have been analyzed by freeze() already
+  EXPECT_TRUE(FrozenGraph.isFrozen());
+  EXPECT_EQ(Graph.getNumVertices(), FrozenGraph.getNumVertices());
+  EXPECT_EQ(Graph.getNumEdges(), FrozenGraph.getNumEdges());
+}
+
+TEST_P(LLVMAliasGraphTest, IntroduceAliasThawsGraph) {
+  LLVMProjectIRDB IRDB(unittest::PathToLLTestFiles + GetParam());
+  ASSERT_TRUE(IRDB.isValid());
+
+  LLVMAliasGraph Graph(IRDB, false);
+  Graph.freeze();
+  auto Pointers = getPointers(IRDB);
+  ASSERT_FALSE(Pointers.empty());
+  const auto *First = Pointers.front();
+  const auto *Last = Pointers.back();
+
+  Graph.introduceAlias(First, Last);
+  EXPECT_FALSE(Graph.isFrozen());
+  EXPECT_TRUE(Graph.getAliasSet(First)->count(Last));
+
+  Graph.freeze();
+  EXPECT_TRUE(Graph.isFrozen());
+  EXPECT_TRUE(Graph.getAliasSet(Last)->count(First));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    LLVMAliasGraphTest, LLVMAliasGraphTest,
+    ::testing::Values("pointers/basic_01_cpp.ll", "pointers/call_01_cpp.ll",
+                      "pointers/dynamic_01_cpp.ll",
+                      "pointers/global_01_cpp.ll",
+                      "pointers/inter_dynamic_01_cpp.ll"));
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -8,6 +8,7 @@
 
 #include "llvm/ADT/StringRef.h"
 #include "llvm/IR/InstIterator.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "TestConfig.h"
@@ -15,6 +16,7 @@
 #include "nlohmann/json.hpp"
 
 #include <cstdlib>
+#include <string>
 
 using namespace psr;
 
@@ -89,6 +91,18 @@ static void analyze(llvm::StringRef File, const GroundTruthTy &Gt,
 
   LLVMAliasSet Deser(&IRDB, Ser);
   checkDeser(*IRDB.getModule(), PTS, Deser);
+
+  std::string BinSer;
+  llvm::raw_string_ostream BinOS(BinSer);
+  PTS.printAsBinary(BinOS);
+  BinOS.flush();
+
+  LLVMAliasSet BinDeser(&IRDB, llvm::MemoryBuffer::getMemBufferCopy(BinSer));
+  EXPECT_FALSE(BinDeser.empty());
+  // Before any query, the alias sets are only stored in the binary image
+  checkSer(BinDeser.getAsJson(), Gt);
+  checkDeser(*IRDB.getModule(), PTS, BinDeser);
+  checkSer(BinDeser.getAsJson(), Gt);
 }
 
 TEST(LLVMAliasSetSerializationTest, Ser_Intra01) {
@@ -112,6 +126,69 @@ TEST(LLVMAliasSetSerializationTest, Ser_Global01) {
             "main"}});
 }
 
+static std::string getBinaryAliasSets(llvm::StringRef File) {
+  ValueAnnotationPass::resetValueID();
+  LLVMProjectIRDB IRDB(unittest::PathToLLTestFiles + File);
+  LLVMAliasSet PTS(&IRDB, false);
+
+  std::string BinSer;
+  llvm::raw_string_ostream BinOS(BinSer);
+  PTS.printAsBinary(BinOS);
+  BinOS.flush();
+  return BinSer;
+}
+
+/// Expects that the alias sets loaded from BinSer are ignored and computed on
+/// the fly instead
+static void checkRecomputed(LLVMProjectIRDB &IRDB, llvm::StringRef BinSer) {
+  LLVMAliasSet BinDeser(&IRDB, llvm::MemoryBuffer::getMemBufferCopy(BinSer));
+  EXPECT_TRUE(BinDeser.empty());
+
+  LLVMAliasSet OnTheFly(&IRDB);
+  checkDeser(*IRDB.getModule(), OnTheFly, BinDeser);
+  EXPECT_FALSE(BinDeser.empty());
+}
+
+TEST(LLVMAliasSetSerializationTest, BinaryFallback) {
+  Logger::disable();
+  auto BinSer = getBinaryAliasSets("pointers/call_01_cpp.ll");
+  auto OtherBinSer = getBinaryAliasSets("pointers/basic_01_cpp.ll");
+
+  ValueAnnotationPass::resetValueID();
+  LLVMProjectIRDB IRDB(unittest::PathToLLTestFiles + "pointers/call_01_cpp.ll");
+  ASSERT_TRUE(IRDB.isValid());
+
+  {
+    SCOPED_TRACE("Truncated header");
+    checkRecomputed(IRDB, llvm::StringRef(BinSer).take_front(16));
+  }
+  {
+    SCOPED_TRACE("Truncated alias sets");
+    checkRecomputed(IRDB, llvm::StringRef(BinSer).drop_back());
+  }
+  {
+    SCOPED_TRACE("Wrong magic");
+    auto WrongMagic = BinSer;
+    WrongMagic[0] ^= 0xff;
+    checkRecomputed(IRDB, WrongMagic);
+  }
+  {
+    SCOPED_TRACE("Other module");
+    checkRecomputed(IRDB, OtherBinSer);
+  }
+  {
+    SCOPED_TRACE("Renamed function");
+    ValueAnnotationPass::resetValueID();
+    LLVMProjectIRDB Renamed(unittest::PathToLLTestFiles +
+                            "pointers/call_01_cpp.ll");
+    ASSERT_TRUE(Renamed.isValid());
+    auto *Main = Renamed.getModule()->getFunction("main");
+    ASSERT_NE(nullptr, Main);
+    Main->setName("renamed_main");
+    checkRecomputed(Renamed, BinSer);
+  }
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
@@ -6,12 +6,174 @@
 #include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
+
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/InstIterator.h"
 
 #include "TestConfig.h"
 #include "gtest/gtest.h"
 
 using namespace psr;
 
+namespace {
+/// Compares the alias sets of all pointers in M
+void expectSameAliasSets(LLVMAliasSet &Actual, LLVMAliasSet &Expected,
+                         const llvm::Module &M) {
+  auto Compare = [&](const llvm::Value *V) {
+    if (isInterestingPointer(V)) {
+      EXPECT_EQ(*Expected.getAliasSet(V), *Actual.getAliasSet(V))
+          << "Different alias sets for " << llvmIRToString(V);
+    }
+  };
+  for (const auto &G : M.globals()) {
+    Compare(&G);
+  }
+  for (const auto &F : M) {
+    for (const auto &Arg : F.args()) {
+      Compare(&Arg);
+    }
+    for (const auto &I : llvm::instructions(F)) {
+      Compare(&I);
+    }
+  }
+}
+
+/// Creates void @Name(i32* %P) in M, whose body is created by BuildBody
+template <typename BodyBuilderT>
+llvm::Function *createFunction(llvm::Module &M, llvm::StringRef Name,
+                               BodyBuilderT BuildBody) {
+  auto &Ctx = M.getContext();
+  auto *FTy = llvm::FunctionType::get(llvm::Type::getVoidTy(Ctx),
+                                      {llvm::Type::getInt32PtrTy(Ctx)}, false);
+  auto *F = llvm::Function::Create(FTy, llvm::GlobalValue::ExternalLinkage,
+                                   Name, M);
+  llvm::IRBuilder<> IRB(llvm::BasicBlock::Create(Ctx, "entry", F));
+  BuildBody(IRB, F->getArg(0));
+  IRB.CreateRetVoid();
+  return F;
+}
+
+/// Creates i32* @Name(i32* %P) in M, which returns the value created by
+/// BuildBody
+template <typename BodyBuilderT>
+llvm::Function *createPtrFunction(llvm::Module &M, llvm::StringRef Name,
+                                  BodyBuilderT BuildBody) {
+  auto *PtrTy = llvm::Type::getInt32PtrTy(M.getContext());
+  auto *FTy = llvm::FunctionType::get(PtrTy, {PtrTy}, false);
+  auto *F = llvm::Function::Create(FTy, llvm::GlobalValue::ExternalLinkage,
+                                   Name, M);
+  llvm::IRBuilder<> IRB(llvm::BasicBlock::Create(M.getContext(), "entry", F));
+  IRB.CreateRet(BuildBody(IRB, F->getArg(0)));
+  return F;
+}
+
+/// Tests that inserting and changing functions incrementally yields the same
+/// alias sets as re-computing them for the changed module
+void testIncrementalUpdate(AliasAnalysisType PATy) {
+  ValueAnnotationPass::resetValueID();
+  LLVMProjectIRDB IRDB(unittest::PathToLLTestFiles + "pointers/call_01_cpp.ll");
+  ASSERT_TRUE(IRDB.isValid());
+  auto &M = *IRDB.getModule();
+  auto &Ctx = M.getContext();
+  auto *PtrTy = llvm::Type::getInt32PtrTy(Ctx);
+
+  LLVMAliasSet PTS(&IRDB, false, PATy);
+
+  // @Glob = internal global i32* null, which is written by @writer() and
+  // read by @reader()
+  auto *Glob = new llvm::GlobalVariable(
+      M, PtrTy, false, llvm::GlobalValue::InternalLinkage,
+      llvm::ConstantPointerNull::get(PtrTy), "Glob");
+  auto *Writer = createFunction(
+      M, "writer", [Glob](llvm::IRBuilder<> &IRB, llvm::Value * /*P*/) {
+        IRB.CreateStore(IRB.CreateAlloca(IRB.getInt32Ty()), Glob);
+      });
+  IRDB.insertFunction(Writer);
+  PTS.insertFunction(Writer);
+
+  const llvm::Value *Read{};
+  auto *Reader = createFunction(
+      M, "reader",
+      [Glob, PtrTy, &Read](llvm::IRBuilder<> &IRB, llvm::Value * /*P*/) {
+        Read = IRB.CreateLoad(PtrTy, Glob);
+      });
+  IRDB.insertFunction(Reader);
+  PTS.insertFunction(Reader);
+
+  {
+    LLVMAliasSet Fresh(&IRDB, false, PATy);
+    expectSameAliasSets(PTS, Fresh, M);
+    EXPECT_EQ(AliasResult::MayAlias,
+              PTS.alias(&Writer->getEntryBlock().front(), Read));
+  }
+
+  // Replace the body of @writer, such that its local does not escape anymore
+  PTS.eraseFunction(Writer);
+  Writer->getEntryBlock().eraseFromParent();
+  llvm::IRBuilder<> IRB(llvm::BasicBlock::Create(Ctx, "entry", Writer));
+  auto *Local = IRB.CreateAlloca(IRB.getInt32Ty());
+  IRB.CreateStore(Local, IRB.CreateAlloca(PtrTy));
+  IRB.CreateRetVoid();
+  // The IRDB already knows @writer(); registering it again would hand out ids
+  // to instructions that may reuse the addresses of the erased ones
+  PTS.insertFunction(Writer);
+
+  {
+    LLVMAliasSet Fresh(&IRDB, false, PATy);
+    expectSameAliasSets(PTS, Fresh, M);
+    EXPECT_EQ(AliasResult::NoAlias, PTS.alias(Local, Read));
+  }
+
+  // @caller() passes its local to @ident() through @wrap()
+  auto *Ident = createPtrFunction(
+      M, "ident", [](llvm::IRBuilder<> & /*IRB*/, llvm::Value *P) {
+        return P;
+      });
+  IRDB.insertFunction(Ident);
+  PTS.insertFunction(Ident);
+  auto *Wrap = createPtrFunction(
+      M, "wrap", [Ident](llvm::IRBuilder<> &IRB, llvm::Value *P) {
+        return IRB.CreateCall(Ident, {P});
+      });
+  IRDB.insertFunction(Wrap);
+  PTS.insertFunction(Wrap);
+  const llvm::Value *CallerLocal{};
+  const llvm::Value *Returned{};
+  auto *Caller = createFunction(
+      M, "caller",
+      [Wrap, &CallerLocal, &Returned](llvm::IRBuilder<> &IRB,
+                                      llvm::Value * /*P*/) {
+        auto *Alloca = IRB.CreateAlloca(IRB.getInt32Ty());
+        CallerLocal = Alloca;
+        Returned = IRB.CreateCall(Wrap, {Alloca});
+      });
+  IRDB.insertFunction(Caller);
+  PTS.insertFunction(Caller);
+
+  {
+    LLVMAliasSet Fresh(&IRDB, false, PATy);
+    expectSameAliasSets(PTS, Fresh, M);
+    EXPECT_EQ(AliasResult::MayAlias, PTS.alias(CallerLocal, Returned));
+  }
+
+  // Let @ident() return its own local instead of its parameter, which changes
+  // the alias sets of its transitive caller @caller()
+  PTS.eraseFunction(Ident);
+  Ident->getEntryBlock().eraseFromParent();
+  IRB.SetInsertPoint(llvm::BasicBlock::Create(Ctx, "entry", Ident));
+  IRB.CreateRet(IRB.CreateAlloca(IRB.getInt32Ty()));
+  PTS.insertFunction(Ident);
+
+  {
+    LLVMAliasSet Fresh(&IRDB, false, PATy);
+    expectSameAliasSets(PTS, Fresh, M);
+    EXPECT_EQ(AliasResult::NoAlias, PTS.alias(CallerLocal, Returned));
+  }
+}
+} // namespace
+
 TEST(LLVMAliasSet, Intra_01) {
   ValueAnnotationPass::resetValueID();
   LLVMProjectIRDB IRDB(unittest::PathToLLTestFiles +
@@ -64,6 +226,75 @@ TEST(LLVMAliasSet, Global_01) {
   llvm::outs() << '\n';
 }
 
+TEST(LLVMAliasSet, CompactAliasSet_01) {
+  ValueAnnotationPass::resetValueID();
+  LLVMProjectIRDB IRDB(unittest::PathToLLTestFiles + "pointers/call_01_cpp.ll");
+  LLVMAliasSet PTS(&IRDB, false);
+  const auto *Main = IRDB.getFunctionDefinition("main");
+
+  std::vector<const llvm::Value *> Pointers;
+  for (const auto &I : llvm::instructions(Main)) {
+    if (!isInterestingPointer(&I)) {
+      continue;
+    }
+    Pointers.push_back(&I);
+
+    auto Compact = PTS.getCompactAliasSet(&I);
+    auto Aliases = PTS.getAliasSet(&I);
+    ASSERT_EQ(Aliases->size(), Compact->size());
+    for (auto Id : *Compact) {
+      EXPECT_TRUE(Aliases->count(PTS.getValueFromId(Id)));
+    }
+
+    auto Id = PTS.getValueId(&I);
+    ASSERT_TRUE(Id.has_value());
+    EXPECT_TRUE(Compact->contains(*Id));
+    for (const auto *Alias : *Aliases) {
+      // All aliases share the same set
+      EXPECT_EQ(Compact, PTS.getCompactAliasSet(Alias));
+    }
+  }
+  ASSERT_GE(Pointers.size(), 2U);
+
+  // Handed-out sets are snapshots
+  const auto *First = Pointers.front();
+  const auto *Last = Pointers.back();
+  auto FirstBefore = PTS.getCompactAliasSet(First);
+  auto NumFirstBefore = FirstBefore->size();
+  PTS.introduceAlias(First, Last);
+
+  auto Merged = PTS.getCompactAliasSet(First);
+  EXPECT_EQ(Merged, PTS.getCompactAliasSet(Last));
+  EXPECT_EQ(PTS.getAliasSet(First)->size(), Merged->size());
+  EXPECT_EQ(NumFirstBefore, FirstBefore->size());
+  EXPECT_EQ(*FirstBefore, Merged->intersection(*FirstBefore));
+}
+
+TEST(LLVMAliasSet, IncrementalUpdate_01) {
+  testIncrementalUpdate(AliasAnalysisType::CFLAnders);
+}
+
+TEST(LLVMAliasSet, IncrementalUpdate_02) {
+  testIncrementalUpdate(AliasAnalysisType::Andersen);
+}
+
+TEST(LLVMAliasSet, ParallelIsDeterministic) {
+  for (const auto *File :
+       {"call_01_cpp.ll", "global_01_cpp.ll", "inter_dynamic_01_cpp.ll",
+        "inter_dynamic_02_cpp.ll", "andersen_01_cpp.ll"}) {
+    SCOPED_TRACE(File);
+    ValueAnnotationPass::resetValueID();
+    LLVMProjectIRDB IRDB(unittest::PathToLLTestFiles + "pointers/" + File);
+    ASSERT_TRUE(IRDB.isValid());
+
+    LLVMAliasSet Sequential(&IRDB, false, AliasAnalysisType::CFLAnders,
+                            /*NumThreads*/ 1);
+    LLVMAliasSet Parallel(&IRDB, false, AliasAnalysisType::CFLAnders,
+                          /*NumThreads*/ 4);
+    expectSameAliasSets(Parallel, Sequential, *IRDB.getModule());
+  }
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
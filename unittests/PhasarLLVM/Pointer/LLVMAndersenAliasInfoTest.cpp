@@ -0,0 +1,215 @@
+#include "phasar/PhasarLLVM/Pointer/LLVMAndersenAliasInfo.h"
+
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasInfo.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+#include <memory>
+
+using namespace psr;
+
+namespace {
+/// The pointer that is loaded from the local variable Name in F
+const llvm::Value *getLoadOf(const llvm::Function *F, llvm::StringRef Name) {
+  for (const auto &I : llvm::instructions(F)) {
+    const auto *Load = llvm::dyn_cast<llvm::LoadInst>(&I);
+    if (Load && Load->getType()->isPointerTy() &&
+        Load->getPointerOperand()->getName() == Name) {
+      return Load;
+    }
+  }
+  return nullptr;
+}
+
+const llvm::Value *getLocal(const llvm::Function *F, llvm::StringRef Name) {
+  for (const auto &I : llvm::instructions(F)) {
+    if (llvm::isa<llvm::AllocaInst>(I) && I.getName() == Name) {
+      return &I;
+    }
+  }
+  return nullptr;
+}
+
+std::unique_ptr<LLVMProjectIRDB> loadIRDB(llvm::StringRef File) {
+  ValueAnnotationPass::resetValueID();
+  return std::make_unique<LLVMProjectIRDB>(unittest::PathToLLTestFiles +
+                                           "pointers/" + File.str());
+}
+
+class LLVMAndersenAliasInfoTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    IRDB = loadIRDB("andersen_01_cpp.ll");
+    ASSERT_TRUE(IRDB->isValid());
+    const auto *Main = IRDB->getFunctionDefinition("main");
+    ASSERT_NE(nullptr, Main);
+
+    A = getLocal(Main, "A");
+    B = getLocal(Main, "B");
+    // X receives &A through assignFirst() and the indirect call of identity()
+    X = getLoadOf(Main, "X");
+    Y = getLoadOf(Main, "Y");
+    ASSERT_TRUE(A && B && X && Y);
+  }
+
+  std::unique_ptr<LLVMProjectIRDB> IRDB;
+  const llvm::Value *A{};
+  const llvm::Value *B{};
+  const llvm::Value *X{};
+  const llvm::Value *Y{};
+};
+} // namespace
+
+TEST_F(LLVMAndersenAliasInfoTest, InterProceduralAndFieldSensitive) {
+  LLVMAndersenAliasInfo PTA(*IRDB);
+  EXPECT_TRUE(PTA.isInterProcedural());
+  EXPECT_TRUE(PTA.isFieldSensitive());
+
+  EXPECT_EQ(llvm::SmallVector<const llvm::Value *>{A}, PTA.getPointsToSet(X));
+  EXPECT_EQ(llvm::SmallVector<const llvm::Value *>{B}, PTA.getPointsToSet(Y));
+
+  // X and Y are loaded from different fields of the same struct
+  EXPECT_EQ(AliasResult::NoAlias, PTA.alias(X, Y));
+  EXPECT_EQ(AliasResult::MayAlias, PTA.alias(X, A));
+  EXPECT_EQ(AliasResult::MayAlias, PTA.alias(Y, B));
+
+  auto Aliases = PTA.getAliasSet(X);
+  EXPECT_TRUE(Aliases->count(A));
+  EXPECT_FALSE(Aliases->count(B));
+  EXPECT_FALSE(Aliases->count(Y));
+
+  auto AllocSites = PTA.getReachableAllocationSites(X);
+  EXPECT_EQ(1U, AllocSites->size());
+  EXPECT_TRUE(AllocSites->count(A));
+  EXPECT_TRUE(PTA.isInReachableAllocationSites(Y, B));
+  EXPECT_FALSE(PTA.isInReachableAllocationSites(Y, A));
+}
+
+TEST_F(LLVMAndersenAliasInfoTest, IntroduceAlias) {
+  LLVMAndersenAliasInfo PTA(*IRDB);
+  auto Before = PTA.getAliasSet(X);
+  PTA.introduceAlias(X, Y);
+
+  EXPECT_EQ(AliasResult::MayAlias, PTA.alias(X, Y));
+  EXPECT_TRUE(PTA.getAliasSet(X)->count(B));
+  EXPECT_EQ(2U, PTA.getPointsToSet(Y).size());
+  // Handed-out sets are snapshots
+  EXPECT_FALSE(Before->count(B));
+}
+
+TEST_F(LLVMAndersenAliasInfoTest, TypeErased) {
+  LLVMAliasInfo AI = std::make_unique<LLVMAndersenAliasInfo>(*IRDB);
+  EXPECT_EQ(AliasAnalysisType::Andersen, AI.getAliasAnalysisType());
+  EXPECT_TRUE(AI.isInterProcedural());
+  EXPECT_EQ(AliasResult::NoAlias, AI.alias(X, Y));
+  EXPECT_TRUE(AI.getAliasSet(Y)->count(B));
+}
+
+TEST_F(LLVMAndersenAliasInfoTest, AliasSets) {
+  LLVMAliasSet PTS(IRDB.get(), false, AliasAnalysisType::Andersen);
+  EXPECT_TRUE(PTS.isInterProcedural());
+  EXPECT_EQ(AliasResult::NoAlias, PTS.alias(X, Y));
+  EXPECT_EQ(AliasResult::MayAlias, PTS.alias(X, A));
+  EXPECT_TRUE(PTS.getAliasSet(Y)->count(B));
+}
+
+TEST(LLVMAndersenAliasInfoCornerCaseTest, CopyCycle) {
+  auto IRDB = loadIRDB("andersen_02_cpp.ll");
+  ASSERT_TRUE(IRDB->isValid());
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  const auto *A = getLocal(Main, "A");
+  const auto *B = getLocal(Main, "B");
+  const auto *P = getLoadOf(Main, "P");
+  const auto *Q = getLoadOf(Main, "Q");
+  const auto *R = getLoadOf(Main, "R");
+  ASSERT_TRUE(A && B && P && Q && R);
+
+  // P, Q and R form a cycle of copies that is collapsed into a single node
+  LLVMAndersenAliasInfo PTA(*IRDB);
+  for (const auto *Ptr : {P, Q, R}) {
+    auto Pts = PTA.getPointsToSet(Ptr);
+    EXPECT_EQ(2U, Pts.size());
+    EXPECT_TRUE(llvm::is_contained(Pts, A));
+    EXPECT_TRUE(llvm::is_contained(Pts, B));
+  }
+  EXPECT_EQ(AliasResult::MayAlias, PTA.alias(P, Q));
+  EXPECT_EQ(AliasResult::MayAlias, PTA.alias(Q, R));
+
+  LLVMAliasSet PTS(IRDB.get(), false, AliasAnalysisType::Andersen);
+  EXPECT_EQ(AliasResult::MayAlias, PTS.alias(P, R));
+  EXPECT_TRUE(PTS.getAliasSet(Q)->count(A));
+  EXPECT_TRUE(PTS.getAliasSet(Q)->count(B));
+}
+
+TEST(LLVMAndersenAliasInfoCornerCaseTest, ChainedIndirectCalls) {
+  auto IRDB = loadIRDB("andersen_03_cpp.ll");
+  ASSERT_TRUE(IRDB->isValid());
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  const auto *A = getLocal(Main, "A");
+  const auto *B = getLocal(Main, "B");
+  const auto *X = getLoadOf(Main, "X");
+  const auto *Y = getLoadOf(Main, "Y");
+  ASSERT_TRUE(A && B && X && Y);
+
+  // The call of Fn can only be bound after the call of Getter has been
+  // resolved, which takes a second round of the solver
+  LLVMAndersenAliasInfo PTA(*IRDB);
+  EXPECT_EQ(llvm::SmallVector<const llvm::Value *>{A}, PTA.getPointsToSet(X));
+  EXPECT_EQ(AliasResult::MayAlias, PTA.alias(X, A));
+  EXPECT_EQ(AliasResult::NoAlias, PTA.alias(X, Y));
+
+  LLVMAliasSet PTS(IRDB.get(), false, AliasAnalysisType::Andersen);
+  EXPECT_EQ(AliasResult::MayAlias, PTS.alias(X, A));
+  EXPECT_EQ(AliasResult::NoAlias, PTS.alias(X, B));
+}
+
+TEST(LLVMAndersenAliasInfoCornerCaseTest, UnknownMemory) {
+  auto IRDB = loadIRDB("andersen_04_cpp.ll");
+  ASSERT_TRUE(IRDB->isValid());
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  const auto *A = getLocal(Main, "A");
+  const auto *B = getLocal(Main, "B");
+  const auto *P = getLoadOf(Main, "P");
+  const auto *Q = getLoadOf(Main, "Q");
+  const auto *R = getLoadOf(Main, "R");
+  ASSERT_TRUE(A && B && P && Q && R);
+
+  LLVMAndersenAliasInfo PTA(*IRDB);
+  // Q is created from an integer and R is written by an external function, so
+  // both may point to unknown memory and to the escaped B
+  for (const auto *Ptr : {Q, R}) {
+    auto Pts = PTA.getPointsToSet(Ptr);
+    EXPECT_TRUE(llvm::is_contained(Pts, nullptr));
+    EXPECT_TRUE(llvm::is_contained(Pts, B));
+    EXPECT_FALSE(llvm::is_contained(Pts, A));
+  }
+  EXPECT_EQ(llvm::SmallVector<const llvm::Value *>{A}, PTA.getPointsToSet(P));
+
+  EXPECT_EQ(AliasResult::MayAlias, PTA.alias(Q, B));
+  EXPECT_EQ(AliasResult::MayAlias, PTA.alias(Q, R));
+  EXPECT_EQ(AliasResult::NoAlias, PTA.alias(Q, A));
+  EXPECT_EQ(AliasResult::NoAlias, PTA.alias(R, P));
+
+  LLVMAliasSet PTS(IRDB.get(), false, AliasAnalysisType::Andersen);
+  EXPECT_EQ(AliasResult::MayAlias, PTS.alias(Q, R));
+  EXPECT_EQ(AliasResult::MayAlias, PTS.alias(R, B));
+  EXPECT_EQ(AliasResult::NoAlias, PTS.alias(R, P));
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,170 @@
+#include "phasar/PhasarLLVM/Pointer/LLVMBasedAliasAnalysis.h"
+
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/Pointer/AliasAnalysisType.h"
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include "gtest/gtest.h"
+
+using namespace psr;
+
+namespace {
+/// Two pairs of callers that share a callee; @rec's summary depends on its
+/// recursive call
+constexpr llvm::StringLiteral SharedCalleeIR = R"(
+define i32* @callee(i32* %P) {
+  ret i32* %P
+}
+
+define i32* @rec(i32* %P) {
+  %R = call i32* @rec(i32* %P)
+  %V = load i32, i32* %P
+  %C = icmp eq i32 %V, 0
+  %S = select i1 %C, i32* %R, i32* %P
+  ret i32* %S
+}
+
+define void @caller1() {
+  %A = alloca i32
+  %B = alloca i32
+  %R = call i32* @callee(i32* %A)
+  ret void
+}
+
+define void @caller2() {
+  %A = alloca i32
+  %B = alloca i32
+  %R = call i32* @callee(i32* %B)
+  ret void
+}
+
+define void @rec_caller1() {
+  %A = alloca i32
+  %B = alloca i32
+  %R = call i32* @rec(i32* %A)
+  ret void
+}
+
+define void @rec_caller2() {
+  %A = alloca i32
+  %B = alloca i32
+  %R = call i32* @rec(i32* %B)
+  ret void
+}
+)";
+
+const llvm::Value *getInst(const llvm::Function *F, llvm::StringRef Name) {
+  for (const auto &I : llvm::instructions(F)) {
+    if (I.getName() == Name) {
+      return &I;
+    }
+  }
+  return nullptr;
+}
+
+/// Expects that both alias analyses yield the same results for all pairs of
+/// pointers in F
+void expectSameAliasResults(LLVMBasedAliasAnalysis &Actual,
+                            LLVMBasedAliasAnalysis &Expected,
+                            llvm::Function *F) {
+  llvm::SmallVector<const llvm::Value *> Pointers;
+  for (const auto &I : llvm::instructions(F)) {
+    if (I.getType()->isPointerTy()) {
+      Pointers.push_back(&I);
+    }
+  }
+
+  auto *ActualAA = Actual.getAAResults(F);
+  auto *ExpectedAA = Expected.getAAResults(F);
+  for (const auto *V1 : Pointers) {
+    for (const auto *V2 : Pointers) {
+      EXPECT_EQ(ExpectedAA->alias(V1, V2), ActualAA->alias(V1, V2))
+          << "Different alias results in " << F->getName().str() << " for "
+          << V1->getName().str() << " and " << V2->getName().str();
+    }
+  }
+}
+
+class LLVMBasedAliasAnalysisTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    ValueAnnotationPass::resetValueID();
+    IRDB = std::make_unique<LLVMProjectIRDB>(
+        llvm::MemoryBufferRef(SharedCalleeIR, "shared_callee.ll"));
+    ASSERT_TRUE(IRDB->isValid());
+    for (auto Name : {"caller1", "caller2", "rec_caller1", "rec_caller2"}) {
+      auto *F = IRDB->getModule()->getFunction(Name);
+      ASSERT_NE(nullptr, F);
+      Callers.push_back(F);
+    }
+  }
+
+  std::unique_ptr<LLVMProjectIRDB> IRDB;
+  llvm::SmallVector<llvm::Function *> Callers;
+};
+} // namespace
+
+TEST_F(LLVMBasedAliasAnalysisTest, SharedSummariesPreserveResults) {
+  // All callers share the summaries of @callee and @rec
+  LLVMBasedAliasAnalysis Shared(*IRDB, true, AliasAnalysisType::CFLAnders);
+  for (auto *F : Callers) {
+    // Nothing to share with other callers
+    LLVMBasedAliasAnalysis Fresh(*IRDB, true, AliasAnalysisType::CFLAnders);
+    expectSameAliasResults(Shared, Fresh, F);
+  }
+
+  for (auto *F : Callers) {
+    auto *AA = Shared.getAAResults(F);
+    const auto *R = getInst(F, "R");
+    const auto *A = getInst(F, "A");
+    const auto *B = getInst(F, "B");
+    ASSERT_TRUE(R && A && B);
+    // The second caller of each pair passes B instead of A
+    bool PassesA = F->getName().endswith("1");
+    EXPECT_EQ(PassesA ? llvm::AliasResult::MayAlias
+                      : llvm::AliasResult::NoAlias,
+              AA->alias(R, A));
+    EXPECT_EQ(PassesA ? llvm::AliasResult::NoAlias
+                      : llvm::AliasResult::MayAlias,
+              AA->alias(R, B));
+  }
+}
+
+TEST_F(LLVMBasedAliasAnalysisTest, ClearDropsStaleSummaries) {
+  LLVMBasedAliasAnalysis Shared(*IRDB, true, AliasAnalysisType::CFLAnders);
+  auto *Caller1 = Callers[0];
+  const auto *R = getInst(Caller1, "R");
+  const auto *A = getInst(Caller1, "A");
+  ASSERT_TRUE(R && A);
+  EXPECT_EQ(llvm::AliasResult::MayAlias,
+            Shared.getAAResults(Caller1)->alias(R, A));
+
+  // Let @callee return its own local instead of its parameter
+  auto *Callee = IRDB->getModule()->getFunction("callee");
+  ASSERT_NE(nullptr, Callee);
+  Callee->getEntryBlock().eraseFromParent();
+  llvm::IRBuilder<> IRB(
+      llvm::BasicBlock::Create(Callee->getContext(), "entry", Callee));
+  IRB.CreateRet(IRB.CreateAlloca(IRB.getInt32Ty()));
+
+  Shared.clear();
+  EXPECT_EQ(llvm::AliasResult::NoAlias,
+            Shared.getAAResults(Caller1)->alias(R, A));
+
+  LLVMBasedAliasAnalysis Fresh(*IRDB, true, AliasAnalysisType::CFLAnders);
+  for (auto *F : Callers) {
+    expectSameAliasResults(Shared, Fresh, F);
+  }
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,153 @@
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasInfo.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/IR/InstIterator.h"
+
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+using namespace psr;
+
+namespace {
+class LLVMCachedAliasInfoTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    ValueAnnotationPass::resetValueID();
+    IRDB = std::make_unique<LLVMProjectIRDB>(unittest::PathToLLTestFiles +
+                                             "pointers/call_01_cpp.ll");
+    ASSERT_TRUE(IRDB->isValid());
+    for (const auto *F : IRDB->getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        if (I.getType()->isPointerTy()) {
+          Pointers.push_back(&I);
+        }
+      }
+    }
+    ASSERT_FALSE(Pointers.empty());
+  }
+
+  std::unique_ptr<LLVMProjectIRDB> IRDB;
+  llvm::SmallVector<const llvm::Value *> Pointers;
+};
+} // namespace
+
+TEST_F(LLVMCachedAliasInfoTest, SameResultsAsUnderlying) {
+  LLVMAliasSet PTS(IRDB.get(), false);
+  LLVMCachedAliasInfo Cached(&PTS);
+  EXPECT_TRUE(Cached);
+  EXPECT_EQ(PTS.getAliasAnalysisType(), Cached.getAliasAnalysisType());
+
+  for (const auto *P : Pointers) {
+    EXPECT_EQ(*PTS.getAliasSet(P), *Cached.getAliasSet(P));
+    EXPECT_EQ(*PTS.getReachableAllocationSites(P),
+              *Cached.getReachableAllocationSites(P));
+    for (const auto *Q : Pointers) {
+      EXPECT_EQ(PTS.isInReachableAllocationSites(P, Q),
+                Cached.isInReachableAllocationSites(P, Q));
+      EXPECT_EQ(PTS.alias(P, Q), Cached.alias(P, Q));
+    }
+  }
+}
+
+TEST_F(LLVMCachedAliasInfoTest, QueriesAreMemoized) {
+  LLVMAliasSet PTS(IRDB.get(), false);
+  LLVMCachedAliasInfo Cached(&PTS);
+
+  const auto *P = Pointers.front();
+  auto First = Cached.getAliasSet(P);
+  EXPECT_EQ(1U, Cached.getNumCachedAliasSets());
+  // LLVMAliasSet is not flow-sensitive, so the instruction does not matter
+  auto Second = Cached.getAliasSet(P, llvm::cast<llvm::Instruction>(P));
+  EXPECT_EQ(First.get(), Second.get());
+  EXPECT_EQ(1U, Cached.getNumCachedAliasSets());
+
+  auto Sites = Cached.getSharedReachableAllocationSites(P);
+  EXPECT_EQ(Sites, Cached.getSharedReachableAllocationSites(P));
+  EXPECT_NE(Sites, Cached.getSharedReachableAllocationSites(P, true));
+}
+
+TEST_F(LLVMCachedAliasInfoTest, BatchedQueries) {
+  LLVMAliasSet PTS(IRDB.get(), false);
+  LLVMCachedAliasInfo Cached(&PTS);
+
+  auto Sets = Cached.getAliasSets(Pointers);
+  ASSERT_EQ(Pointers.size(), Sets.size());
+  LLVMAliasInfo::AliasSetTy Expected;
+  for (size_t I = 0, End = Pointers.size(); I != End; ++I) {
+    EXPECT_EQ(*PTS.getAliasSet(Pointers[I]), *Sets[I]);
+    Expected.insert(Sets[I]->begin(), Sets[I]->end());
+  }
+
+  LLVMAliasInfo::AliasSetTy Union;
+  Cached.insertAliasesOf(Pointers, Union);
+  EXPECT_EQ(Expected, Union);
+}
+
+TEST_F(LLVMCachedAliasInfoTest, IntroduceAliasClearsCache) {
+  LLVMAliasSet PTS(IRDB.get(), false);
+  LLVMCachedAliasInfo Cached(&PTS);
+  LLVMAliasInfoRef AsRef = &Cached;
+
+  const auto *First = Pointers.front();
+  const auto *Last = Pointers.back();
+  EXPECT_TRUE(AsRef.getAliasSet(First)->count(First));
+  EXPECT_TRUE(AsRef.getAliasSet(Last)->count(Last));
+  EXPECT_EQ(2U, Cached.getNumCachedAliasSets());
+
+  AsRef.introduceAlias(First, Last);
+  EXPECT_EQ(0U, Cached.getNumCachedAliasSets());
+  EXPECT_TRUE(Cached.getAliasSet(First)->count(Last));
+  EXPECT_EQ(*PTS.getAliasSet(Last), *Cached.getAliasSet(Last));
+}
+
+TEST(LLVMCachedAliasInfoLazyTest, LazyEvaluationInvalidatesCache) {
+  ValueAnnotationPass::resetValueID();
+  LLVMProjectIRDB IRDB(unittest::PathToLLTestFiles +
+                       "pointers/global_01_cpp.ll");
+  ASSERT_TRUE(IRDB.isValid());
+  const auto *G = IRDB.getModule()->getGlobalVariable("g");
+  ASSERT_NE(nullptr, G);
+  llvm::SmallVector<const llvm::Value *> Pointers;
+  for (const auto *F : IRDB.getAllFunctions()) {
+    for (const auto &I : llvm::instructions(F)) {
+      if (I.getType()->isPointerTy()) {
+        Pointers.push_back(&I);
+      }
+    }
+  }
+  ASSERT_FALSE(Pointers.empty());
+
+  LLVMAliasSet PTS(&IRDB, true);
+  LLVMCachedAliasInfo Cached(&PTS);
+  EXPECT_EQ(PTS.getGeneration(), Cached.getGeneration());
+
+  // Each query may analyze another function and extend the alias sets that
+  // have already been cached
+  auto Gen = PTS.getGeneration();
+  for (const auto *P : Pointers) {
+    (void)Cached.getSharedReachableAllocationSites(P);
+    (void)Cached.getAliasSet(P);
+  }
+  EXPECT_GT(PTS.getGeneration(), Gen);
+
+  // Analyzes all users of g and merges their alias sets with g's
+  (void)Cached.getAliasSet(G);
+
+  // Now, PTS is complete and the cache must not hand out stale results
+  for (const auto *P : Pointers) {
+    EXPECT_EQ(*PTS.getAliasSet(P), *Cached.getAliasSet(P));
+    EXPECT_EQ(*PTS.getReachableAllocationSites(P),
+              *Cached.getSharedReachableAllocationSites(P));
+    EXPECT_EQ(*PTS.getReachableAllocationSites(P, true),
+              *Cached.getSharedReachableAllocationSites(P, true));
+  }
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,50 @@
+#include "phasar/Utils/BucketedWorkList.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace psr;
+
+TEST(BucketedWorkListTest, singleBucketIsLIFO) {
+  BucketedWorkList<int> WL;
+  WL.emplace_back(1);
+  WL.emplace_back(2);
+  WL.emplace_back(3);
+  EXPECT_EQ(3U, WL.size());
+
+  std::vector<int> Popped;
+  while (!WL.empty()) {
+    Popped.push_back(WL.pop());
+  }
+  EXPECT_EQ((std::vector<int>{3, 2, 1}), Popped);
+}
+
+TEST(BucketedWorkListTest, lowestBucketFirst) {
+  BucketedWorkList<int> WL;
+  WL.setNumBuckets(200);
+  WL.emplace(150, 1);
+  WL.emplace(3, 2);
+  WL.emplace(150, 3);
+  WL.emplace(70, 4);
+
+  EXPECT_EQ(2, WL.pop());
+  EXPECT_EQ(4, WL.pop());
+
+  // Inserting into a lower bucket than the current one takes precedence
+  WL.emplace(0, 5);
+  EXPECT_EQ(5, WL.pop());
+  EXPECT_EQ(3, WL.pop());
+  EXPECT_EQ(1, WL.pop());
+  EXPECT_TRUE(WL.empty());
+
+  WL.emplace(199, 6);
+  EXPECT_EQ(6, WL.pop());
+  EXPECT_TRUE(WL.empty());
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
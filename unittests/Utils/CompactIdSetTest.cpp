@@ -0,0 +1,111 @@
+#include "phasar/Utils/CompactIdSet.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+std::set<uint32_t> toSet(const CompactIdSet &Set) {
+  return {Set.begin(), Set.end()};
+}
+
+/// Ids in [Base, Base + Range) with the given density
+std::vector<uint32_t> randomIds(std::mt19937 &Rng, uint32_t Base,
+                                uint32_t Range, double Density) {
+  std::bernoulli_distribution Dist(Density);
+  std::vector<uint32_t> Ret;
+  for (uint32_t Id = Base; Id < Base + Range; ++Id) {
+    if (Dist(Rng)) {
+      Ret.push_back(Id);
+    }
+  }
+  std::shuffle(Ret.begin(), Ret.end(), Rng);
+  return Ret;
+}
+
+void expectSameAs(const std::set<uint32_t> &Expected,
+                  const CompactIdSet &Actual) {
+  EXPECT_EQ(Expected.size(), Actual.size());
+  EXPECT_EQ(Expected, toSet(Actual));
+  for (auto Id : Expected) {
+    EXPECT_TRUE(Actual.contains(Id));
+    EXPECT_FALSE(Actual.contains(Id + 1) && !Expected.count(Id + 1));
+  }
+}
+} // namespace
+
+TEST(CompactIdSetTest, Empty) {
+  CompactIdSet Set;
+  EXPECT_TRUE(Set.empty());
+  EXPECT_EQ(Set.begin(), Set.end());
+  EXPECT_FALSE(Set.contains(0));
+  EXPECT_FALSE(Set.intersects(CompactIdSet({1, 2, 3})));
+  EXPECT_EQ(Set, CompactIdSet(std::vector<uint32_t>{}));
+}
+
+TEST(CompactIdSetTest, SmallSetIsSorted) {
+  CompactIdSet Set({42, 7, 100000, 7, 3});
+  EXPECT_FALSE(Set.isRoaring());
+  EXPECT_EQ(4U, Set.size());
+  EXPECT_EQ((std::vector<uint32_t>{3, 7, 42, 100000}),
+            std::vector<uint32_t>(Set.begin(), Set.end()));
+  EXPECT_TRUE(Set.contains(100000));
+  EXPECT_FALSE(Set.contains(8));
+}
+
+TEST(CompactIdSetTest, LargeSetsAreRoaring) {
+  std::mt19937 Rng(1);
+  // A dense group (bitmap), a sparse group (array) and a group that only
+  // contains the highest possible id
+  auto Ids = randomIds(Rng, 0, 1 << 16, 0.5);
+  auto Sparse = randomIds(Rng, 3 << 16, 1 << 16, 0.01);
+  Ids.insert(Ids.end(), Sparse.begin(), Sparse.end());
+  Ids.push_back(UINT32_MAX);
+  std::set<uint32_t> Expected(Ids.begin(), Ids.end());
+
+  CompactIdSet Set(std::move(Ids));
+  EXPECT_TRUE(Set.isRoaring());
+  expectSameAs(Expected, Set);
+  EXPECT_LT(Set.getMemoryUsage(), Expected.size() * sizeof(uint32_t));
+}
+
+TEST(CompactIdSetTest, IntersectsAllRepresentations) {
+  std::mt19937 Rng(2);
+  std::vector<std::vector<uint32_t>> Inputs = {
+      {},
+      {5, 70000},
+      randomIds(Rng, 0, 1 << 16, 0.002),
+      randomIds(Rng, 0, 1 << 16, 0.3),
+      randomIds(Rng, 1 << 16, 1 << 17, 0.05),
+      randomIds(Rng, 0, 1 << 18, 0.2),
+  };
+
+  for (const auto &LhsIds : Inputs) {
+    for (const auto &RhsIds : Inputs) {
+      std::set<uint32_t> Lhs(LhsIds.begin(), LhsIds.end());
+      std::set<uint32_t> Common;
+      for (auto Id : RhsIds) {
+        if (Lhs.count(Id)) {
+          Common.insert(Id);
+        }
+      }
+
+      CompactIdSet LhsSet(LhsIds);
+      CompactIdSet RhsSet(RhsIds);
+      EXPECT_EQ(!Common.empty(), LhsSet.intersects(RhsSet));
+      EXPECT_EQ(!Common.empty(), RhsSet.intersects(LhsSet));
+      expectSameAs(Common, LhsSet.intersection(RhsSet));
+    }
+  }
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
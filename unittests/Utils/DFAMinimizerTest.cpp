@@ -0,0 +1,175 @@
+#include "phasar/Utils/DFAMinimizer.h"
+
+#include "phasar/Utils/AdjacencyList.h"
+
+#include "llvm/ADT/SmallVector.h"
+
+#include "gtest/gtest.h"
+
+#include <set>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+using GraphTy = AdjacencyList<llvm::SmallVector<int, 1>>;
+using traits_t = GraphTraits<GraphTy>;
+
+unsigned addNode(GraphTy &G, int Tag) {
+  return traits_t::addNode(G, llvm::SmallVector<int, 1>{Tag});
+}
+
+/// Collects all paths from the roots of the DAG G as sequences of node-tags
+std::set<std::vector<int>> collectPaths(const GraphTy &G) {
+  std::set<std::vector<int>> Ret;
+  std::vector<int> Curr;
+  auto Dfs = [&](auto &Self, unsigned Vtx) -> void {
+    Curr.push_back(traits_t::node(G, Vtx).front());
+    if (traits_t::outDegree(G, Vtx) == 0) {
+      Ret.insert(Curr);
+    }
+    for (auto Succ : traits_t::outEdges(G, Vtx)) {
+      Self(Self, Succ);
+    }
+    Curr.pop_back();
+  };
+  for (auto Rt : traits_t::roots(G)) {
+    Dfs(Dfs, Rt);
+  }
+  return Ret;
+}
+
+/// A layered DAG where each vertex of a layer is connected to all vertices of
+/// the next layer. All vertices of a layer are equivalent.
+GraphTy makeLayeredDAG(unsigned NumLayers, unsigned Width) {
+  GraphTy G;
+  for (unsigned L = 0; L < NumLayers; ++L) {
+    for (unsigned W = 0; W < Width; ++W) {
+      auto Vtx = addNode(G, int(L));
+      if (L == 0) {
+        traits_t::addRoot(G, Vtx);
+        continue;
+      }
+      for (unsigned Pred = (L - 1) * Width; Pred < L * Width; ++Pred) {
+        traits_t::addEdge(G, Pred, Vtx);
+      }
+    }
+  }
+  return G;
+}
+} // namespace
+
+TEST(DFAMinimizerTest, MergesEquivalentBranches) {
+  // 0:[1] -> {1:[2], 2:[2]} ; 1 -> 3:[3] ; 2 -> 4:[3] ; 0 -> 5:[3]
+  GraphTy G;
+  auto Rt = addNode(G, 1);
+  auto L = addNode(G, 2);
+  auto R = addNode(G, 2);
+  auto LL = addNode(G, 3);
+  auto RL = addNode(G, 3);
+  auto Other = addNode(G, 3);
+  traits_t::addRoot(G, Rt);
+  traits_t::addEdge(G, Rt, L);
+  traits_t::addEdge(G, Rt, R);
+  traits_t::addEdge(G, L, LL);
+  traits_t::addEdge(G, R, RL);
+  traits_t::addEdge(G, Rt, Other);
+
+  auto Eq = minimizeGraph(G);
+  EXPECT_EQ(3U, Eq.getNumClasses());
+  EXPECT_EQ(Eq[L], Eq[R]);
+  EXPECT_EQ(Eq[LL], Eq[RL]);
+  EXPECT_EQ(Eq[LL], Eq[Other]);
+  EXPECT_NE(Eq[Rt], Eq[L]);
+
+  auto Paths = collectPaths(G);
+  auto Minimized = createEquivalentGraphFrom(G, Eq);
+  EXPECT_EQ(3U, traits_t::size(Minimized));
+  EXPECT_EQ(Paths, collectPaths(Minimized));
+}
+
+TEST(DFAMinimizerTest, DistinguishesSuccessors) {
+  // 0:[1] -> 1:[2] -> 3:[3]; 0 -> 2:[2] -> 4:[4]
+  GraphTy G;
+  auto Rt = addNode(G, 1);
+  auto L = addNode(G, 2);
+  auto R = addNode(G, 2);
+  traits_t::addRoot(G, Rt);
+  traits_t::addEdge(G, Rt, L);
+  traits_t::addEdge(G, Rt, R);
+  traits_t::addEdge(G, L, addNode(G, 3));
+  traits_t::addEdge(G, R, addNode(G, 4));
+
+  auto Eq = minimizeGraph(G);
+  EXPECT_EQ(5U, Eq.getNumClasses());
+  EXPECT_NE(Eq[L], Eq[R]);
+}
+
+TEST(DFAMinimizerTest, HandlesCycles) {
+  // Two isomorphic cycles 0 <-> 1 and 2 <-> 3
+  GraphTy G;
+  auto A0 = addNode(G, 1);
+  auto B0 = addNode(G, 2);
+  auto A1 = addNode(G, 1);
+  auto B1 = addNode(G, 2);
+  traits_t::addEdge(G, A0, B0);
+  traits_t::addEdge(G, B0, A0);
+  traits_t::addEdge(G, A1, B1);
+  traits_t::addEdge(G, B1, A1);
+
+  auto Eq = minimizeGraph(G);
+  EXPECT_EQ(2U, Eq.getNumClasses());
+  EXPECT_EQ(Eq[A0], Eq[A1]);
+  EXPECT_EQ(Eq[B0], Eq[B1]);
+}
+
+TEST(DFAMinimizerTest, LargeLayeredDAG) {
+  // Would take quadratically many steps in the number of vertices per layer
+  // with pairwise comparison
+  constexpr unsigned NumLayers = 64;
+  constexpr unsigned Width = 128;
+  auto G = makeLayeredDAG(NumLayers, Width);
+
+  auto Eq = minimizeGraph(G);
+  EXPECT_EQ(NumLayers, Eq.getNumClasses());
+
+  auto Minimized = createEquivalentGraphFrom(std::move(G), Eq);
+  ASSERT_EQ(NumLayers, traits_t::size(Minimized));
+  EXPECT_EQ(1U, llvm::size(traits_t::roots(Minimized)));
+  for (auto Vtx : traits_t::vertices(Minimized)) {
+    EXPECT_LE(traits_t::outDegree(Minimized, Vtx), 1U);
+  }
+}
+
+TEST(DFAMinimizerTest, ScalarNodes) {
+  // The node-tags are plain ints instead of ranges:
+  // 0:1 -> {1:2, 2:2, 3:2}
+  AdjacencyList<int> G;
+  using int_traits_t = GraphTraits<AdjacencyList<int>>;
+  auto Rt = int_traits_t::addNode(G, 1);
+  auto A = int_traits_t::addNode(G, 2);
+  auto B = int_traits_t::addNode(G, 2);
+  auto C = int_traits_t::addNode(G, 2);
+  int_traits_t::addRoot(G, Rt);
+  int_traits_t::addEdge(G, Rt, A);
+  int_traits_t::addEdge(G, Rt, B);
+  int_traits_t::addEdge(G, Rt, C);
+
+  auto Eq = minimizeGraph(G);
+  EXPECT_EQ(2U, Eq.getNumClasses());
+  EXPECT_EQ(Eq[A], Eq[B]);
+  EXPECT_EQ(Eq[A], Eq[C]);
+
+  auto Minimized = createEquivalentGraphFrom(std::move(G), Eq);
+  ASSERT_EQ(2U, int_traits_t::size(Minimized));
+  ASSERT_EQ(1U, int_traits_t::roots_size(Minimized));
+  auto MinRt = int_traits_t::roots(Minimized)[0];
+  EXPECT_EQ(1, int_traits_t::node(Minimized, MinRt));
+  EXPECT_EQ(1U, int_traits_t::outDegree(Minimized, MinRt));
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
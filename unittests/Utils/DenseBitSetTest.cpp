@@ -0,0 +1,118 @@
+#include "phasar/Utils/DenseBitSet.h"
+
+#include "phasar/Utils/Utilities.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <set>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+std::set<int> toSet(const DenseBitSet<int> &BS) {
+  return {BS.begin(), BS.end()};
+}
+} // namespace
+
+TEST(DenseBitSetTest, insertEraseCount) {
+  auto Index =
+      std::make_shared<DenseBitSetIndex<int>>(std::vector<int>{10, 20, 30});
+  EXPECT_EQ(3U, Index->size());
+
+  DenseBitSet<int> BS(Index);
+  EXPECT_TRUE(BS.empty());
+  EXPECT_TRUE(BS.insert(20));
+  EXPECT_FALSE(BS.insert(20));
+  // Unknown values extend the index
+  EXPECT_TRUE(BS.insert(42));
+  EXPECT_EQ(4U, Index->size());
+
+  EXPECT_EQ(2U, BS.size());
+  EXPECT_EQ(1U, BS.count(20));
+  EXPECT_EQ(0U, BS.count(10));
+  EXPECT_EQ(0U, BS.count(1337));
+  EXPECT_EQ((std::set<int>{20, 42}), toSet(BS));
+
+  EXPECT_TRUE(BS.erase(20));
+  EXPECT_FALSE(BS.erase(20));
+  EXPECT_FALSE(BS.erase(1337));
+  EXPECT_EQ((std::set<int>{42}), toSet(BS));
+}
+
+TEST(DenseBitSetTest, setOperations) {
+  auto Index = std::make_shared<DenseBitSetIndex<int>>();
+  DenseBitSet<int> A(Index, {1, 2, 3});
+  DenseBitSet<int> B(Index, {3, 4});
+
+  EXPECT_EQ((std::set<int>{1, 2, 3, 4}), toSet(A.setUnion(B)));
+  EXPECT_EQ((std::set<int>{3}), toSet(A.setIntersect(B)));
+  EXPECT_TRUE(A.setUnion(B).includes(B));
+  EXPECT_FALSE(A.includes(B));
+
+  auto C = A;
+  C.erase(B);
+  EXPECT_EQ((std::set<int>{1, 2}), toSet(C));
+
+  intersectWith(C, B);
+  EXPECT_TRUE(C.empty());
+}
+
+TEST(DenseBitSetTest, equalityIgnoresTrailingZeros) {
+  auto Index = std::make_shared<DenseBitSetIndex<int>>();
+  for (int I = 0; I != 200; ++I) {
+    Index->getOrInsert(I);
+  }
+
+  DenseBitSet<int> A(Index, {1});
+  DenseBitSet<int> B(Index, {1, 150});
+  EXPECT_NE(A, B);
+  B.erase(150);
+  EXPECT_EQ(A, B);
+  EXPECT_EQ(hash_value(A), hash_value(B));
+
+  // An unbound, empty set equals every empty set
+  DenseBitSet<int> Empty;
+  A.erase(1);
+  EXPECT_EQ(Empty, A);
+}
+
+TEST(DenseBitSetTest, unboundSetAdoptsIndex) {
+  auto Index = std::make_shared<DenseBitSetIndex<int>>();
+  DenseBitSet<int> A(Index, {5, 6});
+
+  DenseBitSet<int> Merged;
+  Merged.insert(A.begin(), A.end());
+  EXPECT_EQ(Index.get(), Merged.getIndex());
+  EXPECT_EQ(A, Merged);
+
+  // Now, Merged can take single values as well
+  Merged.insert(7);
+  EXPECT_EQ((std::set<int>{5, 6, 7}), toSet(Merged));
+}
+
+TEST(DenseBitSetTest, setsKeepTheirIndexAlive) {
+  DenseBitSet<int> Copy;
+  std::weak_ptr<DenseBitSetIndex<int>> WeakIndex;
+  {
+    auto Index = std::make_shared<DenseBitSetIndex<int>>();
+    WeakIndex = Index;
+    DenseBitSet<int> A(std::move(Index), {1, 2});
+    Copy = A;
+  }
+  // The owner of the index and the original set are gone
+  EXPECT_FALSE(WeakIndex.expired());
+  EXPECT_EQ((std::set<int>{1, 2}), toSet(Copy));
+  Copy.insert(3);
+  EXPECT_EQ((std::set<int>{1, 2, 3}), toSet(Copy));
+
+  Copy = DenseBitSet<int>();
+  EXPECT_TRUE(WeakIndex.expired());
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
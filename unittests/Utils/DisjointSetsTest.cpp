@@ -0,0 +1,87 @@
+#include "phasar/Utils/DisjointSets.h"
+
+#include "gtest/gtest.h"
+
+#include <set>
+
+using namespace psr;
+
+namespace {
+std::set<uint32_t> membersOf(const DisjointSets &Sets, uint32_t Id) {
+  auto Range = Sets.members(Id);
+  return {Range.begin(), Range.end()};
+}
+} // namespace
+
+TEST(DisjointSetsTest, Singletons) {
+  DisjointSets Sets(3);
+  EXPECT_EQ(3U, Sets.size());
+  EXPECT_EQ(3U, Sets.makeSet());
+
+  for (uint32_t Id = 0; Id < 4; ++Id) {
+    EXPECT_TRUE(Sets.isRoot(Id));
+    EXPECT_EQ(Id, Sets.find(Id));
+    EXPECT_EQ(1U, Sets.setSize(Id));
+    EXPECT_EQ(std::set<uint32_t>{Id}, membersOf(Sets, Id));
+  }
+  EXPECT_FALSE(Sets.inSameSet(0, 1));
+}
+
+TEST(DisjointSetsTest, UniteMergesMembers) {
+  DisjointSets Sets(6);
+  Sets.unite(0, 1);
+  Sets.unite(2, 3);
+  EXPECT_FALSE(Sets.inSameSet(1, 2));
+
+  auto Root = Sets.unite(1, 3);
+  EXPECT_TRUE(Root == Sets.find(0) && Root == Sets.find(2));
+  EXPECT_EQ(Root, Sets.unite(0, 2));
+  EXPECT_EQ(4U, Sets.setSize(3));
+  EXPECT_EQ((std::set<uint32_t>{0, 1, 2, 3}), membersOf(Sets, 2));
+  EXPECT_EQ(4U, membersOf(Sets, 0).size());
+
+  EXPECT_EQ(std::set<uint32_t>{4}, membersOf(Sets, 4));
+  EXPECT_FALSE(Sets.inSameSet(4, 5));
+}
+
+TEST(DisjointSetsTest, LongChains) {
+  constexpr uint32_t NumElements = 10000;
+  DisjointSets Sets(NumElements);
+  for (uint32_t Id = 1; Id < NumElements; ++Id) {
+    Sets.unite(Id - 1, Id);
+  }
+
+  auto Root = Sets.find(0);
+  EXPECT_EQ(NumElements, Sets.setSize(NumElements - 1));
+  EXPECT_EQ(NumElements, membersOf(Sets, Root).size());
+  for (uint32_t Id = 0; Id < NumElements; ++Id) {
+    EXPECT_EQ(Root, Sets.find(Id));
+  }
+}
+
+TEST(DisjointSetsTest, DissolveCreatesSingletons) {
+  DisjointSets Sets(6);
+  Sets.unite(0, 1);
+  Sets.unite(2, 3);
+  Sets.unite(1, 3);
+  Sets.unite(4, 5);
+
+  Sets.dissolve(2);
+  for (uint32_t Id = 0; Id < 4; ++Id) {
+    EXPECT_TRUE(Sets.isRoot(Id));
+    EXPECT_EQ(1U, Sets.setSize(Id));
+    EXPECT_EQ(std::set<uint32_t>{Id}, membersOf(Sets, Id));
+  }
+  EXPECT_TRUE(Sets.inSameSet(4, 5));
+
+  // The singletons can be united again
+  Sets.unite(3, 0);
+  EXPECT_EQ((std::set<uint32_t>{0, 3}), membersOf(Sets, 0));
+  EXPECT_FALSE(Sets.inSameSet(0, 1));
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
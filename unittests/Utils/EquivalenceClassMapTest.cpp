@@ -1,5 +1,7 @@
 #include "phasar/Utils/EquivalenceClassMap.h"
 
+#include "phasar/Utils/CountingAllocator.h"
+
 #include "gtest/gtest.h"
 
 #include <optional>
@@ -181,6 +183,24 @@ TEST(EquivalenceClassMap, threeMixedValues) {
   EXPECT_EQ(M.numEquivalenceClasses(), 2U);
 }
 
+TEST(EquivalenceClassMap, countingAllocator) {
+  size_t NumBytes = 0;
+  {
+    using MapTy = EquivalenceClassMap<int, std::string, CountingAllocator<int>>;
+    MapTy M(0, CountingAllocator<int>(&NumBytes));
+    EXPECT_EQ(NumBytes, 0U);
+
+    M.insert(std::make_pair(42, "foo"));
+    auto NumBytesOneClass = NumBytes;
+    EXPECT_GT(NumBytesOneClass, 0U);
+
+    M.insert(std::make_pair(40, "foo"));
+    EXPECT_GT(NumBytes, NumBytesOneClass);
+    EXPECT_EQ(M.get_allocator().getNumBytesAllocated(), NumBytes);
+  }
+  EXPECT_EQ(NumBytes, 0U);
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
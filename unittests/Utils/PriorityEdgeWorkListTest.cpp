@@ -0,0 +1,97 @@
+#include "phasar/Utils/PriorityEdgeWorkList.h"
+
+#include "gtest/gtest.h"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+using EdgeTy = std::pair<int, int>;
+
+// 0 -> 1 -> 2 -> 3
+//      ^---------'
+//      '--> 4 --> 3
+const std::map<int, std::vector<int>> Succs = {
+    {0, {1}}, {1, {2, 4}}, {2, {3}}, {3, {1}}, {4, {3}},
+};
+
+const std::vector<int> &getSuccs(int Node) { return Succs.at(Node); }
+
+std::vector<EdgeTy> drain(PriorityEdgeWorkList<int> &WL) {
+  std::vector<EdgeTy> Ret;
+  while (!WL.empty()) {
+    Ret.push_back(WL.pop());
+  }
+  return Ret;
+}
+} // namespace
+
+TEST(PriorityEdgeWorkListTest, reversePostOrder) {
+  PriorityEdgeWorkList<int> WL;
+  WL.addReversePostOrder(std::vector<int>{0}, getSuccs);
+  EXPECT_EQ(5U, WL.getNumNodes());
+
+  WL.push(3, 1);
+  WL.push(2, 3);
+  WL.push(4, 3);
+  WL.push(0, 1);
+
+  // The loop header 1 is not pending, so 3 comes last. The DFS visits 2
+  // before 4, so 4 precedes 2 in reverse postorder.
+  std::vector<EdgeTy> Expected = {{0, 1}, {4, 3}, {2, 3}, {3, 1}};
+  EXPECT_EQ(Expected, drain(WL));
+  EXPECT_EQ(4U, WL.getNumPops());
+}
+
+TEST(PriorityEdgeWorkListTest, deduplicatesPendingEdges) {
+  PriorityEdgeWorkList<int> WL;
+  WL.addReversePostOrder(std::vector<int>{0}, getSuccs);
+
+  EXPECT_TRUE(WL.push(1, 2));
+  EXPECT_TRUE(WL.push(1, 4));
+  EXPECT_FALSE(WL.push(1, 2));
+  EXPECT_TRUE(WL.push(0, 1));
+  EXPECT_FALSE(WL.push(0, 1));
+  EXPECT_EQ(3U, WL.size());
+  EXPECT_EQ(2U, WL.getNumDuplicates());
+
+  size_t NumPending = 0;
+  WL.foreachPending([&NumPending](int, int) { ++NumPending; });
+  EXPECT_EQ(3U, NumPending);
+
+  EXPECT_EQ(EdgeTy(0, 1), WL.pop());
+  // Once popped, an edge can be added again
+  EXPECT_TRUE(WL.push(0, 1));
+  EXPECT_EQ(EdgeTy(0, 1), WL.pop());
+
+  auto Rest = drain(WL);
+  ASSERT_EQ(2U, Rest.size());
+  EXPECT_EQ(1, Rest[0].first);
+  EXPECT_EQ(1, Rest[1].first);
+  EXPECT_EQ(4U, WL.getNumPushes());
+  EXPECT_EQ(4U, WL.getNumPops());
+}
+
+TEST(PriorityEdgeWorkListTest, groupsAndUnnumberedNodes) {
+  PriorityEdgeWorkList<int> WL;
+  WL.addReversePostOrder(std::vector<int>{2}, getSuccs, /*Group*/ 1);
+  // 2, 3, 1 and 4 are already numbered
+  WL.addReversePostOrder(std::vector<int>{0}, getSuccs, /*Group*/ 0);
+
+  WL.push(42, 0);
+  WL.push(2, 3);
+  WL.push(0, 1);
+  WL.push(4, 3);
+
+  std::vector<EdgeTy> Expected = {{0, 1}, {2, 3}, {4, 3}, {42, 0}};
+  EXPECT_EQ(Expected, drain(WL));
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}